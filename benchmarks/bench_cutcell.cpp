@@ -0,0 +1,345 @@
+// Benchmark: end-to-end cut-cell heat problem with embedded spheres
+//
+// Each phase of a run is a separate family so a regression points at the phase:
+//
+//   BM_cutcell_geometry  - mesh construction: ray casting every grid line against
+//                          the spheres and building the fluid selections
+//   BM_cutcell_assembly  - laplacian construction: the O/B/N and Bf*/Br* matrices
+//                          of the three directions on that mesh
+//   BM_cutcell_rhs       - one submit of the pre-built heat RHS graph
+//   BM_cutcell_step      - one rk4 step through integrator::operator()
+//   BM_cutcell_boundary  - update_boundary followed by stats, as run after a step
+//   BM_cutcell_io        - system::write through field_io (xdmf + raw data)
+//
+// Parameterized by mesh size (N³), object count and stencil order (E2 or E4
+// second derivative).  The spheres sit on a ceil(cbrt(objects))³ lattice with
+// Dirichlet conditions, and the domain has Dirichlet xmin/xmax faces.  An
+// object count of 0 is the object-free cube of bench_rhs, for reference.
+//
+// The thread count is fixed per process.  scripts/bench_compare.sh reruns this
+// benchmark for each count in BENCH_THREADS and suffixes the names with
+// /threads:T, so the baselines cover the whole matrix.
+
+#include <benchmark/benchmark.h>
+
+#include <Kokkos_Core.hpp>
+#include <sol/sol.hpp>
+
+#include "fields/field_registry.hpp"
+#include "io/field_io.hpp"
+#include "mesh/mesh.hpp"
+#include "operators/boundaries.hpp"
+#include "operators/laplacian.hpp"
+#include "stencils/stencil.hpp"
+#include "systems/system.hpp"
+#include "temporal/integrator.hpp"
+#include "temporal/step_controller.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <string>
+
+#include <fmt/core.h>
+
+using namespace ccs;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+// Spheres on an m³ lattice of cells with m = ceil(cbrt(objects)), filling the
+// cells in order.  The radius leaves 0.4/m between neighbours and 0.2/m to the
+// domain faces, and the centers are nudged off the grid points.
+std::string shapes(int objects)
+{
+    if (objects == 0) return "{}";
+
+    const int m = static_cast<int>(std::ceil(std::cbrt(static_cast<double>(objects))));
+    std::string s = "{";
+    for (int n = 0; n < objects; ++n) {
+        const int i = n / (m * m), j = (n / m) % m, k = n % m;
+        s += fmt::format(
+            "{{ type = 'sphere', center = {{{}, {}, {}}}, radius = {}, "
+            "boundary_condition = 'dirichlet' }},",
+            (i + 0.5) / m + 0.0013,
+            (j + 0.5) / m - 0.0011,
+            (k + 0.5) / m + 0.0017,
+            0.3 / m);
+    }
+    return s + "}";
+}
+
+std::string config(int N, int objects, int order, const std::string& io_dir)
+{
+    return fmt::format(R"(
+        simulation = {{
+            mesh = {{
+                index_extents = {{{0}, {0}, {0}}},
+                domain_bounds = {{
+                    min = {{0.0, 0.0, 0.0}},
+                    max = {{1.0, 1.0, 1.0}}
+                }}
+            }},
+            domain_boundaries = {{
+                xmin = "dirichlet",
+                xmax = "dirichlet"
+            }},
+            shapes = {1},
+            scheme = {{
+                order = 2,
+                type = "E{2}"
+            }},
+            system = {{
+                type = "heat",
+                diffusivity = 0.1
+            }},
+            integrator = {{
+                type = "rk4"
+            }},
+            io = {{
+                write_every_step = 1,
+                dir = "{3}"
+            }},
+            manufactured_solution = {{
+                type = "gaussian",
+                {{
+                    center = {{0.5, 0.5, 0.5}},
+                    variance = {{0.3, 0.3, 0.3}},
+                    amplitude = 1.0,
+                    frequency = 1.0
+                }}
+            }}
+        }}
+    )",
+                       N,
+                       shapes(objects),
+                       order,
+                       io_dir);
+}
+
+// range(0) = N, range(1) = objects, range(2) = order (2 = E2, 4 = E4; geometry
+// has no order and uses E2)
+struct lua_config {
+    sol::state lua;
+
+    lua_config(benchmark::State& state, int order, const std::string& io_dir = "io")
+    {
+        lua.open_libraries(sol::lib::base, sol::lib::math);
+        lua.script(config(static_cast<int>(state.range(0)),
+                          static_cast<int>(state.range(1)),
+                          order,
+                          io_dir));
+    }
+
+    explicit lua_config(benchmark::State& state, const std::string& io_dir = "io")
+        : lua_config(state, static_cast<int>(state.range(2)), io_dir)
+    {
+    }
+
+    sol::table simulation() { return lua["simulation"]; }
+};
+
+template <typename T>
+T required(std::optional<T>&& opt, const char* what)
+{
+    if (!opt) throw std::runtime_error(std::string{"Failed to build "} + what);
+    return std::move(*opt);
+}
+
+// The four registry slots of simulation_cycle::run with the system initialized,
+// boundary data applied and the RHS graph built.
+struct cutcell_run {
+    system sys;
+    step_controller controller{};
+    sim_registry reg{};
+    field_ref u0{0}, u1{1}, rk{2}, srhs{3};
+    mesh m;
+
+    explicit cutcell_run(lua_config& cfg)
+        : sys{required(system::from_lua(cfg.simulation()), "system")},
+          m{required(mesh::from_lua(cfg.simulation()), "mesh")}
+    {
+        auto sz = sys.size();
+        for (int s = 0; s < sz.nscalars; ++s) {
+            u0 = reg.allocate_scalar(0, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+            u1 = reg.allocate_scalar(1, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+            rk = reg.allocate_scalar(2, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+            srhs =
+                reg.allocate_scalar(3, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        }
+
+        sys.initialize(reg, u0, controller);
+        reg.deep_copy_slot(u1.slot, u0.slot);
+        sys.update_boundary(reg, u0, controller);
+        sys.build_rhs_graph(reg, u1, reg, srhs);
+    }
+};
+
+void set_counters(benchmark::State& state, const mesh& m)
+{
+    const auto R = m.Rx().size() + m.Ry().size() + m.Rz().size();
+    state.counters["points"] = static_cast<double>(m.size());
+    state.counters["boundary_points"] = static_cast<double>(R);
+    state.counters["points/s"] = benchmark::Counter(
+        static_cast<double>(m.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["threads"] = execution_space().concurrency();
+}
+
+void BM_cutcell_geometry(benchmark::State& state)
+{
+    lua_config cfg{state, 2};
+
+    mesh m{};
+    for (auto _ : state) {
+        m = required(mesh::from_lua(cfg.simulation()), "mesh");
+        benchmark::DoNotOptimize(m.Rx().data());
+    }
+    set_counters(state, m);
+}
+
+void BM_cutcell_assembly(benchmark::State& state)
+{
+    lua_config cfg{state};
+    auto m = required(mesh::from_lua(cfg.simulation()), "mesh");
+    auto&& [grid_bcs, object_bcs] =
+        required(bcs::from_lua(cfg.simulation(), m.extents()), "bcs");
+    auto st = required(stencil::from_lua(cfg.simulation()), "stencil");
+
+    for (auto _ : state) {
+        auto lap = laplacian{m, st, grid_bcs, object_bcs};
+        benchmark::DoNotOptimize(lap);
+    }
+    set_counters(state, m);
+}
+
+void BM_cutcell_rhs(benchmark::State& state)
+{
+    lua_config cfg{state};
+    cutcell_run run{cfg};
+
+    // Warm up.
+    run.sys.submit_rhs_graph(run.reg, run.u1, run.reg, run.srhs, run.controller);
+
+    for (auto _ : state) {
+        run.sys.submit_rhs_graph(run.reg, run.u1, run.reg, run.srhs, run.controller);
+    }
+    set_counters(state, run.m);
+}
+
+void BM_cutcell_step(benchmark::State& state)
+{
+    lua_config cfg{state};
+    cutcell_run run{cfg};
+    auto integrate = required(integrator::from_lua(cfg.simulation()), "integrator");
+
+    const auto dt = run.sys.timestep_size(run.reg, run.u0, run.controller);
+    if (!dt) throw std::runtime_error("required timestep too small");
+
+    // Warm up.
+    integrate(run.sys, run.reg, run.u0, run.u1, run.rk, run.srhs, run.controller, *dt);
+
+    // the controller is not advanced, so every step starts from the same time
+    for (auto _ : state) {
+        integrate(
+            run.sys, run.reg, run.u0, run.u1, run.rk, run.srhs, run.controller, *dt);
+    }
+    set_counters(state, run.m);
+}
+
+void BM_cutcell_boundary(benchmark::State& state)
+{
+    lua_config cfg{state};
+    cutcell_run run{cfg};
+
+    for (auto _ : state) {
+        run.sys.update_boundary(run.reg, run.u1, run.controller);
+        auto stats = run.sys.stats(run.reg, run.u0, run.u1, run.controller);
+        benchmark::DoNotOptimize(stats);
+    }
+    set_counters(state, run.m);
+}
+
+void BM_cutcell_io(benchmark::State& state)
+{
+    const auto dir = fs::temp_directory_path() / "shoccs_bench_cutcell_io";
+    fs::remove_all(dir);
+
+    lua_config cfg{state, dir.string()};
+    cutcell_run run{cfg};
+    auto io = required(field_io::from_lua(cfg.simulation()), "field_io");
+
+    // every write at step 0 is a new dump, so the iterations are fixed below to
+    // bound the disk usage
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(run.sys.write(io, run.reg, run.u1, run.controller, 0.0));
+    }
+    set_counters(state, run.m);
+
+    // the solution and error fields, without the geometry written once
+    state.counters["BW(GB/s)"] = benchmark::Counter(
+        2.0 * static_cast<double>(run.m.size()) * sizeof(real),
+        benchmark::Counter::kIsIterationInvariantRate,
+        benchmark::Counter::kIs1024);
+
+    fs::remove_all(dir);
+}
+
+// N x objects
+void geometry_args(benchmark::internal::Benchmark* b)
+{
+    for (int N : {32, 64})
+        for (int objects : {0, 1, 8})
+            b->Args({N, objects});
+}
+
+// N x objects x order
+void cutcell_args(benchmark::internal::Benchmark* b)
+{
+    for (int N : {32, 64})
+        for (int objects : {0, 1, 8})
+            for (int order : {2, 4})
+                b->Args({N, objects, order});
+}
+
+BENCHMARK(BM_cutcell_geometry)
+    ->Apply(geometry_args)
+    ->ArgNames({"N", "objects"})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_cutcell_assembly)
+    ->Apply(cutcell_args)
+    ->ArgNames({"N", "objects", "E"})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_cutcell_rhs)
+    ->Apply(cutcell_args)
+    ->ArgNames({"N", "objects", "E"})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_cutcell_step)
+    ->Apply(cutcell_args)
+    ->ArgNames({"N", "objects", "E"})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_cutcell_boundary)
+    ->Apply(cutcell_args)
+    ->ArgNames({"N", "objects", "E"})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_cutcell_io)
+    ->Apply(cutcell_args)
+    ->ArgNames({"N", "objects", "E"})
+    ->Iterations(10)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+// Custom main: Kokkos must be initialized before any Kokkos calls.
+int main(int argc, char** argv)
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
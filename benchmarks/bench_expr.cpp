@@ -8,6 +8,9 @@
 // Benchmarks:
 //   - assign(dst, N, a + b * c)   — ternary expression, aliasing-safe path
 //   - plus_assign(dst, N, a * b)  — compound-assign (no alias check)
+//   - index_width<int|integer>    — the same plus_assign kernel under a 32-bit
+//                                   and a 64-bit RangePolicy index, i.e. the
+//                                   two paths index_for dispatches between
 //
 // Parameterized by vector length N (1K .. 1M elements).
 // Reports effective memory bandwidth (GB/s).
@@ -19,6 +22,7 @@
 #include <Kokkos_Core.hpp>
 
 #include "fields/expr.hpp"
+#include "kokkos_types.hpp"
 #include "types.hpp"
 
 #include <cmath>
@@ -38,12 +42,12 @@ namespace
 //   total:  4 × sizeof(real)  = 32 bytes (double)
 void BM_assign_fma(benchmark::State& state)
 {
-    const auto n = static_cast<int>(state.range(0));
+    const auto n = static_cast<integer>(state.range(0));
 
     std::vector<real> a_vec(n), b_vec(n), c_vec(n), dst_vec(n);
 
     // Fill with smooth data for realistic cache patterns.
-    for (int i = 0; i < n; ++i) {
+    for (integer i = 0; i < n; ++i) {
         const auto t = static_cast<real>(i) / static_cast<real>(n);
         a_vec[i] = std::sin(2.0 * M_PI * t);
         b_vec[i] = std::cos(2.0 * M_PI * t);
@@ -82,11 +86,11 @@ void BM_assign_fma(benchmark::State& state)
 //   total:  4 × sizeof(real)    = 32 bytes (double)
 void BM_plus_assign_mul(benchmark::State& state)
 {
-    const auto n = static_cast<int>(state.range(0));
+    const auto n = static_cast<integer>(state.range(0));
 
     std::vector<real> a_vec(n), b_vec(n), dst_vec(n);
 
-    for (int i = 0; i < n; ++i) {
+    for (integer i = 0; i < n; ++i) {
         const auto t = static_cast<real>(i) / static_cast<real>(n);
         a_vec[i] = std::sin(2.0 * M_PI * t);
         b_vec[i] = std::cos(2.0 * M_PI * t);
@@ -115,6 +119,45 @@ void BM_plus_assign_mul(benchmark::State& state)
     state.counters["points"] = static_cast<double>(n);
 }
 
+// dst[i] += a[i] * b[i] under an explicit index type.  index_for picks the int
+// policy whenever the field fits, so the int row is what every mesh below 2^31
+// points runs; the integer row is the cost of the wide path at the same size.
+template <typename I>
+void BM_index_width(benchmark::State& state)
+{
+    const auto n = static_cast<I>(state.range(0));
+
+    std::vector<real> a_vec(n), b_vec(n), dst_vec(n);
+
+    for (I i = 0; i < n; ++i) {
+        const auto t = static_cast<real>(i) / static_cast<real>(n);
+        a_vec[i] = std::sin(2.0 * M_PI * t);
+        b_vec[i] = std::cos(2.0 * M_PI * t);
+        dst_vec[i] = t;
+    }
+
+    const real* a = a_vec.data();
+    const real* b = b_vec.data();
+    real* d = dst_vec.data();
+    auto kernel = KOKKOS_LAMBDA(I i) { d[i] += a[i] * b[i]; };
+
+    // Warm up.
+    Kokkos::parallel_for(index_policy<I>(0, n), kernel);
+    Kokkos::fence();
+
+    for (auto _ : state) {
+        Kokkos::parallel_for(index_policy<I>(0, n), kernel);
+        Kokkos::fence();
+    }
+
+    const auto bytes_per_point = 4.0 * sizeof(real);
+    state.counters["BW(GB/s)"] = benchmark::Counter(
+        static_cast<double>(n) * bytes_per_point,
+        benchmark::Counter::kIsIterationInvariantRate,
+        benchmark::Counter::kIs1024);
+    state.counters["points"] = static_cast<double>(n);
+}
+
 BENCHMARK(BM_assign_fma)
     ->Arg(1 << 10)   //    1K
     ->Arg(1 << 14)   //   16K
@@ -129,6 +172,20 @@ BENCHMARK(BM_plus_assign_mul)
     ->Arg(1 << 20)   //    1M
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_TEMPLATE(BM_index_width, int)
+    ->Arg(1 << 10)   //    1K
+    ->Arg(1 << 17)   //  128K
+    ->Arg(1 << 20)   //    1M
+    ->Arg(1 << 24)   //   16M
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_index_width, integer)
+    ->Arg(1 << 10)   //    1K
+    ->Arg(1 << 17)   //  128K
+    ->Arg(1 << 20)   //    1M
+    ->Arg(1 << 24)   //   16M
+    ->Unit(benchmark::kMicrosecond);
+
 } // namespace
 
 // Custom main: Kokkos must be initialized before any Kokkos calls.
@@ -1,4 +1,4 @@
-// Benchmark: full Heat RHS evaluation via graph submit
+// Benchmark: full system RHS evaluation via graph submit
 //
 // Exercises the complete heat::build_rhs_graph() + submit_rhs_graph() path:
 // laplacian (3 derivative axes), diffusivity scaling, source scatter from
@@ -8,6 +8,19 @@
 // Parameterized by mesh size (N³ cubic grid) with E2 stencil and Dirichlet BCs.
 // Uses Gaussian MMS (thread-safe, pre-evaluated into member buffers before the
 // timed loop, so MMS cost is setup-only).
+//
+// BM_scalar_wave_rhs covers the fused advection path (-gG·∇u with the wave
+// speed folded into each derivative application) on the same grids.
+//
+// BM_heat_rhs_split is BM_heat_rhs with the laplacian's split graph schedule
+// (system.schedule = "split"), which overlaps the directions and the boundary
+// corrections on disjoint parts of the output.
+//
+// BM_heat_scalars_rhs runs 1-8 heat scalars through one batched laplacian, so
+// the per-scalar cost shows how much coefficient traffic the batch amortizes.
+//
+// BM_inviscid_vortex_rhs covers the compressible Euler flux divergence on a 2D
+// N² grid, with fluxes evaluated per point as each stencil reads the state.
 
 #include <benchmark/benchmark.h>
 
@@ -17,9 +30,12 @@
 #include "fields/field_registry.hpp"
 #include "fields/scalar.hpp"
 #include "systems/heat.hpp"
+#include "systems/inviscid_vortex.hpp"
+#include "systems/scalar_wave.hpp"
 #include "temporal/step_controller.hpp"
 
 #include <string>
+#include <vector>
 
 using namespace ccs;
 
@@ -29,7 +45,7 @@ namespace
 // Build a heat system from Lua for a cubic N³ mesh with Gaussian MMS.
 // Dirichlet BCs on xmin/xmax, Floating on the rest — exercises the full
 // graph path including source scatter and BC fill.
-systems::heat build_heat(int N)
+systems::heat build_heat(int N, int scalars = 1, const std::string& schedule = "chained")
 {
     sol::state lua;
     lua.open_libraries(sol::lib::base, sol::lib::math);
@@ -56,7 +72,9 @@ systems::heat build_heat(int N)
             },
             system = {
                 type = "heat",
-                diffusivity = 0.1
+                diffusivity = 0.1,
+                scalars = )" + std::to_string(scalars) + R"(,
+                schedule = ")" + schedule + R"("
             },
             manufactured_solution = {
                 type = "gaussian",
@@ -77,12 +95,12 @@ systems::heat build_heat(int N)
     return std::move(*opt);
 }
 
-void BM_heat_rhs(benchmark::State& state)
+void heat_rhs(benchmark::State& state, const std::string& schedule)
 {
     const auto N = static_cast<int>(state.range(0));
     const auto total = static_cast<std::size_t>(N) * N * N;
 
-    auto heat = build_heat(N);
+    auto heat = build_heat(N, 1, schedule);
     auto sz = heat.size();
 
     // Allocate registry with 2 slots: u0 (input) and du (output).
@@ -132,12 +150,262 @@ void BM_heat_rhs(benchmark::State& state)
     state.counters["points"] = n_points;
 }
 
+void BM_heat_rhs(benchmark::State& state) { heat_rhs(state, "chained"); }
+
 BENCHMARK(BM_heat_rhs)
     ->Arg(16)
     ->Arg(32)
     ->Arg(64)
     ->Unit(benchmark::kMillisecond);
 
+void BM_heat_rhs_split(benchmark::State& state) { heat_rhs(state, "split"); }
+
+BENCHMARK(BM_heat_rhs_split)
+    ->Arg(16)
+    ->Arg(32)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_heat_scalars_rhs(benchmark::State& state)
+{
+    const auto N = static_cast<int>(state.range(0));
+    const auto n_scalars = static_cast<int>(state.range(1));
+    const auto total = static_cast<std::size_t>(N) * N * N;
+
+    auto heat = build_heat(N, n_scalars);
+    auto sz = heat.size();
+
+    sim_registry reg;
+    field_ref u0_ref{0}, du_ref{1};
+    for (int s = 0; s < sz.nscalars; ++s) {
+        u0_ref = reg.allocate_scalar(0, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        du_ref = reg.allocate_scalar(1, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+    }
+
+    step_controller step{};
+    heat.initialize(reg, u0_ref, step);
+    heat.update_boundary(reg, u0_ref, (real)step);
+    heat.fill_source((real)step);
+
+    std::vector<scalar_view> u;
+    std::vector<scalar_span> du;
+    for (int s = 0; s < sz.nscalars; ++s) {
+        const scalar_handle sh{s * sim_registry::layout_type::scalar_stride};
+        u.push_back(extract_scalar_view(reg, u0_ref, sh));
+        du.push_back(extract_scalar_span(reg, du_ref, sh));
+    }
+    heat.build_rhs_graph(u, du);
+
+    // Warm up.
+    heat.submit_rhs_graph();
+
+    for (auto _ : state) {
+        heat.submit_rhs_graph();
+    }
+
+    // Field traffic grows with the scalar count while the operator metadata and
+    // coefficients are streamed once per sweep, so the per-scalar rate should
+    // rise with the batch size.
+    state.counters["scalar_points/s"] = benchmark::Counter(
+        static_cast<double>(total) * n_scalars, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["points"] = static_cast<double>(total);
+}
+
+BENCHMARK(BM_heat_scalars_rhs)
+    ->Args({32, 1})
+    ->Args({32, 2})
+    ->Args({32, 4})
+    ->Args({32, 8})
+    ->Unit(benchmark::kMillisecond);
+
+// Build a scalar_wave system for a cubic N³ mesh.  The wave center is offset
+// from the grid points so the radial speed coefficients are well defined.
+systems::scalar_wave build_scalar_wave(int N)
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+
+    std::string script = R"(
+        simulation = {
+            mesh = {
+                index_extents = {)" +
+                             std::to_string(N) + ", " + std::to_string(N) + ", " +
+                             std::to_string(N) + R"(},
+                domain_bounds = {
+                    min = {0.0, 0.0, 0.0},
+                    max = {1.0, 1.0, 1.0}
+                }
+            },
+            domain_boundaries = {
+                xmin = "dirichlet",
+                xmax = "dirichlet"
+            },
+            scheme = {
+                order = 1,
+                type = "E2",
+                alpha = {-1.47956280234494, 0.261900367793859, -0.145072532538541, -0.224665713988644}
+            },
+            system = {
+                type = "scalar wave",
+                center = {0.50013, 0.49987, 0.50021},
+                radius = 0.1
+            }
+        }
+    )";
+
+    lua.script(script);
+
+    auto opt = systems::scalar_wave::from_lua(lua["simulation"]);
+    if (!opt) throw std::runtime_error("Failed to build scalar_wave system");
+    return std::move(*opt);
+}
+
+void BM_scalar_wave_rhs(benchmark::State& state)
+{
+    const auto N = static_cast<int>(state.range(0));
+    const auto total = static_cast<std::size_t>(N) * N * N;
+
+    auto sw = build_scalar_wave(N);
+    auto sz = sw.size();
+
+    sim_registry reg;
+    field_ref u0_ref{0}, du_ref{1};
+    for (int s = 0; s < sz.nscalars; ++s) {
+        u0_ref = reg.allocate_scalar(0, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        du_ref = reg.allocate_scalar(1, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+    }
+
+    step_controller step{};
+    sw.initialize(reg, u0_ref, step);
+    sw.update_boundary(reg, u0_ref, (real)step);
+
+    constexpr auto sh = scalar_handle{0};
+    auto u = extract_scalar_view(reg, u0_ref, sh);
+    auto du = extract_scalar_span(reg, du_ref, sh);
+
+    sw.build_rhs_graph(u, du);
+
+    // Warm up.
+    sw.submit_rhs_graph();
+
+    for (auto _ : state) {
+        sw.submit_rhs_graph();
+    }
+
+    // Effective bandwidth estimate.
+    // One zero-fill write, then per axis: stencil_width reads of u, one read of
+    // the wave speed coefficient and a read+write of du = 3 × (3 + 1 + 2) + 1 =
+    // 19 doubles per point.  No gradient fields are written or re-read.
+    constexpr int stencil_width = 3; // E2: 2*1+1
+    const auto n_points = static_cast<double>(total);
+    const auto bytes_per_point =
+        static_cast<double>(3 * (stencil_width + 3) + 1) * sizeof(real);
+    state.counters["BW(GB/s)"] = benchmark::Counter(
+        n_points * bytes_per_point,
+        benchmark::Counter::kIsIterationInvariantRate,
+        benchmark::Counter::kIs1024);
+    state.counters["points"] = n_points;
+}
+
+BENCHMARK(BM_scalar_wave_rhs)
+    ->Arg(16)
+    ->Arg(32)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+
+// Build an isentropic vortex on a square N² mesh with the vortex at the center
+// and exact Dirichlet data on all faces.
+systems::inviscid_vortex build_inviscid_vortex(int N)
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+
+    std::string script = R"(
+        simulation = {
+            mesh = {
+                index_extents = {)" +
+                             std::to_string(N) + ", " + std::to_string(N) + R"(},
+                domain_bounds = {
+                    min = {-5.0, -5.0},
+                    max = {5.0, 5.0}
+                }
+            },
+            domain_boundaries = {
+                xmin = "dirichlet",
+                xmax = "dirichlet",
+                ymin = "dirichlet",
+                ymax = "dirichlet"
+            },
+            scheme = {
+                order = 1,
+                type = "E2",
+                alpha = {-1.47956280234494, 0.261900367793859, -0.145072532538541, -0.224665713988644}
+            },
+            system = {
+                type = "inviscid vortex"
+            }
+        }
+    )";
+
+    lua.script(script);
+
+    auto opt = systems::inviscid_vortex::from_lua(lua["simulation"]);
+    if (!opt) throw std::runtime_error("Failed to build inviscid_vortex system");
+    return std::move(*opt);
+}
+
+void BM_inviscid_vortex_rhs(benchmark::State& state)
+{
+    const auto N = static_cast<int>(state.range(0));
+    const auto total = static_cast<std::size_t>(N) * N;
+
+    auto iv = build_inviscid_vortex(N);
+    auto sz = iv.size();
+
+    sim_registry reg;
+    field_ref u0_ref{0}, du_ref{1};
+    for (int s = 0; s < sz.nscalars; ++s) {
+        u0_ref = reg.allocate_scalar(0, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        du_ref = reg.allocate_scalar(1, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+    }
+    for (int v = 0; v < sz.nvectors; ++v) {
+        u0_ref = reg.allocate_vector(0, v, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        du_ref = reg.allocate_vector(1, v, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+    }
+
+    step_controller step{};
+    iv.initialize(reg, u0_ref, step);
+    iv.update_boundary(reg, u0_ref, (real)step);
+
+    // Warm up.
+    iv.rhs(reg, u0_ref, reg, du_ref, (real)step);
+
+    for (auto _ : state) {
+        iv.rhs(reg, u0_ref, reg, du_ref, (real)step);
+    }
+
+    // Effective bandwidth estimate.
+    // Five zero-fills, then for the 4 active equations and 2 axes: stencil_width
+    // reads of each of the 5 conserved variables and a read+write of du =
+    // 5 + 4 × 2 × (3 × 5 + 2) = 141 doubles per point.  No flux fields are
+    // written or re-read.
+    constexpr int stencil_width = 3; // E2: 2*1+1
+    const auto n_points = static_cast<double>(total);
+    const auto bytes_per_point =
+        static_cast<double>(5 + 4 * 2 * (stencil_width * 5 + 2)) * sizeof(real);
+    state.counters["BW(GB/s)"] = benchmark::Counter(
+        n_points * bytes_per_point,
+        benchmark::Counter::kIsIterationInvariantRate,
+        benchmark::Counter::kIs1024);
+    state.counters["points"] = n_points;
+}
+
+BENCHMARK(BM_inviscid_vortex_rhs)
+    ->Arg(64)
+    ->Arg(128)
+    ->Arg(256)
+    ->Unit(benchmark::kMillisecond);
+
 } // namespace
 
 // Custom main: Kokkos must be initialized before any Kokkos calls.
@@ -0,0 +1,200 @@
+// Benchmark: multi-scalar heat steps against the same scalars run one after another
+//
+//   BM_batched_step   - one rk4 step of an M-scalar heat (a system.diffusivity
+//                       table), whose scalars share one batched laplacian
+//   BM_serial_step    - one rk4 step of each of M single-scalar heat systems
+//
+// Parameterized by mesh size (N³) and scalar count M.  The scalars differ only
+// in diffusivity and the cube has Dirichlet xmin/xmax faces, as bench_rhs.  The
+// scalar_steps/s counter is comparable between the two families; their ratio is
+// the gain of batching per scalar.
+
+#include <benchmark/benchmark.h>
+
+#include <Kokkos_Core.hpp>
+#include <sol/sol.hpp>
+
+#include "fields/field_registry.hpp"
+#include "systems/system.hpp"
+#include "temporal/integrator.hpp"
+#include "temporal/step_controller.hpp"
+
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+using namespace ccs;
+
+namespace
+{
+
+// scalar 0 has the largest diffusivity so its timestep is stable for all
+std::vector<real> diffusivities(int scalars)
+{
+    std::vector<real> k;
+    for (int i = 0; i < scalars; ++i) k.push_back(0.1 * (1.0 - 0.05 * i));
+    return k;
+}
+
+// `system_entries` are spliced into the system table
+std::string config(int N, const std::string& system_entries)
+{
+    return fmt::format(R"(
+        simulation = {{
+            mesh = {{
+                index_extents = {{{0}, {0}, {0}}},
+                domain_bounds = {{
+                    min = {{0.0, 0.0, 0.0}},
+                    max = {{1.0, 1.0, 1.0}}
+                }}
+            }},
+            domain_boundaries = {{
+                xmin = "dirichlet",
+                xmax = "dirichlet"
+            }},
+            scheme = {{
+                order = 2,
+                type = "E2"
+            }},
+            system = {{
+                type = "heat",
+                {1}
+            }},
+            integrator = {{
+                type = "rk4"
+            }},
+            manufactured_solution = {{
+                type = "gaussian",
+                {{
+                    center = {{0.5, 0.5, 0.5}},
+                    variance = {{0.3, 0.3, 0.3}},
+                    amplitude = 1.0,
+                    frequency = 1.0
+                }}
+            }}
+        }}
+    )",
+                       N,
+                       system_entries);
+}
+
+template <typename T>
+T required(std::optional<T>&& opt, const char* what)
+{
+    if (!opt) throw std::runtime_error(std::string{"Failed to build "} + what);
+    return std::move(*opt);
+}
+
+// A system with the four registry slots of simulation_cycle::run, initialized and
+// with its RHS graph built, stepped at a fixed dt
+struct heat_run {
+    sol::state lua;
+    system sys;
+    integrator integrate;
+    step_controller controller{};
+    sim_registry reg{};
+    field_ref u0{0}, u1{1}, rk{2}, srhs{3};
+    real dt;
+
+    explicit heat_run(const std::string& cfg)
+    {
+        lua.open_libraries(sol::lib::base, sol::lib::math);
+        lua.script(cfg);
+        sys = required(system::from_lua(lua["simulation"]), "system");
+        integrate = required(integrator::from_lua(lua["simulation"]), "integrator");
+
+        auto sz = sys.size();
+        for (int s = 0; s < sz.nscalars; ++s) {
+            u0 = reg.allocate_scalar(0, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+            u1 = reg.allocate_scalar(1, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+            rk = reg.allocate_scalar(2, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+            srhs =
+                reg.allocate_scalar(3, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        }
+
+        sys.initialize(reg, u0, controller);
+        reg.deep_copy_slot(u1.slot, u0.slot);
+        sys.update_boundary(reg, u0, controller);
+        sys.build_rhs_graph(reg, u1, reg, srhs);
+
+        dt = required(sys.timestep_size(reg, u0, controller), "timestep");
+    }
+
+    // the controller is not advanced, so every step starts from the same time
+    void step() { integrate(sys, reg, u0, u1, rk, srhs, controller, dt); }
+};
+
+void set_counters(benchmark::State& state, int N, int scalars)
+{
+    state.counters["points"] = static_cast<double>(N) * N * N;
+    state.counters["scalar_steps/s"] = benchmark::Counter(
+        static_cast<double>(scalars), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// range(0) = N, range(1) = scalars
+void BM_batched_step(benchmark::State& state)
+{
+    const int N = static_cast<int>(state.range(0));
+    const int M = static_cast<int>(state.range(1));
+    heat_run run{config(
+        N, fmt::format("diffusivity = {{{}}}", fmt::join(diffusivities(M), ", ")))};
+
+    // Warm up.
+    run.step();
+
+    for (auto _ : state) run.step();
+    set_counters(state, N, M);
+}
+
+void BM_serial_step(benchmark::State& state)
+{
+    const int N = static_cast<int>(state.range(0));
+    const int M = static_cast<int>(state.range(1));
+
+    std::vector<std::unique_ptr<heat_run>> runs;
+    for (auto k : diffusivities(M))
+        runs.push_back(std::make_unique<heat_run>(
+            config(N, fmt::format("diffusivity = {}", k))));
+
+    // Warm up.
+    for (auto&& r : runs) r->step();
+
+    for (auto _ : state)
+        for (auto&& r : runs) r->step();
+    set_counters(state, N, M);
+}
+
+// N x scalars
+void scalar_args(benchmark::internal::Benchmark* b)
+{
+    for (int N : {32, 64})
+        for (int M : {1, 2, 4, 8})
+            b->Args({N, M});
+}
+
+BENCHMARK(BM_batched_step)
+    ->Apply(scalar_args)
+    ->ArgNames({"N", "M"})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_serial_step)
+    ->Apply(scalar_args)
+    ->ArgNames({"N", "M"})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+// Custom main: Kokkos must be initialized before any Kokkos calls.
+int main(int argc, char** argv)
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
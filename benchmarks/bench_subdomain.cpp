@@ -0,0 +1,154 @@
+// Benchmark: slab-decomposed derivative (strong scaling)
+//
+// Compares the undecomposed derivative::operator() with slab_derivative, which
+// splits the mesh into x-slabs and runs each slab on its own partition of the
+// host execution space.  The x sweep of a slab reads its neighbours' halo planes
+// in place.  The slab benchmark first touches u and du slab by slab on those
+// partitions; the global one lets the parallel zero fill of Kokkos::View place
+// them over the whole host.
+//
+// Parameterized by mesh size (N³), direction and slab count.  A slab count of
+// one per NUMA domain is the intended configuration.  The thread count is fixed
+// per process; scripts/strong_scaling.sh reruns this benchmark from 1 thread to
+// all cores and tabulates the speedup.
+//
+// Stencil: E4 second derivative, Floating BCs on all faces, no objects.
+
+#include <benchmark/benchmark.h>
+
+#include <Kokkos_Core.hpp>
+
+#include "mesh/mesh.hpp"
+#include "operators/derivative.hpp"
+#include "operators/slab_derivative.hpp"
+#include "stencils/stencil.hpp"
+#include "types.hpp"
+
+#include <cmath>
+#include <span>
+
+using namespace ccs;
+
+namespace
+{
+
+mesh cube(int N)
+{
+    return mesh{index_extents{int3{N, N, N}},
+                domain_extents{.min = {0.0, 0.0, 0.0}, .max = {1.0, 1.0, 1.0}}};
+}
+
+// u and du, already first touched, with u set to a smooth profile
+struct fields {
+    Kokkos::View<real*> u;
+    Kokkos::View<real*> du;
+
+    fields(Kokkos::View<real*> u_, Kokkos::View<real*> du_) : u{u_}, du{du_}
+    {
+        auto v = u;
+        const auto total = static_cast<real>(v.extent(0));
+        Kokkos::parallel_for(
+            "smooth_field",
+            Kokkos::RangePolicy<execution_space>(0, v.extent(0)),
+            KOKKOS_LAMBDA(integer i) {
+                v(i) = std::sin(2.0 * M_PI * static_cast<real>(i) / total);
+            });
+        Kokkos::fence();
+    }
+
+    std::span<const real> cu() const { return {u.data(), u.extent(0)}; }
+    std::span<real> sdu() const { return {du.data(), du.extent(0)}; }
+};
+
+// zero-filled by Kokkos over the whole host
+fields global_fields(integer total)
+{
+    return {Kokkos::View<real*>("u", total), Kokkos::View<real*>("du", total)};
+}
+
+// zero-filled slab by slab on the partitions of `part`
+fields slab_fields(const slab_partition& part, integer total)
+{
+    auto alloc = [&](const char* label) {
+        Kokkos::View<real*> v(Kokkos::view_alloc(label, Kokkos::WithoutInitializing),
+                              total);
+        part.fill({v.data(), v.extent(0)}, 0.0);
+        return v;
+    };
+    return {alloc("u"), alloc("du")};
+}
+
+void set_counters(benchmark::State& state, integer total)
+{
+    // read u, write du
+    const auto bytes_per_point = 2.0 * sizeof(real);
+    state.counters["BW(GB/s)"] = benchmark::Counter(
+        static_cast<double>(total) * bytes_per_point,
+        benchmark::Counter::kIsIterationInvariantRate,
+        benchmark::Counter::kIs1024);
+    state.counters["points"] = static_cast<double>(total);
+    state.counters["threads"] = execution_space().concurrency();
+}
+
+// Baseline: one operator over the whole mesh on the whole host.
+// range(0) = N, range(1) = direction
+void BM_derivative_global(benchmark::State& state)
+{
+    const auto N = static_cast<int>(state.range(0));
+    const auto dir = static_cast<int>(state.range(1));
+
+    auto m = cube(N);
+    auto d = derivative{dir, m, stencils::second::E4, bcs::Grid{bcs::ff, bcs::ff, bcs::ff},
+                        bcs::Object{}};
+
+    const auto f = global_fields(m.size());
+    const scalar_view u_sv{f.cu(), {}, {}, {}};
+    const scalar_span du_sp{f.sdu(), {}, {}, {}};
+
+    d(u_sv, du_sp);
+
+    for (auto _ : state) d(u_sv, du_sp);
+
+    set_counters(state, m.size());
+}
+
+// range(0) = N, range(1) = direction, range(2) = slabs
+void BM_derivative_slabs(benchmark::State& state)
+{
+    const auto N = static_cast<int>(state.range(0));
+    const auto dir = static_cast<int>(state.range(1));
+    const auto nslabs = static_cast<int>(state.range(2));
+
+    auto m = cube(N);
+    auto d = slab_derivative{
+        dir, m, stencils::second::E4, bcs::Grid{bcs::ff, bcs::ff, bcs::ff}, nslabs};
+
+    const auto f = slab_fields(d.partition(), m.size());
+
+    d(f.cu(), f.sdu());
+
+    for (auto _ : state) d(f.cu(), f.sdu());
+
+    set_counters(state, m.size());
+    state.counters["slabs"] = nslabs;
+}
+
+BENCHMARK(BM_derivative_global)
+    ->ArgsProduct({{64, 128}, {0, 1, 2}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_derivative_slabs)
+    ->ArgsProduct({{64, 128}, {0, 1, 2}, {1, 2, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+// Custom main: Kokkos must be initialized before any Kokkos calls.
+int main(int argc, char** argv)
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -11,6 +11,11 @@
 #
 # The script runs every bench_* executable in build/benchmarks/, merges the
 # results into a single JSON file, and compares against the baseline.
+#
+# bench_cutcell is rerun with --kokkos-num-threads for each count in
+# BENCH_THREADS (default "1 <nproc>") and its names get a /threads:T suffix,
+# so the thread count is part of the tracked matrix.  Extra benchmark flags
+# can be passed in BENCH_ARGS, e.g. BENCH_ARGS=--benchmark_filter=cutcell.
 
 set -euo pipefail
 
@@ -19,6 +24,7 @@ BUILD_DIR="${BUILD_DIR:-build}"
 BENCH_DIR="${BUILD_DIR}/benchmarks"
 BASELINE_DIR="${SCRIPT_DIR}/../benchmarks/baselines"
 THRESHOLD="${BENCH_THRESHOLD:-10}"
+read -r -a THREADS <<< "${BENCH_THREADS:-$(printf '%s\n' 1 "$(nproc)" | sort -nu | xargs)}"
 
 # --- Parse arguments ---
 SAVE_MODE=false
@@ -62,15 +68,26 @@ trap 'rm -rf "$RESULTS_DIR"' EXIT
 
 for exe in "${BENCHMARKS[@]}"; do
     name=$(basename "$exe")
+    if [[ "$name" == bench_cutcell ]]; then
+        for t in "${THREADS[@]}"; do
+            out="${RESULTS_DIR}/${name}.threads-${t}.json"
+            echo "Running ${name} with ${t} thread(s)..."
+            # shellcheck disable=SC2086
+            "$exe" --kokkos-num-threads="$t" ${BENCH_ARGS:-} \
+                --benchmark_out="$out" --benchmark_out_format=json 2>&1 | tail -1
+        done
+        continue
+    fi
     out="${RESULTS_DIR}/${name}.json"
     echo "Running ${name}..."
-    "$exe" --benchmark_out="$out" --benchmark_out_format=json 2>&1 | tail -1
+    # shellcheck disable=SC2086
+    "$exe" ${BENCH_ARGS:-} --benchmark_out="$out" --benchmark_out_format=json 2>&1 | tail -1
 done
 
 # --- Merge into a single JSON file ---
 MERGED="${RESULTS_DIR}/merged.json"
 python3 -c "
-import json, glob, sys
+import json, glob, re, sys
 
 merged = {'benchmarks': []}
 for path in sorted(glob.glob('${RESULTS_DIR}/bench_*.json')):
@@ -79,7 +96,14 @@ for path in sorted(glob.glob('${RESULTS_DIR}/bench_*.json')):
     # Keep context from the first file
     if 'context' not in merged:
         merged['context'] = data.get('context', {})
-    merged['benchmarks'].extend(data.get('benchmarks', []))
+    benchmarks = data.get('benchmarks', [])
+    # per thread count reruns: make the names unique across the runs
+    m = re.search(r'\.threads-(\d+)\.json$', path)
+    if m:
+        for b in benchmarks:
+            b['name'] += '/threads:' + m.group(1)
+            b['run_name'] += '/threads:' + m.group(1)
+    merged['benchmarks'].extend(benchmarks)
 
 with open('${MERGED}', 'w') as f:
     json.dump(merged, f, indent=2)
@@ -12,6 +12,10 @@
 # Prerequisites:
 #   kokkos-tools must be installed (listed in .devcontainer/spack.yaml).
 #
+# Without kokkos-tools, add `profiling = { cadence = N }` to the simulation
+# table instead; region and kernel times are then written per interval to
+# <logging_dir>/profile.csv by the built-in profiler.
+#
 # To use a different tool (e.g. space-time stack):
 #   KOKKOS_TOOLS_LIBS=$(spack location -i kokkos-tools)/lib/libkp_space_time_stack.so \
 #       ./build/src/app/shoccs config.lua
@@ -1,15 +1,19 @@
 """Python → C++ bridge for the Brady-Livescu 2D stability validator.
 
-Builds Lua configs from a template and drives the compiled shoccs binary so
+Builds Lua configs from a template and drives the compiled shoccs solver so
 plan 41's analytical stability stack can validate survivors end-to-end in the
-real solver.
+real solver. When the pyshoccs extension module is built (BUILD_PYTHON=ON) the
+solver runs in-process with the mesh cached per grid size; otherwise each
+evaluation launches the shoccs binary.
 """
 
 from __future__ import annotations
 
 import csv
+import importlib
 import math
 import subprocess
+import sys
 import tempfile
 import time
 from dataclasses import dataclass, field
@@ -23,6 +27,8 @@ REPO_ROOT: Path = Path(__file__).resolve().parents[3]
 LUA_TEMPLATE_DIR: Path = REPO_ROOT / "lua-configs"
 BRADY_LIVESCU_TEMPLATE: Path = LUA_TEMPLATE_DIR / "brady_livescu_4_3.lua"
 SHOCCS_BINARY: Path = REPO_ROOT / "build" / "src" / "app" / "shoccs"
+EIGENVALUES_CONFIG: Path = REPO_ROOT / "eigenvalues.lua"
+EXTENSION_DIR: Path = REPO_ROOT / "build" / "src" / "python"
 
 
 @dataclass
@@ -36,6 +42,17 @@ class BridgeResult:
     stderr: str = ""
 
 
+@dataclass
+class SweepResult:
+    """Batched eigenvalue sweep output, indexed [psi_case, candidate]."""
+
+    max_eigen: np.ndarray = field(default_factory=lambda: np.empty((0, 0)))
+    radius: np.ndarray = field(default_factory=lambda: np.empty((0, 0)))
+    wall_time_s: float = 0.0
+    exit_code: int = 0
+    stderr: str = ""
+
+
 def _format_lua_number(x: float) -> str:
     """Format a Python float as a Lua-parseable numeric literal.
 
@@ -108,6 +125,83 @@ def _parse_system_csv(path: Path) -> tuple[np.ndarray, np.ndarray]:
     return np.asarray(times), np.asarray(linfs)
 
 
+def _is_stable(final_linf: float) -> bool:
+    return math.isfinite(final_linf) and final_linf < 10.0
+
+
+def load_extension() -> Any | None:
+    """Import the pyshoccs extension module, falling back to the build tree.
+
+    Returns None when the module was not built.
+    """
+    try:
+        return importlib.import_module("pyshoccs")
+    except ImportError:
+        pass
+    if EXTENSION_DIR.is_dir() and str(EXTENSION_DIR) not in sys.path:
+        sys.path.append(str(EXTENSION_DIR))
+        try:
+            return importlib.import_module("pyshoccs")
+        except ImportError:
+            pass
+    return None
+
+
+# pyshoccs.Session per (template, N): the mesh and geometry are built once
+_SESSIONS: dict[tuple[Path, int], Any] = {}
+
+
+def run_inprocess_brady2d(
+    scheme_type: str,
+    params: dict[str, Any],
+    *,
+    N: int = 31,
+    t_final: float = 10.0,
+    template: Path = BRADY_LIVESCU_TEMPLATE,
+    extension: Any | None = None,
+) -> BridgeResult:
+    """Run the Brady-Livescu 2D test through the pyshoccs extension module.
+
+    The first call for a (template, N) pair renders the template and builds a
+    Session, which keeps the mesh for later calls; every call then only builds
+    the operators for its scheme. Nothing touches the filesystem. Array
+    parameters (`alpha`) are passed as arrays and the traces come back as
+    NumPy arrays. A rejected config or scheme returns `final_linf=nan` with
+    `exit_code=1` and the error in `stderr`.
+    """
+    ext = extension if extension is not None else load_extension()
+    if ext is None:
+        return BridgeResult(exit_code=-1, stderr="pyshoccs extension module not built")
+
+    scheme = {"order": 1, "type": scheme_type, **params}
+    start = time.perf_counter()
+    try:
+        key = (template, int(N))
+        if key not in _SESSIONS:
+            _SESSIONS[key] = ext.Session(
+                make_brady2d_lua(
+                    scheme_type, params, N=N, t_final=t_final, template=template
+                )
+            )
+        trace = _SESSIONS[key].run(scheme, t_final=float(t_final))
+    except (ValueError, RuntimeError) as e:
+        return BridgeResult(
+            wall_time_s=time.perf_counter() - start, exit_code=1, stderr=str(e)
+        )
+    wall = time.perf_counter() - start
+
+    t_trace = np.asarray(trace["time"])
+    linf_trace = np.asarray(trace["linf"])
+    final_linf = float(linf_trace[-1]) if linf_trace.size else float("nan")
+    return BridgeResult(
+        final_linf=final_linf,
+        linf_trace=linf_trace,
+        t_trace=t_trace,
+        stable=_is_stable(final_linf),
+        wall_time_s=wall,
+    )
+
+
 def run_cpp_brady2d(
     scheme_type: str,
     params: dict[str, Any],
@@ -117,19 +211,30 @@ def run_cpp_brady2d(
     timeout: float = 300.0,
     template: Path = BRADY_LIVESCU_TEMPLATE,
     binary: Path = SHOCCS_BINARY,
+    in_process: bool | None = None,
 ) -> BridgeResult:
     """Run the shoccs Brady-Livescu 2D test and return the parsed result.
 
-    Renders the Lua template with `make_brady2d_lua`, writes it to a
-    NamedTemporaryFile, and invokes `binary` with cwd set to a per-call
-    tempdir. The shoccs binary writes `logs/system.csv` under its cwd, so
-    using a private tempdir isolates concurrent invocations — callers can
-    run this in parallel without racing on the same CSV.
+    With `in_process` unset, runs through `run_inprocess_brady2d` when the
+    pyshoccs module is importable and `binary` is the default; `timeout` does
+    not apply there. Otherwise renders the Lua template with
+    `make_brady2d_lua`, writes it to a NamedTemporaryFile, and invokes
+    `binary` with cwd set to a per-call tempdir. The shoccs binary writes
+    `logs/system.csv` under its cwd, so using a private tempdir isolates
+    concurrent invocations — callers can run this in parallel without racing
+    on the same CSV.
 
     On nonzero exit, timeout, or parse failure, returns a BridgeResult with
     `final_linf=nan`, `stable=False`, and the diagnostic captured in
     `exit_code`/`stderr`.
     """
+    if in_process is None:
+        in_process = binary == SHOCCS_BINARY and load_extension() is not None
+    if in_process:
+        return run_inprocess_brady2d(
+            scheme_type, params, N=N, t_final=t_final, template=template
+        )
+
     lua_source = make_brady2d_lua(
         scheme_type, params, N=N, t_final=t_final, template=template
     )
@@ -191,14 +296,114 @@ def run_cpp_brady2d(
             )
 
         final_linf = float(linf_trace[-1])
-        stable = (
-            math.isfinite(final_linf) and not math.isnan(final_linf) and final_linf < 10.0
-        )
         return BridgeResult(
             final_linf=final_linf,
             linf_trace=linf_trace,
             t_trace=t_trace,
-            stable=stable,
+            stable=_is_stable(final_linf),
+            wall_time_s=wall,
+            exit_code=completed.returncode,
+            stderr=completed.stderr,
+        )
+
+
+def _format_lua_value(v: Any) -> str:
+    if isinstance(v, (list, tuple, np.ndarray)):
+        return _format_lua_array(list(v))
+    return _format_lua_number(v)
+
+
+def make_sweep_script(
+    candidates: list[dict[str, Any]], psi: list[list[float]]
+) -> str:
+    """Render the `simulation.sweep` assignment passed to shoccs via --script.
+
+    Each candidate dict is merged into `simulation.scheme` by the C++ side, so
+    its keys are scheme keys (`alpha`, `floating_alpha`, `sigma`, ...). Each
+    psi row assigns psi to the config's shapes in order.
+    """
+    cands = ", ".join(
+        "{ " + ", ".join(f"{k} = {_format_lua_value(v)}" for k, v in c.items()) + " }"
+        for c in candidates
+    )
+    rows = ", ".join(_format_lua_array(list(p)) for p in psi)
+    return f"simulation.sweep = {{ psi = {{ {rows} }}, candidates = {{ {cands} }} }}"
+
+
+def _parse_sweep_csv(
+    path: Path, n_psi: int, n_candidates: int
+) -> tuple[np.ndarray, np.ndarray]:
+    """Parse `logs/sweep.csv`: Case,Candidate,Psi1..PsiK,MaxEigen,Radius."""
+    max_eigen = np.full((n_psi, n_candidates), np.nan)
+    radius = np.full((n_psi, n_candidates), np.nan)
+    with path.open() as f:
+        for row in csv.reader(f):
+            if not row or not row[0].isdigit():
+                continue
+            try:
+                c, k = int(row[0]), int(row[1])
+                max_eigen[c, k] = float(row[-2])
+                radius[c, k] = float(row[-1])
+            except (IndexError, ValueError):
+                continue
+    return max_eigen, radius
+
+
+def run_cpp_eigen_sweep(
+    candidates: list[dict[str, Any]],
+    psi: list[list[float]],
+    *,
+    timeout: float = 3600.0,
+    config: Path = EIGENVALUES_CONFIG,
+    binary: Path = SHOCCS_BINARY,
+) -> SweepResult:
+    """Screen many stencil candidates over many psi configurations in one run.
+
+    Replaces one shoccs launch per (candidate, psi) pair: the C++ side builds
+    each geometry once and analyzes the candidates concurrently, writing
+    `logs/sweep.csv` under a private tempdir. Missing rows come back as nan.
+    """
+    script = make_sweep_script(candidates, psi)
+    shape = (len(psi), len(candidates))
+
+    with tempfile.TemporaryDirectory(prefix="shoccs-sweep-") as tmpdir:
+        tmp = Path(tmpdir)
+        (tmp / "logs").mkdir(exist_ok=True)
+
+        start = time.perf_counter()
+        try:
+            completed = subprocess.run(
+                [str(binary), str(config), "--script", script],
+                cwd=tmp,
+                capture_output=True,
+                text=True,
+                timeout=timeout,
+                check=False,
+            )
+        except subprocess.TimeoutExpired as e:
+            return SweepResult(
+                max_eigen=np.full(shape, np.nan),
+                radius=np.full(shape, np.nan),
+                wall_time_s=time.perf_counter() - start,
+                exit_code=-1,
+                stderr=f"timeout after {timeout}s: {e}",
+            )
+        wall = time.perf_counter() - start
+
+        csv_path = tmp / "logs" / "sweep.csv"
+        if completed.returncode != 0 or not csv_path.exists():
+            return SweepResult(
+                max_eigen=np.full(shape, np.nan),
+                radius=np.full(shape, np.nan),
+                wall_time_s=wall,
+                exit_code=completed.returncode,
+                stderr=completed.stderr or f"logs/sweep.csv not found under {tmp}",
+            )
+
+        max_eigen, radius = _parse_sweep_csv(csv_path, *shape)
+        return SweepResult(
+            max_eigen=max_eigen,
+            radius=radius,
             wall_time_s=wall,
             exit_code=completed.returncode,
             stderr=completed.stderr,
@@ -2,13 +2,15 @@
 
 Plan 42.2a scope: make_brady2d_lua marker substitution and scheme-table
 emission. Plan 42.2b scope: run_cpp_brady2d subprocess driver, verified with
-a fake shoccs binary so the tests stay fast and hermetic.
+a fake shoccs binary so the tests stay fast and hermetic. The in-process
+path is driven through a fake pyshoccs module for the same reason.
 """
 
 from __future__ import annotations
 
 import re
 import stat
+import types
 from pathlib import Path
 
 import numpy as np
@@ -21,7 +23,11 @@ from stencil_gen.cpp_bridge import (
     SHOCCS_BINARY,
     BridgeResult,
     make_brady2d_lua,
+    load_extension,
+    make_sweep_script,
     run_cpp_brady2d,
+    run_cpp_eigen_sweep,
+    run_inprocess_brady2d,
 )
 
 
@@ -326,6 +332,137 @@ class TestRunCppBrady2D:
         assert before == after, "run_cpp_brady2d must not touch REPO_ROOT/logs/"
 
 
+class _FakeSession:
+    """Mimics pyshoccs.Session: records its config and every run."""
+
+    built: list[str] = []
+
+    def __init__(self, config: str):
+        if "--{{" in config:
+            raise ValueError("unrendered template")
+        _FakeSession.built.append(config)
+        self.runs: list[tuple[dict, float | None]] = []
+
+    def run(self, scheme, *, t_final=None):
+        if scheme["type"] == "bad":
+            raise ValueError("invalid scheme")
+        self.runs.append((scheme, t_final))
+        n = 4
+        linf = np.array([0.0, 0.001, 0.002, 0.0123])
+        return {
+            "time": np.linspace(0.0, t_final, n),
+            "step": np.arange(n, dtype=np.int32),
+            "linf": linf,
+            "stats": np.column_stack([linf, -np.ones(n), np.ones(n)]),
+            "wall_time_s": np.full(n, 1e-4),
+        }
+
+
+@pytest.fixture
+def fake_extension(monkeypatch):
+    import stencil_gen.cpp_bridge as bridge
+
+    _FakeSession.built = []
+    monkeypatch.setattr(bridge, "_SESSIONS", {})
+    return types.SimpleNamespace(Session=_FakeSession)
+
+
+class TestRunInprocessBrady2D:
+    def test_returns_traces(self, fake_extension):
+        result = run_inprocess_brady2d(
+            "E4u",
+            {"alpha": np.array([-0.77, 0.16])},
+            N=21,
+            t_final=1.0,
+            extension=fake_extension,
+        )
+        assert result.exit_code == 0
+        assert result.stable is True
+        assert result.final_linf == pytest.approx(0.0123)
+        assert result.linf_trace.shape == (4,)
+        assert result.t_trace[-1] == pytest.approx(1.0)
+
+    def test_session_cached_per_grid(self, fake_extension):
+        import stencil_gen.cpp_bridge as bridge
+
+        for alpha in ([-0.77, 0.16], [-0.70, 0.15]):
+            run_inprocess_brady2d(
+                "E4u", {"alpha": alpha}, N=21, t_final=1.0, extension=fake_extension
+            )
+        run_inprocess_brady2d(
+            "E4u", {"alpha": [-0.77, 0.16]}, N=31, t_final=2.0, extension=fake_extension
+        )
+        assert len(_FakeSession.built) == 2
+        session = bridge._SESSIONS[(BRADY_LIVESCU_TEMPLATE, 21)]
+        schemes = [scheme for scheme, _ in session.runs]
+        assert schemes[1] == {"order": 1, "type": "E4u", "alpha": [-0.70, 0.15]}
+
+    def test_rejected_scheme(self, fake_extension):
+        result = run_inprocess_brady2d(
+            "bad", {"sigma": 0.5}, N=21, t_final=1.0, extension=fake_extension
+        )
+        assert result.stable is False
+        assert np.isnan(result.final_linf)
+        assert result.exit_code == 1
+        assert "invalid scheme" in result.stderr
+
+    def test_fake_binary_stays_out_of_process(self, tmp_path: Path, monkeypatch):
+        import stencil_gen.cpp_bridge as bridge
+
+        monkeypatch.setattr(bridge, "load_extension", lambda: pytest.fail("imported"))
+        fake = _make_fake_shoccs(tmp_path, csv_body=_good_csv(0.5))
+        result = run_cpp_brady2d(
+            "E4u", {"alpha": [-0.77, 0.16]}, N=21, t_final=1.0, binary=fake
+        )
+        assert result.final_linf == pytest.approx(0.5)
+
+
+class TestRunCppEigenSweep:
+    CANDIDATES = [
+        {"floating_alpha": [0.13, 0.14, 0.15, 0.16, 0.17, 0.18], "dirichlet_alpha": [0.12, 0.13, 0.14]},
+        {"sigma": 0.5},
+    ]
+    PSI = [[0.001, 0.9], [0.5, 0.5]]
+
+    def test_script_lists_candidates_and_psi(self):
+        script = make_sweep_script(self.CANDIDATES, self.PSI)
+        assert script.startswith("simulation.sweep = {")
+        assert "psi = { {0.001, 0.9}, {0.5, 0.5} }" in script
+        assert "floating_alpha = {0.13, 0.14" in script
+        assert "sigma = 0.5" in script
+        assert script.count("{") == script.count("}")
+
+    def test_parses_sweep_csv(self, tmp_path: Path):
+        body = "\n".join(
+            [
+                "Case,Candidate,Psi1,Psi2,MaxEigen,Radius",
+                "0,0,0.001,0.9,-1e-3,1.5",
+                "0,1,0.001,0.9,0.25,1.6",
+                "1,0,0.5,0.5,-2e-3,1.4",
+            ]
+        )
+        csv_src = tmp_path / "sweep.csv"
+        csv_src.write_text(body)
+        script = tmp_path / "fake_sweep.sh"
+        script.write_text(f"#!/bin/sh\nmkdir -p logs\ncp {csv_src} logs/sweep.csv\nexit 0\n")
+        script.chmod(script.stat().st_mode | stat.S_IXUSR | stat.S_IXGRP)
+
+        result = run_cpp_eigen_sweep(self.CANDIDATES, self.PSI, binary=script)
+        assert result.exit_code == 0
+        assert result.max_eigen.shape == (2, 2)
+        assert result.max_eigen[0, 1] == pytest.approx(0.25)
+        assert result.radius[1, 0] == pytest.approx(1.4)
+        assert np.isnan(result.max_eigen[1, 1])
+
+    def test_missing_csv_returns_nan(self, tmp_path: Path):
+        script = tmp_path / "silent_sweep.sh"
+        script.write_text("#!/bin/sh\nexit 0\n")
+        script.chmod(script.stat().st_mode | stat.S_IXUSR | stat.S_IXGRP)
+        result = run_cpp_eigen_sweep(self.CANDIDATES, self.PSI, binary=script)
+        assert np.all(np.isnan(result.max_eigen))
+        assert "sweep.csv" in result.stderr
+
+
 class TestCppBridgeSmoke:
     """End-to-end smoke test against the real shoccs binary.
 
@@ -351,6 +488,22 @@ class TestCppBridgeSmoke:
         assert result.linf_trace.size > 0
         assert result.t_trace.size == result.linf_trace.size
 
+    @pytest.mark.slow
+    def test_inprocess_matches_binary(self):
+        if not SHOCCS_BINARY.exists() or load_extension() is None:
+            pytest.skip("shoccs binary or pyshoccs module not built")
+        kwargs = dict(
+            scheme_type="E4u",
+            params={"alpha": [-0.7733323791884821, 0.1623961700641681]},
+            N=21,
+            t_final=1.0,
+        )
+        inproc = run_cpp_brady2d(**kwargs, in_process=True)
+        binary = run_cpp_brady2d(**kwargs, in_process=False)
+        assert inproc.exit_code == 0, inproc.stderr
+        assert inproc.final_linf == pytest.approx(binary.final_linf, rel=1e-12)
+        assert inproc.linf_trace.size == binary.linf_trace.size
+
 
 class TestBridgeResultDefaults:
     def test_default_construction(self):
@@ -0,0 +1,71 @@
+#!/bin/bash
+# Strong scaling of the slab-decomposed derivative from 1 thread to all cores.
+#
+# Usage:
+#   ./scripts/strong_scaling.sh                     # 1, 2, 4, ... up to nproc threads
+#   ./scripts/strong_scaling.sh 1 16 32 64 128      # explicit thread counts
+#
+# Prerequisites:
+#   Build with -DBUILD_BENCHMARKS=ON
+#
+# Each thread count reruns bench_subdomain with --kokkos-num-threads and the
+# threads spread over the cores (OMP_PROC_BIND=spread, OMP_PLACES=cores), so a
+# partition per slab maps onto one socket.  The table reports each benchmark's
+# speedup over its single thread time.  Extra benchmark flags can be passed in
+# BENCH_ARGS, e.g. BENCH_ARGS=--benchmark_filter=slabs/128.
+
+set -euo pipefail
+
+BUILD_DIR="${BUILD_DIR:-build}"
+BENCH="${BUILD_DIR}/benchmarks/bench_subdomain"
+
+if [[ ! -x "$BENCH" ]]; then
+    echo "Error: $BENCH not found." >&2
+    echo "Build with: cmake -DBUILD_BENCHMARKS=ON .. && cmake --build ." >&2
+    exit 1
+fi
+
+if [[ $# -gt 0 ]]; then
+    THREADS=("$@")
+else
+    NPROC=$(nproc)
+    THREADS=()
+    for ((t = 1; t < NPROC; t *= 2)); do THREADS+=("$t"); done
+    THREADS+=("$NPROC")
+fi
+
+RESULTS_DIR=$(mktemp -d)
+trap 'rm -rf "$RESULTS_DIR"' EXIT
+
+export OMP_PROC_BIND="${OMP_PROC_BIND:-spread}"
+export OMP_PLACES="${OMP_PLACES:-cores}"
+
+for t in "${THREADS[@]}"; do
+    echo "Running bench_subdomain with ${t} thread(s)..."
+    # shellcheck disable=SC2086
+    "$BENCH" --kokkos-num-threads="$t" ${BENCH_ARGS:-} \
+        --benchmark_out="${RESULTS_DIR}/threads-${t}.json" \
+        --benchmark_out_format=json >/dev/null
+done
+
+python3 - "$RESULTS_DIR" "${THREADS[@]}" <<'EOF'
+import json, sys
+
+results_dir, threads = sys.argv[1], [int(t) for t in sys.argv[2:]]
+
+times = {}
+for t in threads:
+    with open(f"{results_dir}/threads-{t}.json") as f:
+        for b in json.load(f)["benchmarks"]:
+            times.setdefault(b["name"], {})[t] = b["real_time"]
+
+width = max(len(n) for n in times)
+print()
+print(f"{'benchmark':<{width}}  " + "  ".join(f"{t:>8}" for t in threads))
+for name, by_t in times.items():
+    base = by_t.get(threads[0])
+    row = "  ".join(f"{base / by_t[t]:8.2f}" if t in by_t and base else f"{'-':>8}"
+                    for t in threads)
+    print(f"{name:<{width}}  {row}")
+print(f"\nspeedup relative to {threads[0]} thread(s)")
+EOF
@@ -41,6 +41,12 @@ class Shoccs(CMakePackage):
         default=False,
         description="Build the Google Benchmark microbenchmark suite",
     )
+    variant(
+        "python",
+        default=False,
+        description="Build the pyshoccs extension module for in-process runs "
+        "from the stencil optimizer",
+    )
     # Off by default so the standard build stays fully pinned/offline-capable
     # (kokkos-tools has only an unpinned `develop` branch — see below). The
     # devcontainer turns this on explicitly.
@@ -108,8 +114,16 @@ class Shoccs(CMakePackage):
     depends_on("catch2@3:", when="+tests")
     depends_on("benchmark", when="+benchmarks")
 
+    # ------------------------------------------------------------------ #
+    # Python extension module                                            #
+    # ------------------------------------------------------------------ #
+    extends("python", when="+python")
+    depends_on("py-pybind11", type="build", when="+python")
+    depends_on("py-numpy", type="run", when="+python")
+
     def cmake_args(self):
         return [
             self.define_from_variant("BUILD_TESTING", "tests"),
             self.define_from_variant("BUILD_BENCHMARKS", "benchmarks"),
+            self.define_from_variant("BUILD_PYTHON", "python"),
         ]
@@ -5,12 +5,15 @@
 #include <string>
 
 #include "lib/shoccs.hpp"
+#include "parallel/communicator.hpp"
 
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
 int main(int argc, char* argv[])
 {
+    // a no-op without MPI; system.distributed splits the mesh over its ranks
+    ccs::mpi_scope mpi(argc, argv);
     Kokkos::ScopeGuard kokkos(argc, argv);
 
     cxxopts::Options options(
@@ -23,6 +26,8 @@ int main(int argc, char* argv[])
              cxxopts::value<std::string>())
         ("check", "Check input file for errors and return",
             cxxopts::value<bool>()->default_value("false"))
+        ("dry-run-memory", "Estimate the peak memory of the run and return",
+            cxxopts::value<bool>()->default_value("false"))
         ("help", "Print usage");
     // clang-format on
     options.parse_positional("input-file");
@@ -48,9 +53,21 @@ int main(int argc, char* argv[])
     // We alway check the input but exit early if --check has been specified
 
     if (result.count("check")) { return 0; }
+
+    // sizes the run from the mesh alone, the fields and operators are not built
+    if (result.count("dry-run-memory"))
+        return ccs::memory_estimate_run(lua["simulation"]) ? 0 : 1;
+
     // do some registry and activate loggers for now
     spdlog::info("Starting shoccs");
     // auto console = spdlog::stdout_color_st("system");
 
-    ccs::simulation_run(lua["simulation"]);
+    // a sweep table replaces the time-stepping run with a batched stability sweep,
+    // a runs table with concurrent runs of its variants
+    if (lua["simulation"]["sweep"].valid())
+        ccs::eigenvalue_sweep_run(lua["simulation"]);
+    else if (lua["simulation"]["runs"].valid())
+        ccs::simulation_multi_run(lua["simulation"]);
+    else
+        ccs::simulation_run(lua["simulation"]);
 }
@@ -13,18 +13,18 @@ namespace ccs
 // Expression node types for expression templates.
 //
 // Each node type carries pre-extracted data (pointers or values) and provides
-// operator()(int i) to evaluate at index i. All types are trivially copyable
+// operator()(integer i) to evaluate at index i. All types are trivially copyable
 // to ensure safe capture in Kokkos lambdas (D-ET2).
 // ---------------------------------------------------------------------------
 
 struct handle_expr {
     real* ptr;
-    constexpr real operator()(int i) const { return ptr[i]; }
+    constexpr real operator()(integer i) const { return ptr[i]; }
 };
 
 struct scalar_literal_expr {
     real value;
-    constexpr real operator()(int i) const { (void)i; return value; }
+    constexpr real operator()(integer i) const { (void)i; return value; }
 };
 
 template <typename Op, typename Lhs, typename Rhs>
@@ -35,7 +35,7 @@ struct binary_expr {
     Op op;
     Lhs lhs;
     Rhs rhs;
-    constexpr real operator()(int i) const { return op(lhs(i), rhs(i)); }
+    constexpr real operator()(integer i) const { return op(lhs(i), rhs(i)); }
 };
 
 template <typename Op, typename Arg>
@@ -44,7 +44,7 @@ struct unary_expr {
     static_assert(std::is_trivially_copyable_v<Arg>);
     Op op;
     Arg arg;
-    constexpr real operator()(int i) const { return op(arg(i)); }
+    constexpr real operator()(integer i) const { return op(arg(i)); }
 };
 
 // Trivially-copyable assertions at namespace scope.
@@ -90,21 +90,18 @@ inline bool contains_ptr(const unary_expr<Op, Arg>& e, const real* target)
 // ---------------------------------------------------------------------------
 
 template <typename Expr>
-void assign(real* dst, int n, Expr expr)
+void assign(real* dst, integer n, Expr expr)
 {
     if (contains_ptr(expr, dst)) {
         // Alias detected: evaluate into temporary, then copy back.
         Kokkos::View<real*, memory_space> tmp("expr_tmp", n);
         real* tmp_ptr = tmp.data();
-        Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, n),
-            KOKKOS_LAMBDA(int i) { tmp_ptr[i] = expr(i); });
+        index_for("assign", n, KOKKOS_LAMBDA(auto i) { tmp_ptr[i] = expr(i); });
         Kokkos::View<real*, memory_space, Kokkos::MemoryUnmanaged> dst_um(dst, n);
-        Kokkos::deep_copy(dst_um, tmp);
+        Kokkos::deep_copy(exec_space(), dst_um, tmp);
+        exec_space().fence("assign alias copy complete");
     } else {
-        Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, n),
-            KOKKOS_LAMBDA(int i) { dst[i] = expr(i); });
+        index_for("assign", n, KOKKOS_LAMBDA(auto i) { dst[i] = expr(i); });
     }
 }
 
@@ -118,35 +115,27 @@ void assign(real* dst, int n, Expr expr)
 // ---------------------------------------------------------------------------
 
 template <typename Expr>
-void plus_assign(real* dst, int n, Expr expr)
+void plus_assign(real* dst, integer n, Expr expr)
 {
-    Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, n),
-        KOKKOS_LAMBDA(int i) { dst[i] += expr(i); });
+    index_for("plus_assign", n, KOKKOS_LAMBDA(auto i) { dst[i] += expr(i); });
 }
 
 template <typename Expr>
-void minus_assign(real* dst, int n, Expr expr)
+void minus_assign(real* dst, integer n, Expr expr)
 {
-    Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, n),
-        KOKKOS_LAMBDA(int i) { dst[i] -= expr(i); });
+    index_for("minus_assign", n, KOKKOS_LAMBDA(auto i) { dst[i] -= expr(i); });
 }
 
 template <typename Expr>
-void times_assign(real* dst, int n, Expr expr)
+void times_assign(real* dst, integer n, Expr expr)
 {
-    Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, n),
-        KOKKOS_LAMBDA(int i) { dst[i] *= expr(i); });
+    index_for("times_assign", n, KOKKOS_LAMBDA(auto i) { dst[i] *= expr(i); });
 }
 
 template <typename Expr>
-void divide_assign(real* dst, int n, Expr expr)
+void divide_assign(real* dst, integer n, Expr expr)
 {
-    Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, n),
-        KOKKOS_LAMBDA(int i) { dst[i] /= expr(i); });
+    index_for("divide_assign", n, KOKKOS_LAMBDA(auto i) { dst[i] /= expr(i); });
 }
 
 // ---------------------------------------------------------------------------
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <functional>
 #include <span>
 #include <string>
 #include <utility>
@@ -65,12 +66,18 @@ public:
     using layout_type = field_layout<MaxS, MaxV>;
     static constexpr int buffers_per_slot = layout_type::total_buffers;
 
+    // Zeros a new D buffer in place of the fill of Kokkos::View, e.g. from the
+    // threads that will use each range of it so that its pages are first touched
+    // there (see slab_partition::fill)
+    using first_touch = std::function<void(std::span<real>)>;
+
     field_registry() = default;
 
     // -- Allocation ----------------------------------------------------------
 
     field_ref allocate_scalar(int slot, int scalar_index,
-                              int d_sz, int rx_sz, int ry_sz, int rz_sz)
+                              integer d_sz, integer rx_sz, integer ry_sz, integer rz_sz,
+                              const first_touch& touch = {})
     {
         assert(slot >= 0 && slot < MaxSlots);
         assert(scalar_index >= 0 && scalar_index < MaxS);
@@ -85,7 +92,7 @@ public:
             return "s" + std::to_string(scalar_index) + "_" + suffix;
         };
 
-        buffers_[base + sh.D().id]  = Kokkos::View<real*>(label("D"),  d_sz);
+        buffers_[base + sh.D().id]  = allocate_d(label("D"), d_sz, touch);
         buffers_[base + sh.Rx().id] = Kokkos::View<real*>(label("Rx"), rx_sz);
         buffers_[base + sh.Ry().id] = Kokkos::View<real*>(label("Ry"), ry_sz);
         buffers_[base + sh.Rz().id] = Kokkos::View<real*>(label("Rz"), rz_sz);
@@ -97,7 +104,8 @@ public:
     }
 
     field_ref allocate_vector(int slot, int vector_index,
-                              int d_sz, int rx_sz, int ry_sz, int rz_sz)
+                              integer d_sz, integer rx_sz, integer ry_sz, integer rz_sz,
+                              const first_touch& touch = {})
     {
         assert(slot >= 0 && slot < MaxSlots);
         assert(vector_index >= 0 && vector_index < MaxV);
@@ -111,7 +119,7 @@ public:
         // All 3 components share the same sizes.
         const char* comp_names[] = {"x", "y", "z"};
         const char* buf_names[]  = {"D", "Rx", "Ry", "Rz"};
-        int sizes[] = {d_sz, rx_sz, ry_sz, rz_sz};
+        integer sizes[] = {d_sz, rx_sz, ry_sz, rz_sz};
 
         auto comps = vh.components();
         for (int c = 0; c < 3; ++c) {
@@ -120,7 +128,8 @@ public:
                 std::string lbl = "v" + std::to_string(vector_index) +
                                   "_" + comp_names[c] + buf_names[b];
                 buffers_[base + bufs[b].id] =
-                    Kokkos::View<real*>(lbl, sizes[b]);
+                    b == 0 ? allocate_d(lbl, sizes[b], touch)
+                           : Kokkos::View<real*>(lbl, sizes[b]);
             }
         }
 
@@ -160,11 +169,11 @@ public:
         return view(ref, h).data();
     }
 
-    int size(field_ref ref, buf_handle h) const
+    integer size(field_ref ref, buf_handle h) const
     {
         assert(ref.slot >= 0 && ref.slot < MaxSlots);
         assert(h.id >= 0 && h.id < buffers_per_slot);
-        return static_cast<int>(view(ref, h).extent(0));
+        return static_cast<integer>(view(ref, h).extent(0));
     }
 
     // -- Bulk operations -----------------------------------------------------
@@ -180,10 +189,11 @@ public:
         for (int i = 0; i < buffers_per_slot; ++i) {
             if (buffers_[src_base + i].extent(0) > 0) {
                 assert(buffers_[dst_base + i].extent(0) == buffers_[src_base + i].extent(0));
-                Kokkos::deep_copy(buffers_[dst_base + i],
-                                  buffers_[src_base + i]);
+                Kokkos::deep_copy(
+                    exec_space(), buffers_[dst_base + i], buffers_[src_base + i]);
             }
         }
+        exec_space().fence("sim_registry::deep_copy_slot complete");
     }
 
     void swap_slots(int a, int b)
@@ -207,6 +217,16 @@ public:
     }
 
 private:
+    static Kokkos::View<real*>
+    allocate_d(const std::string& label, integer n, const first_touch& touch)
+    {
+        if (!touch) return Kokkos::View<real*>(label, n);
+
+        Kokkos::View<real*> v(Kokkos::view_alloc(label, Kokkos::WithoutInitializing), n);
+        touch(std::span<real>{v.data(), static_cast<std::size_t>(n)});
+        return v;
+    }
+
     static constexpr int total_views_ = MaxSlots * buffers_per_slot;
     std::array<Kokkos::View<real*>, total_views_> buffers_{};
     std::array<field_ref, MaxSlots> metadata_{};
@@ -3,6 +3,8 @@
 #include "scalar.hpp"
 
 #include <functional>
+#include <span>
+#include <vector>
 
 #include <Kokkos_Core.hpp>
 #include <catch2/catch_session.hpp>
@@ -71,6 +73,23 @@ TEST_CASE("allocate_scalar basic")
     }
 }
 
+TEST_CASE("allocate_scalar first touch")
+{
+    field_registry<4, 2, 1> reg;
+    auto sh = scalar_handle{0};
+
+    // the hook writes the D buffer alone; the R buffers keep the View zero fill
+    std::vector<std::size_t> touched;
+    auto ref = reg.allocate_scalar(0, 0, 100, 5, 3, 2, [&](std::span<real> d) {
+        touched.push_back(d.size());
+        for (auto& x : d) x = 0.0;
+    });
+
+    REQUIRE(touched == std::vector<std::size_t>{100});
+    REQUIRE(reg.data(ref, sh.D())[99] == 0.0);
+    REQUIRE(reg.data(ref, sh.Rx())[4] == 0.0);
+}
+
 // ---------------------------------------------------------------------------
 // allocate_vector
 // ---------------------------------------------------------------------------
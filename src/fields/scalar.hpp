@@ -28,19 +28,11 @@ struct scalar_span {
         real* rx_ptr = Rx.data();
         real* ry_ptr = Ry.data();
         real* rz_ptr = Rz.data();
-        Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, static_cast<int>(D.size())),
-            KOKKOS_LAMBDA(int i) { d_ptr[i] = v; });
-        Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, static_cast<int>(Rx.size())),
-            KOKKOS_LAMBDA(int i) { rx_ptr[i] = v; });
-        Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, static_cast<int>(Ry.size())),
-            KOKKOS_LAMBDA(int i) { ry_ptr[i] = v; });
-        Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, static_cast<int>(Rz.size())),
-            KOKKOS_LAMBDA(int i) { rz_ptr[i] = v; });
-        Kokkos::fence();
+        index_for("scalar_fill", D.size(), KOKKOS_LAMBDA(auto i) { d_ptr[i] = v; });
+        index_for("scalar_fill", Rx.size(), KOKKOS_LAMBDA(auto i) { rx_ptr[i] = v; });
+        index_for("scalar_fill", Ry.size(), KOKKOS_LAMBDA(auto i) { ry_ptr[i] = v; });
+        index_for("scalar_fill", Rz.size(), KOKKOS_LAMBDA(auto i) { rz_ptr[i] = v; });
+        exec_space().fence("scalar_fill complete");
         return *this;
     }
 
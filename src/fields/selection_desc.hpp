@@ -4,6 +4,7 @@
 #include "kokkos_types.hpp"
 #include "mesh/mesh_types.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 #include <span>
@@ -15,16 +16,22 @@ namespace ccs
 // Selection descriptors: lightweight structs describing which elements to
 // access in a flat buffer. Used by assign_selected / fill_selected /
 // plus_assign_selected to replace iterator-based selector views.
+//
+// Offsets and elements are integer so that a plane of a mesh beyond 2^31
+// points is addressable.  element() is templated on the position type: the
+// selected operations pass an int whenever count() fits, which keeps the
+// strided division in 32 bits.
 // ---------------------------------------------------------------------------
 
 // Contiguous range: elements [offset, offset + count).
 // Used for x-plane selections.
 struct contiguous_selection {
-    int offset_;
-    int count_;
+    integer offset_;
+    integer count_;
 
-    KOKKOS_INLINE_FUNCTION int element(int i) const { return offset_ + i; }
-    KOKKOS_INLINE_FUNCTION int count() const { return count_; }
+    template <typename I>
+    KOKKOS_INLINE_FUNCTION integer element(I i) const { return offset_ + i; }
+    KOKKOS_INLINE_FUNCTION integer count() const { return count_; }
 };
 
 // Strided pattern: outer_count blocks of inner_count contiguous elements,
@@ -32,30 +39,78 @@ struct contiguous_selection {
 // Used for y-plane (inner_count = nz) and z-plane (inner_count = 1).
 // Invariant: inner_count_ must be > 0 (used as divisor in element()).
 struct strided_selection {
-    int offset_;
+    integer offset_;
     int inner_count_;
     int outer_count_;
-    int outer_stride_;
+    integer outer_stride_;
 
-    KOKKOS_INLINE_FUNCTION int element(int i) const
+    template <typename I>
+    KOKKOS_INLINE_FUNCTION integer element(I i) const
     {
         return offset_ + (i / inner_count_) * outer_stride_ + (i % inner_count_);
     }
-    KOKKOS_INLINE_FUNCTION int count() const { return inner_count_ * outer_count_; }
+    KOKKOS_INLINE_FUNCTION integer count() const
+    {
+        return (integer)inner_count_ * outer_count_;
+    }
+};
+
+// An index list of one index type, Index = int or integer.
+template <typename Index>
+struct gather_indices {
+    Kokkos::View<const Index*, memory_space> indices_;
+
+    template <typename I>
+    KOKKOS_INLINE_FUNCTION integer element(I i) const { return indices_(i); }
+    KOKKOS_INLINE_FUNCTION integer count() const
+    {
+        return static_cast<integer>(indices_.extent(0));
+    }
 };
 
 // Gather pattern: arbitrary index list stored in a Kokkos::View.
-// Used for fluid (multi_slice) and predicate (object BC) selections.
+// Used for fluid (multi_slice) and predicate (object BC) selections.  Indices
+// are stored as int unless one of them does not fit, in which case the list
+// is held in wide_indices_ instead and indices_ is empty.
+//
+// Kernels go through visit(), which picks the list once per launch.  element()
+// checks which list is held on every call and is meant for host loops.
 struct gather_selection {
     Kokkos::View<const int*, memory_space> indices_;
+    Kokkos::View<const integer*, memory_space> wide_indices_{};
 
-    KOKKOS_INLINE_FUNCTION int element(int i) const { return indices_(i); }
-    KOKKOS_INLINE_FUNCTION int count() const
+    template <typename I>
+    KOKKOS_INLINE_FUNCTION integer element(I i) const
     {
-        return static_cast<int>(indices_.extent(0));
+        return wide_indices_.extent(0) ? wide_indices_(i) : indices_(i);
+    }
+    KOKKOS_INLINE_FUNCTION integer count() const
+    {
+        return static_cast<integer>(indices_.extent(0) + wide_indices_.extent(0));
+    }
+
+    // f(gather_indices<int>) or f(gather_indices<integer>), whichever list is held
+    template <typename F>
+    decltype(auto) visit(F&& f) const
+    {
+        if (wide_indices_.extent(0)) return f(gather_indices<integer>{wide_indices_});
+        return f(gather_indices<int>{indices_});
     }
 };
 
+// f(desc), with a gather_selection resolved to its index list first
+template <typename Desc, typename F>
+decltype(auto) visit_selection(const Desc& desc, F&& f)
+{
+    return f(desc);
+}
+
+template <typename F>
+decltype(auto) visit_selection(const gather_selection& desc, F&& f)
+{
+    return desc.visit(f);
+}
+
 // ---------------------------------------------------------------------------
 // Trivially-copyable assertions for contiguous and strided descriptors.
 // gather_selection holds a Kokkos::View which may not be trivially copyable,
@@ -76,30 +131,51 @@ static_assert(std::is_trivially_copyable_v<strided_selection>);
 
 inline contiguous_selection make_x_plane_desc(index_extents ext, int i)
 {
-    int ny = ext[1];
-    int nz = ext[2];
-    assert(static_cast<long>(ny) * nz <= std::numeric_limits<int>::max());
+    integer ny = ext[1];
+    integer nz = ext[2];
     return {i * ny * nz, ny * nz};
 }
 
 inline strided_selection make_y_plane_desc(index_extents ext, int j)
 {
     int nx = ext[0];
-    int ny = ext[1];
+    integer ny = ext[1];
     int nz = ext[2];
     assert(nz > 0);
-    assert(static_cast<long>(ny) * nz <= std::numeric_limits<int>::max());
-    return {j * nz, nz, nx, ny * nz};
+    return {(integer)j * nz, nz, nx, ny * nz};
 }
 
 inline strided_selection make_z_plane_desc(index_extents ext, int k)
 {
-    int nx = ext[0];
-    int ny = ext[1];
+    integer nx = ext[0];
+    integer ny = ext[1];
     int nz = ext[2];
-    assert(static_cast<long>(nx) * ny > 0);
-    assert(static_cast<long>(nx) * ny <= std::numeric_limits<int>::max());
-    return {k, 1, nx * ny, nz};
+    assert(nx * ny > 0);
+    assert(nx * ny <= std::numeric_limits<int>::max());
+    return {k, 1, static_cast<int>(nx * ny), nz};
+}
+
+// ---------------------------------------------------------------------------
+// Factory: build gather_selection from an index list.  The list is stored as
+// int when every index fits, so meshes below 2^31 points keep the narrow list.
+// ---------------------------------------------------------------------------
+
+inline gather_selection make_gather_from_indices(std::span<const integer> idx)
+{
+    auto copy = [&](auto& indices) {
+        auto h = Kokkos::create_mirror_view(indices);
+        for (std::size_t i = 0; i < idx.size(); ++i) h(i) = idx[i];
+        Kokkos::deep_copy(indices, h);
+    };
+
+    if (idx.empty() || fits_int(*std::ranges::max_element(idx))) {
+        Kokkos::View<int*, memory_space> indices("gather_indices", idx.size());
+        copy(indices);
+        return gather_selection{indices};
+    }
+    Kokkos::View<integer*, memory_space> indices("gather_indices", idx.size());
+    copy(indices);
+    return gather_selection{{}, indices};
 }
 
 // ---------------------------------------------------------------------------
@@ -110,22 +186,30 @@ inline strided_selection make_z_plane_desc(index_extents ext, int k)
 inline gather_selection make_gather_from_slices(std::span<const index_slice> slices)
 {
     // Count total elements across all slices.
-    int total = 0;
-    for (auto& s : slices)
-        total += static_cast<int>(s.last - s.first);
-
-    Kokkos::View<int*, memory_space> indices("gather_indices", total);
-    auto h = Kokkos::create_mirror_view(indices);
-
-    int pos = 0;
-    for (auto& s : slices)
-        for (integer idx = s.first; idx < s.last; ++idx) {
-            assert(idx <= std::numeric_limits<int>::max());
-            h(pos++) = static_cast<int>(idx);
-        }
+    integer total = 0;
+    integer last = 0;
+    for (auto& s : slices) {
+        if (s.last <= s.first) continue;
+        total += s.last - s.first;
+        last = std::max(last, s.last - 1);
+    }
 
-    Kokkos::deep_copy(indices, h);
-    return gather_selection{indices};
+    auto copy = [&](auto& indices) {
+        auto h = Kokkos::create_mirror_view(indices);
+        integer pos = 0;
+        for (auto& s : slices)
+            for (integer idx = s.first; idx < s.last; ++idx) h(pos++) = idx;
+        Kokkos::deep_copy(indices, h);
+    };
+
+    if (fits_int(last)) {
+        Kokkos::View<int*, memory_space> indices("gather_indices", total);
+        copy(indices);
+        return gather_selection{indices};
+    }
+    Kokkos::View<integer*, memory_space> indices("gather_indices", total);
+    copy(indices);
+    return gather_selection{{}, indices};
 }
 
 // ---------------------------------------------------------------------------
@@ -139,7 +223,9 @@ inline gather_selection make_gather_from_slices(std::span<const index_slice> sli
 template <typename Pred>
 gather_selection make_gather_from_predicate(std::span<const mesh_object_info> infos, Pred pred)
 {
-    // First pass: count matching elements.
+    // First pass: count matching elements.  Object points live in the R
+    // buffers, which stay far below 2^31 entries.
+    assert(fits_int(static_cast<integer>(infos.size())));
     int total = 0;
     for (int i = 0; i < static_cast<int>(infos.size()); ++i)
         if (pred(infos[i]))
@@ -169,31 +255,32 @@ gather_selection make_gather_from_predicate(std::span<const mesh_object_info> in
 template <typename Desc, typename Expr>
 void assign_selected(real* dst, Desc desc, Expr expr)
 {
-    Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, desc.count()),
-        KOKKOS_LAMBDA(int i) {
-            int idx = desc.element(i);
+    visit_selection(desc, [=](auto sel) {
+        index_for("assign_selected", sel.count(), KOKKOS_LAMBDA(auto i) {
+            const integer idx = sel.element(i);
             dst[idx] = expr(idx);
         });
+    });
 }
 
 template <typename Desc>
 void fill_selected(real* dst, Desc desc, real value)
 {
-    Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, desc.count()),
-        KOKKOS_LAMBDA(int i) { dst[desc.element(i)] = value; });
+    visit_selection(desc, [=](auto sel) {
+        index_for("fill_selected", sel.count(),
+                  KOKKOS_LAMBDA(auto i) { dst[sel.element(i)] = value; });
+    });
 }
 
 template <typename Desc, typename Expr>
 void plus_assign_selected(real* dst, Desc desc, Expr expr)
 {
-    Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, desc.count()),
-        KOKKOS_LAMBDA(int i) {
-            int idx = desc.element(i);
+    visit_selection(desc, [=](auto sel) {
+        index_for("plus_assign_selected", sel.count(), KOKKOS_LAMBDA(auto i) {
+            const integer idx = sel.element(i);
             dst[idx] += expr(idx);
         });
+    });
 }
 
 // ---------------------------------------------------------------------------
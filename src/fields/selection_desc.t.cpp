@@ -109,6 +109,42 @@ TEST_CASE("gather_selection element and count")
     REQUIRE(sel.element(3) == 42);
 }
 
+TEST_CASE("selections past 2^31 points")
+{
+    // 2048^3 mesh: 2^33 points, none of the offsets below fit in int
+    constexpr integer big = integer{2048} * 2048 * 2048;
+    STATIC_REQUIRE(!fits_int(big));
+
+    contiguous_selection c{big - 10, 10};
+    REQUIRE(c.element(9) == big - 1);
+
+    // y-plane at j = 2047: outer stride ny*nz = 2^22 over nx = 2048 rows
+    strided_selection s{integer{2047} * 2048, 2048, 2048, integer{2048} * 2048};
+    REQUIRE(s.count() == integer{2048} * 2048);
+    REQUIRE(s.element(s.count() - 1) == big - 1);
+
+    // small lists keep int storage, large indices switch to the wide list
+    std::vector<integer> narrow{3, 7, 42};
+    auto n = make_gather_from_indices(narrow);
+    REQUIRE(n.indices_.extent(0) == 3);
+    REQUIRE(n.wide_indices_.extent(0) == 0);
+    REQUIRE(n.element(2) == 42);
+
+    std::vector<integer> wide{3, big - 1, big / 2};
+    auto w = make_gather_from_indices(wide);
+    REQUIRE(w.indices_.extent(0) == 0);
+    REQUIRE(w.count() == 3);
+    REQUIRE(w.element(0) == 3);
+    REQUIRE(w.element(1) == big - 1);
+    REQUIRE(w.element(2) == big / 2);
+
+    std::vector<index_slice> slices{{0, 2}, {big - 2, big}};
+    auto g = make_gather_from_slices(slices);
+    REQUIRE(g.count() == 4);
+    REQUIRE(g.element(1) == 1);
+    REQUIRE(g.element(3) == big - 1);
+}
+
 // ---------------------------------------------------------------------------
 // 11.1a — Cross-check: plane descriptors match expected flat indices
 // ---------------------------------------------------------------------------
@@ -34,7 +34,7 @@ void field_data::write_geom(std::span<const std::string> filenames,
 void field_data::write(std::span<const scalar_view> scalars,
                        std::span<const std::string> filenames) const
 {
-    unsigned long sz = ix[0] * ix[1] * ix[2] * sizeof(real);
+    unsigned long sz = ix.size() * sizeof(real);
 
     for (size_t idx = 0; idx < filenames.size(); ++idx) {
         auto& fname = filenames[idx];
@@ -20,9 +20,11 @@ field_io::field_io(xdmf&& xdmf_w,
                    d_interval&& dump_interval,
                    std::string&& io_dir,
                    int suffix_length,
+                   field_monitor&& monitor,
                    const logs& build_logger)
     : xdmf_w{MOVE(xdmf_w)},
       field_data_w{MOVE(field_data_w)},
+      monitor{MOVE(monitor)},
       dump_interval{MOVE(dump_interval)},
       io_dir{MOVE(io_dir)},
       suffix_length{suffix_length},
@@ -35,6 +37,8 @@ bool field_io::write(std::span<const std::string> names,
                      real dt,
                      std::array<std::span<const mesh_object_info>, 3> r)
 {
+    monitor.write(names, scalars, step, dt);
+
     if (!dump_interval(step, dt)) return false;
 
     fs::path io{io_dir};
@@ -100,7 +104,15 @@ std::optional<field_io> field_io::from_lua(const sol::table& tbl, const logs& lo
     auto step = write_every_step ? interval<int>{*write_every_step} : interval<int>{};
     auto time = write_every_time ? interval<real>{*write_every_time} : interval<real>{};
 
-    return field_io{
-        MOVE(xdmf_w), MOVE(data_w), d_interval{step, time}, MOVE(dir), len, logger};
+    auto monitor = field_monitor::from_lua(io, ix, dom, dir, logger);
+    if (!monitor) return std::nullopt;
+
+    return field_io{MOVE(xdmf_w),
+                    MOVE(data_w),
+                    d_interval{step, time},
+                    MOVE(dir),
+                    len,
+                    MOVE(*monitor),
+                    logger};
 }
 } // namespace ccs
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "field_data.hpp"
+#include "field_monitor.hpp"
 #include "interval.hpp"
 #include "logging.hpp"
 #include "mesh/mesh_types.hpp"
@@ -22,6 +23,7 @@ class field_io
 
     xdmf xdmf_w;
     field_data field_data_w;
+    field_monitor monitor;
 
     d_interval dump_interval;
     std::string io_dir;
@@ -36,8 +38,10 @@ public:
              d_interval&& dump_interval,
              std::string&& io_dir,
              int suffix_length,
+             field_monitor&& monitor = {},
              const logs& = {});
 
+    // Feeds the monitor every call; returns true iff a full dump was written
     bool write(std::span<const std::string>,
                std::span<const scalar_view> scalars,
                const step_controller& controller,
@@ -0,0 +1,360 @@
+#include "field_monitor.hpp"
+
+#include "kokkos_types.hpp"
+
+#include "fields/selection_desc.hpp"
+#include "temporal/step_controller.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <sol/sol.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace std::literals;
+
+namespace ccs
+{
+
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr std::array<char, 3> axis_names{'x', 'y', 'z'};
+constexpr std::array<char, 3> index_names{'i', 'j', 'k'};
+
+// the stream settings shared by all probes or all slices
+struct stream_settings {
+    d_interval cadence;
+    bool binary;
+};
+
+std::optional<stream_settings>
+settings_from_lua(const sol::table& t, const char* what, const logs& logger)
+{
+    sol::optional<int> every_step = t["write_every_step"];
+    sol::optional<real> every_time = t["write_every_time"];
+    if ((every_step && *every_step < 1) || (every_time && *every_time <= 0)) {
+        logger(spdlog::level::err, "io.{} write intervals must be positive", what);
+        return std::nullopt;
+    }
+
+    const auto format = t["format"].get_or("csv"s);
+    if (format != "csv" && format != "binary") {
+        logger(spdlog::level::err,
+               "io.{}.format must be \"csv\" or \"binary\", not \"{}\"",
+               what,
+               format);
+        return std::nullopt;
+    }
+
+    // every step unless told otherwise
+    auto step = every_step ? interval<int>{*every_step}
+                : every_time ? interval<int>{}
+                             : interval<int>{1};
+    auto time = every_time ? interval<real>{*every_time} : interval<real>{};
+    return stream_settings{d_interval{step, time}, format == "binary"};
+}
+} // namespace
+
+field_monitor::field_monitor(std::string io_dir, const logs& build_logger)
+    : io_dir{MOVE(io_dir)}, logger{build_logger, "field_monitor"}
+{
+}
+
+void field_monitor::add_probes(const std::string& file,
+                               bool binary,
+                               d_interval cadence,
+                               index_extents ix,
+                               const domain_extents& dom,
+                               std::span<const std::string> names,
+                               std::span<const real3> locations)
+{
+    const auto first = size();
+
+    for (auto&& loc : locations) {
+        // the lower grid point and the fraction of the way to the next, per axis
+        int3 lo{};
+        real3 t{};
+        int3 corners{1, 1, 1};
+        for (int d = 0; d < 3; ++d) {
+            const int n = ix[d];
+            if (n == 1) continue;
+            const real h = (dom.max[d] - dom.min[d]) / (n - 1);
+            const real s = (loc[d] - dom.min[d]) / h;
+            lo[d] = std::clamp(static_cast<int>(std::floor(s)), 0, n - 2);
+            t[d] = std::clamp(s - lo[d], 0.0, 1.0);
+            corners[d] = 2;
+        }
+
+        for (int a = 0; a < corners[0]; ++a)
+            for (int b = 0; b < corners[1]; ++b)
+                for (int c = 0; c < corners[2]; ++c) {
+                    const real w = (corners[0] == 1 ? 1.0 : a ? t[0] : 1 - t[0]) *
+                                   (corners[1] == 1 ? 1.0 : b ? t[1] : 1 - t[1]) *
+                                   (corners[2] == 1 ? 1.0 : c ? t[2] : 1 - t[2]);
+                    indices.push_back(ix(int3{lo[0] + a, lo[1] + b, lo[2] + c}));
+                    weights.push_back(w);
+                }
+        offsets.push_back(static_cast<integer>(indices.size()));
+    }
+
+    streams.push_back(stream{file,
+                             binary,
+                             MOVE(cadence),
+                             first,
+                             size() - first,
+                             std::vector<std::string>(names.begin(), names.end())});
+}
+
+void field_monitor::add_slice(const std::string& file,
+                              bool binary,
+                              d_interval cadence,
+                              index_extents ix,
+                              int dir,
+                              int index)
+{
+    const auto first = size();
+    // the in-plane axes, the second varying fastest along the selection
+    const int f = dir == 0 ? 1 : 0;
+    const int s = dir == 2 ? 1 : 2;
+
+    std::vector<std::string> samples;
+    auto add = [&](auto&& desc) {
+        for (integer e = 0; e < desc.count(); ++e) {
+            indices.push_back(desc.element(e));
+            weights.push_back(1.0);
+            offsets.push_back(static_cast<integer>(indices.size()));
+            samples.push_back(fmt::format(
+                "{}{}{}{}", index_names[f], e / ix[s], index_names[s], e % ix[s]));
+        }
+    };
+    if (dir == 0)
+        add(make_x_plane_desc(ix, index));
+    else if (dir == 1)
+        add(make_y_plane_desc(ix, index));
+    else
+        add(make_z_plane_desc(ix, index));
+
+    streams.push_back(
+        stream{file, binary, MOVE(cadence), first, size() - first, MOVE(samples)});
+}
+
+void field_monitor::gather(std::span<const scalar_view> scalars)
+{
+    const integer rows = size();
+    const auto nfields = static_cast<integer>(scalars.size());
+    const auto ndue = static_cast<integer>(due.size());
+    values.resize(rows * nfields);
+
+    std::vector<const real*> fields;
+    for (auto&& sc : scalars) fields.push_back(sc.D.data());
+
+    const integer* p = offsets.data();
+    const integer* idx = indices.data();
+    const real* w = weights.data();
+    const integer* r_due = due.data();
+    const real* const* d = fields.data();
+    real* out = values.data();
+
+    // the due rows of every field in one launch: n = field * ndue + due row
+    index_for("field_monitor_gather", ndue * nfields, [=](auto n) {
+        const auto f = n / ndue;
+        const auto r = r_due[n % ndue];
+        const real* u = d[f];
+        real v = 0.0;
+        for (integer q = p[r]; q < p[r + 1]; ++q) v += w[q] * u[idx[q]];
+        out[f * rows + r] = v;
+    });
+    exec_space().fence("field_monitor gather complete");
+}
+
+bool field_monitor::write(std::span<const std::string> names,
+                          std::span<const scalar_view> scalars,
+                          const step_controller& step,
+                          real dt)
+{
+    if (streams.empty() || scalars.empty()) return false;
+
+    // only the rows of the streams due this step are gathered, so a probe stream
+    // written every step does not pay for a slice written every N
+    due.clear();
+    for (auto&& st : streams) {
+        if (!st.cadence(step, dt)) continue;
+        for (integer r = st.first; r < st.first + st.rows; ++r) due.push_back(r);
+    }
+    if (due.empty()) return false;
+    gather(scalars);
+
+    for (auto&& st : streams) {
+        if (!st.cadence(step, dt)) continue;
+
+        const bool first = st.cadence.current_dump() == 0;
+        const auto path = fs::path{io_dir} / st.file;
+        if (first) {
+            if (!io_dir.empty()) fs::create_directories(io_dir);
+
+            std::vector<std::string> columns{"Time", "Step"};
+            for (auto&& name : names)
+                for (auto&& sample : st.samples)
+                    columns.push_back(fmt::format("{}_{}", name, sample));
+            auto header = fmt::format("{}\n", fmt::join(columns, ","));
+
+            if (st.binary) {
+                std::ofstream{fs::path{path} += ".columns"} << header;
+                std::ofstream{path, std::ios::binary | std::ios::trunc};
+            } else {
+                std::ofstream{path, std::ios::trunc} << header;
+            }
+        }
+
+        const integer rows = size();
+        const auto nfields = static_cast<integer>(scalars.size());
+        if (st.binary) {
+            std::ofstream o{path, std::ios::binary | std::ios::app};
+            const real ts[] = {(real)step, static_cast<real>((int)step)};
+            o.write(reinterpret_cast<const char*>(ts), sizeof(ts));
+            for (integer s = 0; s < nfields; ++s)
+                o.write(reinterpret_cast<const char*>(&values[s * rows + st.first]),
+                        st.rows * sizeof(real));
+        } else {
+            std::ofstream o{path, std::ios::app};
+            fmt::memory_buffer buf;
+            fmt::format_to(std::back_inserter(buf), "{},{}", (real)step, (int)step);
+            for (integer s = 0; s < nfields; ++s)
+                for (integer r = 0; r < st.rows; ++r)
+                    fmt::format_to(
+                        std::back_inserter(buf), ",{}", values[s * rows + st.first + r]);
+            buf.push_back('\n');
+            o.write(buf.data(), buf.size());
+        }
+
+        ++st.cadence;
+    }
+
+    return true;
+}
+
+std::optional<field_monitor> field_monitor::from_lua(const sol::table& io,
+                                                     index_extents ix,
+                                                     const domain_extents& dom,
+                                                     const std::string& io_dir,
+                                                     const logs& logger)
+{
+    auto monitor = field_monitor{io_dir, logger};
+
+    if (sol::optional<sol::table> probes = io["probes"]; probes) {
+        auto settings = settings_from_lua(*probes, "probes", logger);
+        if (!settings) return std::nullopt;
+
+        std::vector<std::string> names;
+        std::vector<real3> locations;
+        for (int i = 1; (*probes)[i].valid(); ++i) {
+            sol::optional<sol::table> loc = (*probes)[i]["location"];
+            if (!loc) {
+                logger(spdlog::level::err, "io.probes[{}].location is required", i);
+                return std::nullopt;
+            }
+            real3 x = dom.min;
+            for (int d = 0; d < 3; ++d) {
+                x[d] = (*loc)[d + 1].get_or(x[d]);
+                if (ix[d] == 1) continue;
+                // round-off at the domain faces is not an error
+                const real eps = 1e-12 * (dom.max[d] - dom.min[d]);
+                if (x[d] < dom.min[d] - eps || x[d] > dom.max[d] + eps) {
+                    logger(spdlog::level::err,
+                           "io.probes[{}].location {} = {} is outside the domain",
+                           i,
+                           axis_names[d],
+                           x[d]);
+                    return std::nullopt;
+                }
+            }
+            names.push_back((*probes)[i]["name"].get_or(fmt::format("p{}", i)));
+            locations.push_back(x);
+        }
+        if (locations.empty()) {
+            logger(spdlog::level::err, "io.probes lists no probes");
+            return std::nullopt;
+        }
+
+        const auto file = settings->binary ? "probes.bin"s : "probes.csv"s;
+        logger(spdlog::level::info, "{} probes written to {}", names.size(), file);
+        monitor.add_probes(
+            file, settings->binary, settings->cadence, ix, dom, names, locations);
+    }
+
+    if (sol::optional<sol::table> slices = io["slices"]; slices) {
+        auto settings = settings_from_lua(*slices, "slices", logger);
+        if (!settings) return std::nullopt;
+
+        int nslices = 0;
+        for (int i = 1; (*slices)[i].valid(); ++i, ++nslices) {
+            sol::optional<sol::table> t = (*slices)[i];
+            if (!t) {
+                logger(spdlog::level::err, "io.slices[{}] must be a table", i);
+                return std::nullopt;
+            }
+
+            int dir = -1;
+            real x{};
+            for (int d = 0; d < 3; ++d) {
+                sol::optional<real> v = (*t)[std::string(1, axis_names[d])];
+                if (!v) continue;
+                if (dir != -1) {
+                    dir = 3;
+                    break;
+                }
+                dir = d;
+                x = *v;
+            }
+            if (dir < 0 || dir > 2) {
+                logger(spdlog::level::err,
+                       "io.slices[{}] needs exactly one of x, y or z",
+                       i);
+                return std::nullopt;
+            }
+
+            // the nearest grid plane, within half a cell of the domain
+            int index = 0;
+            if (const int n = ix[dir]; n > 1) {
+                const real h = (dom.max[dir] - dom.min[dir]) / (n - 1);
+                const real s = (x - dom.min[dir]) / h;
+                if (s < -0.5 || s > n - 0.5) {
+                    logger(spdlog::level::err,
+                           "io.slices[{}] {} = {} is outside the domain",
+                           i,
+                           axis_names[dir],
+                           x);
+                    return std::nullopt;
+                }
+                index = std::clamp(static_cast<int>(std::lround(s)), 0, n - 1);
+            }
+
+            const auto name = (*t)["name"].get_or(fmt::format("s{}", i));
+            const auto file =
+                fmt::format("slice_{}.{}", name, settings->binary ? "bin" : "csv");
+            logger(spdlog::level::info,
+                   "slice {} at {} index {} written to {}",
+                   name,
+                   axis_names[dir],
+                   index,
+                   file);
+            monitor.add_slice(file, settings->binary, settings->cadence, ix, dir, index);
+        }
+        if (nslices == 0) {
+            logger(spdlog::level::err, "io.slices lists no slices");
+            return std::nullopt;
+        }
+    }
+
+    return monitor;
+}
+
+} // namespace ccs
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "interval.hpp"
+#include "logging.hpp"
+#include "types.hpp"
+
+#include "fields/scalar.hpp"
+#include "index_extents.hpp"
+#include "mesh/mesh_types.hpp"
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sol/forward.hpp>
+
+namespace ccs
+{
+// Forward decls
+class step_controller;
+
+//
+// Probe and plane-slice streams written next to the field dumps, for watching a
+// few locations every step without dumping the whole mesh.  Both are configured
+// in the io table:
+//
+//   io = {
+//       probes = { write_every_step = 1, format = "csv",
+//                  { name = "wake", location = {1.5, 0.5, 0.5} } },
+//       slices = { write_every_time = 0.01, format = "binary",
+//                  { name = "mid", z = 0.5 } }
+//   }
+//
+// A probe is interpolated multilinearly from the 2^dims grid points around its
+// location; a slice is the x, y or z grid plane nearest its coordinate, selected
+// by make_x/y/z_plane_desc.  Both become rows of one precomputed (index, weight)
+// table over the D component, and a single kernel gathers the rows of the streams
+// due at a write for every field.
+//
+// Each stream appends one record per write to its file in io.dir: probes.csv or
+// probes.bin for the probes and slice_<name>.csv or .bin for each slice.  A
+// record is Time, Step and then the samples field by field, named
+// <field>_<sample> in the CSV header.  Binary records are the same float64 values
+// with no header; the column names go to a .columns file next to them.
+//
+class field_monitor
+{
+    struct stream {
+        std::string file;
+        bool binary;
+        d_interval cadence;
+        integer first; // first row of the table
+        integer rows;
+        std::vector<std::string> samples;
+    };
+
+    std::vector<stream> streams;
+    // row r of the table gathers sum(weight[q] * D[index[q]]) for q in
+    // [offsets[r], offsets[r + 1])
+    std::vector<integer> offsets{0};
+    std::vector<integer> indices;
+    std::vector<real> weights;
+    std::vector<real> values;
+    // rows of the streams due at the current write
+    std::vector<integer> due;
+    std::string io_dir;
+    logs logger{};
+
+    void gather(std::span<const scalar_view> scalars);
+
+public:
+    field_monitor() = default;
+
+    field_monitor(std::string io_dir, const logs& = {});
+
+    // rows of the table, one per sample
+    integer size() const { return static_cast<integer>(offsets.size()) - 1; }
+
+    // rows gathered by the last write
+    integer gathered() const { return static_cast<integer>(due.size()); }
+
+    // A probe stream interpolating at `locations`, which must lie in dom
+    void add_probes(const std::string& file,
+                    bool binary,
+                    d_interval cadence,
+                    index_extents ix,
+                    const domain_extents& dom,
+                    std::span<const std::string> names,
+                    std::span<const real3> locations);
+
+    // A slice stream of grid plane `index` normal to `dir`
+    void add_slice(const std::string& file,
+                   bool binary,
+                   d_interval cadence,
+                   index_extents ix,
+                   int dir,
+                   int index);
+
+    // Append a record to every stream that is due.  Returns true if any was
+    bool write(std::span<const std::string> names,
+               std::span<const scalar_view> scalars,
+               const step_controller& controller,
+               real dt);
+
+    // An empty monitor when io has neither probes nor slices
+    static std::optional<field_monitor> from_lua(const sol::table& io,
+                                                 index_extents ix,
+                                                 const domain_extents& dom,
+                                                 const std::string& io_dir,
+                                                 const logs& = {});
+};
+
+} // namespace ccs
@@ -0,0 +1,201 @@
+#include "field_io.hpp"
+#include "field_monitor.hpp"
+#include "temporal/step_controller.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sol/sol.hpp>
+
+using namespace ccs;
+namespace fs = std::filesystem;
+
+// Custom main: Kokkos must be initialized before the monitor launches its gather.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+namespace
+{
+using T = std::array<std::span<const mesh_object_info>, 3>;
+
+constexpr auto config = R"(
+    simulation = {
+        mesh = {
+            index_extents = {5, 4, 3},
+            domain_bounds = {
+                min = {0, 0, 0},
+                max = {1, 1.5, 1}
+            }
+        },
+        io = {
+            probes = {
+                { name = "a", location = {0.3, 0.7, 0.25} },
+                { name = "corner", location = {1, 1.5, 1} }
+            },
+            slices = {
+                write_every_step = 2,
+                format = "binary",
+                { name = "mid", y = 0.6 }
+            }
+        }
+    }
+)";
+
+// linear, so the multilinear probes reproduce it exactly
+real u(real x, real y, real z) { return 1 + 2 * x + 3 * y - z; }
+
+std::vector<std::string> lines(const fs::path& p)
+{
+    std::ifstream f{p};
+    std::vector<std::string> r{};
+    for (std::string l; std::getline(f, l);)
+        r.push_back(l);
+    return r;
+}
+
+std::vector<real> columns(const std::string& line)
+{
+    std::istringstream s{line};
+    std::vector<real> r{};
+    for (std::string c; std::getline(s, c, ',');)
+        r.push_back(std::stod(c));
+    return r;
+}
+} // namespace
+
+TEST_CASE("field_monitor - probes and slices")
+{
+    const auto dir = fs::temp_directory_path() / "shoccs_field_monitor";
+    fs::remove_all(dir);
+
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(config);
+    lua["simulation"]["io"]["dir"] = dir.string();
+
+    auto io_opt = field_io::from_lua(lua["simulation"]);
+    REQUIRE(!!io_opt);
+    auto& io = *io_opt;
+
+    // d index i * ny * nz + j * nz + k
+    std::vector<real> u_d(60), v_d(60, 7.0);
+    for (int i = 0; i < 5; ++i)
+        for (int j = 0; j < 4; ++j)
+            for (int k = 0; k < 3; ++k)
+                u_d[i * 12 + j * 3 + k] = u(0.25 * i, 0.5 * j, 0.5 * k);
+
+    std::vector<std::string> names{"U", "V"};
+    std::vector<scalar_view> scalars{scalar_span{u_d, {}, {}, {}},
+                                     scalar_span{v_d, {}, {}, {}}};
+
+    step_controller step{};
+    for (int n = 0; n < 5; ++n) {
+        // no full dumps are configured
+        REQUIRE(!io.write(names, scalars, step, 0.1, T{}));
+        step.advance(0.1);
+    }
+
+    // the slice rows are only gathered on the steps it is written
+    {
+        auto m = field_monitor::from_lua(lua["simulation"]["io"],
+                                         index_extents{{5, 4, 3}},
+                                         domain_extents{{0, 0, 0}, {1, 1.5, 1}},
+                                         (dir / "rows").string());
+        REQUIRE(!!m);
+        REQUIRE(m->size() == 2 + 15);
+        step_controller s{};
+        for (int n = 0; n < 4; ++n) {
+            REQUIRE(m->write(names, scalars, s, 0.1));
+            REQUIRE(m->gathered() == (n % 2 == 0 ? 2 + 15 : 2));
+            s.advance(0.1);
+        }
+    }
+
+    SECTION("probes")
+    {
+        auto l = lines(dir / "probes.csv");
+        REQUIRE(l.size() == 6);
+        REQUIRE(l[0] == "Time,Step,U_a,U_corner,V_a,V_corner");
+        for (int n = 0; n < 5; ++n) {
+            auto c = columns(l[n + 1]);
+            REQUIRE(c.size() == 6);
+            REQUIRE(c[0] == Catch::Approx(0.1 * n));
+            REQUIRE(c[1] == n);
+            REQUIRE(c[2] == Catch::Approx(u(0.3, 0.7, 0.25)));
+            REQUIRE(c[3] == Catch::Approx(u(1, 1.5, 1)));
+            REQUIRE(c[4] == Catch::Approx(7.0));
+            REQUIRE(c[5] == Catch::Approx(7.0));
+        }
+    }
+
+    SECTION("slices")
+    {
+        // y = 0.6 snaps to the plane j = 1; records at steps 0, 2 and 4
+        const auto file = dir / "slice_mid.bin";
+        constexpr int record = 2 + 2 * 15;
+        REQUIRE(fs::file_size(file) == 3 * record * sizeof(real));
+
+        auto header = lines(fs::path{file} += ".columns");
+        REQUIRE(header.size() == 1);
+        REQUIRE(header[0].starts_with("Time,Step,U_i0k0,U_i0k1,U_i0k2,U_i1k0,"));
+
+        std::vector<real> r(3 * record);
+        std::ifstream f{file, std::ios::binary};
+        f.read(reinterpret_cast<char*>(r.data()), r.size() * sizeof(real));
+
+        for (int n = 0; n < 3; ++n) {
+            const real* rec = &r[n * record];
+            REQUIRE(rec[0] == Catch::Approx(0.2 * n));
+            REQUIRE(rec[1] == 2 * n);
+            for (int i = 0; i < 5; ++i)
+                for (int k = 0; k < 3; ++k) {
+                    REQUIRE(rec[2 + i * 3 + k] == u(0.25 * i, 0.5, 0.5 * k));
+                    REQUIRE(rec[17 + i * 3 + k] == 7.0);
+                }
+        }
+    }
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("field_monitor - invalid")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+
+    auto invalid = [&lua](const char* change) {
+        lua.script(config);
+        lua.script(change);
+        return !field_io::from_lua(lua["simulation"]);
+    };
+
+    REQUIRE(invalid("simulation.io.probes[1].location = {2, 0, 0}"));
+    REQUIRE(invalid("simulation.io.probes[1].location = nil"));
+    REQUIRE(invalid("simulation.io.probes = {}"));
+    REQUIRE(invalid("simulation.io.probes.format = 'hdf5'"));
+    REQUIRE(invalid("simulation.io.slices.write_every_step = 0"));
+    REQUIRE(invalid("simulation.io.slices[1] = { x = 0.5, z = 0.5 }"));
+    REQUIRE(invalid("simulation.io.slices[1] = { name = 'none' }"));
+    REQUIRE(invalid("simulation.io.slices[1] = { z = 1.3 }"));
+
+    // a slice within half a cell of the domain snaps to its face
+    lua.script(config);
+    lua.script("simulation.io.slices[1] = { x = 1.1 }");
+    REQUIRE(!!field_io::from_lua(lua["simulation"]));
+
+    // without probes or slices there is nothing to monitor
+    auto m = field_monitor::from_lua(lua.create_table(), {}, {}, "io");
+    REQUIRE(!!m);
+    REQUIRE(m->size() == 0);
+}
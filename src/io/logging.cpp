@@ -13,7 +13,7 @@ logs::logs(const std::string& logging_dir, bool enable, const std::string& name)
     : enable{enable}, logging_dir{logging_dir}
 {
     if (enable) {
-        auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_st>();
+        auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
         logger = std::make_shared<spdlog::logger>(name, sink);
     }
 }
@@ -21,7 +21,7 @@ logs::logs(const std::string& logging_dir, bool enable, const std::string& name)
 logs::logs(const logs& other, const std::string& logger_name) : enable{other}
 {
     if (enable) {
-        auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_st>();
+        auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
         logger = std::make_shared<spdlog::logger>(logger_name, sink);
     }
 }
@@ -32,7 +32,7 @@ logs::logs(const logs& other,
     : enable(other), logging_dir(other.logging_dir)
 {
     if (enable) {
-        auto sink = std::make_shared<spdlog::sinks::basic_file_sink_st>(
+        auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(
             fs::path{logging_dir} / file_name, true);
         logger = std::make_shared<spdlog::logger>(logger_name, sink);
     }
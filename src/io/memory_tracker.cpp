@@ -0,0 +1,156 @@
+#include "memory_tracker.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <fmt/core.h>
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace ccs
+{
+
+namespace
+{
+struct views {
+    std::mutex m;
+    // live views and the subsystem they were charged to
+    std::unordered_map<const void*, subsystem> live;
+    bool active = false;
+};
+
+views tracked{};
+
+void allocate(const Kokkos::Tools::SpaceHandle,
+              const char* label,
+              const void* ptr,
+              const std::uint64_t size)
+{
+    memory_tracker::view_allocated(label, ptr, size);
+}
+
+void deallocate(const Kokkos::Tools::SpaceHandle,
+                const char*,
+                const void* ptr,
+                const std::uint64_t size)
+{
+    memory_tracker::view_deallocated(ptr, size);
+}
+} // namespace
+
+memory_tracker::memory_tracker(const logs& logger) : logger{logger, "memory"}
+{
+    if (tracked.active) {
+        this->logger(spdlog::level::warn, "views are already tracked");
+        return;
+    }
+
+    // an external tool loaded through KOKKOS_TOOLS_LIBS keeps its callbacks
+    if (Kokkos::Tools::profileLibraryLoaded()) {
+        this->logger(spdlog::level::warn,
+                     "a Kokkos tool is already loaded, views are not counted");
+        return;
+    }
+
+    installed = tracked.active = true;
+    restore_callbacks();
+}
+
+memory_tracker::memory_tracker(memory_tracker&& other) noexcept
+    : logger{std::move(other.logger)}, installed{std::exchange(other.installed, false)}
+{
+}
+
+memory_tracker& memory_tracker::operator=(memory_tracker&& other) noexcept
+{
+    std::swap(logger, other.logger);
+    std::swap(installed, other.installed);
+    return *this;
+}
+
+memory_tracker::~memory_tracker()
+{
+    if (!installed) return;
+
+    namespace kt = Kokkos::Tools::Experimental;
+    kt::set_allocate_data_callback(nullptr);
+    kt::set_deallocate_data_callback(nullptr);
+
+    std::scoped_lock lock{tracked.m};
+    tracked.active = false;
+    tracked.live.clear();
+}
+
+bool memory_tracker::active() { return tracked.active; }
+
+void memory_tracker::view_allocated(const char* label,
+                                    const void* ptr,
+                                    const std::uint64_t size)
+{
+    if (!tracked.active) return;
+
+    const auto s = subsystem_of(label);
+    {
+        std::scoped_lock lock{tracked.m};
+        tracked.live[ptr] = s;
+    }
+    charge_memory(s, static_cast<std::int64_t>(size));
+}
+
+void memory_tracker::view_deallocated(const void* ptr, const std::uint64_t size)
+{
+    if (!tracked.active) return;
+
+    std::unique_lock lock{tracked.m};
+    auto it = tracked.live.find(ptr);
+    if (it == tracked.live.end()) return;
+    const auto s = it->second;
+    tracked.live.erase(it);
+    lock.unlock();
+
+    release_memory(s, static_cast<std::int64_t>(size));
+}
+
+void memory_tracker::restore_callbacks()
+{
+    if (!tracked.active) return;
+
+    namespace kt = Kokkos::Tools::Experimental;
+    kt::set_allocate_data_callback(allocate);
+    kt::set_deallocate_data_callback(deallocate);
+}
+
+std::string memory_tracker::bytes(std::int64_t b)
+{
+    constexpr std::array units{"B", "KiB", "MiB", "GiB", "TiB"};
+    double v = static_cast<double>(b);
+    std::size_t u = 0;
+    while ((v >= 1024 || v <= -1024) && u + 1 < units.size()) {
+        v /= 1024;
+        ++u;
+    }
+    return u == 0 ? fmt::format("{} B", b) : fmt::format("{:.1f} {}", v, units[u]);
+}
+
+void memory_tracker::report(std::string_view when) const
+{
+    if (!logger) return;
+
+    std::string r{};
+    for (int i = 0; i < n_subsystems; ++i) {
+        const auto [current, peak] = memory_in(static_cast<subsystem>(i));
+        if (peak == 0) continue;
+        r += fmt::format(
+            ", {} {} (peak {})", subsystem_names[i], bytes(current), bytes(peak));
+    }
+    const auto [current, peak] = memory_total();
+    logger(spdlog::level::info,
+           "memory {}: {} (peak {}){}",
+           when,
+           bytes(current),
+           bytes(peak),
+           r);
+}
+
+} // namespace ccs
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "logging.hpp"
+#include "memory.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ccs
+{
+
+//
+// Charges Kokkos views to the subsystem named by their label (subsystem_of) and
+// logs the bytes held by each subsystem.  Containers with a tracking_allocator
+// are counted from the start of the process, views only while a tracker is
+// installed.  Views are remembered by address, so freeing one allocated before
+// the tracker was installed releases nothing.
+//
+// Kokkos Tools take a single callback per event.  A profiler session forwards
+// its allocate and deallocate events here and hands the callbacks back when it
+// ends.  A tool loaded through KOKKOS_TOOLS_LIBS keeps its callbacks and views
+// go uncounted.
+//
+// A default constructed tracker installs nothing and logs nothing.
+//
+class memory_tracker
+{
+    logs logger{};
+    bool installed = false;
+
+public:
+    memory_tracker() = default;
+    explicit memory_tracker(const logs&);
+
+    memory_tracker(memory_tracker&&) noexcept;
+    memory_tracker& operator=(memory_tracker&&) noexcept;
+    ~memory_tracker();
+
+    operator bool() const { return installed; }
+
+    // Log the current and peak bytes of every subsystem holding memory, e.g.
+    // report("after operator build")
+    void report(std::string_view when) const;
+
+    // "12.5 MiB"
+    static std::string bytes(std::int64_t);
+
+    // Called by the profiler, which owns the Kokkos callbacks during a session
+    static bool active();
+    static void view_allocated(const char* label, const void* ptr, std::uint64_t size);
+    static void view_deallocated(const void* ptr, std::uint64_t size);
+    static void restore_callbacks();
+};
+
+} // namespace ccs
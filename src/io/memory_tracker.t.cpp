@@ -0,0 +1,126 @@
+#include "memory_tracker.hpp"
+#include "kokkos_types.hpp"
+#include "memory.hpp"
+#include "profiler.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <optional>
+
+using namespace ccs;
+namespace fs = std::filesystem;
+
+// Custom main: Kokkos must be initialized before any test allocates Views.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+TEST_CASE("memory - subsystem_of")
+{
+    REQUIRE(subsystem_of("s0_D") == subsystem::fields);
+    REQUIRE(subsystem_of("s12_Rx") == subsystem::fields);
+    REQUIRE(subsystem_of("v1_yRz") == subsystem::fields);
+    REQUIRE(subsystem_of("gather_indices") == subsystem::fields);
+    REQUIRE(subsystem_of("block_coeffs") == subsystem::matrices);
+    REQUIRE(subsystem_of("line_solver_meta") == subsystem::matrices);
+    REQUIRE(subsystem_of("gradient_sweep_c") == subsystem::operators);
+    REQUIRE(subsystem_of("slab_in") == subsystem::operators);
+    REQUIRE(subsystem_of("sum") == subsystem::other);
+    REQUIRE(subsystem_of("s_D") == subsystem::other);
+    REQUIRE(subsystem_of("v") == subsystem::other);
+}
+
+TEST_CASE("memory - tracking_allocator")
+{
+    const auto before = memory_in(subsystem::systems);
+    const auto total = memory_total();
+    {
+        tracked_vector<double, subsystem::systems> v(100);
+        REQUIRE(memory_in(subsystem::systems).current == before.current + 800);
+        REQUIRE(memory_total().current == total.current + 800);
+
+        // a copy is charged to the same subsystem
+        auto w = v;
+        REQUIRE(memory_in(subsystem::systems).current == before.current + 1600);
+        REQUIRE(memory_in(subsystem::systems).peak >= before.current + 1600);
+    }
+    REQUIRE(memory_in(subsystem::systems).current == before.current);
+    REQUIRE(memory_total().current == total.current);
+}
+
+TEST_CASE("memory_tracker - disabled")
+{
+    memory_tracker tracker{};
+    REQUIRE(!tracker);
+    REQUIRE(!memory_tracker::active());
+
+    const auto before = memory_in(subsystem::fields).current;
+    device_view<real*> v("s0_D", 100);
+    REQUIRE(memory_in(subsystem::fields).current == before);
+}
+
+TEST_CASE("memory_tracker - views")
+{
+    // allocated before the tracker, so never charged or released
+    std::optional<device_view<real*>> early{std::in_place, "s0_Rx", 50};
+
+    const auto before = memory_in(subsystem::fields).current;
+    {
+        memory_tracker tracker{logs{false, "memory"}};
+        REQUIRE(!!tracker);
+        REQUIRE(memory_tracker::active());
+        REQUIRE(Kokkos::Tools::profileLibraryLoaded());
+
+        {
+            device_view<real*> v("s0_D", 100);
+            REQUIRE(memory_in(subsystem::fields).current == before + 100 * sizeof(real));
+            REQUIRE(memory_in(subsystem::fields).peak >= before + 100 * sizeof(real));
+        }
+        REQUIRE(memory_in(subsystem::fields).current == before);
+
+        early.reset();
+        REQUIRE(memory_in(subsystem::fields).current == before);
+
+        const auto m = memory_in(subsystem::matrices).current;
+        device_view<real*> c("block_coeffs", 10);
+        REQUIRE(memory_in(subsystem::matrices).current == m + 10 * sizeof(real));
+    }
+    REQUIRE(!memory_tracker::active());
+    REQUIRE(!Kokkos::Tools::profileLibraryLoaded());
+}
+
+TEST_CASE("memory_tracker - profiler")
+{
+    const auto dir = fs::temp_directory_path() / "shoccs_memory_tracker";
+    fs::remove_all(dir);
+
+    memory_tracker tracker{logs{false, "memory"}};
+    const auto before = memory_in(subsystem::fields).current;
+    {
+        // the tracker's callbacks do not count as an external tool
+        profiler prof{(dir / "profile.csv").string(), 1, profiler::format::csv};
+        auto session = prof.start();
+        REQUIRE(!!prof);
+
+        device_view<real*> v("s1_D", 100);
+        REQUIRE(memory_in(subsystem::fields).current == before + 100 * sizeof(real));
+    }
+
+    // handed back when the session ends
+    REQUIRE(Kokkos::Tools::profileLibraryLoaded());
+    device_view<real*> v("s1_D", 100);
+    REQUIRE(memory_in(subsystem::fields).current == before + 100 * sizeof(real));
+}
+
+TEST_CASE("memory_tracker - bytes")
+{
+    REQUIRE(memory_tracker::bytes(0) == "0 B");
+    REQUIRE(memory_tracker::bytes(1023) == "1023 B");
+    REQUIRE(memory_tracker::bytes(1536) == "1.5 KiB");
+    REQUIRE(memory_tracker::bytes(3l << 30) == "3.0 GiB");
+}
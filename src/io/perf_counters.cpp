@@ -0,0 +1,116 @@
+#include "perf_counters.hpp"
+
+#include <cerrno>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ccs
+{
+
+namespace fs = std::filesystem;
+
+perf_counters::perf_counters(perf_counters&& other) noexcept
+    : leaders{std::exchange(other.leaders, {})}, fds{std::exchange(other.fds, {})}
+{
+}
+
+perf_counters& perf_counters::operator=(perf_counters&& other) noexcept
+{
+    std::swap(leaders, other.leaders);
+    std::swap(fds, other.fds);
+    return *this;
+}
+
+#ifdef __linux__
+
+namespace
+{
+constexpr std::array<std::uint64_t, perf_counters::n> configs{
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_REFERENCES,
+    PERF_COUNT_HW_CACHE_MISSES};
+
+int open_event(std::uint64_t config, pid_t tid, int leader)
+{
+    perf_event_attr a{};
+    a.size = sizeof(a);
+    a.type = PERF_TYPE_HARDWARE;
+    a.config = config;
+    a.disabled = leader == -1;
+    a.exclude_kernel = 1;
+    a.exclude_hv = 1;
+    a.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &a, tid, -1, leader, 0));
+}
+
+// PERF_FORMAT_GROUP: the number of events, then one count per event
+void add_group(int leader, perf_counters::values& v)
+{
+    std::uint64_t buf[1 + perf_counters::n];
+    if (::read(leader, buf, sizeof(buf)) != sizeof(buf)) return;
+    for (int i = 0; i < perf_counters::n; ++i) v[i] += buf[1 + i];
+}
+} // namespace
+
+perf_counters::~perf_counters()
+{
+    for (auto fd : fds) close(fd);
+}
+
+std::optional<perf_counters> perf_counters::open()
+{
+    perf_counters p{};
+
+    std::error_code ec;
+    for (auto&& task : fs::directory_iterator{"/proc/self/task", ec}) {
+        const auto tid = static_cast<pid_t>(std::stol(task.path().filename().string()));
+
+        int leader = -1;
+        for (auto config : configs) {
+            const int fd = open_event(config, tid, leader);
+            // the thread may have exited since the directory was read
+            if (fd < 0) {
+                if (leader == -1 && errno == ESRCH) break;
+                return std::nullopt;
+            }
+            p.fds.push_back(fd);
+            if (leader == -1) leader = fd;
+        }
+        if (leader != -1) p.leaders.push_back(leader);
+    }
+    if (ec || p.leaders.empty()) return std::nullopt;
+
+    for (auto fd : p.leaders) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    return p;
+}
+
+perf_counters::values perf_counters::read() const
+{
+    values v{};
+    for (auto fd : leaders) add_group(fd, v);
+    return v;
+}
+
+#else
+
+perf_counters::~perf_counters() {}
+
+std::optional<perf_counters> perf_counters::open() { return std::nullopt; }
+
+perf_counters::values perf_counters::read() const { return {}; }
+
+#endif
+
+} // namespace ccs
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace ccs
+{
+
+//
+// Hardware counters of every thread of the process through perf_event_open, one
+// counter group per thread so the events of a group are scheduled together.
+// Threads started after open() are not counted, so open the counters once the
+// Kokkos thread pool exists.  The last-level cache misses times the line size
+// serve as a proxy for the DRAM traffic.
+//
+// read() is one read(2) call per thread, so reading around a region costs two
+// per thread.
+//
+class perf_counters
+{
+    // group leader per thread, and every descriptor opened
+    std::vector<int> leaders;
+    std::vector<int> fds;
+
+public:
+    static constexpr int n = 4;
+    static constexpr std::array<const char*, n> names{
+        "Cycles", "Instructions", "LLCReferences", "LLCMisses"};
+    enum event { cycles, instructions, llc_references, llc_misses };
+
+    using values = std::array<std::uint64_t, n>;
+
+    perf_counters() = default;
+    perf_counters(perf_counters&&) noexcept;
+    perf_counters& operator=(perf_counters&&) noexcept;
+    ~perf_counters();
+
+    // nullopt off Linux, without a PMU (e.g. most VMs) or when
+    // perf_event_paranoid forbids user-space counting
+    static std::optional<perf_counters> open();
+
+    // the counts summed over the threads
+    values read() const;
+};
+
+} // namespace ccs
@@ -0,0 +1,55 @@
+#include "perf_counters.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <latch>
+#include <thread>
+
+using namespace ccs;
+
+TEST_CASE("perf_counters")
+{
+    auto p = perf_counters::open();
+    // virtual machines and locked down kernels have no counters to read
+    if (!p) SKIP("hardware counters are unavailable");
+
+    const auto before = p->read();
+    volatile double s = 0;
+    for (int i = 0; i < 1000000; ++i) s = s + 0.5 * i;
+    const auto after = p->read();
+
+    REQUIRE(after[perf_counters::cycles] > before[perf_counters::cycles]);
+    REQUIRE(after[perf_counters::instructions] > before[perf_counters::instructions]);
+
+    // moved-from counters own nothing
+    perf_counters q{std::move(*p)};
+    REQUIRE(q.read()[perf_counters::cycles] >= after[perf_counters::cycles]);
+    REQUIRE(p->read() == perf_counters::values{});
+}
+
+TEST_CASE("perf_counters - threads")
+{
+    // a thread started before open() is counted, like the Kokkos pool threads
+    std::latch opened{1}, done{1};
+    std::jthread worker{[&] {
+        opened.wait();
+        volatile double s = 0;
+        for (int i = 0; i < 1000000; ++i) s = s + 0.5 * i;
+        done.count_down();
+    }};
+
+    auto p = perf_counters::open();
+    if (!p) {
+        opened.count_down();
+        SKIP("hardware counters are unavailable");
+    }
+
+    const auto before = p->read();
+    opened.count_down();
+    done.wait();
+    const auto after = p->read();
+
+    // the waiting main thread runs only a few instructions of its own
+    REQUIRE(after[perf_counters::instructions] - before[perf_counters::instructions] >
+            1000000);
+}
@@ -0,0 +1,639 @@
+#include "profiler.hpp"
+#include "memory_tracker.hpp"
+#include "perf_counters.hpp"
+
+#include "temporal/step_controller.hpp"
+#include "work.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+#include <sol/sol.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std::literals;
+
+namespace ccs
+{
+
+namespace fs = std::filesystem;
+
+namespace
+{
+using clock = std::chrono::steady_clock;
+
+struct timing {
+    std::int64_t count;
+    double seconds;
+    // regions only
+    work w;
+    perf_counters::values hw;
+
+    timing& operator+=(const timing& o)
+    {
+        count += o.count;
+        seconds += o.seconds;
+        w += o.w;
+        for (int i = 0; i < perf_counters::n; ++i) hw[i] += o.hw[i];
+        return *this;
+    }
+};
+
+struct memory {
+    std::int64_t count; // allocations in the interval
+    std::int64_t bytes; // bytes allocated in the interval
+    std::int64_t live;  // bytes currently allocated
+    std::int64_t peak;  // largest `live` in the interval
+};
+
+// lookups with the const char* Kokkos hands us do not build a std::string
+struct name_hash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const
+    {
+        return std::hash<std::string_view>{}(s);
+    }
+};
+
+template <typename T>
+using name_map = std::unordered_map<std::string, T, name_hash, std::equal_to<>>;
+
+template <typename T>
+T& entry(name_map<T>& m, std::string_view name)
+{
+    auto it = m.find(name);
+    if (it == m.end()) it = m.emplace(std::string{name}, T{}).first;
+    return it->second;
+}
+
+// Times of the regions and kernels launched by one thread.  Only the owner
+// updates them; the lock is contended only while write() merges them.  Map
+// values are never erased while a profiler is installed so the pointers of the
+// open regions and kernels stay valid.
+struct thread_counts {
+    std::mutex m;
+    name_map<timing> regions;
+    name_map<timing> kernels;
+};
+
+// Regions and kernels open on this thread
+struct open_region {
+    timing* t;
+    clock::time_point begin;
+    perf_counters::values hw;
+};
+thread_local std::vector<open_region> open_regions;
+thread_local std::vector<std::pair<timing*, clock::time_point>> open_kernels;
+
+std::string csv_quote(std::string_view s)
+{
+    std::string r{"\""};
+    for (auto c : s) {
+        if (c == '"') r += '"';
+        r += c;
+    }
+    return r += '"';
+}
+
+std::string json_quote(std::string_view s)
+{
+    std::string r{"\""};
+    for (auto c : s) {
+        switch (c) {
+        case '"':
+            r += "\\\"";
+            break;
+        case '\\':
+            r += "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                r += fmt::format("\\u{:04x}", static_cast<int>(c));
+            else
+                r += c;
+        }
+    }
+    return r += '"';
+}
+
+bool used(const timing& t) { return t.count > 0; }
+
+bool used(const memory& e) { return e.count > 0 || e.live > 0; }
+
+// entries touched in the interval, by name
+template <typename T>
+std::vector<std::pair<std::string_view, T>> sorted(const name_map<T>& m)
+{
+    std::vector<std::pair<std::string_view, T>> r{};
+    for (auto&& [k, v] : m)
+        if (used(v)) r.emplace_back(k, v);
+    std::ranges::sort(r, {}, [](auto&& p) { return p.first; });
+    return r;
+}
+} // namespace
+
+struct profiler::state {
+    std::string filename;
+    int cadence;
+    format fmt;
+    logs logger;
+
+    bool counters;
+    machine peaks;
+    std::optional<perf_counters> hw;
+    // counts of every thread at the last write
+    perf_counters::values hw_written{};
+
+    // guards the list of threads and the spaces.  Allocations are rare and
+    // their peak needs the live bytes of every thread, so they share it.
+    std::mutex m;
+    std::vector<std::unique_ptr<thread_counts>> threads;
+    name_map<memory> spaces;
+    // regions over the whole session, for the roofline
+    name_map<timing> totals;
+
+    // step and time of the last operator() call
+    int step = 0;
+    real time = 0;
+    std::atomic<bool> recorded = false;
+    bool opened = false;
+};
+
+namespace
+{
+profiler::state* active = nullptr;
+// bumped by every install so a thread knows its counts are from an older session
+std::uint64_t installs = 0;
+
+struct thread_slot {
+    std::uint64_t install = 0;
+    thread_counts* counts = nullptr;
+};
+thread_local thread_slot slot;
+
+// The counts of the calling thread, registered with the active profiler on its
+// first callback of the session
+thread_counts& counts()
+{
+    if (slot.install != installs) {
+        std::scoped_lock lock{active->m};
+        slot = {installs,
+                active->threads.emplace_back(std::make_unique<thread_counts>()).get()};
+        open_regions.clear();
+        open_kernels.clear();
+    }
+    return *slot.counts;
+}
+
+void mark_recorded()
+{
+    if (!active->recorded.load(std::memory_order_relaxed))
+        active->recorded.store(true, std::memory_order_relaxed);
+}
+
+// regions read the group of every thread, since the pool threads run their kernels
+perf_counters::values read_counters()
+{
+    return active->hw ? active->hw->read() : perf_counters::values{};
+}
+
+void push_region(const char* name)
+{
+    const auto hw = read_counters();
+    auto& c = counts();
+    std::scoped_lock lock{c.m};
+    open_regions.push_back({&entry(c.regions, name), clock::now(), hw});
+    mark_recorded();
+}
+
+void pop_region()
+{
+    auto& c = counts();
+    if (open_regions.empty()) return;
+    const auto end = clock::now();
+    const auto hw = read_counters();
+    auto r = open_regions.back();
+    open_regions.pop_back();
+
+    std::scoped_lock lock{c.m};
+    ++r.t->count;
+    r.t->seconds += std::chrono::duration<double>(end - r.begin).count();
+    for (int i = 0; i < perf_counters::n; ++i) r.t->hw[i] += hw[i] - r.hw[i];
+}
+
+// work is inclusive like the region times
+void add_work(const work& w)
+{
+    auto& c = counts();
+    std::scoped_lock lock{c.m};
+    for (auto&& r : open_regions) r.t->w += w;
+}
+
+void begin_kernel(const char* name, const std::uint32_t, std::uint64_t* kernel_id)
+{
+    *kernel_id = 0;
+    auto& c = counts();
+    std::scoped_lock lock{c.m};
+    open_kernels.emplace_back(&entry(c.kernels, name), clock::now());
+    mark_recorded();
+}
+
+void end_kernel(const std::uint64_t)
+{
+    auto& c = counts();
+    if (open_kernels.empty()) return;
+    const auto end = clock::now();
+    auto [t, begin] = open_kernels.back();
+    open_kernels.pop_back();
+
+    std::scoped_lock lock{c.m};
+    ++t->count;
+    t->seconds += std::chrono::duration<double>(end - begin).count();
+}
+
+// views are also charged to their subsystem when a memory_tracker is installed
+void allocate(const Kokkos::Tools::SpaceHandle space,
+              const char* label,
+              const void* ptr,
+              const std::uint64_t size)
+{
+    memory_tracker::view_allocated(label, ptr, size);
+    std::scoped_lock lock{active->m};
+    auto& e = entry(active->spaces, space.name);
+    ++e.count;
+    e.bytes += size;
+    e.live += size;
+    e.peak = std::max(e.peak, e.live);
+    mark_recorded();
+}
+
+void deallocate(const Kokkos::Tools::SpaceHandle space,
+                const char*,
+                const void* ptr,
+                const std::uint64_t size)
+{
+    memory_tracker::view_deallocated(ptr, size);
+    std::scoped_lock lock{active->m};
+    entry(active->spaces, space.name).live -= size;
+}
+} // namespace
+
+profiler::profiler() = default;
+
+profiler::profiler(std::string filename,
+                   int cadence,
+                   format fmt,
+                   const logs& logger,
+                   bool counters,
+                   machine peaks)
+    : s{new state{MOVE(filename), cadence, fmt, logger, counters, peaks}}
+{
+}
+
+profiler::profiler(profiler&&) noexcept = default;
+profiler& profiler::operator=(profiler&&) noexcept = default;
+profiler::~profiler() = default;
+
+void profiler::install()
+{
+    if (!s) return;
+
+    // an external tool loaded through KOKKOS_TOOLS_LIBS keeps its callbacks.  The
+    // memory tracker's are taken over and given back by uninstall.
+    if (Kokkos::Tools::profileLibraryLoaded() && !memory_tracker::active()) {
+        s->logger(spdlog::level::warn,
+                  "a Kokkos tool is already loaded, in-process profiling is disabled");
+        s.reset();
+        return;
+    }
+
+    // opened now so the Kokkos thread pool is counted
+    if (s->counters && !s->hw) {
+        s->hw = perf_counters::open();
+        if (!s->hw)
+            s->logger(spdlog::level::warn,
+                      "hardware counters are unavailable, check perf_event_paranoid");
+    }
+
+    if (s->hw) s->hw_written = s->hw->read();
+
+    active = s.get();
+    ++installs;
+
+    namespace kt = Kokkos::Tools::Experimental;
+    kt::set_push_region_callback(push_region);
+    kt::set_pop_region_callback(pop_region);
+    kt::set_begin_parallel_for_callback(begin_kernel);
+    kt::set_end_parallel_for_callback(end_kernel);
+    kt::set_begin_parallel_reduce_callback(begin_kernel);
+    kt::set_end_parallel_reduce_callback(end_kernel);
+    kt::set_begin_parallel_scan_callback(begin_kernel);
+    kt::set_end_parallel_scan_callback(end_kernel);
+    kt::set_allocate_data_callback(allocate);
+    kt::set_deallocate_data_callback(deallocate);
+    work_sink = add_work;
+}
+
+void profiler::uninstall()
+{
+    if (!s || active != s.get()) return;
+
+    namespace kt = Kokkos::Tools::Experimental;
+    kt::set_push_region_callback(nullptr);
+    kt::set_pop_region_callback(nullptr);
+    kt::set_begin_parallel_for_callback(nullptr);
+    kt::set_end_parallel_for_callback(nullptr);
+    kt::set_begin_parallel_reduce_callback(nullptr);
+    kt::set_end_parallel_reduce_callback(nullptr);
+    kt::set_begin_parallel_scan_callback(nullptr);
+    kt::set_end_parallel_scan_callback(nullptr);
+    kt::set_allocate_data_callback(nullptr);
+    kt::set_deallocate_data_callback(nullptr);
+    memory_tracker::restore_callbacks();
+    work_sink = nullptr;
+
+    active = nullptr;
+    open_regions.clear();
+    open_kernels.clear();
+    slot = {};
+}
+
+profiler::session::session(profiler& p) : p{&p} { p.install(); }
+
+profiler::session::~session()
+{
+    if (p->s && p->s->recorded) p->write();
+    p->roofline();
+    p->uninstall();
+}
+
+void profiler::operator()(const step_controller& controller)
+{
+    if (!s) return;
+
+    s->step = controller.simulation_step();
+    s->time = controller.simulation_time();
+    if (s->step % s->cadence == 0) write();
+}
+
+void profiler::write()
+{
+    if (!s) return;
+
+    std::scoped_lock lock{s->m};
+    s->recorded = false;
+
+    // merge the threads' counts, which restart for the next interval
+    name_map<timing> region_sums{};
+    name_map<timing> kernel_sums{};
+    for (auto&& c : s->threads) {
+        std::scoped_lock thread_lock{c->m};
+        for (auto&& [sums, times] :
+             {std::pair{&region_sums, &c->regions}, std::pair{&kernel_sums, &c->kernels}})
+            for (auto&& [k, t] : *times) {
+                if (!used(t)) continue;
+                entry(*sums, k) += t;
+                t = {};
+            }
+    }
+
+    if (!s->opened) {
+        if (auto dir = fs::path{s->filename}.parent_path(); !dir.empty())
+            fs::create_directories(dir);
+    }
+    std::ofstream o{s->filename, s->opened ? std::ios::app : std::ios::trunc};
+
+    const auto regions = sorted(region_sums);
+    const auto kernels = sorted(kernel_sums);
+    const auto spaces = sorted(s->spaces);
+
+    // every thread's counts over the interval
+    perf_counters::values process{};
+    if (s->hw) {
+        const auto hw = s->hw->read();
+        for (int i = 0; i < perf_counters::n; ++i) process[i] = hw[i] - s->hw_written[i];
+        s->hw_written = hw;
+    }
+
+    if (s->fmt == format::csv) {
+        if (!s->opened)
+            o << fmt::format("Step,Time,Kind,Name,Count,Seconds,Bytes,Peak,Flops,"
+                             "Traffic,{}\n",
+                             fmt::join(perf_counters::names, ","));
+
+        // kernels carry no work or counters
+        for (auto&& [kind, list] :
+             {std::pair{"region", &regions}, std::pair{"kernel", &kernels}})
+            for (auto&& [name, t] : *list)
+                o << fmt::format("{},{},{},{},{},{},0,0,{},{},{}\n",
+                                 s->step,
+                                 s->time,
+                                 kind,
+                                 csv_quote(name),
+                                 t.count,
+                                 t.seconds,
+                                 t.w.flops,
+                                 t.w.bytes,
+                                 fmt::join(t.hw, ","));
+        for (auto&& [name, e] : spaces)
+            o << fmt::format("{},{},memory,{},{},0,{},{},0,0,{}\n",
+                             s->step,
+                             s->time,
+                             csv_quote(name),
+                             e.count,
+                             e.bytes,
+                             e.peak,
+                             fmt::join(perf_counters::values{}, ","));
+        if (s->hw)
+            o << fmt::format("{},{},counters,\"process\",0,0,0,0,0,0,{}\n",
+                             s->step,
+                             s->time,
+                             fmt::join(process, ","));
+    } else {
+        // one JSON object per line
+        auto timings = [](auto&& list, bool region) {
+            std::string r{};
+            for (auto&& [name, t] : list) {
+                r += fmt::format("{}{{\"name\":{},\"count\":{},\"seconds\":{}",
+                                 r.empty() ? "" : ",",
+                                 json_quote(name),
+                                 t.count,
+                                 t.seconds);
+                if (region)
+                    r += fmt::format(",\"flops\":{},\"traffic\":{},\"cycles\":{},"
+                                     "\"instructions\":{},\"llc_references\":{},"
+                                     "\"llc_misses\":{}",
+                                     t.w.flops,
+                                     t.w.bytes,
+                                     t.hw[perf_counters::cycles],
+                                     t.hw[perf_counters::instructions],
+                                     t.hw[perf_counters::llc_references],
+                                     t.hw[perf_counters::llc_misses]);
+                r += '}';
+            }
+            return r;
+        };
+        std::string mem{};
+        for (auto&& [name, e] : spaces)
+            mem += fmt::format(
+                "{}{{\"space\":{},\"count\":{},\"bytes\":{},\"peak\":{}}}",
+                mem.empty() ? "" : ",",
+                json_quote(name),
+                e.count,
+                e.bytes,
+                e.peak);
+
+        std::string counts{};
+        if (s->hw)
+            counts = fmt::format(",\"counters\":{{\"cycles\":{},\"instructions\":{},"
+                                 "\"llc_references\":{},\"llc_misses\":{}}}",
+                                 process[perf_counters::cycles],
+                                 process[perf_counters::instructions],
+                                 process[perf_counters::llc_references],
+                                 process[perf_counters::llc_misses]);
+
+        o << fmt::format("{{\"step\":{},\"time\":{},\"regions\":[{}],\"kernels\":[{}],"
+                         "\"memory\":[{}]{}}}\n",
+                         s->step,
+                         s->time,
+                         timings(regions, true),
+                         timings(kernels, false),
+                         mem,
+                         counts);
+    }
+
+    // start the next interval
+    for (auto&& [k, t] : region_sums) entry(s->totals, k) += t;
+    for (auto&& [k, e] : s->spaces)
+        e = {0, 0, e.live, e.live};
+    s->opened = true;
+}
+
+void profiler::roofline() const
+{
+    if (!s) return;
+
+    std::scoped_lock lock{s->m};
+
+    // regions that did work, the longest first
+    auto regions = sorted(s->totals);
+    std::erase_if(regions, [](auto&& r) { return r.second.w.bytes == 0; });
+    if (regions.empty()) return;
+    std::ranges::sort(regions, std::ranges::greater{}, [](auto&& r) {
+        return r.second.seconds;
+    });
+
+    // a last-level miss moves one cache line
+    constexpr real line = 64;
+    const real ridge = s->peaks.gbs > 0 ? s->peaks.gflops / s->peaks.gbs : 0;
+
+    std::ofstream o{fs::path{s->filename}.replace_filename("roofline.csv")};
+    o << "Region,Count,Seconds,GFlops,GBs,Intensity,IPC,LLCMissGBs,Bound,"
+         "PctAttainable\n";
+
+    s->logger(spdlog::level::info,
+              "{:<36} {:>10} {:>9} {:>9} {:>9} {:>6} {:>6}",
+              "roofline region",
+              "seconds",
+              "GFLOP/s",
+              "GB/s",
+              "flop/B",
+              "IPC",
+              "bound");
+    for (auto&& [name, t] : regions) {
+        const auto& hw = t.hw;
+        const real gflops = t.w.flops / t.seconds * 1e-9;
+        const real gbs = t.w.bytes / t.seconds * 1e-9;
+        const real intensity = t.w.flops / t.w.bytes;
+        const real ipc = hw[perf_counters::cycles] > 0
+                             ? (real)hw[perf_counters::instructions] /
+                                   hw[perf_counters::cycles]
+                             : 0;
+        const real miss_gbs = hw[perf_counters::llc_misses] * line / t.seconds * 1e-9;
+
+        // attainable = min(peak flops, intensity * peak bandwidth)
+        std::string bound{"-"};
+        real pct = 0;
+        if (s->peaks.gflops > 0 && s->peaks.gbs > 0) {
+            bound = intensity < ridge ? "memory" : "compute";
+            pct = 100 * gflops / std::min(s->peaks.gflops, intensity * s->peaks.gbs);
+        }
+
+        o << fmt::format("{},{},{},{},{},{},{},{},{},{}\n",
+                         csv_quote(name),
+                         t.count,
+                         t.seconds,
+                         gflops,
+                         gbs,
+                         intensity,
+                         ipc,
+                         miss_gbs,
+                         bound,
+                         pct);
+        s->logger(spdlog::level::info,
+                  "{:<36} {:>10.4f} {:>9.3f} {:>9.3f} {:>9.3f} {:>6.2f} {:>6}",
+                  name,
+                  t.seconds,
+                  gflops,
+                  gbs,
+                  intensity,
+                  ipc,
+                  bound);
+    }
+}
+
+std::optional<profiler> profiler::from_lua(const sol::table& tbl,
+                                           const std::string& logging_dir,
+                                           const logs& logger)
+{
+    auto prof = tbl["profiling"];
+    if (!prof.valid()) return profiler{};
+
+    int cadence = prof["cadence"].get_or(1);
+    std::string fmt_name = prof["format"].get_or("csv"s);
+    bool counters = prof["counters"].get_or(false);
+    machine peaks{prof["peak_gflops"].get_or(0.0), prof["peak_gbs"].get_or(0.0)};
+
+    if (cadence < 1) {
+        logger(spdlog::level::err, "profiling.cadence must be positive");
+        return std::nullopt;
+    }
+
+    if (peaks.gflops < 0 || peaks.gbs < 0) {
+        logger(spdlog::level::err, "profiling.peak_gflops and peak_gbs must be non-negative");
+        return std::nullopt;
+    }
+
+    format f;
+    if (fmt_name == "csv") {
+        f = format::csv;
+    } else if (fmt_name == "json") {
+        f = format::json;
+    } else {
+        logger(spdlog::level::err, "profiling.format must be 'csv' or 'json'");
+        return std::nullopt;
+    }
+
+    auto filename = fs::path{logging_dir} / ("profile."s + fmt_name);
+    logger(spdlog::level::info,
+           "profiling every {} steps to {}",
+           cadence,
+           filename.string());
+
+    return profiler{filename.string(), cadence, f, logger, counters, peaks};
+}
+
+} // namespace ccs
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "logging.hpp"
+#include "types.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <sol/forward.hpp>
+
+namespace ccs
+{
+// Forward decls
+class step_controller;
+
+//
+// In-process replacement for the kokkos-tools kernel timer.  While a session is
+// alive the Kokkos Tools callbacks aggregate inclusive region times, kernel
+// times and launch counts, and the bytes allocated in each memory space.  Every
+// `cadence` steps the totals since the previous write are appended to the
+// profile file and a new interval starts.
+//
+// Regions are also charged the work (flops and compulsory bytes) reported by
+// the matvecs run inside them and, with counters enabled, the hardware counts
+// of every thread of the process while they were open, so the pool threads
+// running their kernels are included.  Each write adds the counts of every
+// thread over the interval.  When the session ends, roofline.csv next to the profile
+// file lists the achieved GFLOP/s and GB/s of every region that did work
+// against the machine peaks.
+//
+// A default constructed profiler is disabled: it installs no callbacks, so a run
+// without a `profiling` table pays nothing beyond Kokkos' own null checks.
+//
+class profiler
+{
+public:
+    enum class format { csv, json };
+
+    // Peak GFLOP/s and GB/s of the machine for the roofline; 0 if unknown
+    struct machine {
+        real gflops;
+        real gbs;
+    };
+
+    // the counters, defined in profiler.cpp
+    struct state;
+
+private:
+    std::unique_ptr<state> s;
+
+    void install();
+    void uninstall();
+    void roofline() const;
+
+public:
+    profiler();
+    profiler(std::string filename,
+             int cadence,
+             format fmt,
+             const logs& = {},
+             bool counters = false,
+             machine peaks = {});
+
+    profiler(profiler&&) noexcept;
+    profiler& operator=(profiler&&) noexcept;
+    ~profiler();
+
+    operator bool() const { return !!s; }
+
+    // Callbacks are installed for the lifetime of a session.  Ending it writes
+    // whatever was recorded since the last write, then the roofline summary.
+    class session
+    {
+        profiler* p;
+
+    public:
+        explicit session(profiler&);
+        ~session();
+
+        session(const session&) = delete;
+        session& operator=(const session&) = delete;
+    };
+
+    session start() { return session{*this}; }
+
+    // Note the current step and write the interval when the step is a multiple
+    // of the cadence
+    void operator()(const step_controller&);
+
+    // Write the interval now, labelled with the last step seen
+    void write();
+
+    static std::optional<profiler>
+    from_lua(const sol::table&, const std::string& logging_dir, const logs& = {});
+};
+
+} // namespace ccs
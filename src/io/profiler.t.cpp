@@ -0,0 +1,247 @@
+#include "profiler.hpp"
+#include "kokkos_types.hpp"
+#include "temporal/step_controller.hpp"
+#include "work.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sol/sol.hpp>
+
+using namespace ccs;
+namespace fs = std::filesystem;
+
+// Custom main: Kokkos must be initialized before any test allocates Views.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+namespace
+{
+// one region holding an allocation and a kernel doing 10 flops on 20 bytes
+void step()
+{
+    Kokkos::Profiling::ScopedRegion region("test::step");
+    device_view<real*> v("v", 100);
+    report_work({10, 20});
+    index_for("test::fill", 100, [=](auto i) { v(i) = i; });
+    Kokkos::fence();
+}
+
+// the comma separated fields of the first line starting with prefix
+std::vector<std::string> row(const std::vector<std::string>& v, const std::string& prefix)
+{
+    std::vector<std::string> r{};
+    auto it = std::ranges::find_if(v, [&](auto&& l) { return l.starts_with(prefix); });
+    if (it == v.end()) return r;
+
+    std::string f{};
+    for (auto c : *it) {
+        if (c == ',') {
+            r.push_back(f);
+            f.clear();
+        } else {
+            f += c;
+        }
+    }
+    r.push_back(f);
+    return r;
+}
+
+std::vector<std::string> lines(const fs::path& p)
+{
+    std::ifstream f{p};
+    std::vector<std::string> r{};
+    for (std::string l; std::getline(f, l);)
+        r.push_back(l);
+    return r;
+}
+
+bool contains(const std::vector<std::string>& v, const std::string& s)
+{
+    return std::ranges::any_of(
+        v, [&s](auto&& l) { return l.find(s) != std::string::npos; });
+}
+} // namespace
+
+TEST_CASE("profiler - disabled")
+{
+    profiler prof{};
+    REQUIRE(!prof);
+
+    auto session = prof.start();
+    REQUIRE(!Kokkos::Tools::profileLibraryLoaded());
+    step();
+}
+
+TEST_CASE("profiler - csv")
+{
+    const auto dir = fs::temp_directory_path() / "shoccs_profiler_csv";
+    fs::remove_all(dir);
+    const auto file = dir / "profile.csv";
+
+    {
+        profiler prof{file.string(), 2, profiler::format::csv};
+        REQUIRE(!!prof);
+        step_controller controller{bounded<int>{10}, bounded<real>{1.0}, 1.0, 1.0, 1e-6};
+
+        auto session = prof.start();
+        REQUIRE(Kokkos::Tools::profileLibraryLoaded());
+
+        for (int i = 0; i < 3; ++i) {
+            step();
+            controller.advance(0.1);
+            prof(controller);
+        }
+    }
+    REQUIRE(!Kokkos::Tools::profileLibraryLoaded());
+
+    auto l = lines(file);
+    REQUIRE(l.size() > 0);
+    REQUIRE(l[0] == "Step,Time,Kind,Name,Count,Seconds,Bytes,Peak,Flops,Traffic,Cycles,"
+                    "Instructions,LLCReferences,LLCMisses");
+
+    // two steps in the first interval, the last one written when the session ends
+    REQUIRE(contains(l, "2,0.2,region,\"test::step\",2,"));
+    REQUIRE(contains(l, "2,0.2,kernel,\"test::fill\",2,"));
+    REQUIRE(contains(l, ",memory,"));
+    REQUIRE(contains(l, "3,0.30000000000000004,region,\"test::step\",1,"));
+    REQUIRE(contains(l, "3,0.30000000000000004,kernel,\"test::fill\",1,"));
+
+    // reported work is charged to the enclosing region
+    auto r = row(l, "2,0.2,region,\"test::step\"");
+    REQUIRE(r.size() == 14);
+    REQUIRE(r[8] == "20");
+    REQUIRE(r[9] == "40");
+
+    // without machine peaks the roofline leaves the bound open
+    auto roof = lines(dir / "roofline.csv");
+    REQUIRE(roof[0] == "Region,Count,Seconds,GFlops,GBs,Intensity,IPC,LLCMissGBs,Bound,"
+                       "PctAttainable");
+    r = row(roof, "\"test::step\"");
+    REQUIRE(r.size() == 10);
+    REQUIRE(r[1] == "3");
+    REQUIRE(r[5] == "0.5");
+    REQUIRE(r[8] == "-");
+}
+
+TEST_CASE("profiler - roofline")
+{
+    const auto dir = fs::temp_directory_path() / "shoccs_profiler_roofline";
+    fs::remove_all(dir);
+
+    {
+        // ridge point at 2 flop/B
+        profiler prof{
+            (dir / "profile.csv").string(), 1, profiler::format::csv, {}, false, {10, 5}};
+        auto session = prof.start();
+        step();
+    }
+
+    auto r = row(lines(dir / "roofline.csv"), "\"test::step\"");
+    REQUIRE(r.size() == 10);
+    REQUIRE(r[8] == "memory");
+
+    // achieved GFLOP/s against min(peak, intensity * bandwidth) = 2.5
+    const real seconds = std::stod(r[2]);
+    REQUIRE(std::abs(std::stod(r[9]) - 100 * 10e-9 / seconds / 2.5) < 1e-6);
+}
+
+TEST_CASE("profiler - json")
+{
+    const auto dir = fs::temp_directory_path() / "shoccs_profiler_json";
+    fs::remove_all(dir);
+    const auto file = dir / "profile.json";
+
+    {
+        profiler prof{file.string(), 1, profiler::format::json};
+        step_controller controller{bounded<int>{10}, bounded<real>{1.0}, 1.0, 1.0, 1e-6};
+
+        auto session = prof.start();
+        for (int i = 0; i < 2; ++i) {
+            step();
+            controller.advance(0.5);
+            prof(controller);
+        }
+    }
+
+    auto l = lines(file);
+    REQUIRE(l.size() == 2);
+    REQUIRE(l[0].starts_with("{\"step\":1,\"time\":0.5,\"regions\":["));
+    REQUIRE(contains(l, "{\"name\":\"test::step\",\"count\":1,"));
+    REQUIRE(contains(l, "\"flops\":10,\"traffic\":20,"));
+    REQUIRE(contains(l, "{\"name\":\"test::fill\",\"count\":1,"));
+    REQUIRE(contains(l, "\"memory\":[{\"space\":"));
+}
+
+TEST_CASE("profiler - threads")
+{
+    const auto dir = fs::temp_directory_path() / "shoccs_profiler_threads";
+    fs::remove_all(dir);
+    const auto file = dir / "profile.csv";
+
+    {
+        profiler prof{file.string(), 1, profiler::format::csv};
+        auto session = prof.start();
+
+        // each thread counts on its own until the session writes
+        std::vector<std::jthread> threads{};
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([] {
+                for (int i = 0; i < 5; ++i) {
+                    Kokkos::Profiling::ScopedRegion region("test::thread");
+                    report_work({1, 2});
+                }
+            });
+    }
+
+    auto r = row(lines(file), "0,0,region,\"test::thread\"");
+    REQUIRE(r.size() == 14);
+    REQUIRE(r[4] == "20");
+    REQUIRE(r[8] == "20");
+    REQUIRE(r[9] == "40");
+}
+
+TEST_CASE("profiler - from_lua")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base);
+
+    lua.script("simulation = {}");
+    auto p = profiler::from_lua(lua["simulation"], "logs");
+    REQUIRE(!!p);
+    REQUIRE(!*p);
+
+    lua.script("simulation = { profiling = { cadence = 10, format = 'json' } }");
+    p = profiler::from_lua(lua["simulation"], "logs");
+    REQUIRE(!!p);
+    REQUIRE(!!*p);
+
+    lua.script("simulation = { profiling = {} }");
+    REQUIRE(!!profiler::from_lua(lua["simulation"], "logs"));
+
+    lua.script("simulation = { profiling = { cadence = 0 } }");
+    REQUIRE(!profiler::from_lua(lua["simulation"], "logs"));
+
+    lua.script("simulation = { profiling = { format = 'xml' } }");
+    REQUIRE(!profiler::from_lua(lua["simulation"], "logs"));
+
+    lua.script("simulation = { profiling = { counters = true, peak_gflops = 100, "
+               "peak_gbs = 20 } }");
+    REQUIRE(!!profiler::from_lua(lua["simulation"], "logs"));
+
+    lua.script("simulation = { profiling = { peak_gbs = -1 } }");
+    REQUIRE(!profiler::from_lua(lua["simulation"], "logs"));
+}
@@ -167,7 +167,7 @@ void xdmf::write(int grid_number,
                 file_names,
                 fmt::format("{}", fmt::join(ix.extents, " ")),
                 tp,
-                ix[0] * ix[1] * ix[2]);
+                ix.size());
 
     doc.save_file(xmf_filename.c_str());
 
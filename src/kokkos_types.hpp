@@ -4,6 +4,9 @@
 
 #include "shoccs_config.hpp"
 
+#include <limits>
+#include <utility>
+
 namespace ccs
 {
 
@@ -13,4 +16,53 @@ using memory_space = typename execution_space::memory_space;
 template <typename T>
 using device_view = Kokkos::View<T, memory_space>;
 
+namespace detail
+{
+inline thread_local const execution_space* current_exec_space = nullptr;
+}
+
+// The instance kernels and graphs of the calling thread are launched on: a
+// partition of the host while a scoped_exec_space is alive on the thread (one per
+// run of simulation_multi_run), the default instance otherwise.
+inline execution_space exec_space()
+{
+    return detail::current_exec_space ? *detail::current_exec_space : execution_space{};
+}
+
+// Launch the kernels of this thread on `space` for the life of the scope
+class scoped_exec_space
+{
+    const execution_space* prev;
+
+public:
+    explicit scoped_exec_space(const execution_space& space)
+        : prev{std::exchange(detail::current_exec_space, &space)}
+    {
+    }
+    scoped_exec_space(const scoped_exec_space&) = delete;
+    scoped_exec_space& operator=(const scoped_exec_space&) = delete;
+    ~scoped_exec_space() { detail::current_exec_space = prev; }
+};
+
+// Range policy with an explicit index type
+template <typename I>
+using index_policy = Kokkos::RangePolicy<execution_space, Kokkos::IndexType<I>>;
+
+// True when every index in [0, n) fits in a 32-bit int
+constexpr bool fits_int(integer n) { return n <= std::numeric_limits<int>::max(); }
+
+// parallel_for over [0, n) on exec_space().  Ranges that fit in int keep the
+// 32-bit loop counter of the original kernels; larger fields (beyond 2^31 points)
+// run the same functor with an integer index.  f must therefore accept either, e.g. a
+// lambda taking `auto i`.
+template <typename F>
+void index_for(const char* label, integer n, const F& f)
+{
+    if (fits_int(n))
+        Kokkos::parallel_for(
+            label, index_policy<int>(exec_space(), 0, static_cast<int>(n)), f);
+    else
+        Kokkos::parallel_for(label, index_policy<integer>(exec_space(), 0, n), f);
+}
+
 } // namespace ccs
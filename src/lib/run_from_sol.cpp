@@ -5,7 +5,13 @@
 
 #include <sol/sol.hpp>
 
+#include "simulation/memory_estimate.hpp"
+#include "simulation/multi_run.hpp"
 #include "simulation/simulation_cycle.hpp"
+#include "systems/eigenvalue_sweep.hpp"
+
+#include <ranges>
+#include <string>
 
 namespace ccs
 {
@@ -18,4 +24,48 @@ std::optional<real3> simulation_run(const sol::table& lua)
         return {std::nullopt};
     }
 }
+
+std::optional<std::vector<std::optional<real3>>>
+simulation_multi_run(const sol::table& lua)
+{
+    using namespace std::string_literals;
+
+    bool enable_logging = lua["logging"].get_or(true);
+    std::string logging_dir = enable_logging ? lua["logging_dir"].get_or("logs"s) : ""s;
+    logs l{logging_dir, enable_logging, "builder"};
+
+    auto runs = multi_run::from_lua(lua, l);
+    if (!runs) return std::nullopt;
+
+    return runs->run();
+}
+
+std::optional<std::vector<real>> eigenvalue_sweep_run(const sol::table& lua)
+{
+    using namespace std::string_literals;
+
+    bool enable_logging = lua["logging"].get_or(true);
+    std::string logging_dir = enable_logging ? lua["logging_dir"].get_or("logs"s) : ""s;
+    logs l{logging_dir, enable_logging, "builder"};
+
+    auto sweep = systems::eigenvalue_sweep::from_lua(lua, l);
+    if (!sweep) return std::nullopt;
+
+    auto results = sweep->run();
+    auto v = results | std::views::transform([](auto&& r) { return r.max_eigen; });
+    return std::vector<real>(v.begin(), v.end());
+}
+
+std::optional<std::int64_t> memory_estimate_run(const sol::table& lua)
+{
+    using namespace std::string_literals;
+
+    logs l{lua["logging_dir"].get_or("logs"s), true, "memory"};
+
+    auto est = memory_estimate::from_lua(lua, l);
+    if (!est) return std::nullopt;
+
+    est->log(l);
+    return est->total();
+}
 } // namespace ccs
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
+#include <vector>
 #include <sol/forward.hpp>
 
 #include "shoccs_config.hpp"
@@ -8,4 +10,18 @@
 namespace ccs
 {
 std::optional<real3> simulation_run(const sol::table& lua);
+
+// Run every simulation of simulation.runs concurrently on partitions of the host.
+// Returns the result of each run in order, nullopt for runs that could not be
+// built.
+std::optional<std::vector<std::optional<real3>>>
+simulation_multi_run(const sol::table& lua);
+
+// Run the eigenvalue stability sweep described by simulation.sweep.  Returns the
+// -h * min Re(lambda) value of every (psi case, candidate) pair, case-major.
+std::optional<std::vector<real>> eigenvalue_sweep_run(const sol::table& lua);
+
+// Log the bytes a simulation_run would hold per subsystem, building only the
+// mesh.  Returns the estimated peak.
+std::optional<std::int64_t> memory_estimate_run(const sol::table& lua);
 } // namespace ccs
@@ -0,0 +1,88 @@
+#include "autotuner.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace ccs::matrix
+{
+
+namespace fs = std::filesystem;
+
+// One entry per line: hardware, kernel shape and the configuration, separated
+// by tabs.  Lines that do not parse are dropped.
+autotuner::autotuner(std::string filename, int repeats)
+    : filename{std::move(filename)}, hw{hardware()}, repeats{repeats}
+{
+    if (this->filename.empty()) return;
+
+    std::ifstream f{this->filename};
+    for (std::string l; std::getline(f, l);) {
+        const auto a = l.find('\t');
+        const auto b = a == std::string::npos ? a : l.find('\t', a + 1);
+        if (b == std::string::npos) continue;
+
+        launch_config c{};
+        std::istringstream s{l.substr(b + 1)};
+        if (s >> c.team_size >> c.vector_len >> c.chunk) cache[l.substr(0, b)] = c;
+    }
+}
+
+autotuner::autotuner(autotuner&& other) noexcept
+    : filename{std::move(other.filename)},
+      hw{std::move(other.hw)},
+      repeats{std::exchange(other.repeats, 0)},
+      cache{std::move(other.cache)},
+      hits_{other.hits_},
+      tuned_{other.tuned_},
+      dirty{std::exchange(other.dirty, false)}
+{
+}
+
+autotuner& autotuner::operator=(autotuner&& other) noexcept
+{
+    std::swap(filename, other.filename);
+    std::swap(hw, other.hw);
+    std::swap(repeats, other.repeats);
+    std::swap(cache, other.cache);
+    std::swap(hits_, other.hits_);
+    std::swap(tuned_, other.tuned_);
+    std::swap(dirty, other.dirty);
+    return *this;
+}
+
+autotuner::~autotuner()
+{
+    if (dirty) save();
+}
+
+std::string autotuner::hardware()
+{
+    std::string model = "unknown";
+    std::ifstream f{"/proc/cpuinfo"};
+    for (std::string l; std::getline(f, l);) {
+        if (!l.starts_with("model name")) continue;
+        if (auto p = l.find(": "); p != std::string::npos) model = l.substr(p + 2);
+        break;
+    }
+    return model + '/' + execution_space::name() + '/' +
+           std::to_string(execution_space().concurrency());
+}
+
+void autotuner::save()
+{
+    dirty = false;
+    if (filename.empty()) return;
+
+    const auto p = fs::path{filename};
+    if (p.has_parent_path()) fs::create_directories(p.parent_path());
+
+    std::ofstream f{p};
+    for (auto&& [k, c] : cache)
+        f << k << '\t' << c.team_size << ' ' << c.vector_len << ' ' << c.chunk << '\n';
+}
+
+} // namespace ccs::matrix
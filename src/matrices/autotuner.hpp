@@ -0,0 +1,112 @@
+#pragma once
+
+#include "kokkos_types.hpp"
+#include "types.hpp"
+
+#include <Kokkos_Timer.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <limits>
+#include <map>
+#include <span>
+#include <string>
+
+namespace ccs::matrix
+{
+
+// Launch shape of a matvec kernel.  A team_size of 0 is Kokkos::AUTO and a chunk
+// of 0 the default chunk size of a RangePolicy.  The default is the shape the
+// kernels used before tuning existed.
+struct launch_config {
+    int team_size = 0;
+    int vector_len = 8;
+    int chunk = 0;
+
+    auto operator<=>(const launch_config&) const = default;
+};
+
+//
+// Picks the launch shape of each matvec kernel by timing a set of candidates on
+// scratch buffers the first time a kernel shape is seen.  The winners are kept
+// per hardware and kernel shape in a plain text cache file, so later runs on the
+// same machine and mesh skip the timing.  The hardware key is the CPU model,
+// the Kokkos host backend and its concurrency, so one file can be shared by
+// the nodes of a heterogeneous cluster.
+//
+// A default constructed autotuner is disabled and the matrices keep their
+// default launch_config.
+//
+class autotuner
+{
+    std::string filename;
+    std::string hw;
+    int repeats = 0;
+    // "<hardware>\t<kernel shape>" -> winner
+    std::map<std::string, launch_config> cache;
+    int hits_ = 0;
+    int tuned_ = 0;
+    bool dirty = false;
+
+public:
+    autotuner() = default;
+    // An empty filename tunes without persisting the results
+    explicit autotuner(std::string filename, int repeats = 5);
+
+    autotuner(autotuner&&) noexcept;
+    autotuner& operator=(autotuner&&) noexcept;
+    // saves the cache if anything was tuned
+    ~autotuner();
+
+    operator bool() const { return repeats > 0; }
+
+    // e.g. "AMD EPYC 7763 64-Core Processor/OpenMP/128"
+    static std::string hardware();
+
+    // The configuration for the kernel shape `key`: the cached winner, or else
+    // the candidate with the least time over `repeats` calls of run(config)
+    // after one warm-up call.  run must leave its outputs in a state it can be
+    // called again from.
+    template <typename F>
+    launch_config
+    operator()(const std::string& key, std::span<const launch_config> candidates, F&& run)
+    {
+        const auto k = hw + '\t' + key;
+        if (auto it = cache.find(k); it != cache.end()) {
+            ++hits_;
+            return it->second;
+        }
+
+        launch_config best = candidates.empty() ? launch_config{} : candidates[0];
+        double best_t = std::numeric_limits<double>::max();
+        for (auto&& c : candidates) {
+            run(c);
+            exec_space().fence("autotuner trial");
+            double t = std::numeric_limits<double>::max();
+            for (int i = 0; i < repeats; ++i) {
+                Kokkos::Timer timer;
+                run(c);
+                exec_space().fence("autotuner trial");
+                t = std::min(t, timer.seconds());
+            }
+            if (t < best_t) {
+                best_t = t;
+                best = c;
+            }
+        }
+
+        cache[k] = best;
+        ++tuned_;
+        dirty = true;
+        return best;
+    }
+
+    // Write every cached entry, including those of other hardware
+    void save();
+
+    // kernel shapes found in the cache and shapes timed in this process
+    int hits() const { return hits_; }
+    int tuned() const { return tuned_; }
+};
+
+} // namespace ccs::matrix
@@ -0,0 +1,157 @@
+#include "autotuner.hpp"
+#include "block.hpp"
+#include "csr.hpp"
+
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "random/random.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+// Custom main: Kokkos must be initialized before View construction.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+using namespace ccs;
+using Catch::Matchers::Approx;
+using T = std::vector<real>;
+namespace fs = std::filesystem;
+
+namespace
+{
+T random_vec(integer n)
+{
+    T v(n);
+    std::generate_n(v.begin(), n, []() { return pick(); });
+    return v;
+}
+
+// three strided lines of 16 rows with random closures and a 5 point stencil
+matrix::block make_block()
+{
+    auto bld = matrix::block::builder();
+    for (int l = 0; l < 3; ++l)
+        bld.add_inner_block(16,
+                            l,
+                            l,
+                            3,
+                            matrix::dense{3, 4, random_vec(12)},
+                            matrix::circulant{10, random_vec(5)},
+                            matrix::dense{3, 4, random_vec(12)});
+    return MOVE(bld).to_block();
+}
+
+std::vector<std::string> lines(const fs::path& p)
+{
+    std::ifstream f{p};
+    std::vector<std::string> r{};
+    for (std::string l; std::getline(f, l);)
+        r.push_back(l);
+    return r;
+}
+} // namespace
+
+TEST_CASE("autotuner - disabled")
+{
+    matrix::autotuner tuner{};
+    REQUIRE(!tuner);
+
+    auto A = make_block();
+    A.tune(tuner);
+    REQUIRE(A.launch() == matrix::launch_config{});
+    REQUIRE(tuner.tuned() == 0);
+}
+
+TEST_CASE("autotuner - block")
+{
+    const auto file = fs::temp_directory_path() / "shoccs_autotuner" / "block.cache";
+    fs::remove_all(file.parent_path());
+
+    auto A = make_block();
+    const auto x = random_vec(A.rows());
+    T expected(x.size());
+    A(x, expected);
+
+    matrix::launch_config tuned{};
+    {
+        matrix::autotuner tuner{file.string(), 2};
+        REQUIRE(!!tuner);
+        A.tune(tuner);
+        REQUIRE(tuner.tuned() == 1);
+        REQUIRE(tuner.hits() == 0);
+        tuned = A.launch();
+
+        // any tuned shape computes the same product
+        T b(x.size());
+        A(x, b);
+        REQUIRE_THAT(b, Approx(expected));
+    }
+
+    // written when the tuner goes out of scope
+    auto l = lines(file);
+    REQUIRE(l.size() == 1);
+    REQUIRE(l[0].starts_with(matrix::autotuner::hardware() + "\tblock lines=3 rows=16"));
+
+    // a second run takes the shape from the cache without timing
+    matrix::autotuner tuner{file.string(), 2};
+    auto B = make_block();
+    B.tune(tuner);
+    REQUIRE(tuner.hits() == 1);
+    REQUIRE(tuner.tuned() == 0);
+    REQUIRE(B.launch() == tuned);
+}
+
+TEST_CASE("autotuner - csr")
+{
+    const auto file = fs::temp_directory_path() / "shoccs_autotuner" / "csr.cache";
+    fs::remove_all(file.parent_path());
+    fs::create_directories(file.parent_path());
+    {
+        // entries of other hardware are kept, malformed lines dropped
+        std::ofstream f{file};
+        f << "other cpu/Serial/1\tcsr rows=5 nnz=5\t0 8 64\n";
+        f << "not an entry\n";
+    }
+
+    matrix::csr::builder bld{};
+    for (integer r = 0; r < 100; ++r) {
+        bld.add_point(r, r, pick());
+        bld.add_point(r, (r * 7) % 100, pick());
+    }
+    auto A = bld.to_csr(100);
+
+    const auto x = random_vec(100);
+    T expected(100);
+    A(x, expected);
+
+    {
+        matrix::autotuner tuner{file.string(), 2};
+        A.tune(tuner);
+        REQUIRE(tuner.tuned() == 1);
+
+        T b(100);
+        A(x, b);
+        REQUIRE_THAT(b, Approx(expected));
+    }
+
+    auto l = lines(file);
+    REQUIRE(l.size() == 2);
+    REQUIRE(std::ranges::count_if(l, [](auto&& s) {
+                return s.starts_with("other cpu/Serial/1\tcsr rows=5 nnz=5\t");
+            }) == 1);
+    REQUIRE(std::ranges::count_if(l, [](auto&& s) {
+                return s.starts_with(matrix::autotuner::hardware() +
+                                     "\tcsr rows=100 nnz=");
+            }) == 1);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <cassert>
+
+namespace ccs::matrix
+{
+// The same buffer of up to max_size scalars, e.g. the D buffers of every species
+// in a slot.  Passed by value into kernels so that each matrix coefficient is
+// loaded once and applied to every scalar in the batch.  max_size matches the
+// scalar capacity of sim_registry.
+template <typename T>
+struct batch {
+    static constexpr int max_size = 8;
+
+    T* ptr[max_size] = {};
+    int n = 0;
+
+    void push_back(T* p)
+    {
+        assert(n < max_size);
+        ptr[n++] = p;
+    }
+
+    KOKKOS_INLINE_FUNCTION int size() const { return n; }
+    KOKKOS_INLINE_FUNCTION T* operator[](int k) const { return ptr[k]; }
+};
+
+// One dot product per scalar of a batch, summed over a vector range
+struct batch_dot {
+    real v[batch<real>::max_size] = {};
+
+    KOKKOS_INLINE_FUNCTION batch_dot& operator+=(const batch_dot& o)
+    {
+        for (int k = 0; k < batch<real>::max_size; ++k) v[k] += o.v[k];
+        return *this;
+    }
+};
+
+} // namespace ccs::matrix
+
+namespace Kokkos
+{
+template <>
+struct reduction_identity<ccs::matrix::batch_dot> {
+    KOKKOS_FORCEINLINE_FUNCTION static ccs::matrix::batch_dot sum() { return {}; }
+};
+} // namespace Kokkos
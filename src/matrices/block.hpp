@@ -1,18 +1,76 @@
 #pragma once
 
+#include "autotuner.hpp"
+#include "batch.hpp"
+#include "coefficient_pool.hpp"
 #include "inner_block.hpp"
 #include "inner_block_meta.hpp"
 
 #include "kokkos_types.hpp"
+#include "work.hpp"
 
 #include <Kokkos_Graph.hpp>
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <concepts>
+#include <limits>
+#include <string>
+#include <vector>
 
 namespace ccs::matrix
 {
+// Rows of a block matvec to compute: the closure rows are the dense left and
+// right rows of each line and the interior rows the circulant ones.
+enum class row_part { all, interior, closure };
+
+// Local rows of one line to compute: at most two runs [a, a + na) and
+// [b, b + nb), numbered t = 0 .. count() - 1.
+struct row_runs {
+    int a, na, b, nb;
+
+    KOKKOS_INLINE_FUNCTION int count() const { return na + nb; }
+    KOKKOS_INLINE_FUNCTION int operator[](int t) const
+    {
+        return t < na ? a + t : b + (t - na);
+    }
+};
+
+// Rows of part P of line m whose output index lies in [first, last)
+template <row_part P>
+KOKKOS_INLINE_FUNCTION row_runs
+select_rows(const inner_block_meta& m, integer first, integer last)
+{
+    const int total = m.left_rows + m.interior_rows + m.right_rows;
+    const integer end = m.row_offset + total * m.stride;
+    // output indices are row_offset + row * stride, increasing with the row
+    auto local = [&](integer i) {
+        if (i <= m.row_offset) return 0;
+        if (i >= end) return total;
+        return static_cast<int>((i - m.row_offset + m.stride - 1) / m.stride);
+    };
+    const int lo = local(first);
+    const int hi = local(last);
+
+    row_runs r{0, 0, 0, 0};
+    auto clip = [lo, hi](int a, int b, int& start, int& n) {
+        start = a < lo ? lo : a;
+        const int e = b < hi ? b : hi;
+        n = e > start ? e - start : 0;
+    };
+    const int interior_end = m.left_rows + m.interior_rows;
+    if constexpr (P == row_part::all) {
+        clip(0, total, r.a, r.na);
+    } else if constexpr (P == row_part::interior) {
+        clip(m.left_rows, interior_end, r.a, r.na);
+    } else {
+        clip(0, m.left_rows, r.a, r.na);
+        clip(interior_end, total, r.b, r.nb);
+    }
+    return r;
+}
+
 // Block matrix arising from method-of-lines discretization over whole domain.
 // Due to the requirements of a cut-cell mesh, the InnerBlocks may not be adjacent to
 // eachother.  To simplify construction, a builder class is exposed which computes all
@@ -27,14 +85,32 @@ class block
     device_view<inner_block_meta*> meta_d;
     device_view<real*> coeffs_d;
 
+    // nonzeros and rows of the closure and interior parts, for cost()
+    integer closure_nnz = 0;
+    integer closure_rows = 0;
+    integer interior_nnz = 0;
+    integer interior_rows = 0;
+
+    // launch shape of every matvec kernel, set by tune()
+    launch_config cfg{};
+
+    using team_policy = Kokkos::TeamPolicy<execution_space>;
+
+    static team_policy policy(const execution_space& exec, int n, const launch_config& c)
+    {
+        return c.team_size > 0 ? team_policy(exec, n, c.team_size, c.vector_len)
+                               : team_policy(exec, n, Kokkos::AUTO, c.vector_len);
+    }
+
     void build_device_arrays()
     {
         if (blocks.empty()) return;
 
         const int n = static_cast<int>(blocks.size());
 
-        // First pass: compute total coefficient count and populate host metadata.
-        int total_coeffs = 0;
+        // Populate host metadata.  Coefficients go through a pool so lines with
+        // identical closures and stencils point at the same storage.
+        coefficient_pool pool;
         std::vector<inner_block_meta> host_meta(n);
         for (int i = 0; i < n; ++i) {
             const auto& ib = blocks[i];
@@ -48,49 +124,63 @@ class block
             m.stride = ib.stride();
             m.left_rows = L.rows();
             m.left_cols = L.columns();
-            m.left_coeff_offset = total_coeffs;
-            total_coeffs += L.size();
+            m.left_coeff_offset = pool.insert(L.data());
             m.interior_rows = C.rows();
-            m.interior_coeff_offset = total_coeffs;
+            m.interior_coeff_offset = pool.insert(C.data());
             m.stencil_width = C.size();
-            total_coeffs += C.size();
             m.right_rows = R.rows();
             m.right_cols = R.columns();
-            m.right_coeff_offset = total_coeffs;
+            m.right_coeff_offset = pool.insert(R.data());
             m.right_col_offset = R.col_offset();
-            total_coeffs += R.size();
+
+            closure_nnz += (integer)m.left_rows * m.left_cols +
+                           (integer)m.right_rows * m.right_cols;
+            closure_rows += m.left_rows + m.right_rows;
+            interior_nnz += (integer)m.interior_rows * m.stencil_width;
+            interior_rows += m.interior_rows;
         }
 
         // Allocate device views.
         meta_d = device_view<inner_block_meta*>("block_meta", n);
-        coeffs_d = device_view<real*>("block_coeffs", total_coeffs);
+        coeffs_d = device_view<real*>("block_coeffs", pool.size());
 
-        // Copy metadata to device.
+        // Copy metadata and the pooled coefficients to device.
         auto h_meta = Kokkos::View<const inner_block_meta*, Kokkos::HostSpace,
                                    Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
             host_meta.data(), n);
         Kokkos::deep_copy(meta_d, h_meta);
 
-        // Second pass: copy coefficients into a contiguous host buffer, then to device.
-        std::vector<real> host_coeffs(total_coeffs);
+        auto h_coeffs = Kokkos::View<const real*, Kokkos::HostSpace,
+                                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+            pool.data().data(), pool.size());
+        Kokkos::deep_copy(coeffs_d, h_coeffs);
+
+        // The host copies used by the per-line operators and visitors point into
+        // the pooled table too, releasing the storage of each line
+        const auto table = pool.share();
         for (int i = 0; i < n; ++i) {
-            const auto& ib = blocks[i];
             const auto& m = host_meta[i];
-
-            auto lc = ib.left().data();
-            std::copy(lc.begin(), lc.end(), host_coeffs.begin() + m.left_coeff_offset);
-
-            auto cc = ib.interior_circ().data();
-            std::copy(cc.begin(), cc.end(), host_coeffs.begin() + m.interior_coeff_offset);
-
-            auto rc = ib.right().data();
-            std::copy(rc.begin(), rc.end(), host_coeffs.begin() + m.right_coeff_offset);
+            blocks[i].share(
+                table, m.left_coeff_offset, m.interior_coeff_offset, m.right_coeff_offset);
         }
+    }
 
-        auto h_coeffs = Kokkos::View<const real*, Kokkos::HostSpace,
-                                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
-            host_coeffs.data(), total_coeffs);
-        Kokkos::deep_copy(coeffs_d, h_coeffs);
+    // Shared body of the eager matvecs.
+    template <row_part P = row_part::all, typename Op>
+    void matvec(const execution_space& exec,
+                const real* x_ptr,
+                real* b_ptr,
+                Op op,
+                integer first = 0,
+                integer last = std::numeric_limits<integer>::max()) const
+    {
+        const auto n = num_lines();
+        if (n == 0) return;
+
+        report_work(cost<P>(1, sizeof(real), !std::same_as<Op, eq_t>));
+        Kokkos::parallel_for(policy(exec, n, cfg),
+                             matvec_functor<Op, const real*, P>{
+                                 meta_d, coeffs_d, x_ptr, b_ptr, op, first, last});
     }
 
 public:
@@ -109,18 +199,88 @@ public:
         return b.row_offset() + b.rows() * b.stride();
     }
 
+    // Flops and compulsory memory traffic of a matvec over the rows of part P
+    // with k inputs of `scalar` bytes.  Each x and b value moves once, b twice
+    // when the op reads it back, and the pooled coefficients and line metadata
+    // once per call whatever k is.
+    template <row_part P = row_part::all>
+    work cost(int k = 1, int scalar = sizeof(real), bool read_b = false) const
+    {
+        const integer nnz = P == row_part::closure    ? closure_nnz
+                            : P == row_part::interior ? interior_nnz
+                                                      : closure_nnz + interior_nnz;
+        const integer nrows = P == row_part::closure    ? closure_rows
+                              : P == row_part::interior ? interior_rows
+                                                        : closure_rows + interior_rows;
+        const real tables = (real)meta_d.size() * sizeof(inner_block_meta) +
+                            (real)coeffs_d.size() * sizeof(real);
+        return {2.0 * nnz * k, (real)k * scalar * nrows * (read_b ? 3 : 2) + tables};
+    }
+
+    launch_config launch() const { return cfg; }
+    void launch(const launch_config& c) { cfg = c; }
+
+    // Time the launch shapes of the matvec on scratch buffers, or take them
+    // from the tuner's cache, and use the winner for every later kernel and
+    // graph node.  The shape key is the line count, the mean rows per line, the
+    // stride and the widest stencil or closure.
+    void tune(autotuner& tuner)
+    {
+        const auto n = num_lines();
+        if (!tuner || n == 0) return;
+
+        integer extent = 0;
+        integer width = 0;
+        for (auto&& ib : blocks) {
+            const auto& L = ib.left();
+            const auto& C = ib.interior_circ();
+            const auto& R = ib.right();
+            const auto st = ib.stride();
+            width = std::max({width, L.columns(), C.size(), R.columns()});
+            extent = std::max({extent,
+                               ib.row_offset() + (ib.rows() + C.size() / 2) * st,
+                               ib.col_offset() + L.columns() * st,
+                               R.col_offset() + R.columns() * st});
+        }
+        const auto key = "block lines=" + std::to_string(n) +
+                         " rows=" + std::to_string((closure_rows + interior_rows) / n) +
+                         " stride=" + std::to_string(blocks[0].stride()) +
+                         " width=" + std::to_string(width);
+
+        device_view<real*> x("block_tune_x", extent);
+        device_view<real*> b("block_tune_b", extent);
+        const matvec_functor<eq_t> f{meta_d, coeffs_d, x.data(), b.data(), eq};
+
+        std::vector<launch_config> candidates{launch_config{}};
+        for (int v : {1, 4, 8, 16, 32}) {
+            const int max_team =
+                team_policy(n, Kokkos::AUTO, v).team_size_max(f, Kokkos::ParallelForTag{});
+            for (int t = 0; t <= max_team; t = t ? 2 * t : 1)
+                if (launch_config c{t, v}; c != launch_config{}) candidates.push_back(c);
+        }
+
+        cfg = tuner(key, candidates, [&](const launch_config& c) {
+            Kokkos::parallel_for("block_matvec_tune", policy(exec_space(), n, c), f);
+        });
+    }
+
     const device_view<inner_block_meta*>& metadata_view() const { return meta_d; }
     const device_view<real*>& coefficients_view() const { return coeffs_d; }
     int num_lines() const { return static_cast<int>(blocks.size()); }
 
     // Named functor for the block matvec kernel, shared by operator() and graph_node.
-    template <typename Op>
+    // X is anything indexable by a flat point index: a plain pointer, or an
+    // accessor that evaluates a pointwise function of the field when read.
+    // Only the rows of part P with output index in [first, last) are written.
+    template <typename Op, typename X = const real*, row_part P = row_part::all>
     struct matvec_functor {
         device_view<inner_block_meta*> meta;
         device_view<real*> coeffs;
-        const real* x_ptr;
+        X x_ptr;
         real* b_ptr;
         Op op;
+        integer first = 0;
+        integer last = std::numeric_limits<integer>::max();
 
         using team_policy = Kokkos::TeamPolicy<execution_space>;
         using member_type = typename team_policy::member_type;
@@ -129,12 +289,13 @@ public:
         void operator()(const member_type& team) const
         {
             const auto m = meta(team.league_rank());
-            const int total_rows = m.left_rows + m.interior_rows + m.right_rows;
+            const auto rows = select_rows<P>(m, first, last);
 
             Kokkos::parallel_for(
-                Kokkos::TeamThreadRange(team, total_rows),
-                [&](int local_row) {
-                    int out_idx;
+                Kokkos::TeamThreadRange(team, rows.count()),
+                [&](int t) {
+                    const int local_row = rows[t];
+                    integer out_idx;
                     real dot = 0;
 
                     if (local_row < m.left_rows) {
@@ -171,41 +332,224 @@ public:
                     }
 
                     Kokkos::single(Kokkos::PerThread(team), [&]() {
-                        op(b_ptr[out_idx], dot);
+                        if constexpr (std::invocable<Op, real&, real, integer>)
+                            op(b_ptr[out_idx], dot, out_idx);
+                        else
+                            op(b_ptr[out_idx], dot);
                     });
                 });
         }
     };
 
+    // Batched matvec: b[k] op= A x[k] for every scalar k in the batch.  Each row
+    // walks its coefficients once and applies each to all inputs, so metadata and
+    // coefficient traffic is shared by the whole batch.
+    template <typename Op, row_part P = row_part::all>
+    struct batch_matvec_functor {
+        device_view<inner_block_meta*> meta;
+        device_view<real*> coeffs;
+        batch<const real> x;
+        batch<real> b;
+        Op op;
+        integer first = 0;
+        integer last = std::numeric_limits<integer>::max();
+
+        using team_policy = Kokkos::TeamPolicy<execution_space>;
+        using member_type = typename team_policy::member_type;
+
+        KOKKOS_INLINE_FUNCTION
+        void operator()(const member_type& team) const
+        {
+            const auto m = meta(team.league_rank());
+            const auto rows = select_rows<P>(m, first, last);
+
+            Kokkos::parallel_for(Kokkos::TeamThreadRange(team, rows.count()), [&](int t) {
+                const int local_row = rows[t];
+                // coefficient row start, row length and first column of this row
+                integer out_idx, col0;
+                int c0, nc;
+                if (local_row < m.left_rows) {
+                    int r = local_row;
+                    out_idx = m.row_offset + r * m.stride;
+                    c0 = m.left_coeff_offset + r * m.left_cols;
+                    nc = m.left_cols;
+                    col0 = m.col_offset;
+                } else if (local_row < m.left_rows + m.interior_rows) {
+                    int r = local_row - m.left_rows;
+                    out_idx = m.row_offset + (m.left_rows + r) * m.stride;
+                    c0 = m.interior_coeff_offset;
+                    nc = m.stencil_width;
+                    col0 = out_idx - (m.stencil_width / 2) * m.stride;
+                } else {
+                    int r = local_row - m.left_rows - m.interior_rows;
+                    out_idx = m.row_offset + (m.left_rows + m.interior_rows + r) * m.stride;
+                    c0 = m.right_coeff_offset + r * m.right_cols;
+                    nc = m.right_cols;
+                    col0 = m.right_col_offset;
+                }
+
+                batch_dot dot;
+                Kokkos::parallel_reduce(
+                    Kokkos::ThreadVectorRange(team, nc),
+                    [&](int j, batch_dot& s) {
+                        const real c = coeffs(c0 + j);
+                        const integer col = col0 + j * m.stride;
+                        for (int k = 0; k < x.size(); ++k) s.v[k] += c * x[k][col];
+                    }, dot);
+
+                Kokkos::single(Kokkos::PerThread(team), [&]() {
+                    for (int k = 0; k < b.size(); ++k) op(b[k][out_idx], dot.v[k]);
+                });
+            });
+        }
+    };
+
     template <typename Op = eq_t>
     void operator()(std::span<const real> x, std::span<real> b, Op op = {}) const
     {
         Kokkos::Profiling::ScopedRegion region("block::operator()");
+        matvec(exec_space(), x.data(), b.data(), op);
+    }
+
+    // As above but launched on the given instance, e.g. one partition of the
+    // host space, and without a fence.  Only rows with output index in
+    // [first, last) are written.
+    template <typename Op = eq_t>
+    void operator()(const execution_space& exec,
+                    std::span<const real> x,
+                    std::span<real> b,
+                    Op op = {},
+                    integer first = 0,
+                    integer last = std::numeric_limits<integer>::max()) const
+    {
+        matvec(exec, x.data(), b.data(), op, first, last);
+    }
+
+    // Only the rows of part P, e.g. the closures of lines whose interior rows
+    // were computed elsewhere
+    template <row_part P, typename Op = eq_t>
+    void apply_part(std::span<const real> x, std::span<real> b, Op op = {}) const
+    {
+        Kokkos::Profiling::ScopedRegion region("block::apply_part()");
+        matvec<P>(exec_space(), x.data(), b.data(), op);
+    }
+
+    // Matvec on an accessor input: x[i] is evaluated each time a stencil reads
+    // point i, so a function of the field (e.g. a flux) need not be stored.
+    template <typename X, typename Op = eq_t>
+    void apply(X x, std::span<real> b, Op op = {}) const
+    {
+        Kokkos::Profiling::ScopedRegion region("block::apply()");
         const auto n = num_lines();
         if (n == 0) return;
 
-        constexpr int vector_len = 8;
-        using team_policy = Kokkos::TeamPolicy<execution_space>;
+        report_work(cost(1, sizeof(real), !std::same_as<Op, eq_t>));
+        Kokkos::parallel_for(policy(exec_space(), n, cfg),
+                             matvec_functor<Op, X>{meta_d, coeffs_d, x, b.data(), op});
+    }
 
-        Kokkos::parallel_for(
-            team_policy(n, Kokkos::AUTO, vector_len),
-            matvec_functor<Op>{meta_d, coeffs_d, x.data(), b.data(), op});
+    // Batched form of operator(): b[k] op= A x[k] for all k.
+    template <typename Op = eq_t>
+    void operator()(batch<const real> x, batch<real> b, Op op = {}) const
+    {
+        Kokkos::Profiling::ScopedRegion region("block::operator() batch");
+        assert(x.size() == b.size());
+        const auto n = num_lines();
+        if (n == 0 || x.size() == 0) return;
+
+        report_work(cost(x.size(), sizeof(real), !std::same_as<Op, eq_t>));
+        Kokkos::parallel_for(policy(exec_space(), n, cfg),
+                             batch_matvec_functor<Op>{meta_d, coeffs_d, x, b, op});
     }
 
     // Chain a TeamPolicy graph node that performs the block matvec with the given op.
-    // For empty blocks (0 lines), the node executes zero teams.
-    template <typename NodeType, typename Op = eq_t>
-    auto graph_node(NodeType parent, const real* x_ptr, real* b_ptr, Op op = {}) const
+    // For empty blocks (0 lines), the node executes zero teams.  Nodes for
+    // different parts, or for disjoint [first, last) output ranges, write
+    // disjoint rows and may run concurrently.
+    template <row_part P = row_part::all, typename NodeType, typename Op = eq_t>
+    auto graph_node(NodeType parent,
+                    const real* x_ptr,
+                    real* b_ptr,
+                    Op op = {},
+                    integer first = 0,
+                    integer last = std::numeric_limits<integer>::max()) const
     {
         const auto n = num_lines();
 
-        constexpr int vector_len = 8;
-        using team_policy = Kokkos::TeamPolicy<execution_space>;
+        return parent.then_parallel_for(
+            P == row_part::all        ? "block_matvec"
+            : P == row_part::interior ? "block_matvec_interior"
+                                      : "block_matvec_closure",
+            policy(exec_space(), n, cfg),
+            matvec_functor<Op, const real*, P>{
+                meta_d, coeffs_d, x_ptr, b_ptr, op, first, last});
+    }
+
+    // Batched form of graph_node.
+    template <row_part P = row_part::all, typename NodeType, typename Op = eq_t>
+    auto graph_node(NodeType parent,
+                    batch<const real> x,
+                    batch<real> b,
+                    Op op = {},
+                    integer first = 0,
+                    integer last = std::numeric_limits<integer>::max()) const
+    {
+        assert(x.size() == b.size());
+        const auto n = num_lines();
 
         return parent.then_parallel_for(
-            "block_matvec",
-            team_policy(n, Kokkos::AUTO, vector_len),
-            matvec_functor<Op>{meta_d, coeffs_d, x_ptr, b_ptr, op});
+            P == row_part::all        ? "block_matvec_batch"
+            : P == row_part::interior ? "block_matvec_batch_interior"
+                                      : "block_matvec_batch_closure",
+            policy(exec_space(), n, cfg),
+            batch_matvec_functor<Op, P>{meta_d, coeffs_d, x, b, op, first, last});
+    }
+
+    // f(first, rows, stride) for the circulant rows of every line, whose output
+    // indices are first + r * stride for r < rows
+    template <typename F>
+    void for_each_interior_run(F&& f) const
+    {
+        for (auto&& ib : blocks)
+            if (const integer rows = ib.interior_circ().rows(); rows > 0)
+                f(ib.row_offset() + ib.left().rows() * ib.stride(), rows, ib.stride());
+    }
+
+    // d[i] += A[i][i] for every row of every line.  Row and column indices
+    // follow the matvec kernel.
+    void diagonal(std::span<real> d) const
+    {
+        for (auto&& ib : blocks) {
+            const auto& L = ib.left();
+            const auto& C = ib.interior_circ();
+            const auto& R = ib.right();
+            const auto st = ib.stride();
+
+            auto lc = L.data();
+            for (integer r = 0; r < L.rows(); ++r) {
+                const integer row = ib.row_offset() + r * st;
+                for (integer j = 0; j < L.columns(); ++j)
+                    if (ib.col_offset() + j * st == row) d[row] += lc[r * L.columns() + j];
+            }
+
+            if (C.rows() > 0) {
+                // interior row i reads columns i + (j - w / 2) * stride in the
+                // matvec functors, so its diagonal is coefficient w / 2.  That is
+                // the centre of the stencil only for an odd width 2p + 1.
+                const integer w = C.size();
+                assert(w % 2 == 1);
+                const real c = C.data()[w / 2];
+                for (integer r = 0; r < C.rows(); ++r)
+                    d[ib.row_offset() + (L.rows() + r) * st] += c;
+            }
+
+            auto rc = R.data();
+            for (integer r = 0; r < R.rows(); ++r) {
+                const integer row = ib.row_offset() + (L.rows() + C.rows() + r) * st;
+                for (integer j = 0; j < R.columns(); ++j)
+                    if (R.col_offset() + j * st == row) d[row] += rc[r * R.columns() + j];
+            }
+        }
     }
 
     void visit(visitor& v) const
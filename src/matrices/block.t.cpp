@@ -1,5 +1,6 @@
 #include "block.hpp"
 #include "inner_block_meta.hpp"
+#include "memory.hpp"
 
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_session.hpp>
@@ -170,6 +171,60 @@ TEST_CASE("Random Boundary")
     REQUIRE_THAT(b, Approx(exact));
 }
 
+TEST_CASE("Batched")
+{
+    using T = std::vector<real>;
+
+    auto bld = matrix::block::builder(2);
+    T left_c(20), int_c(5), right_c(6);
+    std::generate_n(left_c.begin(), left_c.size(), g);
+    std::generate_n(int_c.begin(), int_c.size(), g);
+    std::generate_n(right_c.begin(), right_c.size(), g);
+
+    bld.add_inner_block(16,
+                        1,
+                        1,
+                        1,
+                        matrix::dense{4, 5, left_c},
+                        matrix::circulant{10, int_c},
+                        matrix::dense{2, 3, right_c});
+    bld.add_inner_block(16,
+                        21,
+                        21,
+                        1,
+                        matrix::dense{4, 5, left_c},
+                        matrix::circulant{10, int_c},
+                        matrix::dense{2, 3, right_c});
+
+    const auto A = MOVE(bld).to_block();
+    const integer n = A.rows();
+
+    constexpr int nb = 3;
+    std::vector<T> x(nb, T(n)), b(nb, T(n, 0.0)), exact(nb, T(n, 0.0));
+    matrix::batch<const real> xb;
+    matrix::batch<real> bb;
+    for (int k = 0; k < nb; ++k) {
+        std::generate_n(x[k].begin(), n, g);
+        xb.push_back(x[k].data());
+        bb.push_back(b[k].data());
+        A(x[k], exact[k]);
+    }
+
+    A(xb, bb);
+    for (int k = 0; k < nb; ++k) REQUIRE_THAT(b[k], Approx(exact[k]));
+
+    // accumulate through the graph form
+    auto graph = Kokkos::Experimental::create_graph<execution_space>(
+        [&](auto root) { A.graph_node(root, xb, bb, plus_eq); });
+    graph.submit();
+    Kokkos::fence();
+    for (int k = 0; k < nb; ++k) {
+        T exact2(n);
+        std::ranges::transform(exact[k], exact2.begin(), x2);
+        REQUIRE_THAT(b[k], Approx(exact2));
+    }
+}
+
 TEST_CASE("strided")
 {
     // Assume we have some field of values on an XxY (15 x 3) grid with the stride in Y ==
@@ -241,6 +296,59 @@ TEST_CASE("strided")
     }
 }
 
+TEST_CASE("row parts and output ranges")
+{
+    // Three interleaved lines with stride 3, as for x-lines of a 15 x 3 grid, so
+    // every output range cuts across all of them.
+    using T = std::vector<real>;
+
+    T lc(15), ic(5), rc(6);
+    std::generate_n(lc.begin(), lc.size(), g);
+    std::generate_n(ic.begin(), ic.size(), g);
+    std::generate_n(rc.begin(), rc.size(), g);
+
+    auto bld = matrix::block::builder(3);
+    for (integer offset = 0; offset < 3; ++offset)
+        bld.add_inner_block(15,
+                            offset,
+                            offset,
+                            3,
+                            matrix::dense(3, 5, lc),
+                            matrix::circulant(10, ic),
+                            matrix::dense(2, 3, rc));
+    const auto A = MOVE(bld).to_block();
+    const integer n = A.rows();
+
+    T x(n), exact(n);
+    std::generate_n(x.begin(), n, g);
+    A(x, exact);
+
+    // interior and closure rows over two output ranges: four disjoint nodes
+    const integer cut = 17;
+    T b(n, 0.0);
+    auto graph = Kokkos::Experimental::create_graph<execution_space>([&](auto root) {
+        using matrix::row_part;
+        const real* xp = x.data();
+        real* bp = b.data();
+        A.graph_node<row_part::interior>(root, xp, bp, eq, 0, cut);
+        A.graph_node<row_part::closure>(root, xp, bp, eq, 0, cut);
+        A.graph_node<row_part::interior>(root, xp, bp, eq, cut, n);
+        A.graph_node<row_part::closure>(root, xp, bp, eq, cut, n);
+    });
+    graph.submit();
+    Kokkos::fence();
+    REQUIRE_THAT(b, Approx(exact));
+
+    // a range alone leaves the other rows untouched
+    T c(n, -1.0);
+    auto graph2 = Kokkos::Experimental::create_graph<execution_space>([&](auto root) {
+        A.graph_node(root, x.data(), c.data(), eq, cut, n);
+    });
+    graph2.submit();
+    Kokkos::fence();
+    for (integer i = 0; i < n; ++i) REQUIRE(c[i] == (i < cut ? -1.0 : exact[i]));
+}
+
 TEST_CASE("device metadata arrays")
 {
     using T = std::vector<real>;
@@ -281,7 +389,8 @@ TEST_CASE("device metadata arrays")
         host_meta.data(), 2);
     Kokkos::deep_copy(h_meta, meta_view);
 
-    // Expected coefficient sizes per inner_block: 20 (left) + 3 (circ) + 6 (right) = 29
+    // Expected coefficient sizes per inner_block: 20 (left) + 3 (circ) + 6 (right) = 29.
+    // Both lines have the same coefficients so they share one copy.
     const int coeffs_per_block = 20 + 3 + 6;
 
     SECTION("inner_block 0 metadata")
@@ -311,13 +420,13 @@ TEST_CASE("device metadata arrays")
         REQUIRE(m.stride == 1);
         REQUIRE(m.left_rows == 4);
         REQUIRE(m.left_cols == 5);
-        REQUIRE(m.left_coeff_offset == coeffs_per_block);
+        REQUIRE(m.left_coeff_offset == 0);
         REQUIRE(m.interior_rows == 10);
-        REQUIRE(m.interior_coeff_offset == coeffs_per_block + 20);
+        REQUIRE(m.interior_coeff_offset == 20);
         REQUIRE(m.stencil_width == 3);
         REQUIRE(m.right_rows == 2);
         REQUIRE(m.right_cols == 3);
-        REQUIRE(m.right_coeff_offset == coeffs_per_block + 23);
+        REQUIRE(m.right_coeff_offset == 23);
         // right_col_offset = 20 + 1*(16-3) = 33
         REQUIRE(m.right_col_offset == 33);
     }
@@ -325,9 +434,9 @@ TEST_CASE("device metadata arrays")
     SECTION("coefficient data")
     {
         const auto& coeffs_view = A.coefficients_view();
-        REQUIRE(coeffs_view.extent(0) == static_cast<std::size_t>(2 * coeffs_per_block));
+        REQUIRE(coeffs_view.extent(0) == static_cast<std::size_t>(coeffs_per_block));
 
-        std::vector<real> host_coeffs(2 * coeffs_per_block);
+        std::vector<real> host_coeffs(coeffs_per_block);
         auto h_coeffs = Kokkos::View<real*, Kokkos::HostSpace,
                                      Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
             host_coeffs.data(), host_coeffs.size());
@@ -344,11 +453,79 @@ TEST_CASE("device metadata arrays")
         // Check right coefficients for block 0
         for (int i = 0; i < 6; ++i)
             REQUIRE(host_coeffs[23 + i] == Catch::Approx(right_c[i]));
+    }
+}
 
-        // Check left coefficients for block 1 (same data, offset by coeffs_per_block)
-        for (int i = 0; i < 20; ++i)
-            REQUIRE(host_coeffs[coeffs_per_block + i] == Catch::Approx(left_c[i]));
+TEST_CASE("pooled coefficients")
+{
+    using T = std::vector<real>;
+
+    const T lc{1, 2, 3, 4, 5, 6};
+    const T lc2{6, 5, 4, 3, 2, 1};
+    const T ic{-1, 0, 1};
+    const T rc{7, 8, 9, 10};
+
+    // Lines 0 and 2 are identical; line 1 differs only in its left closure
+    const integer cols = 12;
+    const std::vector<matrix::inner_block> lines{
+        matrix::inner_block{cols, 0, 0, 1,
+                            matrix::dense{2, 3, lc},
+                            matrix::circulant{8, ic},
+                            matrix::dense{2, 2, rc}},
+        matrix::inner_block{cols, 12, 12, 1,
+                            matrix::dense{2, 3, lc2},
+                            matrix::circulant{8, ic},
+                            matrix::dense{2, 2, rc}},
+        matrix::inner_block{cols, 24, 24, 1,
+                            matrix::dense{2, 3, lc},
+                            matrix::circulant{8, ic},
+                            matrix::dense{2, 2, rc}}};
+    const auto A = matrix::block{std::vector{lines}};
+
+    REQUIRE(A.coefficients_view().extent(0) == lc.size() + ic.size() + rc.size() + lc2.size());
+
+    std::vector<matrix::inner_block_meta> m(3);
+    Kokkos::deep_copy(Kokkos::View<matrix::inner_block_meta*, Kokkos::HostSpace,
+                                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>(m.data(), 3),
+                      A.metadata_view());
+
+    REQUIRE(m[2].left_coeff_offset == m[0].left_coeff_offset);
+    REQUIRE(m[1].left_coeff_offset != m[0].left_coeff_offset);
+    for (int i = 1; i < 3; ++i) {
+        REQUIRE(m[i].interior_coeff_offset == m[0].interior_coeff_offset);
+        REQUIRE(m[i].right_coeff_offset == m[0].right_coeff_offset);
     }
+
+    // matvec agrees with the per-line reference
+    T x(A.rows());
+    std::generate_n(x.begin(), A.rows(), g);
+    T b(x.size());
+    A(x, b);
+
+    T expected(x.size());
+    for (auto&& ib : lines) ib(x, expected);
+    REQUIRE_THAT(b, Approx(expected));
+
+    // the lines' own copies are released once they point into the pool, which
+    // leaves one host copy of a uniform operator however many lines it has
+    constexpr int nlines = 1000;
+    const auto line_bytes = (lc.size() + ic.size() + rc.size()) * sizeof(real);
+    const auto before = memory_in(subsystem::matrices).current;
+    {
+        std::vector<matrix::inner_block> many;
+        for (int i = 0; i < nlines; ++i)
+            many.emplace_back(cols, 12 * i, 12 * i, 1,
+                              matrix::dense{2, 3, lc},
+                              matrix::circulant{8, ic},
+                              matrix::dense{2, 2, rc});
+        REQUIRE(memory_in(subsystem::matrices).current - before >=
+                (std::int64_t)(nlines * line_bytes));
+
+        const auto B = matrix::block{MOVE(many)};
+        REQUIRE(memory_in(subsystem::matrices).current - before <
+                (std::int64_t)(2 * line_bytes));
+    }
+    REQUIRE(memory_in(subsystem::matrices).current == before);
 }
 
 TEST_CASE("device metadata with stride")
@@ -395,4 +572,4 @@ TEST_CASE("device metadata with stride")
     REQUIRE(host_meta[1].col_offset == 1);
     REQUIRE(host_meta[1].stride == 3);
     REQUIRE(host_meta[1].right_col_offset == 37);
-}
\ No newline at end of file
+}
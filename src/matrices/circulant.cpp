@@ -10,12 +10,8 @@ namespace ccs::matrix
 
 circulant::circulant(integer rows, std::span<const real> coeffs)
     : matrix_base{rows, rows + (integer)coeffs.size() - 1, (integer)coeffs.size() / 2},
-      v_d("circulant_coeffs", coeffs.size())
+      v{coefficient_storage(coeffs.begin(), coeffs.end())}
 {
-    auto h_view = Kokkos::View<const real*, Kokkos::HostSpace,
-                               Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
-        coeffs.data(), coeffs.size());
-    Kokkos::deep_copy(v_d, h_view);
 }
 
 circulant::circulant(integer rows,
@@ -23,12 +19,8 @@ circulant::circulant(integer rows,
                      integer stride,
                      std::span<const real> coeffs)
     : matrix_base{rows, rows + (integer)coeffs.size() - 1, row_offset, -1, stride},
-      v_d("circulant_coeffs", coeffs.size())
+      v{coefficient_storage(coeffs.begin(), coeffs.end())}
 {
-    auto h_view = Kokkos::View<const real*, Kokkos::HostSpace,
-                               Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
-        coeffs.data(), coeffs.size());
-    Kokkos::deep_copy(v_d, h_view);
 }
 
 template <typename Op>
@@ -43,21 +35,21 @@ void circulant::operator()(std::span<const real> x, std::span<real> b, Op op) co
     b = b.subspan(row_offset());
 
     const auto nr = rows();
-    const auto* vp = v_d.data();
-    const auto vs = static_cast<integer>(v_d.extent(0));
+    const auto* vp = v.data();
+    const auto vs = v.size();
     const auto* xp = x.data();
     auto* bp = b.data();
 
     if (st == 1) {
         Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, nr),
+            Kokkos::RangePolicy<execution_space>(exec_space(), 0, nr),
             [=](int i) {
                 auto dot = std::inner_product(vp, vp + vs, xp + i, 0.0);
                 op(bp[i], dot);
             });
     } else {
         Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, nr),
+            Kokkos::RangePolicy<execution_space>(exec_space(), 0, nr),
             [=](int i) {
                 real dot = 0.0;
                 for (integer j = 0; j < vs; j++)
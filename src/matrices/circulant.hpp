@@ -2,15 +2,17 @@
 
 #include "matrix_visitor.hpp"
 
+#include "coefficient_pool.hpp"
 #include "common.hpp"
 #include "kokkos_types.hpp"
 
 namespace ccs::matrix
 {
 
+// The interior stencil of a line, kept on the host like dense
 class circulant : public matrix_base
 {
-    device_view<real*> v_d;
+    shared_coefficients v;
 
 public:
     circulant() = default;
@@ -22,9 +24,10 @@ public:
               integer stride,
               std::span<const real> coeffs);
 
-    integer size() const noexcept { return v_d.extent(0); }
+    integer size() const noexcept { return v.size(); }
 
-    const device_view<real*>& coeffs_view() const { return v_d; }
+    // point at an identical run of shared storage, e.g. a pooled table
+    void share(shared_coefficients c) { v = MOVE(c); }
 
     template <typename Op = eq_t>
     void operator()(std::span<const real> x,
@@ -33,7 +36,7 @@ public:
 
     void visit(visitor& v) const { return v.visit(*this); }
 
-    std::span<const real> data() const { return {v_d.data(), v_d.extent(0)}; }
+    std::span<const real> data() const { return v.span(); }
 };
 
 } // namespace ccs::matrix
@@ -0,0 +1,62 @@
+#include "coefficient_pool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <utility>
+
+namespace ccs::matrix
+{
+
+static_assert(sizeof(real) == sizeof(std::uint64_t));
+
+namespace
+{
+// FNV-1a over the bit patterns so that equal hashes only arise from equal bits
+std::size_t hash(std::span<const real> c)
+{
+    std::uint64_t h = 14695981039346656037ull;
+    auto mix = [&h](std::uint64_t x) {
+        h ^= x;
+        h *= 1099511628211ull;
+    };
+    mix(c.size());
+    for (auto x : c) mix(std::bit_cast<std::uint64_t>(x));
+    return static_cast<std::size_t>(h);
+}
+
+bool same_bits(std::span<const real> a, std::span<const real> b)
+{
+    return std::ranges::equal(a, b, [](real x, real y) {
+        return std::bit_cast<std::uint64_t>(x) == std::bit_cast<std::uint64_t>(y);
+    });
+}
+} // namespace
+
+int coefficient_pool::insert(std::span<const real> c)
+{
+    if (c.empty()) return 0;
+
+    const auto h = hash(c);
+    auto [first, last] = runs.equal_range(h);
+    for (auto it = first; it != last; ++it) {
+        const int off = it->second;
+        if (static_cast<std::size_t>(off) + c.size() <= v.size() &&
+            same_bits(c, std::span<const real>{v}.subspan(off, c.size())))
+            return off;
+    }
+
+    const int off = size();
+    v.insert(v.end(), c.begin(), c.end());
+    runs.emplace(h, off);
+    return off;
+}
+
+std::shared_ptr<const coefficient_storage> coefficient_pool::share()
+{
+    runs.clear();
+    v.shrink_to_fit();
+    return std::make_shared<const coefficient_storage>(std::exchange(v, {}));
+}
+
+} // namespace ccs::matrix
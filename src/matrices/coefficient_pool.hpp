@@ -0,0 +1,73 @@
+#pragma once
+
+#include "memory.hpp"
+#include "types.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace ccs::matrix
+{
+
+using coefficient_storage = tracked_vector<real, subsystem::matrices>;
+
+//
+// A run of coefficients in shared, immutable host storage.  A dense or circulant
+// matrix owns its run until block points it into the pooled table of its lines,
+// after which every line with the same coefficients holds the same run.
+//
+class shared_coefficients
+{
+    std::shared_ptr<const coefficient_storage> store;
+    integer first = 0;
+    integer n = 0;
+
+public:
+    shared_coefficients() = default;
+
+    explicit shared_coefficients(coefficient_storage&& c)
+        : store{std::make_shared<const coefficient_storage>(MOVE(c))},
+          n{static_cast<integer>(store->size())}
+    {
+    }
+
+    shared_coefficients(std::shared_ptr<const coefficient_storage> table,
+                        integer first,
+                        integer n)
+        : store{MOVE(table)}, first{first}, n{n}
+    {
+    }
+
+    integer size() const noexcept { return n; }
+    const real* data() const noexcept { return store ? store->data() + first : nullptr; }
+    std::span<const real> span() const noexcept { return {data(), (std::size_t)n}; }
+};
+
+// Host-side table of matrix coefficients in which identical runs are stored
+// once.  insert() returns the offset of a run bitwise equal to its argument,
+// appending it only if no such run exists.  block uses this so that lines with
+// the same closures and interior stencil, differing only in their row/column
+// offsets, share a single copy of their coefficients.
+class coefficient_pool
+{
+    coefficient_storage v;
+    // content hash -> offsets of runs with that hash
+    std::unordered_multimap<std::size_t, int> runs;
+
+public:
+    coefficient_pool() = default;
+
+    int insert(std::span<const real> c);
+
+    int size() const noexcept { return static_cast<int>(v.size()); }
+    std::span<const real> data() const { return v; }
+
+    // the table as shared storage for the runs handed out by insert(); the pool
+    // is left empty
+    std::shared_ptr<const coefficient_storage> share();
+};
+
+} // namespace ccs::matrix
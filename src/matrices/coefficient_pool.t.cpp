@@ -0,0 +1,50 @@
+#include "coefficient_pool.hpp"
+
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+
+// Custom main: Kokkos must be initialized before any test allocates Views.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+using namespace ccs;
+
+TEST_CASE("identical runs share storage")
+{
+    using T = std::vector<real>;
+    const T a{1.0, -2.0, 1.0};
+    const T b{0.5, 0.25};
+
+    matrix::coefficient_pool pool;
+    REQUIRE(pool.insert(a) == 0);
+    REQUIRE(pool.insert(b) == 3);
+    REQUIRE(pool.insert(T{a}) == 0);
+    REQUIRE(pool.insert(b) == 3);
+    REQUIRE(pool.size() == 5);
+
+    const auto d = pool.data();
+    REQUIRE(T(d.begin(), d.begin() + 3) == a);
+    REQUIRE(T(d.begin() + 3, d.end()) == b);
+}
+
+TEST_CASE("distinct runs are kept")
+{
+    using T = std::vector<real>;
+
+    matrix::coefficient_pool pool;
+    REQUIRE(pool.insert(T{1.0, 2.0}) == 0);
+    // a prefix of an existing run is a different run
+    REQUIRE(pool.insert(T{1.0}) == 2);
+    // -0.0 and 0.0 compare equal but are not the same coefficient bits
+    REQUIRE(pool.insert(T{0.0}) == 3);
+    REQUIRE(pool.insert(T{-0.0}) == 4);
+    REQUIRE(pool.insert(T{}) == 0);
+    REQUIRE(pool.size() == 5);
+}
@@ -3,31 +3,40 @@
 #include "kokkos_types.hpp"
 
 #include <algorithm>
+#include <cassert>
+#include <string>
 
 namespace ccs::matrix
 {
 
 csr csr::builder::to_csr(integer nrows)
 {
+    // Bucket the points by row, then sort each row by column in parallel.  The
+    // result matches a global sort of p regardless of the order points were added.
     std::vector<int> u(nrows + 1);
+    for (auto& pt : p) {
+        assert(pt.row >= 0 && pt.row < nrows);
+        ++u[pt.row + 1];
+    }
+    for (integer i = 0; i < nrows; i++) u[i + 1] += u[i];
 
-    std::ranges::sort(p);
-    auto first = p.begin();
-    auto last = p.end();
-
-    for (integer i = 0; i < nrows; i++) {
-        u[i + 1] = u[i];
-        while (first != last && first->row == i) {
-            ++u[i + 1];
-            ++first;
-        }
+    std::vector<pts> sorted(p.size());
+    {
+        std::vector<int> next(u.begin(), u.end() - 1);
+        for (auto& pt : p) sorted[next[pt.row]++] = pt;
     }
 
+    auto* s_ptr = sorted.data();
+    const auto* u_ptr = u.data();
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<execution_space>(exec_space(), 0, nrows),
+        [=](integer row) { std::sort(s_ptr + u_ptr[row], s_ptr + u_ptr[row + 1]); });
+
     std::vector<real> w_vec;
     std::vector<integer> v_vec;
-    w_vec.reserve(p.size());
-    v_vec.reserve(p.size());
-    for (auto& pt : p) {
+    w_vec.reserve(sorted.size());
+    v_vec.reserve(sorted.size());
+    for (auto& pt : sorted) {
         w_vec.push_back(pt.v);
         v_vec.push_back(pt.col);
     }
@@ -42,14 +51,85 @@ void csr::operator()(std::span<const real> x, std::span<real> b) const
     const auto* u_ptr = u.data();
     const auto* x_ptr = x.data();
     auto* b_ptr = b.data();
+    report_work(cost());
     Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, nr),
+        range(0, nr),
         [=](integer row) {
             for (integer i = u_ptr[row]; i < u_ptr[row + 1]; i++)
                 b_ptr[row] += w_ptr[i] * x_ptr[v_ptr[i]];
         });
 }
 
+void csr::operator()(std::span<const real> x, std::span<real> b, const real* row_w) const
+{
+    const auto nr = rows();
+    const auto* w_ptr = w.data();
+    const auto* v_ptr = v.data();
+    const auto* u_ptr = u.data();
+    const auto* x_ptr = x.data();
+    auto* b_ptr = b.data();
+    report_work(cost() + work{(real)rows(), (real)rows() * sizeof(real)});
+    Kokkos::parallel_for(
+        range(0, nr),
+        [=](integer row) {
+            real s = 0;
+            for (integer i = u_ptr[row]; i < u_ptr[row + 1]; i++)
+                s += w_ptr[i] * x_ptr[v_ptr[i]];
+            b_ptr[row] += row_w[row] * s;
+        });
+}
+
+void csr::operator()(batch<const real> x, batch<real> b) const
+{
+    assert(x.size() == b.size());
+    const auto nr = rows();
+    const auto* w_ptr = w.data();
+    const auto* v_ptr = v.data();
+    const auto* u_ptr = u.data();
+    report_work(cost(x.size()));
+    Kokkos::parallel_for(
+        range(0, nr),
+        [=](integer row) {
+            real s[batch<real>::max_size] = {};
+            for (integer i = u_ptr[row]; i < u_ptr[row + 1]; i++) {
+                const real c = w_ptr[i];
+                const integer col = v_ptr[i];
+                for (int k = 0; k < x.size(); ++k) s[k] += c * x[k][col];
+            }
+            for (int k = 0; k < b.size(); ++k) b[k][row] += s[k];
+        });
+}
+
+void csr::tune(autotuner& tuner)
+{
+    const auto nr = rows();
+    if (!tuner || nr == 0) return;
+
+    const integer cols = size() ? *std::ranges::max_element(v) + 1 : 0;
+    device_view<real*> x("csr_tune_x", cols);
+    device_view<real*> b("csr_tune_b", nr);
+
+    const auto* w_ptr = w.data();
+    const auto* v_ptr = v.data();
+    const auto* u_ptr = u.data();
+    const auto* x_ptr = x.data();
+    auto* b_ptr = b.data();
+
+    std::vector<launch_config> candidates{};
+    for (int c : {0, 16, 64, 256, 1024}) candidates.push_back(launch_config{0, 8, c});
+
+    cfg = tuner("csr rows=" + std::to_string(nr) + " nnz=" + std::to_string(size()),
+                candidates,
+                [&](const launch_config& c) {
+                    Kokkos::RangePolicy<execution_space> p(exec_space(), 0, nr);
+                    if (c.chunk > 0) p.set_chunk_size(c.chunk);
+                    Kokkos::parallel_for("csr_matvec_tune", p, [=](integer row) {
+                        for (integer i = u_ptr[row]; i < u_ptr[row + 1]; i++)
+                            b_ptr[row] += w_ptr[i] * x_ptr[v_ptr[i]];
+                    });
+                });
+}
+
 std::span<const integer> csr::column_indices(integer row) const
 {
     integer r0 = u[row];
@@ -64,4 +144,11 @@ std::span<const real> csr::column_coefficients(integer row) const
     return std::span(w.data() + r0, r1 - r0);
 }
 
+void csr::diagonal(std::span<real> d) const
+{
+    for (integer row = 0; row < rows(); ++row)
+        for (integer i = u[row]; i < u[row + 1]; ++i)
+            if (v[i] == row) d[row] += w[i];
+}
+
 } // namespace ccs::matrix
@@ -1,13 +1,19 @@
 #pragma once
 
+#include "autotuner.hpp"
+#include "batch.hpp"
 #include "common.hpp"
 #include "matrix_visitor.hpp"
 
 #include "kokkos_types.hpp"
+#include "memory.hpp"
+#include "work.hpp"
 
 #include <Kokkos_Graph.hpp>
 
+#include <algorithm>
 #include <compare>
+#include <limits>
 #include <ranges>
 #include <vector>
 
@@ -16,10 +22,19 @@ namespace ccs::matrix
 class csr
 {
     // standard csr format
-    std::vector<real> w;    // values
-    std::vector<integer> v; // column indices
-    std::vector<integer> u; // starting column index for rows
+    tracked_vector<real, subsystem::matrices> w;    // values
+    tracked_vector<integer, subsystem::matrices> v; // column indices
+    tracked_vector<integer, subsystem::matrices> u; // starting column index for rows
     flag f;
+    // only the chunk size applies to the row loop, set by tune()
+    launch_config cfg{};
+
+    Kokkos::RangePolicy<execution_space> range(integer first, integer last) const
+    {
+        Kokkos::RangePolicy<execution_space> p(exec_space(), first, last);
+        if (cfg.chunk > 0) p.set_chunk_size(cfg.chunk);
+        return p;
+    }
 
 public:
     csr() = default;
@@ -37,15 +52,64 @@ public:
     std::span<const integer> column_indices(integer row) const;
     std::span<const real> column_coefficients(integer row) const;
 
+    // d[row] += A[row][row]; only meaningful when rows and columns share a space
+    void diagonal(std::span<real> d) const;
+
     // number of non-zero entries
     integer size() const { return (integer)w.size(); }
 
+    // Flops and compulsory memory traffic of a matvec with k inputs of `scalar`
+    // bytes: every nonzero reads its value, column index and one x per input,
+    // and every row reads and writes b.
+    work cost(int k = 1, int scalar = sizeof(real)) const
+    {
+        const auto nnz = (real)size();
+        return {2.0 * nnz * k,
+                nnz * (sizeof(real) + sizeof(integer) + (real)k * scalar) +
+                    (real)rows() * (sizeof(integer) + 2.0 * k * scalar)};
+    }
+
+    launch_config launch() const { return cfg; }
+    void launch(const launch_config& c) { cfg = c; }
+
+    // Pick the chunk size of the row loop with the tuner, keyed on the rows and
+    // nonzeros.  See block::tune.
+    void tune(autotuner&);
+
     void operator()(std::span<const real> x, std::span<real> b) const;
 
+    // b[row] += row_w[row] * (A x)[row]
+    void operator()(std::span<const real> x, std::span<real> b, const real* row_w) const;
+
+    // Batched form: b[k] += A x[k] for every scalar k, reading each nonzero once.
+    void operator()(batch<const real> x, batch<real> b) const;
+
+    // Accessor form of operator() (always +=): x[i] may compute its value when read.
+    template <typename X>
+    void apply(X x, std::span<real> b) const
+    {
+        const auto nr = rows();
+        const auto* wp = w.data();
+        const auto* vp = v.data();
+        const auto* up = u.data();
+        auto* b_ptr = b.data();
+        report_work(cost());
+        Kokkos::parallel_for(
+            range(0, nr), KOKKOS_LAMBDA(integer row) {
+                for (integer i = up[row]; i < up[row + 1]; i++) b_ptr[row] += wp[i] * x[vp[i]];
+            });
+    }
+
     // Chain a RangePolicy graph node that performs the CSR matvec (always +=).
-    // For 0-row matrices, the node executes zero iterations.
+    // For 0-row matrices, the node executes zero iterations.  Only the rows in
+    // [first, last) are updated, so nodes over disjoint ranges may run
+    // concurrently.
     template <typename NodeType>
-    auto graph_node(NodeType parent, const real* x_ptr, real* b_ptr) const
+    auto graph_node(NodeType parent,
+                    const real* x_ptr,
+                    real* b_ptr,
+                    integer first = 0,
+                    integer last = std::numeric_limits<integer>::max()) const
     {
         const auto nr = rows();
         const auto* wp = w.data();
@@ -53,13 +117,57 @@ public:
         const auto* up = u.data();
         return parent.then_parallel_for(
             "csr_matvec",
-            Kokkos::RangePolicy<execution_space>(0, nr),
+            range(std::min(first, nr), std::min(last, nr)),
             KOKKOS_LAMBDA(integer row) {
                 for (integer i = up[row]; i < up[row + 1]; i++)
                     b_ptr[row] += wp[i] * x_ptr[vp[i]];
             });
     }
 
+    // Batched form of graph_node.
+    template <typename NodeType>
+    auto graph_node(NodeType parent,
+                    batch<const real> x,
+                    batch<real> b,
+                    integer first = 0,
+                    integer last = std::numeric_limits<integer>::max()) const
+    {
+        const auto nr = rows();
+        const auto* wp = w.data();
+        const auto* vp = v.data();
+        const auto* up = u.data();
+        return parent.then_parallel_for(
+            "csr_matvec_batch",
+            range(std::min(first, nr), std::min(last, nr)),
+            KOKKOS_LAMBDA(integer row) {
+                real s[batch<real>::max_size] = {};
+                for (integer i = up[row]; i < up[row + 1]; i++) {
+                    const real c = wp[i];
+                    const integer col = vp[i];
+                    for (int k = 0; k < x.size(); ++k) s[k] += c * x[k][col];
+                }
+                for (int k = 0; k < b.size(); ++k) b[k][row] += s[k];
+            });
+    }
+
+    // Weighted variant of graph_node: b[row] += row_w[row] * (A x)[row].
+    template <typename NodeType>
+    auto graph_node(NodeType parent, const real* x_ptr, real* b_ptr, const real* row_w) const
+    {
+        const auto nr = rows();
+        const auto* wp = w.data();
+        const auto* vp = v.data();
+        const auto* up = u.data();
+        return parent.then_parallel_for(
+            "csr_matvec_weighted",
+            range(0, nr),
+            KOKKOS_LAMBDA(integer row) {
+                real s = 0;
+                for (integer i = up[row]; i < up[row + 1]; i++) s += wp[i] * x_ptr[vp[i]];
+                b_ptr[row] += row_w[row] * s;
+            });
+    }
+
     struct builder;
 
     flag flags() const { return f; }
@@ -88,6 +196,16 @@ struct csr::builder {
         p.emplace_back(row, col, v);
     }
 
+    // Take the points of another builder, e.g. one filled by a different thread.
+    void append(builder&& other)
+    {
+        if (p.empty())
+            p = MOVE(other.p);
+        else
+            p.insert(p.end(), other.p.begin(), other.p.end());
+        other.p.clear();
+    }
+
     csr to_csr(integer nrows);
 };
 
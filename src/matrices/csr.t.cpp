@@ -93,6 +93,91 @@ TEST_CASE("Random")
                           19.15476174098357}));
 }
 
+TEST_CASE("Random Weighted")
+{
+    T w{6.132558989050928,
+        -0.4611523807581932,
+        -2.874686661596037,
+        9.42084557206411,
+        0.2298026797436883,
+        6.066446959605997,
+        -7.70721485928825,
+        -0.9885546582519957,
+        -5.302176517574914};
+
+    std::vector<int> v{1, 6, 0, 4, 6, 7, 8, 9, 0};
+    std::vector<int> u{0, 2, 3, 4, 4, 4, 4, 8, 8, 8, 9};
+
+    const matrix::csr A{w, v, u};
+
+    const T x{-3.612622416000683,
+              -1.1427601879942273,
+              0.8552565615441736,
+              -4.755547850496647,
+              -9.711932690401355,
+              -7.232904766266888,
+              -5.437050079342718,
+              -2.4092054560513105,
+              3.557741982344453,
+              5.127028269794991};
+
+    const T row_w{2, -1, 0.5, 3, 3, 3, -2, 3, 3, 0.25};
+
+    // weighted application accumulates into existing data
+    T b(x.size(), 1.0);
+    A(x, b, row_w.data());
+
+    REQUIRE_THAT(b,
+                 Approx(T{1 + 2 * -4.500735674823108,
+                          1 - 10.385157472660014,
+                          1 + 0.5 * -91.49461808255228,
+                          1.,
+                          1.,
+                          1.,
+                          1 - 2 * -48.353395342996556,
+                          1.,
+                          1.,
+                          1 + 0.25 * 19.15476174098357}));
+}
+
+TEST_CASE("Random Batched")
+{
+    T w{6.132558989050928,
+        -0.4611523807581932,
+        -2.874686661596037,
+        9.42084557206411,
+        0.2298026797436883,
+        6.066446959605997,
+        -7.70721485928825,
+        -0.9885546582519957,
+        -5.302176517574914};
+
+    std::vector<int> v{1, 6, 0, 4, 6, 7, 8, 9, 0};
+    std::vector<int> u{0, 2, 3, 4, 4, 4, 4, 8, 8, 8, 9};
+
+    const matrix::csr A{w, v, u};
+
+    constexpr int nb = 4;
+    std::vector<T> x, b, exact;
+    matrix::batch<const real> xb;
+    matrix::batch<real> bb;
+    for (int k = 0; k < nb; ++k) {
+        x.push_back(random_vec(10));
+        b.push_back(random_vec(10));
+        exact.push_back(b.back());
+    }
+    for (int k = 0; k < nb; ++k) {
+        xb.push_back(x[k].data());
+        bb.push_back(b[k].data());
+        A(x[k], exact[k]);
+    }
+
+    // batched application accumulates into existing data like the single form
+    A(xb, bb);
+    Kokkos::fence();
+    for (int k = 0; k < nb; ++k) REQUIRE_THAT(b[k], Approx(exact[k]));
+}
+
 TEST_CASE("Identity Builder")
 {
 
@@ -172,3 +257,43 @@ TEST_CASE("Random Builder")
         REQUIRE_THAT(b, Approx(exact));
     }
 }
+
+TEST_CASE("Appended Builders")
+{
+    using P = matrix::csr::builder::pts;
+    auto pts = std::vector<P>{};
+    for (integer row = 0; row < 50; ++row)
+        for (integer col = row % 3; col < 50; col += 7) pts.push_back({row, col, pick()});
+
+    auto reference = matrix::csr::builder();
+    for (auto&& [r, c, v] : pts) reference.add_point(r, c, v);
+    const auto A = reference.to_csr(50);
+
+    const T x = random_vec(50);
+    T exact(x.size());
+    A(x, exact);
+
+    for (int j = 0; j < 5; j++) {
+        // scatter the points over several builders, as a threaded assembly would
+        std::ranges::shuffle(pts, rng);
+        std::vector<matrix::csr::builder> parts(4);
+        for (std::size_t i = 0; i < pts.size(); ++i)
+            parts[i % parts.size()].add_point(pts[i].row, pts[i].col, pts[i].v);
+
+        auto builder = matrix::csr::builder();
+        for (auto&& part : parts) builder.append(MOVE(part));
+        REQUIRE(builder.p.size() == pts.size());
+
+        const auto B = builder.to_csr(50);
+        REQUIRE(B.size() == A.size());
+        for (integer row = 0; row < 50; ++row) {
+            REQUIRE(std::ranges::equal(B.column_indices(row), A.column_indices(row)));
+            REQUIRE(std::ranges::equal(B.column_coefficients(row),
+                                       A.column_coefficients(row)));
+        }
+
+        T b(x.size());
+        B(x, b);
+        REQUIRE_THAT(b, Approx(exact));
+    }
+}
@@ -16,7 +16,7 @@ void dense::operator()(std::span<const real> x, std::span<real> b, Op op) const
     x = x.subspan(col_offset());
     b = b.subspan(row_offset());
     const auto st = stride();
-    const auto* vp = v_d.data();
+    const auto* vp = v.data();
     const auto nc = columns();
 
     if (st == 1) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "coefficient_pool.hpp"
 #include "common.hpp"
 #include "kokkos_types.hpp"
 #include "matrix_visitor.hpp"
@@ -10,25 +11,28 @@
 namespace ccs::matrix
 {
 
-// Simple contiguous storage for dense matrix with lazy operators
+// Simple contiguous storage for dense matrix with lazy operators.  The
+// coefficients stay on the host; block copies the pooled coefficients of its
+// lines to the device once.
 class dense : public matrix_base
 {
-    device_view<real*> v_d;
+    shared_coefficients v;
     flag f;
 
+    static shared_coefficients copy(integer n, auto&& rng)
+    {
+        coefficient_storage c(n);
+        std::ranges::copy(rng | std::views::take(n), c.begin());
+        return shared_coefficients{MOVE(c)};
+    }
+
 public:
     dense() = default;
 
     template <std::ranges::input_range R>
     dense(integer rows, integer columns, R&& rng, flag boundary = 0)
-        : matrix_base{rows, columns}, v_d("dense_coeffs", rows * columns), f{boundary}
+        : matrix_base{rows, columns}, v{copy(rows * columns, rng)}, f{boundary}
     {
-        std::vector<real> tmp(rows * columns);
-        std::ranges::copy(rng | std::views::take(tmp.size()), tmp.begin());
-        auto h_view = Kokkos::View<const real*, Kokkos::HostSpace,
-                                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
-            tmp.data(), tmp.size());
-        Kokkos::deep_copy(v_d, h_view);
     }
 
     template <std::ranges::input_range R>
@@ -40,27 +44,22 @@ public:
           R&& rng,
           flag boundary = 0)
         : matrix_base{rows, columns, row_offset, col_offset, stride},
-          v_d("dense_coeffs", rows * columns),
+          v{copy(rows * columns, rng)},
           f{boundary}
     {
-        std::vector<real> tmp(rows * columns);
-        std::ranges::copy(rng | std::views::take(tmp.size()), tmp.begin());
-        auto h_view = Kokkos::View<const real*, Kokkos::HostSpace,
-                                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
-            tmp.data(), tmp.size());
-        Kokkos::deep_copy(v_d, h_view);
     }
 
-    integer size() const noexcept { return v_d.extent(0); }
+    integer size() const noexcept { return v.size(); }
 
-    const device_view<real*>& coeffs_view() const { return v_d; }
+    // point at an identical run of shared storage, e.g. a pooled table
+    void share(shared_coefficients c) { v = MOVE(c); }
 
     template <typename Op = eq_t>
     void operator()(std::span<const real> x,
                     std::span<real> b,
                     Op op = {}) const;
 
-    std::span<const real> data() const { return {v_d.data(), v_d.extent(0)}; }
+    std::span<const real> data() const { return v.span(); }
     flag flags() const { return f; }
     void flags(flag f_) { f = f_; }
     void visit(visitor& v) const { v.visit(*this); };
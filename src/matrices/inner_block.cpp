@@ -39,6 +39,16 @@ inner_block::inner_block(integer columns,
         .stride(stride);
 }
 
+void inner_block::share(const std::shared_ptr<const coefficient_storage>& table,
+                        integer left,
+                        integer interior_offset,
+                        integer right)
+{
+    left_boundary.share({table, left, left_boundary.size()});
+    interior.share({table, interior_offset, interior.size()});
+    right_boundary.share({table, right, right_boundary.size()});
+}
+
 template <typename Op>
 void inner_block::operator()(std::span<const real> x, std::span<real> b, Op op) const
 {
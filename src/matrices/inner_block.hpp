@@ -42,6 +42,12 @@ public:
                     std::span<real> b,
                     Op op = {}) const;
 
+    // point the closures and the interior stencil at their runs of a pooled table
+    void share(const std::shared_ptr<const coefficient_storage>& table,
+               integer left,
+               integer interior,
+               integer right);
+
     const dense& left() const { return left_boundary; }
     const circulant& interior_circ() const { return interior; }
     const dense& right() const { return right_boundary; }
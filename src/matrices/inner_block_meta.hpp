@@ -1,15 +1,19 @@
 #pragma once
 
+#include "shoccs_config.hpp"
+
 namespace ccs::matrix
 {
 
 // POD struct holding per-line metadata for the TeamPolicy kernel in block::operator().
 // One instance per inner_block (i.e., per line in the mesh). All offsets refer to
 // positions within the flat input/output spans and the concatenated coefficient array.
+// Field offsets and the stride are integer so that lines of a mesh beyond 2^31
+// points are addressable; per-line counts and coefficient offsets stay int.
 struct inner_block_meta {
-    int row_offset;
-    int col_offset;
-    int stride;
+    integer row_offset;
+    integer col_offset;
+    integer stride;
     int left_rows;
     int left_cols;
     int left_coeff_offset;
@@ -19,7 +23,7 @@ struct inner_block_meta {
     int right_rows;
     int right_cols;
     int right_coeff_offset;
-    int right_col_offset;
+    integer right_col_offset;
 };
 
 } // namespace ccs::matrix
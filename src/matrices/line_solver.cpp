@@ -0,0 +1,194 @@
+#include "line_solver.hpp"
+#include "coefficient_pool.hpp"
+
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ccs::matrix
+{
+namespace
+{
+// The square part of one line in band storage: row r holds columns r - kl ..
+// r + ku at r * (kl + ku + 1) + (c - r + kl).
+struct band {
+    int n = 0;
+    int kl = 0;
+    int ku = 0;
+    std::vector<real> a;
+
+    real& operator()(int r, int c) { return a[r * (kl + ku + 1) + c - r + kl]; }
+};
+
+// Visit the nonzero entries (local row, local column, coefficient) of line m
+// whose column lies on the line itself.  Indexing follows block's matvec kernel.
+template <typename F>
+void for_each_line_entry(const inner_block_meta& m, const real* coeffs, F&& f)
+{
+    const int n = m.left_rows + m.interior_rows + m.right_rows;
+    auto local = [&](integer g) -> int {
+        const integer d = g - m.row_offset;
+        if (m.stride <= 0 || d < 0 || d % m.stride != 0) return -1;
+        return d / m.stride < n ? d / m.stride : -1;
+    };
+
+    for (int r = 0; r < m.left_rows; ++r)
+        for (int j = 0; j < m.left_cols; ++j) {
+            const real c = coeffs[m.left_coeff_offset + r * m.left_cols + j];
+            if (int col = local(m.col_offset + j * m.stride); col >= 0 && c != 0) f(r, col, c);
+        }
+
+    const int half_w = m.stencil_width / 2;
+    for (int r = m.left_rows; r < m.left_rows + m.interior_rows; ++r)
+        for (int j = 0; j < m.stencil_width; ++j) {
+            const real c = coeffs[m.interior_coeff_offset + j];
+            if (int col = r + j - half_w; col >= 0 && col < n && c != 0) f(r, col, c);
+        }
+
+    for (int r = 0; r < m.right_rows; ++r) {
+        const int row = m.left_rows + m.interior_rows + r;
+        for (int j = 0; j < m.right_cols; ++j) {
+            const real c = coeffs[m.right_coeff_offset + r * m.right_cols + j];
+            if (int col = local(m.right_col_offset + j * m.stride); col >= 0 && c != 0)
+                f(row, col, c);
+        }
+    }
+}
+
+// alpha I + beta A restricted to the line
+band line_band(const inner_block_meta& m, const real* coeffs, real alpha, real beta)
+{
+    band b;
+    b.n = m.left_rows + m.interior_rows + m.right_rows;
+    for_each_line_entry(m, coeffs, [&](int r, int c, real) {
+        b.kl = std::max(b.kl, r - c);
+        b.ku = std::max(b.ku, c - r);
+    });
+    b.a.assign(static_cast<std::size_t>(b.n) * (b.kl + b.ku + 1), 0.0);
+    for (int r = 0; r < b.n; ++r) b(r, r) = alpha;
+    for_each_line_entry(m, coeffs, [&](int r, int c, real v) { b(r, c) += beta * v; });
+    return b;
+}
+
+// In place banded LU without pivoting.  The unit lower factor keeps its
+// multipliers below the diagonal and the diagonal of U is stored inverted.
+bool factor(band& b)
+{
+    for (int k = 0; k < b.n; ++k) {
+        const real piv = b(k, k);
+        if (piv == 0 || !std::isfinite(piv)) return false;
+        for (int i = k + 1; i <= std::min(b.n - 1, k + b.kl); ++i) {
+            const real l = b(i, k) / piv;
+            b(i, k) = l;
+            for (int j = k + 1; j <= std::min(b.n - 1, k + b.ku); ++j) b(i, j) -= l * b(k, j);
+        }
+        b(k, k) = 1 / piv;
+    }
+    return true;
+}
+
+// Forward and back substitution for the lines of group m on buffer x
+template <typename Member>
+KOKKOS_INLINE_FUNCTION void
+solve_group(const Member& team, const line_group_meta& m, const real* f, real* x)
+{
+    const int w = m.kl + m.ku + 1;
+    auto at = [&](int r, int l) -> real& { return x[m.row_offset + l + r * m.stride]; };
+
+    for (int r = 1; r < m.n; ++r) {
+        const int c0 = r > m.kl ? r - m.kl : 0;
+        const real* fr = f + m.factor_offset + r * w - r + m.kl;
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, m.lines), [&](int l) {
+            real s = 0;
+            for (int c = c0; c < r; ++c) s += fr[c] * at(c, l);
+            at(r, l) -= s;
+        });
+    }
+
+    for (int r = m.n - 1; r >= 0; --r) {
+        const int c1 = r + m.ku < m.n - 1 ? r + m.ku : m.n - 1;
+        const real* fr = f + m.factor_offset + r * w - r + m.kl;
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, m.lines), [&](int l) {
+            real s = at(r, l);
+            for (int c = r + 1; c <= c1; ++c) s -= fr[c] * at(c, l);
+            at(r, l) = s * fr[r];
+        });
+    }
+}
+} // namespace
+
+line_solver::line_solver(const block& A, real alpha, real beta)
+{
+    const int n = A.num_lines();
+    if (n == 0) return;
+
+    auto meta = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, A.metadata_view());
+    auto coeffs =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace{}, A.coefficients_view());
+
+    coefficient_pool pool;
+    std::vector<line_group_meta> groups;
+    for (int i = 0; i < n; ++i) {
+        const auto& m = meta(i);
+        auto b = line_band(m, coeffs.data(), alpha, beta);
+        if (b.n == 0) continue;
+        ok = factor(b) && ok;
+        ++n_lines;
+
+        const int offset = pool.insert(b.a);
+        if (!groups.empty()) {
+            auto& g = groups.back();
+            if (g.lines < group_size && g.factor_offset == offset && g.n == b.n &&
+                g.kl == b.kl && g.ku == b.ku && g.stride == m.stride &&
+                g.row_offset + g.lines == m.row_offset) {
+                ++g.lines;
+                continue;
+            }
+        }
+        groups.push_back({m.row_offset, m.stride, 1, b.n, b.kl, b.ku, offset});
+    }
+
+    meta_d = device_view<line_group_meta*>("line_solver_meta", groups.size());
+    factors_d = device_view<real*>("line_solver_factors", pool.size());
+
+    auto h_meta = Kokkos::View<const line_group_meta*, Kokkos::HostSpace,
+                               Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+        groups.data(), groups.size());
+    Kokkos::deep_copy(meta_d, h_meta);
+
+    auto h_factors = Kokkos::View<const real*, Kokkos::HostSpace,
+                                  Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+        pool.data().data(), pool.size());
+    Kokkos::deep_copy(factors_d, h_factors);
+}
+
+void line_solver::operator()(std::span<real> x) const
+{
+    batch<real> b;
+    b.push_back(x.data());
+    (*this)(b);
+}
+
+void line_solver::operator()(batch<real> x) const
+{
+    Kokkos::Profiling::ScopedRegion region("line_solver::operator()");
+    const int n = num_groups();
+    if (n == 0 || x.size() == 0) return;
+
+    using team_policy = Kokkos::TeamPolicy<execution_space>;
+    auto meta = meta_d;
+    const real* f = factors_d.data();
+
+    Kokkos::parallel_for(
+        "line_solver",
+        team_policy(exec_space(), n, 1, group_size),
+        KOKKOS_LAMBDA(const team_policy::member_type& team) {
+            const auto m = meta(team.league_rank());
+            for (int k = 0; k < x.size(); ++k) solve_group(team, m, f, x[k]);
+        });
+    exec_space().fence("line_solver::operator() complete");
+}
+
+} // namespace ccs::matrix
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "batch.hpp"
+#include "block.hpp"
+
+#include "kokkos_types.hpp"
+
+#include <span>
+
+namespace ccs::matrix
+{
+
+// POD struct describing a group of lines solved together by line_solver.  The
+// lines of a group share their length, bandwidths, stride and factors, and
+// line l starts at row_offset + l, so every row step touches adjacent memory.
+struct line_group_meta {
+    integer row_offset;
+    integer stride;
+    int lines;
+    int n;
+    int kl;
+    int ku;
+    int factor_offset;
+};
+
+//
+// Banded direct solves along the lines of a block: for each inner_block the
+// square part of alpha I + beta A (the columns falling on the line's own rows)
+// is factored once by banded LU without pivoting and then applied as
+// x <- (alpha I + beta A)^-1 x on the rows of the line.  Tridiagonal lines reduce
+// to the Thomas algorithm.  Columns outside the line (e.g. a Dirichlet end
+// point) are dropped, so the solve is the one with homogeneous boundary data.
+//
+// Lines with identical factors share storage through a coefficient_pool, and
+// adjacent lines of the same shape are grouped so the substitution sweeps
+// vectorize across them.
+//
+class line_solver
+{
+    device_view<line_group_meta*> meta_d;
+    device_view<real*> factors_d;
+    int n_lines = 0;
+    bool ok = true;
+
+public:
+    // max lines per group, the vector length of the solve kernel
+    static constexpr int group_size = 8;
+
+    line_solver() = default;
+
+    line_solver(const block& A, real alpha, real beta);
+
+    // false if some line had a zero pivot, in which case the solve is not usable
+    bool factored() const { return ok; }
+
+    int num_lines() const { return n_lines; }
+    int num_groups() const { return static_cast<int>(meta_d.extent(0)); }
+    // number of stored factor coefficients after pooling
+    int factor_size() const { return static_cast<int>(factors_d.extent(0)); }
+
+    // x <- (alpha I + beta A)^-1 x along every line; points on no line are untouched
+    void operator()(std::span<real> x) const;
+
+    // Batched form: each group is solved for every scalar while its factors are
+    // in cache
+    void operator()(batch<real> x) const;
+};
+
+} // namespace ccs::matrix
@@ -0,0 +1,155 @@
+#include "line_solver.hpp"
+
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "random/random.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+// Custom main: Kokkos must be initialized before parallel_for calls.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+using namespace ccs;
+using Catch::Matchers::Approx;
+using T = std::vector<real>;
+
+constexpr auto g = []() { return pick(); };
+
+namespace
+{
+// alpha x + beta A x on the given rows, x elsewhere
+T shifted(const matrix::block& A, const T& x, real alpha, real beta, const std::vector<int>& rows)
+{
+    T ax(x.size());
+    A(x, ax);
+    T b = x;
+    for (auto r : rows) b[r] = alpha * x[r] + beta * ax[r];
+    return b;
+}
+} // namespace
+
+TEST_CASE("tridiagonal lines with a dropped column")
+{
+    // Two lines of 10 rows whose first column (a Dirichlet point) is not one of
+    // their rows.  Rows 1-10 and 13-22.
+    const T lc{1, -2, 1, 0, 1, -2};
+    const T ic{1, -2, 1};
+    const T rc{1, -2, 1, 0, 1, -2};
+
+    auto bld = matrix::block::builder();
+    for (integer offset : {0, 12})
+        bld.add_inner_block(11,
+                            offset + 1,
+                            offset,
+                            1,
+                            matrix::dense{2, 3, lc},
+                            matrix::circulant{6, ic},
+                            matrix::dense{2, 3, rc});
+    const auto A = MOVE(bld).to_block();
+
+    const real alpha = 1, beta = -0.25;
+    auto solve = matrix::line_solver{A, alpha, beta};
+    REQUIRE(solve.factored());
+    REQUIRE(solve.num_lines() == 2);
+    REQUIRE(solve.num_groups() == 2);
+    // identical lines share their tridiagonal factors
+    REQUIRE(solve.factor_size() == 10 * 3);
+
+    std::vector<int> rows;
+    for (int r = 1; r <= 10; ++r) {
+        rows.push_back(r);
+        rows.push_back(12 + r);
+    }
+
+    T x(24);
+    std::generate(x.begin(), x.end(), g);
+    // homogeneous boundary data
+    x[0] = x[12] = 0;
+
+    T b = shifted(A, x, alpha, beta, rows);
+    solve(b);
+    REQUIRE_THAT(b, Approx(x));
+}
+
+TEST_CASE("adjacent strided lines are grouped")
+{
+    // Three interleaved pentadiagonal lines of 15 points with stride 3, as for
+    // the x-lines of a 15 x 3 grid
+    const T lc{-2, 1, 0, 0, 0, 1, -2, 1, 0, 0, 0, 1, -2, 1, 0};
+    const T ic{-1. / 12, 16. / 12, -30. / 12, 16. / 12, -1. / 12};
+    const T rc{1, -2, 1, 0, 1, -2};
+
+    const integer columns = 15;
+    const integer stride = 3;
+
+    std::vector<matrix::inner_block> lines;
+    for (integer offset = 0; offset < 3; ++offset)
+        lines.emplace_back(columns,
+                           offset,
+                           offset,
+                           stride,
+                           matrix::dense(3, 5, lc),
+                           matrix::circulant(10, ic),
+                           matrix::dense(2, 3, rc));
+    const auto A = matrix::block{MOVE(lines)};
+
+    const real alpha = 1, beta = -0.1;
+    auto solve = matrix::line_solver{A, alpha, beta};
+    REQUIRE(solve.factored());
+    REQUIRE(solve.num_lines() == 3);
+    REQUIRE(solve.num_groups() == 1);
+
+    std::vector<int> rows(45);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    T x0(45), x1(45);
+    std::generate(x0.begin(), x0.end(), g);
+    std::generate(x1.begin(), x1.end(), g);
+
+    SECTION("single")
+    {
+        T b = shifted(A, x0, alpha, beta, rows);
+        solve(b);
+        REQUIRE_THAT(b, Approx(x0));
+    }
+
+    SECTION("batched")
+    {
+        T b0 = shifted(A, x0, alpha, beta, rows);
+        T b1 = shifted(A, x1, alpha, beta, rows);
+        matrix::batch<real> b;
+        b.push_back(b0.data());
+        b.push_back(b1.data());
+        solve(b);
+        REQUIRE_THAT(b0, Approx(x0));
+        REQUIRE_THAT(b1, Approx(x1));
+    }
+}
+
+TEST_CASE("zero pivot")
+{
+    const T ic{1};
+    auto bld = matrix::block::builder();
+    bld.add_inner_block(4,
+                        0,
+                        0,
+                        1,
+                        matrix::dense{0, 0, T{}},
+                        matrix::circulant{4, ic},
+                        matrix::dense{0, 0, T{}});
+    const auto A = MOVE(bld).to_block();
+
+    // I - A == 0
+    REQUIRE(!matrix::line_solver{A, 1, -1}.factored());
+    REQUIRE(matrix::line_solver{A, 1, 1}.factored());
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ccs
+{
+
+// Owners of the bytes reported by the memory accounting.  Kokkos views are
+// charged by label (see subsystem_of) and std containers by the tag of their
+// tracking_allocator.
+enum class subsystem { fields, matrices, operators, mesh, systems, other };
+
+inline constexpr int n_subsystems = 6;
+
+inline constexpr std::array<std::string_view, n_subsystems> subsystem_names{
+    "fields", "matrices", "operators", "mesh", "systems", "other"};
+
+// Live and high-water bytes of one subsystem
+struct memory_usage {
+    std::int64_t current;
+    std::int64_t peak;
+};
+
+namespace detail
+{
+struct memory_counter {
+    std::atomic<std::int64_t> current{0};
+    std::atomic<std::int64_t> peak{0};
+
+    void add(std::int64_t bytes)
+    {
+        const auto now = current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        auto p = peak.load(std::memory_order_relaxed);
+        while (now > p && !peak.compare_exchange_weak(p, now, std::memory_order_relaxed))
+            ;
+    }
+
+    memory_usage load() const
+    {
+        return {current.load(std::memory_order_relaxed),
+                peak.load(std::memory_order_relaxed)};
+    }
+};
+
+// one per subsystem and the total, whose peak is not the sum of the others
+inline std::array<memory_counter, n_subsystems + 1> memory_counters{};
+} // namespace detail
+
+inline void charge_memory(subsystem s, std::int64_t bytes)
+{
+    detail::memory_counters[static_cast<int>(s)].add(bytes);
+    detail::memory_counters[n_subsystems].add(bytes);
+}
+
+inline void release_memory(subsystem s, std::int64_t bytes)
+{
+    detail::memory_counters[static_cast<int>(s)].add(-bytes);
+    detail::memory_counters[n_subsystems].add(-bytes);
+}
+
+inline memory_usage memory_in(subsystem s)
+{
+    return detail::memory_counters[static_cast<int>(s)].load();
+}
+
+// all subsystems
+inline memory_usage memory_total()
+{
+    return detail::memory_counters[n_subsystems].load();
+}
+
+// The subsystem owning a Kokkos view, from the label prefixes used in the tree.
+// Registry buffers are labelled s<i>_D, v<i>_xRy, ... and the matrices and
+// operators prefix their labels with the owning class.
+inline subsystem subsystem_of(std::string_view label)
+{
+    constexpr std::pair<std::string_view, subsystem> prefixes[] = {
+        {"block_", subsystem::matrices},
+        {"line_solver_", subsystem::matrices},
+        {"csr_", subsystem::matrices},
+        {"gradient_sweep_", subsystem::operators},
+        {"slab_", subsystem::operators},
+        {"gather_", subsystem::fields},
+        {"expr_tmp", subsystem::fields},
+    };
+    for (auto&& [p, s] : prefixes)
+        if (label.starts_with(p)) return s;
+
+    // s<digits>_ and v<digits>_
+    if (label.size() > 2 && (label[0] == 's' || label[0] == 'v')) {
+        std::size_t i = 1;
+        while (i < label.size() && label[i] >= '0' && label[i] <= '9') ++i;
+        if (i > 1 && i < label.size() && label[i] == '_') return subsystem::fields;
+    }
+    return subsystem::other;
+}
+
+//
+// std::allocator that charges its bytes to subsystem S.  It is stateless, so
+// containers using it swap and move like their std::allocator counterparts.
+//
+template <typename T, subsystem S>
+struct tracking_allocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = tracking_allocator<U, S>;
+    };
+
+    tracking_allocator() = default;
+    template <typename U>
+    tracking_allocator(const tracking_allocator<U, S>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        T* p = std::allocator<T>{}.allocate(n);
+        charge_memory(S, static_cast<std::int64_t>(n * sizeof(T)));
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        release_memory(S, static_cast<std::int64_t>(n * sizeof(T)));
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const tracking_allocator<U, S>&) const noexcept
+    {
+        return true;
+    }
+};
+
+template <typename T, subsystem S>
+using tracked_vector = std::vector<T, tracking_allocator<T, S>>;
+
+} // namespace ccs
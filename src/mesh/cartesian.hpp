@@ -100,13 +100,13 @@ public:
     {
         const auto& n_ = as_extents();
         auto [f, s] = index::dirs(dir);
-        return [s, f, dir, nf = n_[f], n = n_[dir]](auto&& ijk) {
-            return n * (nf * ijk[s] + ijk[f]) + ijk[dir];
+        return [s, f, dir, nf = n_[f], n = n_[dir]](auto&& ijk) -> integer {
+            return (integer)n * ((integer)nf * ijk[s] + ijk[f]) + ijk[dir];
         };
     }
 
     // given a point in ijk, compute the unique coordinate according to dir
-    constexpr int uc_ijk2dir(int dir, const int3& ijk) { return ucf_ijk2dir(dir)(ijk); }
+    constexpr integer uc_ijk2dir(int dir, const int3& ijk) { return ucf_ijk2dir(dir)(ijk); }
 
     // return a function that will take a point in "dir" space and return the
     // unique coordinate in that space
@@ -115,11 +115,11 @@ public:
         return [n = n_dir(dir)](auto&& pt) {
             auto [ns, nf, nd] = n;
             auto [s, f, d] = pt;
-            return nd * (nf * s + f) + d;
+            return (integer)nd * ((integer)nf * s + f) + d;
         };
     }
 
-    constexpr int uc_dir(int dir, const int3& pt) { return ucf_dir(dir)(pt); }
+    constexpr integer uc_dir(int dir, const int3& pt) { return ucf_dir(dir)(pt); }
 
     static std::optional<std::pair<index_extents, domain_extents>>
     from_lua(const sol::table&, const logs& = {});
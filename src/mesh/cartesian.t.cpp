@@ -86,6 +86,27 @@ TEST_CASE("mesh api")
         }
     }
 
+    SECTION("beyond 2^31 points")
+    {
+        // only the coordinate lines are allocated, so this is cheap
+        const int3 n{2048, 2048, 2048};
+        const real3 min{0, 0, 0}, max{1, 1, 1};
+        m = cartesian{n, min, max};
+
+        REQUIRE(m.size() == integer{1} << 33);
+        REQUIRE(m.plane_size(0) == integer{1} << 22);
+
+        for (int i = 0; i < m.dims(); i++) {
+            auto f = m.ucf_ijk2dir(i);
+            REQUIRE(f(int3{n[0] - 1, n[1] - 1, n[2] - 1}) == m.size() - 1);
+
+            auto [fast, slow] = index::dirs(i);
+            int3 ijk{};
+            ijk[slow] = n[slow] - 1;
+            REQUIRE(f(ijk) == m.size() - m.plane_size(slow));
+        }
+    }
+
     SECTION("2d")
     {
         sol::state lua;
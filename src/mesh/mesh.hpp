@@ -64,7 +64,7 @@ public:
     constexpr integer ic(int3 ijk) const
     {
         const auto& n = extents();
-        return ijk[0] * n[1] * n[2] + ijk[1] * n[2] + ijk[2];
+        return (integer)ijk[0] * n[1] * n[2] + (integer)ijk[1] * n[2] + ijk[2];
     }
 
     // Intersection of rays in x and all objects
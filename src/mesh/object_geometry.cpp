@@ -33,8 +33,8 @@ closest_hit(std::span<const shape> shapes, const ray& r, real t_min, real t_max)
 template <int I>
 static void init_line(std::span<const shape> shapes,
                       const std::array<umesh_line, 3>& lines,
-                      std::vector<mesh_object_info>& info,
-                      std::vector<std::vector<mesh_object_info>>& sorted_info)
+                      geometry_vector<mesh_object_info>& info,
+                      std::vector<geometry_vector<mesh_object_info>>& sorted_info)
 {
     sorted_info.resize(shapes.size());
     // handy shortcuts
@@ -125,7 +125,7 @@ static constexpr bool same_plane(const int3& x, const int3& y)
 // [starting_coord, ending_I]
 template <int I>
 static void
-append_solid_points(std::vector<int3>& info, int3 starting_coord, int ending_I)
+append_solid_points(geometry_vector<int3>& info, int3 starting_coord, int ending_I)
 {
     int nitems = ending_I - starting_coord[I] + 1;
     // info.reserve(info.size() + nitems);
@@ -140,7 +140,7 @@ append_solid_points(std::vector<int3>& info, int3 starting_coord, int ending_I)
 template <int I>
 static void init_solid(const std::array<umesh_line, 3>& lines,
                        std::span<const mesh_object_info> r,
-                       std::vector<int3>& info)
+                       geometry_vector<int3>& info)
 {
     constexpr auto S = index::dir<I>::slow;
     constexpr auto F = index::dir<I>::fast;
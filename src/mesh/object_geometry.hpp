@@ -1,6 +1,7 @@
 #pragma once
 
 #include "cartesian.hpp"
+#include "memory.hpp"
 #include "mesh_types.hpp"
 #include "shapes.hpp"
 #include "types.hpp"
@@ -14,20 +15,24 @@
 namespace ccs
 {
 
+// intersection and solid point lists, charged to subsystem::mesh
+template <typename T>
+using geometry_vector = tracked_vector<T, subsystem::mesh>;
+
 class object_geometry
 {
     // mesh / object intersection info for all rays
-    std::vector<mesh_object_info> rx_;
-    std::vector<mesh_object_info> ry_;
-    std::vector<mesh_object_info> rz_;
+    geometry_vector<mesh_object_info> rx_;
+    geometry_vector<mesh_object_info> ry_;
+    geometry_vector<mesh_object_info> rz_;
     // mesh / object intersection info rays organized by shape_id
-    std::vector<std::vector<mesh_object_info>> rx_m_;
-    std::vector<std::vector<mesh_object_info>> ry_m_;
-    std::vector<std::vector<mesh_object_info>> rz_m_;
+    std::vector<geometry_vector<mesh_object_info>> rx_m_;
+    std::vector<geometry_vector<mesh_object_info>> ry_m_;
+    std::vector<geometry_vector<mesh_object_info>> rz_m_;
     // solid points not associated with mesh / object intersections
-    std::vector<int3> sx_;
-    std::vector<int3> sy_;
-    std::vector<int3> sz_;
+    geometry_vector<int3> sx_;
+    geometry_vector<int3> sy_;
+    geometry_vector<int3> sz_;
 
 public:
     object_geometry() = default;
@@ -0,0 +1,48 @@
+#include "slab_decomposition.hpp"
+#include "mesh.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ccs
+{
+
+slab_decomposition::slab_decomposition(const index_extents& extents, int nslabs, int halo)
+    : ext{extents}, halo_{halo}
+{
+    const int nx = ext[0];
+    assert(nslabs > 0);
+    assert(halo >= 0);
+    assert(nx >= nslabs * std::max(halo, 2));
+
+    slabs.reserve(nslabs);
+    const int w = nx / nslabs;
+    const int extra = nx % nslabs;
+    int first = 0;
+    for (int s = 0; s < nslabs; ++s) {
+        const int last = first + w + (s < extra);
+        slabs.push_back(
+            slab{first, last, std::max(first - halo, 0), std::min(last + halo, nx)});
+        first = last;
+    }
+}
+
+mesh slab_mesh(const mesh& m, int lo, int hi)
+{
+    const auto& n = m.extents();
+    const auto x = m.x();
+    const auto y = m.y();
+    const auto z = m.z();
+    return mesh{index_extents{int3{hi - lo, n[1], n[2]}},
+                domain_extents{.min = {x[lo], y.front(), z.front()},
+                               .max = {x[hi - 1], y.back(), z.back()}}};
+}
+
+bcs::Grid slab_bcs(bcs::Grid grid_bcs, int lo, int hi, int nx)
+{
+    if (lo > 0) grid_bcs[0].left = bcs::Floating;
+    if (hi < nx) grid_bcs[0].right = bcs::Floating;
+    return grid_bcs;
+}
+
+} // namespace ccs
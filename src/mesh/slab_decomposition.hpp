@@ -0,0 +1,70 @@
+#pragma once
+
+#include "fields/selection_desc.hpp"
+#include "index_extents.hpp"
+#include "operators/boundaries.hpp"
+
+#include <vector>
+
+namespace ccs
+{
+
+// The x-planes [first, last) owned by one subdomain and the planes [lo, hi) it
+// reads: the owned planes plus up to `halo` planes on each side, clipped to the
+// domain.  x is the slowest index so both are contiguous ranges of a D buffer.
+struct slab {
+    int first;
+    int last;
+    int lo;
+    int hi;
+};
+
+//
+// Split of a cartesian mesh into slabs of whole x-planes, e.g. one per NUMA
+// domain of the host.  Slab widths differ by at most one plane and every slab
+// owns at least max(halo, 2) planes, so a halo never reaches past a neighbour.
+//
+class slab_decomposition
+{
+    index_extents ext;
+    int halo_;
+    std::vector<slab> slabs;
+
+public:
+    slab_decomposition() = default;
+
+    slab_decomposition(const index_extents& extents, int nslabs, int halo);
+
+    int size() const { return static_cast<int>(slabs.size()); }
+    int halo() const { return halo_; }
+    const index_extents& extents() const { return ext; }
+    const slab& operator[](int s) const { return slabs[s]; }
+
+    // points in one x-plane
+    integer plane_size() const { return (integer)ext[1] * ext[2]; }
+
+    // flat ranges of slab s in a global D buffer: owned planes, and owned plus
+    // halo planes
+    contiguous_selection owned(int s) const
+    {
+        const auto& sl = slabs[s];
+        return {sl.first * plane_size(), (sl.last - sl.first) * plane_size()};
+    }
+
+    contiguous_selection padded(int s) const
+    {
+        const auto& sl = slabs[s];
+        return {sl.lo * plane_size(), (sl.hi - sl.lo) * plane_size()};
+    }
+};
+
+class mesh;
+
+// Mesh of the planes [lo, hi) of m, with the spacing of m
+mesh slab_mesh(const mesh& m, int lo, int hi);
+
+// grid_bcs with Floating conditions on the faces of [lo, hi) that lie inside a
+// domain of nx planes: they are cut faces, not boundaries
+bcs::Grid slab_bcs(bcs::Grid grid_bcs, int lo, int hi, int nx);
+
+} // namespace ccs
@@ -0,0 +1,60 @@
+#include "slab_decomposition.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ccs;
+
+TEST_CASE("slabs cover the x-planes")
+{
+    const index_extents ext{int3{23, 5, 7}};
+    const int plane = 5 * 7;
+
+    for (int nslabs = 1; nslabs <= 5; ++nslabs) {
+        auto d = slab_decomposition{ext, nslabs, 2};
+        REQUIRE(d.size() == nslabs);
+        REQUIRE(d.plane_size() == plane);
+        REQUIRE(d[0].first == 0);
+        REQUIRE(d[nslabs - 1].last == 23);
+
+        integer owned = 0;
+        for (int s = 0; s < nslabs; ++s) {
+            const auto& sl = d[s];
+            // balanced to within one plane
+            REQUIRE(sl.last - sl.first >= 23 / nslabs);
+            REQUIRE(sl.last - sl.first <= 23 / nslabs + 1);
+            if (s > 0) REQUIRE(sl.first == d[s - 1].last);
+
+            REQUIRE(d.owned(s).offset_ == sl.first * plane);
+            REQUIRE(d.owned(s).count() == (sl.last - sl.first) * plane);
+            owned += d.owned(s).count();
+        }
+        REQUIRE(owned == ext.size());
+    }
+}
+
+TEST_CASE("halo planes are clipped to the domain")
+{
+    auto d = slab_decomposition{index_extents{int3{12, 3, 1}}, 3, 2};
+
+    REQUIRE(d[0].first == 0);
+    REQUIRE(d[0].last == 4);
+    REQUIRE(d[0].lo == 0);
+    REQUIRE(d[0].hi == 6);
+
+    REQUIRE(d[1].lo == 2);
+    REQUIRE(d[1].hi == 10);
+
+    REQUIRE(d[2].lo == 6);
+    REQUIRE(d[2].hi == 12);
+
+    // padded range of the middle slab: 2 halo planes on each side
+    REQUIRE(d.padded(1).offset_ == 2 * 3);
+    REQUIRE(d.padded(1).count() == 8 * 3);
+
+    // no halo: padded and owned coincide
+    auto n = slab_decomposition{index_extents{int3{12, 3, 1}}, 3, 0};
+    for (int s = 0; s < n.size(); ++s) {
+        REQUIRE(n.padded(s).offset_ == n.owned(s).offset_);
+        REQUIRE(n.padded(s).count() == n.owned(s).count());
+    }
+}
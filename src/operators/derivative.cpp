@@ -1,11 +1,15 @@
 #include "derivative.hpp"
+#include "stencils/nbs_cache.hpp"
 
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <map>
 #include <ranges>
 #include <span>
+#include <thread>
 #include <vector>
 
 namespace ccs
@@ -111,7 +115,7 @@ struct OB_builder {
         ++it;
 
         // handle interior
-        for (int ic = left_ic + stride; ic < right_ic; ic += stride) {
+        for (integer ic = left_ic + stride; ic < right_ic; ic += stride) {
             O.add_point(shape_row, ic, deriv_coeff * *it);
             ++it;
         }
@@ -156,6 +160,25 @@ struct OB_builder {
     }
 };
 
+// Assembly runs in one contiguous chunk of lines/points per host thread.  Each
+// chunk owns its scratch and builders; results are merged on the calling thread,
+// which also creates any device views (they may not be allocated in a kernel).
+int chunk_count(integer n)
+{
+    return std::max(1, std::min<int>(exec_space().concurrency(), n));
+}
+
+template <typename F>
+void for_each_chunk(int nchunks, integer n, F&& f)
+{
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<execution_space>(exec_space(), 0, nchunks), [&](int k) {
+            f(k,
+              static_cast<integer>((std::int64_t)n * k / nchunks),
+              static_cast<integer>((std::int64_t)n * (k + 1) / nchunks));
+        });
+}
+
 void cut_discretization(int r,
                         int dir,
                         const mesh& m,
@@ -174,85 +197,114 @@ void cut_discretization(int r,
         std::ranges::all_of(obj_bcs, [](auto bc) { return bc == bcs::Dirichlet; }))
         return; // quick exit'
 
-    auto [p, rmax, tmax, ex_max] = st.query_max();
     auto h = m.h(dir);
-
-    OB_builder builder{};
-
-    // allocate maximum amount of memory required by any boundary conditions
-    std::vector<real> c(rmax * tmax);
-    std::vector<real> interp_c(tmax);
-    std::vector<real> extra(ex_max);
     auto stride = m.stride(dir);
 
-    if (dir == r) {
-        // no interpolation needed for this case
-        for (integer shape_row = 0; shape_row < (integer)sz; ++shape_row) {
-            const auto& obj = shapes[shape_row];
-            auto bc_t = obj_bcs[obj.shape_id];
-            // nothing to do for dirichlet
-            if (bc_t == bcs::Dirichlet) continue;
-
-            auto&& [pObj, rObj, tObj, exObj] = st.query(bc_t);
-            st.nbs(h, bc_t, obj.psi, obj.ray_outside, c, extra);
-
-            if (obj.ray_outside) {
-                auto sub = std::span{c}.subspan((rObj - 1) * tObj, tObj);
-                std::vector<real> rng(sub.begin(), sub.end());
-                std::ranges::reverse(rng);
-                builder.add_cut_row(shape_row, m.ic(obj.solid_coord), -stride, rng);
-            } else {
-                auto rng = std::span{c}.subspan(0, tObj);
-                builder.add_cut_row(shape_row, m.ic(obj.solid_coord), stride, rng);
+    const int nchunks = chunk_count(sz);
+    std::vector<OB_builder> builders(nchunks);
+    // log messages are kept per row so they are emitted in row order
+    std::vector<std::string> msgs(logger && dir != r ? sz : 0);
+
+    for_each_chunk(nchunks, sz, [&](int chunk, integer first, integer last) {
+        auto& builder = builders[chunk];
+
+        // allocate maximum amount of memory required by any boundary conditions
+        auto [p, rmax, tmax, ex_max] = st.query_max();
+        std::vector<real> c(rmax * tmax);
+        std::vector<real> interp_c(tmax);
+        std::vector<real> extra(ex_max);
+
+        if (dir == r) {
+            // closures of the chunk's cut points, computed in one batched call
+            // per boundary type and side
+            stencils::nbs_cache closures{st, h};
+            {
+                std::map<std::pair<bcs::type, bool>, std::vector<real>> psi{};
+                for (integer shape_row = first; shape_row < last; ++shape_row) {
+                    const auto& obj = shapes[shape_row];
+                    auto bc_t = obj_bcs[obj.shape_id];
+                    if (bc_t != bcs::Dirichlet)
+                        psi[{bc_t, obj.ray_outside}].push_back(obj.psi);
+                }
+                for (auto&& [k, v] : psi) closures.fill(k.first, k.second, v);
             }
-        }
-    } else {
-        for (integer shape_row = 0; shape_row < (integer)sz; ++shape_row) {
-            const auto& obj = shapes[shape_row];
-            auto bc_t = obj_bcs[obj.shape_id];
-            // nothing to do for dirichlet
-            if (bc_t == bcs::Dirichlet) continue;
-
-            auto [c_line, cp_shift] = interp_deriv_coefficients(
-                dir, m.extents()[dir] - 1, h, obj, bc_t, st, c, extra);
-
-            // get starting coordinates of closest point
-            int3 cp = [&obj, r, dir, cp_shift]() {
-                int3 ray = obj.solid_coord;
-                if (obj.psi <= 0.5) ray[r] += 1 - 2 * obj.ray_outside;
-                ray[dir] += cp_shift;
-                return ray;
-            }();
-
-            // Set interp distance y for interp stencils in (i + y) format
-            const real y = [&obj]() {
-                real sign = obj.ray_outside ? 1.0 : -1.0;
-                return sign * (obj.psi <= 0.5 ? obj.psi : obj.psi - 1);
-            }();
-
-            // prepare the log message if we are logging
-            std::string msg{};
-            if (logger)
-                msg = fmt::format("{},{},{},{},{}", dir, r, shape_row, y, obj.psi);
-
-            for (auto&& v : c_line) {
-                if (cp[dir] == obj.solid_coord[dir]) {
-                    builder.add_cut_point(shape_row, v);
+
+            // no interpolation needed for this case
+            for (integer shape_row = first; shape_row < last; ++shape_row) {
+                const auto& obj = shapes[shape_row];
+                auto bc_t = obj_bcs[obj.shape_id];
+                // nothing to do for dirichlet
+                if (bc_t == bcs::Dirichlet) continue;
+
+                auto&& [pObj, rObj, tObj, exObj] = st.query(bc_t);
+                auto cObj = closures(bc_t, obj.ray_outside, obj.psi).c;
+
+                if (obj.ray_outside) {
+                    auto sub = cObj.subspan((rObj - 1) * tObj, tObj);
+                    std::vector<real> rng(sub.begin(), sub.end());
+                    std::ranges::reverse(rng);
+                    builder.add_cut_row(shape_row, m.ic(obj.solid_coord), -stride, rng);
                 } else {
-                    auto&& [r_stride, left_bounds, right_bounds] = m.interp_line(r, cp);
-                    auto&& [interp_v, left, right] =
-                        st.interp(r, cp, y, left_bounds, right_bounds, interp_c);
-                    builder.add_interp_row(
-                        shape_row, v, interp_v, left, right, r_stride, m, msg);
+                    auto rng = cObj.subspan(0, tObj);
+                    builder.add_cut_row(shape_row, m.ic(obj.solid_coord), stride, rng);
                 }
-                ++cp[dir];
             }
+        } else {
+            for (integer shape_row = first; shape_row < last; ++shape_row) {
+                const auto& obj = shapes[shape_row];
+                auto bc_t = obj_bcs[obj.shape_id];
+                // nothing to do for dirichlet
+                if (bc_t == bcs::Dirichlet) continue;
+
+                auto [c_line, cp_shift] = interp_deriv_coefficients(
+                    dir, m.extents()[dir] - 1, h, obj, bc_t, st, c, extra);
+
+                // get starting coordinates of closest point
+                int3 cp = [&obj, r, dir, cp_shift]() {
+                    int3 ray = obj.solid_coord;
+                    if (obj.psi <= 0.5) ray[r] += 1 - 2 * obj.ray_outside;
+                    ray[dir] += cp_shift;
+                    return ray;
+                }();
+
+                // Set interp distance y for interp stencils in (i + y) format
+                const real y = [&obj]() {
+                    real sign = obj.ray_outside ? 1.0 : -1.0;
+                    return sign * (obj.psi <= 0.5 ? obj.psi : obj.psi - 1);
+                }();
+
+                // prepare the log message if we are logging
+                std::string msg{};
+                if (logger)
+                    msg = fmt::format("{},{},{},{},{}", dir, r, shape_row, y, obj.psi);
+
+                for (auto&& v : c_line) {
+                    if (cp[dir] == obj.solid_coord[dir]) {
+                        builder.add_cut_point(shape_row, v);
+                    } else {
+                        auto&& [r_stride, left_bounds, right_bounds] = m.interp_line(r, cp);
+                        auto&& [interp_v, left, right] =
+                            st.interp(r, cp, y, left_bounds, right_bounds, interp_c);
+                        builder.add_interp_row(
+                            shape_row, v, interp_v, left, right, r_stride, m, msg);
+                    }
+                    ++cp[dir];
+                }
 
-            logger(spdlog::level::info, msg);
+                if (logger) msgs[shape_row] = MOVE(msg);
+            }
         }
-    }
+    });
+
+    for (auto&& msg : msgs)
+        if (msg.size()) logger(spdlog::level::info, msg);
 
     // construct ray in 'dir` emanative from R(r)
+    OB_builder builder{};
+    for (auto&& b : builders) {
+        builder.O.append(MOVE(b.O));
+        builder.B.append(MOVE(b.B));
+    }
     builder.to_csr(r, O, B, sz);
 }
 
@@ -302,6 +354,17 @@ struct submatrix_size {
     integer right_row(integer row = 0) const { return last_row + stride * row; }
 };
 
+// Host-side result of discretizing one line.  The dense/circulant matrices are
+// built from it after the parallel pass.
+struct line_discretization {
+    bool skip = true;
+    submatrix_size sub;
+    integer left_rows = 0, left_cols = 0;
+    integer right_rows = 0, right_cols = 0;
+    std::vector<real> left, right;
+    flag left_flags = 0, right_flags = 0;
+};
+
 void domain_discretization(int dir,
                            const mesh& m,
                            const stencil& st,
@@ -312,131 +375,168 @@ void domain_discretization(int dir,
                            matrix::csr& N,
                            std::span<const real> interior)
 {
-    // query the stencil and allocate memory
-    auto [p, rmax, tmax, ex_max] = st.query_max();
     auto h = m.h(dir);
 
-    // allocate maximum amount of memory required by any boundary conditions
-    std::vector<real> left(rmax * tmax);
-    std::vector<real> right(rmax * tmax);
-    std::vector<real> extra(ex_max);
-
-    auto B_builder = matrix::csr::builder();
-    auto O_builder = matrix::block::builder();
-    auto N_builder = matrix::csr::builder();
-
-    for (auto [stride, start, end] : m.lines(dir)) {
-        if (m.dirichlet_line(start.mesh_coordinate, dir, grid_bcs)) continue;
-
-        // start with assumption of square matrix and adjust based on boundary conditions
-        auto sub = submatrix_size{dir, stride, start, end, m};
+    const auto& mesh_lines = m.lines(dir);
+    const auto nlines = (integer)mesh_lines.size();
+    const int nchunks = chunk_count(nlines);
+
+    std::vector<line_discretization> lines(nlines);
+    std::vector<matrix::csr::builder> B_builders(nchunks);
+    std::vector<matrix::csr::builder> N_builders(nchunks);
+
+    for_each_chunk(nchunks, nlines, [&](int chunk, integer first, integer last) {
+        auto& B_builder = B_builders[chunk];
+        auto& N_builder = N_builders[chunk];
+
+        // query the stencil and allocate the maximum amount of memory required by
+        // any boundary conditions
+        auto [p, rmax, tmax, ex_max] = st.query_max();
+        std::vector<real> left(rmax * tmax);
+        std::vector<real> right(rmax * tmax);
+        std::vector<real> extra(ex_max);
+        // lines ending on objects share closures with equal psi
+        stencils::nbs_cache closures{st, h};
+
+        for (integer i = first; i < last; ++i) {
+            auto [stride, start, end] = mesh_lines[i];
+            if (m.dirichlet_line(start.mesh_coordinate, dir, grid_bcs)) continue;
+
+            auto& ld = lines[i];
+            ld.skip = false;
+
+            // start with assumption of square matrix and adjust based on boundary
+            // conditions
+            auto& sub = ld.sub;
+            sub = submatrix_size{dir, stride, start, end, m};
+
+            if (const auto& obj = start.object; obj) {
+                const auto id = obj->objectID;
+                assert(id < (integer)obj_bcs.size());
+                const auto bc_t = obj_bcs[id];
+
+                auto&& [pLeft, rLeft, tLeft, exLeft] = st.query(bc_t);
+                std::ranges::copy(closures(bc_t, false, obj->psi).c, left.begin());
+
+                // change to allow something other than dirichlet
+                // In the case of non-dirichlet bc's on the object, we need to skip the
+                // first row as it will be handled in the Rx/y/z operators
+                int s = bc_t != bcs::Dirichlet;
+                rLeft -= s;
+                auto lc = std::span{left}.subspan(s * tLeft);
+
+                // Build dense matrix: skip first column of each row
+                ld.left.reserve(rLeft * (tLeft - 1));
+                for (int row = 0; row < rLeft; ++row) {
+                    auto row_span = lc.subspan(row * tLeft + 1, tLeft - 1);
+                    ld.left.insert(ld.left.end(), row_span.begin(), row_span.end());
+                }
+                ld.left_rows = rLeft;
+                ld.left_cols = tLeft - 1;
 
-        auto leftMat = matrix::dense{};
+                sub.remove_left_row_col();
 
-        if (const auto& obj = start.object; obj) {
-            const auto id = obj->objectID;
-            assert(id < (integer)obj_bcs.size());
-            const auto bc_t = obj_bcs[id];
+                // add points to B (first element of each row = stride by tLeft)
+                for (int row = 0; row < rLeft; ++row) {
+                    B_builder.add_point(
+                        sub.left_row(row), obj->object_coordinate, lc[row * tLeft]);
+                }
 
-            auto&& [pLeft, rLeft, tLeft, exLeft] = st.query(bc_t);
-            st.nbs(h, bc_t, obj->psi, false, left, extra);
+            } else {
+                auto&& [pLeft, rLeft, tLeft, exLeft] = st.query(grid_bcs[dir].left);
+                st.nbs(h, grid_bcs[dir].left, 1.0, false, left, extra);
+
+                ld.left.assign(left.begin(), left.begin() + rLeft * tLeft);
+                ld.left_rows = rLeft;
+                ld.left_cols = tLeft;
+                if (grid_bcs[dir].left == bcs::Dirichlet) {
+                    sub.remove_left_row();
+                    ld.left_flags = ldd;
+                } else if (grid_bcs[dir].left == bcs::Neumann) {
+                    // add data to N matrix
+                    for (int row = 0; row < exLeft; row++) {
+                        N_builder.add_point(sub.left_row(row), sub.left_row(), extra[row]);
+                    }
+                }
+            }
 
-            // change to allow something other than dirichlet
-            // In the case of non-dirichlet bc's on the object, we need to skip the
-            // first row as it will be handled in the Rx/y/z operators
-            int s = bc_t != bcs::Dirichlet;
-            rLeft -= s;
-            auto lc = std::span{left}.subspan(s * tLeft);
+            if (const auto& obj = end.object; obj) {
+                const auto id = obj->objectID;
+                assert(id < (integer)obj_bcs.size());
+                const auto bc_t = obj_bcs[id];
 
-            // Build dense matrix: skip first column of each row
-            std::vector<real> dense_data;
-            dense_data.reserve(rLeft * (tLeft - 1));
-            for (int row = 0; row < rLeft; ++row) {
-                auto row_span = lc.subspan(row * tLeft + 1, tLeft - 1);
-                dense_data.insert(dense_data.end(), row_span.begin(), row_span.end());
-            }
-            leftMat = matrix::dense{rLeft, tLeft - 1, dense_data};
+                auto&& [pRight, rRight, tRight, exRight] = st.query(bc_t);
+                std::ranges::copy(closures(bc_t, true, obj->psi).c, right.begin());
 
-            sub.remove_left_row_col();
+                integer s = bc_t != bcs::Dirichlet;
+                rRight -= s;
+                auto rc = std::span{right}.subspan(0, rRight * tRight);
 
-            // add points to B (first element of each row = stride by tLeft)
-            for (int row = 0; row < rLeft; ++row) {
-                B_builder.add_point(sub.left_row(row), obj->object_coordinate, lc[row * tLeft]);
-            }
+                // Build dense matrix: take first (tRight-1) columns of each row
+                ld.right.reserve(rRight * (tRight - 1));
+                for (int row = 0; row < rRight; ++row) {
+                    auto row_span = rc.subspan(row * tRight, tRight - 1);
+                    ld.right.insert(ld.right.end(), row_span.begin(), row_span.end());
+                }
+                ld.right_rows = rRight;
+                ld.right_cols = tRight - 1;
+                sub.remove_right_row_col();
+
+                // add points to B (last element of each row)
+                for (int row = 0; row < rRight; ++row) {
+                    auto val = rc[row * tRight + tRight - 1];
+                    B_builder.add_point(
+                        sub.right_row(row - rRight), obj->object_coordinate, val);
+                }
 
-        } else {
-            auto&& [pLeft, rLeft, tLeft, exLeft] = st.query(grid_bcs[dir].left);
-            st.nbs(h, grid_bcs[dir].left, 1.0, false, left, extra);
-
-            leftMat = matrix::dense{rLeft, tLeft, left};
-            if (grid_bcs[dir].left == bcs::Dirichlet) {
-                sub.remove_left_row();
-                leftMat.flags(ldd);
-            } else if (grid_bcs[dir].left == bcs::Neumann) {
-                // add data to N matrix
-                for (int row = 0; row < exLeft; row++) {
-                    N_builder.add_point(sub.left_row(row), sub.left_row(), extra[row]);
+            } else {
+                auto&& [pRight, rRight, tRight, exRight] = st.query(grid_bcs[dir].right);
+                st.nbs(h, grid_bcs[dir].right, 1.0, true, right, extra);
+
+                ld.right.assign(right.begin(), right.begin() + rRight * tRight);
+                ld.right_rows = rRight;
+                ld.right_cols = tRight;
+                if (grid_bcs[dir].right == bcs::Dirichlet) {
+                    sub.remove_right_row();
+                    ld.right_flags = rdd;
+                } else if (grid_bcs[dir].right == bcs::Neumann) {
+                    for (int row = 0; row < exRight; row++) {
+                        N_builder.add_point(
+                            sub.right_row(row - exRight + 1), sub.right_row(), extra[row]);
+                    }
                 }
             }
         }
+    });
 
-        auto rightMat = matrix::dense{};
-
-        if (const auto& obj = end.object; obj) {
-            const auto id = obj->objectID;
-            assert(id < (integer)obj_bcs.size());
-            const auto bc_t = obj_bcs[id];
-
-            auto&& [pRight, rRight, tRight, exRight] = st.query(bc_t);
-            st.nbs(h, bc_t, obj->psi, true, right, extra);
+    auto O_builder = matrix::block::builder(nlines);
+    for (auto&& ld : lines) {
+        if (ld.skip) continue;
 
-            integer s = bc_t != bcs::Dirichlet;
-            rRight -= s;
-            auto rc = std::span{right}.subspan(0, rRight * tRight);
+        auto leftMat = matrix::dense{ld.left_rows, ld.left_cols, ld.left};
+        leftMat.flags(ld.left_flags);
+        auto rightMat = matrix::dense{ld.right_rows, ld.right_cols, ld.right};
+        rightMat.flags(ld.right_flags);
 
-            // Build dense matrix: take first (tRight-1) columns of each row
-            std::vector<real> dense_data;
-            dense_data.reserve(rRight * (tRight - 1));
-            for (int row = 0; row < rRight; ++row) {
-                auto row_span = rc.subspan(row * tRight, tRight - 1);
-                dense_data.insert(dense_data.end(), row_span.begin(), row_span.end());
-            }
-            rightMat = matrix::dense{rRight, tRight - 1, dense_data};
-            sub.remove_right_row_col();
-
-            // add points to B (last element of each row)
-            for (int row = 0; row < rRight; ++row) {
-                auto val = rc[row * tRight + tRight - 1];
-                B_builder.add_point(
-                    sub.right_row(row - rRight), obj->object_coordinate, val);
-            }
-
-        } else {
-            auto&& [pRight, rRight, tRight, exRight] = st.query(grid_bcs[dir].right);
-            st.nbs(h, grid_bcs[dir].right, 1.0, true, right, extra);
-
-            rightMat = matrix::dense{rRight, tRight, right};
-            if (grid_bcs[dir].right == bcs::Dirichlet) {
-                sub.remove_right_row();
-                rightMat.flags(rdd);
-            } else if (grid_bcs[dir].right == bcs::Neumann) {
-                for (int row = 0; row < exRight; row++) {
-                    N_builder.add_point(
-                        sub.right_row(row - exRight + 1), sub.right_row(), extra[row]);
-                }
-            }
-        }
-        const integer n_interior = sub.rows - leftMat.rows() - rightMat.rows();
+        const auto& sub = ld.sub;
+        const integer n_interior = sub.rows - ld.left_rows - ld.right_rows;
 
         O_builder.add_inner_block(sub.columns,
                                   sub.row_offset,
                                   sub.col_offset,
-                                  stride,
+                                  sub.stride,
                                   MOVE(leftMat),
                                   matrix::circulant{n_interior, interior},
                                   MOVE(rightMat));
     }
 
+    auto B_builder = matrix::csr::builder();
+    auto N_builder = matrix::csr::builder();
+    for (int k = 0; k < nchunks; ++k) {
+        B_builder.append(MOVE(B_builders[k]));
+        N_builder.append(MOVE(N_builders[k]));
+    }
+
     O = MOVE(O_builder).to_block();
     B = MOVE(B_builder.to_csr(m.size()));
     N = MOVE(N_builder.to_csr(m.size()));
@@ -472,6 +572,44 @@ derivative::derivative(int dir,
     cut_discretization(2, dir, m, st, grid_bcs, obj_bcs, Bfz, Brz, interior_c, logger);
 }
 
+std::array<derivative, 3> make_derivatives(const mesh& m,
+                                           const stencil& st,
+                                           const bcs::Grid& grid_bcs,
+                                           const bcs::Object& obj_bcs,
+                                           const logs& logger)
+{
+    std::array<derivative, 3> d{};
+    std::vector<int> dirs;
+    for (int dir = 0; dir < 3; ++dir) {
+        if (m.extents()[dir] > 1)
+            dirs.push_back(dir);
+        else
+            d[dir] = derivative{dir, m, st, grid_bcs, obj_bcs, logger};
+    }
+
+    const int n = static_cast<int>(dirs.size());
+    if (n < 2 || exec_space().concurrency() < n) {
+        for (int dir : dirs) d[dir] = derivative{dir, m, st, grid_bcs, obj_bcs, logger};
+        return d;
+    }
+
+    // each direction splits its own partition into assembly chunks
+    auto instances =
+        Kokkos::Experimental::partition_space(exec_space(), std::vector<int>(n, 1));
+    std::vector<std::jthread> threads;
+    threads.reserve(n);
+    for (int k = 0; k < n; ++k)
+        threads.emplace_back([&, k] {
+            scoped_exec_space scope{instances[k]};
+            const int dir = dirs[k];
+            d[dir] = derivative{dir, m, st, grid_bcs, obj_bcs, logger};
+            instances[k].fence("derivative assembly complete");
+        });
+    threads.clear(); // joins
+
+    return d;
+}
+
 template <typename Op>
     requires std::invocable<Op, real&, real>
 void derivative::apply_kernels(scalar_view u, scalar_span du, Op op) const
@@ -505,7 +643,7 @@ void derivative::operator()(scalar_view u, scalar_span du, Op op) const
 {
     Kokkos::Profiling::ScopedRegion region("derivative::operator()");
     apply_kernels(u, du, op);
-    Kokkos::fence("derivative::operator() complete");
+    exec_space().fence("derivative::operator() complete");
 }
 
 template <typename Op>
@@ -515,7 +653,149 @@ void derivative::operator()(scalar_view u, scalar_view nu, scalar_span du, Op op
     Kokkos::Profiling::ScopedRegion region("derivative::operator()");
     apply_kernels(u, du, op);
     N(nu.D, du.D);
-    Kokkos::fence("derivative::operator() with Neumann complete");
+    exec_space().fence("derivative::operator() with Neumann complete");
+}
+
+void derivative::apply_closure(scalar_view u, scalar_span du) const
+{
+    Kokkos::Profiling::ScopedRegion region("derivative::apply_closure()");
+
+    // update points in R
+    Bfx(u.D, du.Rx);
+    Bfy(u.D, du.Ry);
+    Bfz(u.D, du.Rz);
+
+    Brx(u.Rx, du.Rx);
+    Bry(u.Ry, du.Ry);
+    Brz(u.Rz, du.Rz);
+
+    // update the closure rows of the fluid domain
+    O.apply_part<matrix::row_part::closure>(u.D, du.D);
+    switch (dir) {
+    case 0:
+        B(u.Rx, du.D);
+        break;
+    case 1:
+        B(u.Ry, du.D);
+        break;
+    default:
+        B(u.Rz, du.D);
+    }
+    exec_space().fence("derivative::apply_closure() complete");
+}
+
+void derivative::accumulate_weighted(scalar_view u, scalar_view w, scalar_span du) const
+{
+    Kokkos::Profiling::ScopedRegion region("derivative::accumulate_weighted()");
+
+    // update points in R
+    Bfx(u.D, du.Rx, w.Rx.data());
+    Bfy(u.D, du.Ry, w.Ry.data());
+    Bfz(u.D, du.Rz, w.Rz.data());
+
+    Brx(u.Rx, du.Rx, w.Rx.data());
+    Bry(u.Ry, du.Ry, w.Ry.data());
+    Brz(u.Rz, du.Rz, w.Rz.data());
+
+    // update fluid domain
+    O(u.D, du.D, weighted_plus_eq_t{w.D.data()});
+    switch (dir) {
+    case 0:
+        B(u.Rx, du.D, w.D.data());
+        break;
+    case 1:
+        B(u.Ry, du.D, w.D.data());
+        break;
+    default:
+        B(u.Rz, du.D, w.D.data());
+    }
+    exec_space().fence("derivative::accumulate_weighted() complete");
+}
+
+void derivative::accumulate_weighted_closure(scalar_view u,
+                                             scalar_view w,
+                                             scalar_span du) const
+{
+    Kokkos::Profiling::ScopedRegion region("derivative::accumulate_weighted_closure()");
+
+    // update points in R
+    Bfx(u.D, du.Rx, w.Rx.data());
+    Bfy(u.D, du.Ry, w.Ry.data());
+    Bfz(u.D, du.Rz, w.Rz.data());
+
+    Brx(u.Rx, du.Rx, w.Rx.data());
+    Bry(u.Ry, du.Ry, w.Ry.data());
+    Brz(u.Rz, du.Rz, w.Rz.data());
+
+    // update the closure rows of the fluid domain
+    O.apply_part<matrix::row_part::closure>(u.D, du.D, weighted_plus_eq_t{w.D.data()});
+    switch (dir) {
+    case 0:
+        B(u.Rx, du.D, w.D.data());
+        break;
+    case 1:
+        B(u.Ry, du.D, w.D.data());
+        break;
+    default:
+        B(u.Rz, du.D, w.D.data());
+    }
+    exec_space().fence("derivative::accumulate_weighted_closure() complete");
+}
+
+std::array<matrix::batch<const real>, 4>
+derivative::batch_buffers(std::span<const scalar_view> u)
+{
+    assert(std::ssize(u) <= matrix::batch<const real>::max_size);
+    std::array<matrix::batch<const real>, 4> b{};
+    for (auto&& s : u) {
+        b[0].push_back(s.D.data());
+        b[1].push_back(s.Rx.data());
+        b[2].push_back(s.Ry.data());
+        b[3].push_back(s.Rz.data());
+    }
+    return b;
+}
+
+std::array<matrix::batch<real>, 4> derivative::batch_buffers(std::span<const scalar_span> u)
+{
+    assert(std::ssize(u) <= matrix::batch<real>::max_size);
+    std::array<matrix::batch<real>, 4> b{};
+    for (auto&& s : u) {
+        b[0].push_back(s.D.data());
+        b[1].push_back(s.Rx.data());
+        b[2].push_back(s.Ry.data());
+        b[3].push_back(s.Rz.data());
+    }
+    return b;
+}
+
+template <typename Op>
+    requires std::invocable<Op, real&, real>
+void derivative::apply_batch(std::span<const scalar_view> u,
+                             std::span<const scalar_view> nu,
+                             std::span<const scalar_span> du,
+                             Op op) const
+{
+    Kokkos::Profiling::ScopedRegion region("derivative::apply_batch()");
+    assert(u.size() == du.size() && (nu.empty() || nu.size() == u.size()));
+
+    const auto ub = batch_buffers(u);
+    const auto db = batch_buffers(du);
+
+    // update points in R
+    Bfx(ub[0], db[1]);
+    Bfy(ub[0], db[2]);
+    Bfz(ub[0], db[3]);
+
+    Brx(ub[1], db[1]);
+    Bry(ub[2], db[2]);
+    Brz(ub[3], db[3]);
+
+    // update fluid domain
+    O(ub[0], db[0], op);
+    B(ub[1 + dir], db[0]);
+    if (!nu.empty()) N(batch_buffers(nu)[0], db[0]);
+    exec_space().fence("derivative::apply_batch() complete");
 }
 
 template <typename Op>
@@ -532,7 +812,7 @@ void derivative::build_graph(scalar_view u, scalar_span du, Op op)
     real* du_Rz = du.Rz.data();
     const real* b_src = (dir == 0) ? u_Rx : (dir == 1) ? u_Ry : u_Rz;
 
-    graph_ = Kokkos::Experimental::create_graph<execution_space>(
+    graph_ = Kokkos::Experimental::create_graph(exec_space(),
         [&](auto root) {
             // R-space chains (3 independent pairs)
             auto bfx = Bfx.graph_node(root, u_D, du_Rx);
@@ -550,6 +830,7 @@ void derivative::build_graph(scalar_view u, scalar_span du, Op op)
         });
 
     graph_->instantiate();
+    graph_work_ = cost(1, !std::same_as<Op, eq_t>);
 }
 
 template <typename Op>
@@ -567,7 +848,7 @@ void derivative::build_graph(scalar_view u, scalar_view nu, scalar_span du, Op o
     real* du_Rz = du.Rz.data();
     const real* b_src = (dir == 0) ? u_Rx : (dir == 1) ? u_Ry : u_Rz;
 
-    graph_ = Kokkos::Experimental::create_graph<execution_space>(
+    graph_ = Kokkos::Experimental::create_graph(exec_space(),
         [&](auto root) {
             // R-space chains (3 independent pairs)
             auto bfx = Bfx.graph_node(root, u_D, du_Rx);
@@ -586,13 +867,34 @@ void derivative::build_graph(scalar_view u, scalar_view nu, scalar_span du, Op o
         });
 
     graph_->instantiate();
+    graph_work_ = cost(1, !std::same_as<Op, eq_t>);
 }
 
 void derivative::submit_graph()
 {
     Kokkos::Profiling::ScopedRegion region("derivative::submit_graph()");
+    report_work(graph_work_);
     graph_->submit();
-    Kokkos::fence("derivative::submit_graph() complete");
+    exec_space().fence("derivative::submit_graph() complete");
+}
+
+work derivative::cost(int k, bool accumulate) const
+{
+    return O.cost(k, sizeof(real), accumulate) + B.cost(k) + N.cost(k) + Bfx.cost(k) +
+           Brx.cost(k) + Bfy.cost(k) + Bry.cost(k) + Bfz.cost(k) + Brz.cost(k);
+}
+
+work derivative::closure_cost(bool accumulate) const
+{
+    return O.cost<matrix::row_part::closure>(1, sizeof(real), accumulate) + B.cost(1) +
+           Bfx.cost(1) + Brx.cost(1) + Bfy.cost(1) + Bry.cost(1) + Bfz.cost(1) +
+           Brz.cost(1);
+}
+
+void derivative::tune(matrix::autotuner& tuner)
+{
+    O.tune(tuner);
+    for (auto* m : {&B, &N, &Bfx, &Brx, &Bfy, &Bry, &Bfz, &Brz}) m->tune(tuner);
 }
 
 template void derivative::operator()<eq_t>(scalar_view, scalar_span, eq_t) const;
@@ -606,6 +908,15 @@ derivative::operator()<eq_t>(scalar_view, scalar_view, scalar_span, eq_t) const;
 template void
 derivative::operator()<plus_eq_t>(scalar_view, scalar_view, scalar_span, plus_eq_t) const;
 
+template void derivative::apply_batch<eq_t>(std::span<const scalar_view>,
+                                           std::span<const scalar_view>,
+                                           std::span<const scalar_span>,
+                                           eq_t) const;
+template void derivative::apply_batch<plus_eq_t>(std::span<const scalar_view>,
+                                                std::span<const scalar_view>,
+                                                std::span<const scalar_span>,
+                                                plus_eq_t) const;
+
 template void derivative::build_graph<eq_t>(scalar_view, scalar_span, eq_t);
 template void derivative::build_graph<plus_eq_t>(scalar_view, scalar_span, plus_eq_t);
 template void derivative::build_graph<eq_t>(scalar_view, scalar_view, scalar_span, eq_t);
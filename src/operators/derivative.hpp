@@ -6,6 +6,7 @@
 #include "fields/scalar.hpp"
 #include "matrices/block.hpp"
 #include "matrices/csr.hpp"
+#include "matrices/line_solver.hpp"
 #include "matrices/matrix_visitor.hpp"
 #include "mesh/mesh.hpp"
 #include "stencils/stencil.hpp"
@@ -13,7 +14,9 @@
 #include "io/logging.hpp"
 
 #include <Kokkos_Graph.hpp>
+#include <array>
 #include <optional>
+#include <span>
 
 namespace ccs
 {
@@ -30,6 +33,12 @@ class derivative
     matrix::csr Bfz, Brz;
     // Pre-built graph for submit_graph().
     std::optional<Kokkos::Experimental::Graph<execution_space>> graph_;
+    work graph_work_{};
+
+    // Gather buffer b (0 = D, 1/2/3 = Rx/Ry/Rz) of every scalar into batches.
+    static std::array<matrix::batch<const real>, 4>
+    batch_buffers(std::span<const scalar_view> u);
+    static std::array<matrix::batch<real>, 4> batch_buffers(std::span<const scalar_span> u);
 
     // Submit all kernels (R-space + D-space) without fencing.
     template <typename Op = eq_t>
@@ -68,6 +77,94 @@ public:
                     scalar_span,
                     Op op = {}) const;
 
+    // Batched operator(): du[k] op= D(u[k]) for up to matrix::batch max_size
+    // scalars sharing this operator.  Each coefficient is loaded once per sweep
+    // and applied to every scalar.  nu holds the Neumann data of each scalar and
+    // may be empty when no Neumann conditions apply.
+    template <typename Op = eq_t>
+        requires std::invocable<Op, real&, real>
+    void apply_batch(std::span<const scalar_view> u,
+                     std::span<const scalar_view> nu,
+                     std::span<const scalar_span> du,
+                     Op op = {}) const;
+
+    // d += diag(D) over the unknowns of each space: O on D and the R -> R cut
+    // operators on Rx/Ry/Rz.  The boundary couplings B, Bf* and N have no
+    // diagonal entries.
+    void diagonal(scalar_span d) const
+    {
+        O.diagonal(d.D);
+        Brx.diagonal(d.Rx);
+        Bry.diagonal(d.Ry);
+        Brz.diagonal(d.Rz);
+    }
+
+    // Banded solves with alpha I + beta D along the lines of the D -> D operator
+    matrix::line_solver line_solve(real alpha, real beta) const { return {O, alpha, beta}; }
+
+    // du op= D(u) on D alone, launched on exec without a fence, writing only the
+    // rows in [first, last).  Skips the couplings to R, so this is the whole
+    // operator only on meshes without embedded objects.  Used by slab_derivative
+    // to keep each subdomain on its own partition of the host.
+    template <typename Op = eq_t>
+        requires std::invocable<Op, real&, real>
+    void apply_D(const execution_space& exec,
+                 std::span<const real> u,
+                 std::span<real> du,
+                 Op op = {},
+                 integer first = 0,
+                 integer last = std::numeric_limits<integer>::max()) const
+    {
+        O(exec, u, du, op, first, last);
+    }
+
+    // f(first, rows, stride) for the run of circulant rows of each line of the
+    // D -> D operator, at output indices first + r * stride.  These rows are the
+    // centered interior stencil along dir and nothing else: B and N only touch
+    // closure rows.
+    template <typename F>
+    void for_each_interior_run(F&& f) const
+    {
+        O.for_each_interior_run(FWD(f));
+    }
+
+    // du = D(u) everywhere except the circulant rows of the D -> D operator,
+    // which the caller has already written (see gradient::fused).  As with
+    // operator(), the R buffers of du accumulate.
+    void apply_closure(scalar_view u, scalar_span du) const;
+
+    // du += w * D(u), with the pointwise weight w laid out like du.  Folds a
+    // variable coefficient into the operator so no derivative field is formed.
+    void accumulate_weighted(scalar_view u, scalar_view w, scalar_span du) const;
+
+    // accumulate_weighted without the circulant rows of the D -> D operator,
+    // which the caller has already accumulated (see gradient::fused_dot)
+    void accumulate_weighted_closure(scalar_view u, scalar_view w, scalar_span du) const;
+
+    // du op= D(f) for a field f that is never stored.  flux(b) returns an
+    // accessor for buffer b (0 = D, 1/2/3 = Rx/Ry/Rz) whose operator[](integer)
+    // evaluates f at that point, so fluxes are formed per line as the stencils
+    // read them.  As with operator(), the boundary parts always accumulate.
+    template <typename Flux, typename Op = eq_t>
+    void apply_flux(const Flux& flux, scalar_span du, Op op = {}) const
+    {
+        Kokkos::Profiling::ScopedRegion region("derivative::apply_flux()");
+
+        // update points in R
+        Bfx.apply(flux(0), du.Rx);
+        Bfy.apply(flux(0), du.Ry);
+        Bfz.apply(flux(0), du.Rz);
+
+        Brx.apply(flux(1), du.Rx);
+        Bry.apply(flux(2), du.Ry);
+        Brz.apply(flux(3), du.Rz);
+
+        // update fluid domain
+        O.apply(flux(0), du.D, op);
+        B.apply(flux(1 + dir), du.D);
+        exec_space().fence("derivative::apply_flux() complete");
+    }
+
     // Build a pre-instantiated graph for the non-Neumann overload.
     // Buffer pointers are baked in at creation time.
     template <typename Op = eq_t>
@@ -82,6 +179,18 @@ public:
     // Submit the pre-built graph.
     void submit_graph();
 
+    // Flops and compulsory memory traffic of all the matvecs of one application
+    // to k scalars, with the O rows read back when accumulate is set
+    work cost(int k = 1, bool accumulate = false) const;
+
+    // cost() of apply_closure or accumulate_weighted_closure: the circulant rows
+    // of O are left out
+    work closure_cost(bool accumulate = false) const;
+
+    // Tune the launch shape of every matrix (see matrix::autotuner).  Call it
+    // before building graphs, which capture the shapes.
+    void tune(matrix::autotuner&);
+
     // Add derivative nodes to an existing graph, chaining from parent.
     // Returns a when_all of all leaf nodes so the caller can chain further.
     template <typename Op = eq_t, typename NodeT>
@@ -115,6 +224,187 @@ public:
         return Kokkos::Experimental::when_all(brx, bry, brz, b);
     }
 
+    // Graph form of apply_closure: add_graph_nodes with only the closure rows
+    // of O
+    template <typename NodeT>
+    auto add_closure_graph_nodes(NodeT parent, scalar_view u, scalar_span du) const
+    {
+        const real* u_D = u.D.data();
+        const real* u_Rx = u.Rx.data();
+        const real* u_Ry = u.Ry.data();
+        const real* u_Rz = u.Rz.data();
+        real* du_D = du.D.data();
+        real* du_Rx = du.Rx.data();
+        real* du_Ry = du.Ry.data();
+        real* du_Rz = du.Rz.data();
+        const real* b_src = (dir == 0) ? u_Rx : (dir == 1) ? u_Ry : u_Rz;
+
+        auto bfx = Bfx.graph_node(parent, u_D, du_Rx);
+        auto brx = Brx.graph_node(bfx, u_Rx, du_Rx);
+
+        auto bfy = Bfy.graph_node(parent, u_D, du_Ry);
+        auto bry = Bry.graph_node(bfy, u_Ry, du_Ry);
+
+        auto bfz = Bfz.graph_node(parent, u_D, du_Rz);
+        auto brz = Brz.graph_node(bfz, u_Rz, du_Rz);
+
+        auto o = O.graph_node<matrix::row_part::closure>(parent, u_D, du_D, eq_t{});
+        auto b = B.graph_node(o, b_src, du_D);
+
+        return Kokkos::Experimental::when_all(brx, bry, brz, b);
+    }
+
+    // Graph form of apply_batch.  Same node layout as the Neumann overload of
+    // add_graph_nodes.
+    template <typename Op = eq_t, typename NodeT>
+        requires std::invocable<Op, real&, real>
+    auto add_batch_graph_nodes(NodeT parent,
+                               std::span<const scalar_view> u,
+                               std::span<const scalar_view> nu,
+                               std::span<const scalar_span> du,
+                               Op op = {}) const
+    {
+        const auto ub = batch_buffers(u);
+        const auto db = batch_buffers(du);
+
+        // R-space chains (3 independent pairs)
+        auto bfx = Bfx.graph_node(parent, ub[0], db[1]);
+        auto brx = Brx.graph_node(bfx, ub[1], db[1]);
+
+        auto bfy = Bfy.graph_node(parent, ub[0], db[2]);
+        auto bry = Bry.graph_node(bfy, ub[2], db[2]);
+
+        auto bfz = Bfz.graph_node(parent, ub[0], db[3]);
+        auto brz = Brz.graph_node(bfz, ub[3], db[3]);
+
+        // D-space chain
+        auto o = O.graph_node(parent, ub[0], db[0], op);
+        auto b = B.graph_node(o, ub[1 + dir], db[0]);
+        // an empty Neumann batch makes this node a no-op
+        auto n = N.graph_node(b, nu.empty() ? matrix::batch<const real>{} : batch_buffers(nu)[0],
+                              nu.empty() ? matrix::batch<real>{} : db[0]);
+        return Kokkos::Experimental::when_all(brx, bry, brz, n);
+    }
+
+    // Parts of add_batch_graph_nodes for split schedules, which partition the
+    // outputs so that parts need no atomics to run concurrently.  The D nodes
+    // write only rows [first, last) of the D buffers: the interior rows of O run
+    // beside its closure rows, which B and N then correct.  Returns the join of
+    // the two.
+    template <typename Op = eq_t, typename NodeT>
+        requires std::invocable<Op, real&, real>
+    auto add_batch_D_graph_nodes(NodeT parent,
+                                 std::span<const scalar_view> u,
+                                 std::span<const scalar_view> nu,
+                                 std::span<const scalar_span> du,
+                                 integer first,
+                                 integer last,
+                                 Op op = {}) const
+    {
+        using matrix::row_part;
+        const auto ub = batch_buffers(u);
+        const auto db = batch_buffers(du);
+        // an empty Neumann batch makes the N node a no-op
+        const auto nb = nu.empty() ? matrix::batch<const real>{} : batch_buffers(nu)[0];
+        const auto nd = nu.empty() ? matrix::batch<real>{} : db[0];
+
+        auto interior =
+            O.graph_node<row_part::interior>(parent, ub[0], db[0], op, first, last);
+        auto closure =
+            O.graph_node<row_part::closure>(parent, ub[0], db[0], op, first, last);
+        auto b = B.graph_node(closure, ub[1 + dir], db[0], first, last);
+        auto n = N.graph_node(b, nb, nd, first, last);
+        return Kokkos::Experimental::when_all(interior, n);
+    }
+
+    // The R nodes of add_batch_graph_nodes for the ray buffer of direction r
+    // (0, 1, 2 = Rx, Ry, Rz) alone.
+    template <typename NodeT>
+    auto add_batch_R_graph_nodes(NodeT parent,
+                                 std::span<const scalar_view> u,
+                                 std::span<const scalar_span> du,
+                                 int r) const
+    {
+        const auto ub = batch_buffers(u);
+        const auto db = batch_buffers(du);
+        const auto& Bf = r == 0 ? Bfx : r == 1 ? Bfy : Bfz;
+        const auto& Br = r == 0 ? Brx : r == 1 ? Bry : Brz;
+
+        auto bf = Bf.graph_node(parent, ub[0], db[1 + r]);
+        return Br.graph_node(bf, ub[1 + r], db[1 + r]);
+    }
+
+    // Graph form of accumulate_weighted.  Same node layout as add_graph_nodes.
+    template <typename NodeT>
+    auto add_weighted_graph_nodes(NodeT parent, scalar_view u, scalar_view w,
+                                  scalar_span du) const
+    {
+        const real* u_D = u.D.data();
+        const real* u_Rx = u.Rx.data();
+        const real* u_Ry = u.Ry.data();
+        const real* u_Rz = u.Rz.data();
+        real* du_D = du.D.data();
+        real* du_Rx = du.Rx.data();
+        real* du_Ry = du.Ry.data();
+        real* du_Rz = du.Rz.data();
+        const real* w_D = w.D.data();
+        const real* w_Rx = w.Rx.data();
+        const real* w_Ry = w.Ry.data();
+        const real* w_Rz = w.Rz.data();
+        const real* b_src = (dir == 0) ? u_Rx : (dir == 1) ? u_Ry : u_Rz;
+
+        // R-space chains (3 independent pairs)
+        auto bfx = Bfx.graph_node(parent, u_D, du_Rx, w_Rx);
+        auto brx = Brx.graph_node(bfx, u_Rx, du_Rx, w_Rx);
+
+        auto bfy = Bfy.graph_node(parent, u_D, du_Ry, w_Ry);
+        auto bry = Bry.graph_node(bfy, u_Ry, du_Ry, w_Ry);
+
+        auto bfz = Bfz.graph_node(parent, u_D, du_Rz, w_Rz);
+        auto brz = Brz.graph_node(bfz, u_Rz, du_Rz, w_Rz);
+
+        // D-space chain
+        auto o = O.graph_node(parent, u_D, du_D, weighted_plus_eq_t{w_D});
+        auto b = B.graph_node(o, b_src, du_D, w_D);
+
+        return Kokkos::Experimental::when_all(brx, bry, brz, b);
+    }
+
+    // Graph form of accumulate_weighted_closure
+    template <typename NodeT>
+    auto add_weighted_closure_graph_nodes(NodeT parent, scalar_view u, scalar_view w,
+                                          scalar_span du) const
+    {
+        const real* u_D = u.D.data();
+        const real* u_Rx = u.Rx.data();
+        const real* u_Ry = u.Ry.data();
+        const real* u_Rz = u.Rz.data();
+        real* du_D = du.D.data();
+        real* du_Rx = du.Rx.data();
+        real* du_Ry = du.Ry.data();
+        real* du_Rz = du.Rz.data();
+        const real* w_D = w.D.data();
+        const real* w_Rx = w.Rx.data();
+        const real* w_Ry = w.Ry.data();
+        const real* w_Rz = w.Rz.data();
+        const real* b_src = (dir == 0) ? u_Rx : (dir == 1) ? u_Ry : u_Rz;
+
+        auto bfx = Bfx.graph_node(parent, u_D, du_Rx, w_Rx);
+        auto brx = Brx.graph_node(bfx, u_Rx, du_Rx, w_Rx);
+
+        auto bfy = Bfy.graph_node(parent, u_D, du_Ry, w_Ry);
+        auto bry = Bry.graph_node(bfy, u_Ry, du_Ry, w_Ry);
+
+        auto bfz = Bfz.graph_node(parent, u_D, du_Rz, w_Rz);
+        auto brz = Brz.graph_node(bfz, u_Rz, du_Rz, w_Rz);
+
+        auto o = O.graph_node<matrix::row_part::closure>(
+            parent, u_D, du_D, weighted_plus_eq_t{w_D});
+        auto b = B.graph_node(o, b_src, du_D, w_D);
+
+        return Kokkos::Experimental::when_all(brx, bry, brz, b);
+    }
+
     // Neumann overload: adds N node at end of D-space chain.
     template <typename Op = eq_t, typename NodeT>
         requires std::invocable<Op, real&, real>
@@ -150,4 +440,13 @@ public:
         return Kokkos::Experimental::when_all(brx, bry, brz, n);
     }
 };
+
+// The x, y and z derivatives of one scheme.  The directions with more than one
+// point are assembled concurrently, each on its own partition of exec_space()
+// driven by its own host thread, when there is a thread for each.
+std::array<derivative, 3> make_derivatives(const mesh& m,
+                                           const stencil& st,
+                                           const bcs::Grid& grid_bcs,
+                                           const bcs::Object& object_bcs,
+                                           const logs& = {});
 } // namespace ccs
@@ -5,11 +5,64 @@
 #include <Kokkos_Profiling_ScopedRegion.hpp>
 
 #include <fmt/ranges.h>
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ccs
 {
+namespace
+{
+template <typename T>
+device_view<T*> to_device(const std::string& label, const std::vector<T>& v)
+{
+    using host_t =
+        Kokkos::View<const T*, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+    auto d = device_view<T*>(label, v.size());
+    Kokkos::deep_copy(d, host_t(v.data(), v.size()));
+    return d;
+}
+
+// Indices i in [p, n - p) along d that no circulant run of dd covers.  The
+// runs are grouped by grid line and each line's gaps are listed in order, so
+// the work is proportional to the lines, the runs and the gaps.
+std::vector<integer>
+interior_gaps(const derivative& dd, const index_extents& ex, int d, int p)
+{
+    const integer n = ex[d];
+    const integer s = d == 0 ? (integer)ex[1] * ex[2] : d == 1 ? ex[2] : 1;
+
+    // (line, first, last) with line the index of the line's point at 0 along d
+    std::vector<std::array<integer, 3>> runs{};
+    dd.for_each_interior_run([&](integer first, integer rows, integer) {
+        const integer i = first / s % n;
+        runs.push_back({first - i * s, i, i + rows});
+    });
+    std::ranges::sort(runs);
+
+    std::vector<integer> gaps{};
+    auto r = runs.begin();
+    int3 lines = ex.extents;
+    lines[d] = 1;
+    for (int a = 0; a < lines[0]; ++a)
+        for (int b = 0; b < lines[1]; ++b)
+            for (int c = 0; c < lines[2]; ++c) {
+                const integer line = ex(int3{a, b, c});
+                integer i = p;
+                auto gap = [&](integer last) {
+                    for (; i < std::min(last, n - p); ++i) gaps.push_back(line + i * s);
+                };
+                for (; r != runs.end() && (*r)[0] == line; ++r) {
+                    gap((*r)[1]);
+                    i = std::max(i, (*r)[2]);
+                }
+                gap(n - p);
+            }
+    return gaps;
+}
+} // namespace
+
 gradient::gradient(const mesh& m,
                    const stencil& st,
                    const bcs::Grid& grid_bcs,
@@ -25,10 +78,49 @@ gradient::gradient(const mesh& m,
            fmt::join(hdr, ","));
     logger.set_pattern("%Y-%m-%d %H:%M:%S.%f,%v");
 
-    dx = derivative{0, m, st, grid_bcs, obj_bcs, logger};
-    dy = derivative{1, m, st, grid_bcs, obj_bcs, logger};
-    dz = derivative{2, m, st, grid_bcs, obj_bcs, logger};
+    auto d = make_derivatives(m, st, grid_bcs, obj_bcs, logger);
+    dx = MOVE(d[0]);
+    dy = MOVE(d[1]);
+    dz = MOVE(d[2]);
     ex = m.extents();
+
+    // centered stencils for the fused sweep
+    const int p = st.query_max().p;
+    const int w = 2 * p + 1;
+    std::vector<real> c(3 * w);
+    for (int d = 0; d < 3; ++d)
+        if (ex[d] > 1) st.interior(m.h(d), std::span{c}.subspan(d * w, w));
+    sweep_p = p;
+    sweep_c = to_device("gradient_sweep_c", c);
+
+    // points the sweep writes that are not circulant rows of the derivative:
+    // the gaps its circulant runs leave in [p, n - p) of each grid line
+    const derivative* ds[] = {&dx, &dy, &dz};
+    std::vector<std::pair<integer, int>> patch{};
+    for (int d = 0; d < 3; ++d) {
+        std::vector<integer> reset{};
+        if (ex[d] > 1) {
+            reset = interior_gaps(*ds[d], ex, d, p);
+            for (auto i : reset) patch.emplace_back(i, 1 << d);
+        }
+        sweep_reset[d] = to_device("gradient_sweep_reset", reset);
+    }
+
+    // the weighted sweep patches each point once, dropping every direction
+    // that resets it
+    std::ranges::sort(patch);
+    std::vector<integer> patch_idx{};
+    std::vector<int> patch_drop{};
+    for (auto&& [i, bit] : patch) {
+        if (!patch_idx.empty() && patch_idx.back() == i)
+            patch_drop.back() |= bit;
+        else {
+            patch_idx.push_back(i);
+            patch_drop.push_back(bit);
+        }
+    }
+    sweep_patch = to_device("gradient_sweep_patch", patch_idx);
+    sweep_patch_drop = to_device("gradient_sweep_patch_drop", patch_drop);
 }
 
 std::function<void(scalar_span, scalar_span, scalar_span)>
@@ -44,4 +136,96 @@ gradient::operator()(scalar_view u) const
         if (ex[2] > 1) dz(u, du_z);
     };
 }
+
+std::function<void(scalar_span, scalar_span, scalar_span)>
+gradient::fused(scalar_view u) const
+{
+    return [this, u](scalar_span du_x, scalar_span du_y, scalar_span du_z) {
+        Kokkos::Profiling::ScopedRegion region("gradient::fused()");
+        Kokkos::parallel_for(
+            "gradient_fused_sweep", sweep_policy(), sweep(u, du_x, du_y, du_z));
+
+        const scalar_span du[] = {du_x, du_y, du_z};
+        for (int d = 0; d < 3; ++d) {
+            const auto& pts = sweep_reset[d];
+            real* ptr = du[d].D.data();
+            index_for(
+                "gradient_fused_reset", pts.extent(0), KOKKOS_LAMBDA(auto i) {
+                    ptr[pts(i)] = 0;
+                });
+            // the sweep writes all of D; only R starts from zero
+            scalar_span{{}, du[d].Rx, du[d].Ry, du[d].Rz} = 0;
+        }
+
+        if (ex[0] > 1) dx.apply_closure(u, du_x);
+        if (ex[1] > 1) dy.apply_closure(u, du_y);
+        if (ex[2] > 1) dz.apply_closure(u, du_z);
+    };
+}
+
+std::function<void(scalar_span)>
+gradient::fused_dot(scalar_view u, scalar_view wx, scalar_view wy, scalar_view wz) const
+{
+    return [this, u, wx, wy, wz](scalar_span du) {
+        Kokkos::Profiling::ScopedRegion region("gradient::fused_dot()");
+        const auto f = dot_sweep(u, wx, wy, wz, du);
+        Kokkos::parallel_for("gradient_fused_dot_sweep", sweep_policy(), f);
+
+        const auto& pts = sweep_patch;
+        const auto& drop = sweep_patch_drop;
+        index_for(
+            "gradient_fused_dot_patch", pts.extent(0), KOKKOS_LAMBDA(auto q) {
+                f.patch(pts(q), drop(q));
+            });
+        // the sweep writes all of D; only R starts from zero
+        scalar_span{{}, du.Rx, du.Ry, du.Rz} = 0;
+
+        if (ex[0] > 1) dx.accumulate_weighted_closure(u, wx, du);
+        if (ex[1] > 1) dy.accumulate_weighted_closure(u, wy, du);
+        if (ex[2] > 1) dz.accumulate_weighted_closure(u, wz, du);
+    };
+}
+
+std::function<void(scalar_span)>
+gradient::dot(scalar_view u, scalar_view wx, scalar_view wy, scalar_view wz) const
+{
+    return [this, u, wx, wy, wz](scalar_span du) {
+        Kokkos::Profiling::ScopedRegion region("gradient::dot()");
+        du = 0;
+        if (ex[0] > 1) dx.accumulate_weighted(u, wx, du);
+        if (ex[1] > 1) dy.accumulate_weighted(u, wy, du);
+        if (ex[2] > 1) dz.accumulate_weighted(u, wz, du);
+    };
+}
+
+void gradient::tune(matrix::autotuner& tuner)
+{
+    if (ex[0] > 1) dx.tune(tuner);
+    if (ex[1] > 1) dy.tune(tuner);
+    if (ex[2] > 1) dz.tune(tuner);
+}
+
+work gradient::cost(bool accumulate) const
+{
+    work w{};
+    if (ex[0] > 1) w += dx.cost(1, accumulate);
+    if (ex[1] > 1) w += dy.cost(1, accumulate);
+    if (ex[2] > 1) w += dz.cost(1, accumulate);
+    return w;
+}
+
+work gradient::fused_dot_cost() const
+{
+    // per point: a weighted stencil for each direction the mesh has, reading u
+    // and its weight once and writing du once
+    const real points = (real)ex.size();
+    const int dims = (ex[0] > 1) + (ex[1] > 1) + (ex[2] > 1);
+    work w{points * dims * (2.0 * (2 * sweep_p + 1) + 2),
+           points * (2 + dims) * sizeof(real)};
+    if (ex[0] > 1) w += dx.closure_cost(true);
+    if (ex[1] > 1) w += dy.closure_cost(true);
+    if (ex[2] > 1) w += dz.closure_cost(true);
+    return w;
+}
+
 } // namespace ccs
@@ -6,9 +6,91 @@
 
 #include <Kokkos_Graph.hpp>
 
+#include <algorithm>
+#include <array>
+
 namespace ccs
 {
 
+// The centered interior stencil of direction d at the point idx, whose index
+// along d is i, or 0 where it does not fit.  s is the stride of d.
+struct centered_lines {
+    const real* u;
+    // centered stencils of the three directions, 2p + 1 coefficients each
+    device_view<real*> c;
+    int p;
+    int3 n;
+
+    KOKKOS_INLINE_FUNCTION
+    real operator()(int d, int i, integer idx, integer s) const
+    {
+        if (n[d] < 2 || i < p || i >= n[d] - p) return 0;
+        const int w = 2 * p + 1;
+        real dot = 0;
+        for (int t = 0; t < w; ++t) dot += c(d * w + t) * u[idx + (t - p) * s];
+        return dot;
+    }
+};
+
+// One read of u for all three directions: every point gets the centered
+// interior stencil of each direction it fits in (0 elsewhere).  The 3D tiles of
+// the sweep keep the planes the x and y stencils reach in cache.
+struct fused_gradient_sweep {
+    centered_lines line;
+    real* du_x;
+    real* du_y;
+    real* du_z;
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(int i, int j, int k) const
+    {
+        const integer sy = line.n[2];
+        const integer sx = sy * line.n[1];
+        const integer idx = i * sx + j * sy + k;
+        du_x[idx] = line(0, i, idx, sx);
+        du_y[idx] = line(1, j, idx, sy);
+        du_z[idx] = line(2, k, idx, 1);
+    }
+};
+
+// The weighted form of the sweep: du = wx * line_x + wy * line_y + wz * line_z
+// in one read of u, so the three derivatives are never stored.  patch()
+// recomputes a point without the directions set in drop (bit d for direction d).
+struct fused_dot_sweep {
+    centered_lines line;
+    const real* w_x;
+    const real* w_y;
+    const real* w_z;
+    real* du;
+
+    KOKKOS_INLINE_FUNCTION
+    void at(int i, int j, int k, int drop) const
+    {
+        const integer sy = line.n[2];
+        const integer sx = sy * line.n[1];
+        const integer idx = i * sx + j * sy + k;
+        real v = 0;
+        if (!(drop & 1)) v += w_x[idx] * line(0, i, idx, sx);
+        if (!(drop & 2)) v += w_y[idx] * line(1, j, idx, sy);
+        if (!(drop & 4)) v += w_z[idx] * line(2, k, idx, 1);
+        du[idx] = v;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(int i, int j, int k) const { at(i, j, k, 0); }
+
+    KOKKOS_INLINE_FUNCTION
+    void patch(integer idx, int drop) const
+    {
+        const integer nz = line.n[2];
+        const integer nyz = nz * line.n[1];
+        at(static_cast<int>(idx / nyz),
+           static_cast<int>(idx / nz % line.n[1]),
+           static_cast<int>(idx % nz),
+           drop);
+    }
+};
+
 class gradient
 {
     derivative dx;
@@ -16,7 +98,56 @@ class gradient
     derivative dz;
     index_extents ex;
 
+    // Fused sweep data: the centered stencils and, for each direction, the
+    // points where the stencil fits but which are not circulant rows of that
+    // derivative (solid points, removed Dirichlet rows and closure rows).
+    // The sweep's value there is reset before the closures are applied.  The
+    // weighted sweep patches the union of the three lists instead, with the
+    // directions to drop at each point in sweep_patch_drop.
+    device_view<real*> sweep_c;
+    int sweep_p = 0;
+    std::array<device_view<integer*>, 3> sweep_reset;
+    device_view<integer*> sweep_patch;
+    device_view<int*> sweep_patch_drop;
+
+    centered_lines lines(scalar_view u) const
+    {
+        return {u.D.data(), sweep_c, sweep_p, ex.extents};
+    }
+
+    fused_gradient_sweep
+    sweep(scalar_view u, scalar_span du_x, scalar_span du_y, scalar_span du_z) const
+    {
+        return {lines(u), du_x.D.data(), du_y.D.data(), du_z.D.data()};
+    }
+
+    fused_dot_sweep dot_sweep(scalar_view u,
+                              scalar_view wx,
+                              scalar_view wy,
+                              scalar_view wz,
+                              scalar_span du) const
+    {
+        return {lines(u), wx.D.data(), wy.D.data(), wz.D.data(), du.D.data()};
+    }
+
+    auto sweep_policy() const
+    {
+        using md_t = Kokkos::MDRangePolicy<
+            execution_space,
+            Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>,
+            Kokkos::IndexType<int>>;
+        return md_t(exec_space(),
+                    {0, 0, 0},
+                    {ex[0], ex[1], ex[2]},
+                    {std::min(ex[0], sweep_tile[0]),
+                     std::min(ex[1], sweep_tile[1]),
+                     std::min(ex[2], sweep_tile[2])});
+    }
+
 public:
+    // x, y, z extents of the tiles of the fused sweep
+    static constexpr int3 sweep_tile{4, 8, 128};
+
     gradient() = default;
 
     gradient(const mesh&,
@@ -27,6 +158,33 @@ public:
 
     std::function<void(scalar_span, scalar_span, scalar_span)> operator()(scalar_view) const;
 
+    // Fused directional derivative: du = wx * dx(u) + wy * dy(u) + wz * dz(u).
+    // Each derivative accumulates straight into du so the gradient is never stored.
+    std::function<void(scalar_span)>
+    dot(scalar_view u, scalar_view wx, scalar_view wy, scalar_view wz) const;
+
+    // Same result as operator() with u read once: the interior rows of all
+    // three derivatives come from one tiled sweep of u.D, then the closure rows
+    // and the cut-cell corrections of each direction are applied on top.
+    std::function<void(scalar_span, scalar_span, scalar_span)> fused(scalar_view) const;
+
+    // dot() with u read once: the weighted interior rows of all three
+    // derivatives come from one tiled sweep of u.D, then the weighted closure
+    // rows and cut-cell corrections of each direction accumulate on top.
+    std::function<void(scalar_span)>
+    fused_dot(scalar_view u, scalar_view wx, scalar_view wy, scalar_view wz) const;
+
+    // Flops and compulsory memory traffic of the derivative matvecs of one
+    // gradient, with the outputs read back when accumulate is set (dot)
+    work cost(bool accumulate = false) const;
+
+    // The same for fused_dot: one sweep reading u and the three weights, plus
+    // the closures of each direction
+    work fused_dot_cost() const;
+
+    // Tune the matrices of dx, dy and dz; call before adding graph nodes
+    void tune(matrix::autotuner&);
+
     void visit(operator_visitor& v) const { return v.visit(dx); }
 
     // Add gradient nodes to an existing graph. Zeros du_x/du_y/du_z, then
@@ -42,74 +200,74 @@ public:
         real* dux_rx = du_x.Rx.data();
         real* dux_ry = du_x.Ry.data();
         real* dux_rz = du_x.Rz.data();
-        const int n_dux_d = static_cast<int>(du_x.D.size());
-        const int n_dux_rx = static_cast<int>(du_x.Rx.size());
-        const int n_dux_ry = static_cast<int>(du_x.Ry.size());
-        const int n_dux_rz = static_cast<int>(du_x.Rz.size());
+        const integer n_dux_d = static_cast<integer>(du_x.D.size());
+        const integer n_dux_rx = static_cast<integer>(du_x.Rx.size());
+        const integer n_dux_ry = static_cast<integer>(du_x.Ry.size());
+        const integer n_dux_rz = static_cast<integer>(du_x.Rz.size());
 
         real* duy_d = du_y.D.data();
         real* duy_rx = du_y.Rx.data();
         real* duy_ry = du_y.Ry.data();
         real* duy_rz = du_y.Rz.data();
-        const int n_duy_d = static_cast<int>(du_y.D.size());
-        const int n_duy_rx = static_cast<int>(du_y.Rx.size());
-        const int n_duy_ry = static_cast<int>(du_y.Ry.size());
-        const int n_duy_rz = static_cast<int>(du_y.Rz.size());
+        const integer n_duy_d = static_cast<integer>(du_y.D.size());
+        const integer n_duy_rx = static_cast<integer>(du_y.Rx.size());
+        const integer n_duy_ry = static_cast<integer>(du_y.Ry.size());
+        const integer n_duy_rz = static_cast<integer>(du_y.Rz.size());
 
         real* duz_d = du_z.D.data();
         real* duz_rx = du_z.Rx.data();
         real* duz_ry = du_z.Ry.data();
         real* duz_rz = du_z.Rz.data();
-        const int n_duz_d = static_cast<int>(du_z.D.size());
-        const int n_duz_rx = static_cast<int>(du_z.Rx.size());
-        const int n_duz_ry = static_cast<int>(du_z.Ry.size());
-        const int n_duz_rz = static_cast<int>(du_z.Rz.size());
+        const integer n_duz_d = static_cast<integer>(du_z.D.size());
+        const integer n_duz_rx = static_cast<integer>(du_z.Rx.size());
+        const integer n_duz_ry = static_cast<integer>(du_z.Ry.size());
+        const integer n_duz_rz = static_cast<integer>(du_z.Rz.size());
 
         // Zero du_x (4 buffers fan out from parent)
         auto zx_d = parent.then_parallel_for(
             "grad_zero_dux_D", rp_t(0, n_dux_d),
-            KOKKOS_LAMBDA(int i) { dux_d[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { dux_d[i] = 0; });
         auto zx_rx = parent.then_parallel_for(
             "grad_zero_dux_Rx", rp_t(0, n_dux_rx),
-            KOKKOS_LAMBDA(int i) { dux_rx[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { dux_rx[i] = 0; });
         auto zx_ry = parent.then_parallel_for(
             "grad_zero_dux_Ry", rp_t(0, n_dux_ry),
-            KOKKOS_LAMBDA(int i) { dux_ry[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { dux_ry[i] = 0; });
         auto zx_rz = parent.then_parallel_for(
             "grad_zero_dux_Rz", rp_t(0, n_dux_rz),
-            KOKKOS_LAMBDA(int i) { dux_rz[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { dux_rz[i] = 0; });
         auto dux_zeroed =
             Kokkos::Experimental::when_all(zx_d, zx_rx, zx_ry, zx_rz);
 
         // Zero du_y
         auto zy_d = parent.then_parallel_for(
             "grad_zero_duy_D", rp_t(0, n_duy_d),
-            KOKKOS_LAMBDA(int i) { duy_d[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { duy_d[i] = 0; });
         auto zy_rx = parent.then_parallel_for(
             "grad_zero_duy_Rx", rp_t(0, n_duy_rx),
-            KOKKOS_LAMBDA(int i) { duy_rx[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { duy_rx[i] = 0; });
         auto zy_ry = parent.then_parallel_for(
             "grad_zero_duy_Ry", rp_t(0, n_duy_ry),
-            KOKKOS_LAMBDA(int i) { duy_ry[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { duy_ry[i] = 0; });
         auto zy_rz = parent.then_parallel_for(
             "grad_zero_duy_Rz", rp_t(0, n_duy_rz),
-            KOKKOS_LAMBDA(int i) { duy_rz[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { duy_rz[i] = 0; });
         auto duy_zeroed =
             Kokkos::Experimental::when_all(zy_d, zy_rx, zy_ry, zy_rz);
 
         // Zero du_z
         auto zz_d = parent.then_parallel_for(
             "grad_zero_duz_D", rp_t(0, n_duz_d),
-            KOKKOS_LAMBDA(int i) { duz_d[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { duz_d[i] = 0; });
         auto zz_rx = parent.then_parallel_for(
             "grad_zero_duz_Rx", rp_t(0, n_duz_rx),
-            KOKKOS_LAMBDA(int i) { duz_rx[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { duz_rx[i] = 0; });
         auto zz_ry = parent.then_parallel_for(
             "grad_zero_duz_Ry", rp_t(0, n_duz_ry),
-            KOKKOS_LAMBDA(int i) { duz_ry[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { duz_ry[i] = 0; });
         auto zz_rz = parent.then_parallel_for(
             "grad_zero_duz_Rz", rp_t(0, n_duz_rz),
-            KOKKOS_LAMBDA(int i) { duz_rz[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { duz_rz[i] = 0; });
         auto duz_zeroed =
             Kokkos::Experimental::when_all(zz_d, zz_rx, zz_ry, zz_rz);
 
@@ -120,5 +278,124 @@ public:
 
         return Kokkos::Experimental::when_all(dx_done, dy_done, dz_done);
     }
+
+    // Graph form of fused().  The tiled sweep runs first; each direction then
+    // resets its non-interior points and chains its closures.  Only the R
+    // buffers are zeroed since the sweep writes every point of D.
+    template <typename NodeT>
+    auto add_fused_graph_nodes(NodeT parent, scalar_view u,
+                               scalar_span du_x, scalar_span du_y, scalar_span du_z) const
+    {
+        using rp_t = Kokkos::RangePolicy<execution_space>;
+
+        auto zero_R = [parent](scalar_span du) {
+            real* rx = du.Rx.data();
+            real* ry = du.Ry.data();
+            real* rz = du.Rz.data();
+            auto z_rx = parent.then_parallel_for(
+                "grad_fused_zero_Rx", rp_t(0, static_cast<integer>(du.Rx.size())),
+                KOKKOS_LAMBDA(integer i) { rx[i] = 0; });
+            auto z_ry = parent.then_parallel_for(
+                "grad_fused_zero_Ry", rp_t(0, static_cast<integer>(du.Ry.size())),
+                KOKKOS_LAMBDA(integer i) { ry[i] = 0; });
+            auto z_rz = parent.then_parallel_for(
+                "grad_fused_zero_Rz", rp_t(0, static_cast<integer>(du.Rz.size())),
+                KOKKOS_LAMBDA(integer i) { rz[i] = 0; });
+            return Kokkos::Experimental::when_all(z_rx, z_ry, z_rz);
+        };
+
+        auto swept = parent.then_parallel_for(
+            "grad_fused_sweep", sweep_policy(), sweep(u, du_x, du_y, du_z));
+
+        auto reset = [swept](const device_view<integer*>& pts, scalar_span du) {
+            real* d = du.D.data();
+            return swept.then_parallel_for(
+                "grad_fused_reset", rp_t(0, static_cast<integer>(pts.extent(0))),
+                KOKKOS_LAMBDA(integer i) { d[pts(i)] = 0; });
+        };
+
+        auto x_in = Kokkos::Experimental::when_all(reset(sweep_reset[0], du_x), zero_R(du_x));
+        auto y_in = Kokkos::Experimental::when_all(reset(sweep_reset[1], du_y), zero_R(du_y));
+        auto z_in = Kokkos::Experimental::when_all(reset(sweep_reset[2], du_z), zero_R(du_z));
+
+        auto dx_done = dx.add_closure_graph_nodes(x_in, u, du_x);
+        auto dy_done = dy.add_closure_graph_nodes(y_in, u, du_y);
+        auto dz_done = dz.add_closure_graph_nodes(z_in, u, du_z);
+
+        return Kokkos::Experimental::when_all(dx_done, dy_done, dz_done);
+    }
+
+    // Graph form of fused_dot().  The weighted sweep and its patch run beside
+    // the zeroing of the R buffers, then the weighted closures of dx -> dy -> dz
+    // accumulate into du in sequence.  Returns the final node.
+    template <typename NodeT>
+    auto add_fused_dot_graph_nodes(NodeT parent, scalar_view u, scalar_view wx,
+                                   scalar_view wy, scalar_view wz, scalar_span du) const
+    {
+        using rp_t = Kokkos::RangePolicy<execution_space>;
+
+        real* rx = du.Rx.data();
+        real* ry = du.Ry.data();
+        real* rz = du.Rz.data();
+        auto z_rx = parent.then_parallel_for(
+            "grad_fused_dot_zero_Rx", rp_t(0, static_cast<integer>(du.Rx.size())),
+            KOKKOS_LAMBDA(integer i) { rx[i] = 0; });
+        auto z_ry = parent.then_parallel_for(
+            "grad_fused_dot_zero_Ry", rp_t(0, static_cast<integer>(du.Ry.size())),
+            KOKKOS_LAMBDA(integer i) { ry[i] = 0; });
+        auto z_rz = parent.then_parallel_for(
+            "grad_fused_dot_zero_Rz", rp_t(0, static_cast<integer>(du.Rz.size())),
+            KOKKOS_LAMBDA(integer i) { rz[i] = 0; });
+
+        const auto f = dot_sweep(u, wx, wy, wz, du);
+        const auto pts = sweep_patch;
+        const auto drop = sweep_patch_drop;
+        auto swept = parent.then_parallel_for("grad_fused_dot_sweep", sweep_policy(), f);
+        auto patched = swept.then_parallel_for(
+            "grad_fused_dot_patch", rp_t(0, static_cast<integer>(pts.extent(0))),
+            KOKKOS_LAMBDA(integer q) { f.patch(pts(q), drop(q)); });
+
+        auto in = Kokkos::Experimental::when_all(patched, z_rx, z_ry, z_rz);
+        auto d0 = dx.add_weighted_closure_graph_nodes(in, u, wx, du);
+        auto d1 = dy.add_weighted_closure_graph_nodes(d0, u, wy, du);
+        return dz.add_weighted_closure_graph_nodes(d1, u, wz, du);
+    }
+
+    // Graph form of dot().  Zeros du, then chains the weighted dx -> dy -> dz
+    // sequentially since they all accumulate into du.  Returns the final node.
+    template <typename NodeT>
+    auto add_dot_graph_nodes(NodeT parent, scalar_view u, scalar_view wx,
+                             scalar_view wy, scalar_view wz, scalar_span du) const
+    {
+        using rp_t = Kokkos::RangePolicy<execution_space>;
+
+        real* d_ptr = du.D.data();
+        real* rx_ptr = du.Rx.data();
+        real* ry_ptr = du.Ry.data();
+        real* rz_ptr = du.Rz.data();
+        const integer n_d = static_cast<integer>(du.D.size());
+        const integer n_rx = static_cast<integer>(du.Rx.size());
+        const integer n_ry = static_cast<integer>(du.Ry.size());
+        const integer n_rz = static_cast<integer>(du.Rz.size());
+
+        auto z_d = parent.then_parallel_for(
+            "grad_dot_zero_D", rp_t(0, n_d),
+            KOKKOS_LAMBDA(integer i) { d_ptr[i] = 0; });
+        auto z_rx = parent.then_parallel_for(
+            "grad_dot_zero_Rx", rp_t(0, n_rx),
+            KOKKOS_LAMBDA(integer i) { rx_ptr[i] = 0; });
+        auto z_ry = parent.then_parallel_for(
+            "grad_dot_zero_Ry", rp_t(0, n_ry),
+            KOKKOS_LAMBDA(integer i) { ry_ptr[i] = 0; });
+        auto z_rz = parent.then_parallel_for(
+            "grad_dot_zero_Rz", rp_t(0, n_rz),
+            KOKKOS_LAMBDA(integer i) { rz_ptr[i] = 0; });
+
+        auto zeroed = Kokkos::Experimental::when_all(z_d, z_rx, z_ry, z_rz);
+
+        auto d0 = dx.add_weighted_graph_nodes(zeroed, u, wx, du);
+        auto d1 = dy.add_weighted_graph_nodes(d0, u, wy, du);
+        return dz.add_weighted_graph_nodes(d1, u, wz, du);
+    }
 };
 } // namespace ccs
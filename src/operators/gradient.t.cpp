@@ -7,9 +7,12 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_session.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
 #include <ranges>
+#include <string>
+#include <utility>
 
 #include <sol/sol.hpp>
 
@@ -469,3 +472,226 @@ TEST_CASE("E2 with Objects - Floating")
     REQUIRE_THAT(ex_z.ry_vec, Approx(du_z.ry_vec));
     REQUIRE_THAT(ex_z.rz_vec, Approx(du_z.rz_vec));
 }
+
+TEST_CASE("Fused dot matches gradient")
+{
+    sol::state lua;
+    lua.script(R"(
+        simulation = {
+            mesh = {
+                index_extents = {21, 22, 23},
+                domain_bounds = {
+                    min = {0.1, 0.2, 0.3},
+                    max = {1, 2, 2.2}
+                }
+            },
+            domain_boundaries = {
+                xmin = "dirichlet",
+                zmax = "dirichlet"
+            },
+            shapes = {
+                {
+                    type = "sphere",
+                    center = {0.45, 1.011, 1.31},
+                    radius = 0.141,
+                    boundary_condition = "floating"
+                }
+            },
+            scheme = {
+                order = 1,
+                type = "E2",
+                alpha = {-1.47956280234494, 0.261900367793859, -0.145072532538541, -0.224665713988644}
+            }
+        }
+    )");
+    auto m_opt = mesh::from_lua(lua["simulation"]);
+    REQUIRE(!!m_opt);
+    const mesh& m = *m_opt;
+
+    auto bc_opt = bcs::from_lua(lua["simulation"], m.extents());
+    REQUIRE(!!bc_opt);
+    auto&& [gridBcs, objectBcs] = *bc_opt;
+
+    auto scheme_opt = stencil::from_lua(lua["simulation"]);
+    REQUIRE(!!scheme_opt);
+
+    auto u = eval_at_mesh(m, f2);
+    // pointwise weights: any smooth, non-constant fields will do
+    const auto wx = eval_at_mesh(m, gx);
+    const auto wy = eval_at_mesh(m, gy);
+    const auto wz = eval_at_mesh(m, g);
+
+    auto grad = gradient{m, *scheme_opt, gridBcs, objectBcs};
+
+    // reference: full gradient followed by a pointwise dot product
+    auto du_x = make_scalar(m);
+    auto du_y = make_scalar(m);
+    auto du_z = make_scalar(m);
+    grad(u)(du_x, du_y, du_z);
+
+    auto ex = make_scalar(m);
+    auto combine = [](std::vector<real>& o,
+                      const std::vector<real>& a, const std::vector<real>& x,
+                      const std::vector<real>& b, const std::vector<real>& y,
+                      const std::vector<real>& c, const std::vector<real>& z) {
+        for (std::size_t i = 0; i < o.size(); ++i)
+            o[i] = a[i] * x[i] + b[i] * y[i] + c[i] * z[i];
+    };
+    combine(ex.d_vec, wx.d_vec, du_x.d_vec, wy.d_vec, du_y.d_vec, wz.d_vec, du_z.d_vec);
+    combine(ex.rx_vec, wx.rx_vec, du_x.rx_vec, wy.rx_vec, du_y.rx_vec, wz.rx_vec, du_z.rx_vec);
+    combine(ex.ry_vec, wx.ry_vec, du_x.ry_vec, wy.ry_vec, du_y.ry_vec, wz.ry_vec, du_z.ry_vec);
+    combine(ex.rz_vec, wx.rz_vec, du_x.rz_vec, wy.rz_vec, du_y.rz_vec, wz.rz_vec, du_z.rz_vec);
+
+    SECTION("eager")
+    {
+        auto du = make_scalar(m);
+        // stale data must not leak into the result
+        std::ranges::fill(du.d_vec, 7.0);
+        grad.dot(u, wx, wy, wz)(du);
+
+        REQUIRE_THAT(du.d_vec, Approx(ex.d_vec));
+        REQUIRE_THAT(du.rx_vec, Approx(ex.rx_vec));
+        REQUIRE_THAT(du.ry_vec, Approx(ex.ry_vec));
+        REQUIRE_THAT(du.rz_vec, Approx(ex.rz_vec));
+    }
+
+    SECTION("graph")
+    {
+        auto du = make_scalar(m);
+        std::ranges::fill(du.d_vec, 7.0);
+        auto graph = Kokkos::Experimental::create_graph<execution_space>([&](auto root) {
+            grad.add_dot_graph_nodes(root, u, wx, wy, wz, du);
+        });
+        graph.instantiate();
+        graph.submit();
+        Kokkos::fence();
+
+        REQUIRE_THAT(du.d_vec, Approx(ex.d_vec));
+        REQUIRE_THAT(du.rx_vec, Approx(ex.rx_vec));
+        REQUIRE_THAT(du.ry_vec, Approx(ex.ry_vec));
+        REQUIRE_THAT(du.rz_vec, Approx(ex.rz_vec));
+    }
+}
+
+TEST_CASE("Fused sweep matches gradient")
+{
+    const std::string mesh_3d = R"(
+            mesh = {
+                index_extents = {21, 22, 23},
+                domain_bounds = {
+                    min = {0.1, 0.2, 0.3},
+                    max = {1, 2, 2.2}
+                }
+            },
+            domain_boundaries = {
+                xmin = "dirichlet",
+                zmax = "dirichlet"
+            },
+            shapes = {
+                {
+                    type = "sphere",
+                    center = {0.45, 1.011, 1.31},
+                    radius = 0.141,
+                    boundary_condition = "floating"
+                }
+            },)";
+    const std::string mesh_2d = R"(
+            mesh = {
+                index_extents = {21, 15},
+                domain_bounds = {
+                    min = {0.1, 0.2},
+                    max = {2, 2}
+                }
+            },
+            domain_boundaries = {
+                xmin = "dirichlet",
+                ymin = "dirichlet"
+            },
+            shapes = {
+                {
+                    type = "sphere",
+                    center = {2, 2},
+                    radius = 0.541,
+                    boundary_condition = "floating"
+                },
+                {
+                    type = "sphere",
+                    center = {0.1, 0.2},
+                    radius = 0.4,
+                    boundary_condition = "dirichlet"
+                }
+            },)";
+    const auto domain = GENERATE_COPY(mesh_3d, mesh_2d);
+
+    sol::state lua;
+    lua.script("simulation = {" + domain + R"(
+            scheme = {
+                order = 1,
+                type = "E2",
+                alpha = {-1.47956280234494, 0.261900367793859, -0.145072532538541, -0.224665713988644}
+            }
+        }
+    )");
+    auto m_opt = mesh::from_lua(lua["simulation"]);
+    REQUIRE(!!m_opt);
+    const mesh& m = *m_opt;
+
+    auto bc_opt = bcs::from_lua(lua["simulation"], m.extents());
+    REQUIRE(!!bc_opt);
+    auto&& [gridBcs, objectBcs] = *bc_opt;
+
+    auto scheme_opt = stencil::from_lua(lua["simulation"]);
+    REQUIRE(!!scheme_opt);
+
+    auto u = eval_at_mesh(m, f2);
+    auto grad = gradient{m, *scheme_opt, gridBcs, objectBcs};
+
+    auto ex_x = make_scalar(m);
+    auto ex_y = make_scalar(m);
+    auto ex_z = make_scalar(m);
+    grad(u)(ex_x, ex_y, ex_z);
+
+    // stale data must not leak into the result
+    auto stale = [&m]() {
+        auto s = make_scalar(m);
+        for (auto* v : {&s.d_vec, &s.rx_vec, &s.ry_vec, &s.rz_vec})
+            std::ranges::fill(*v, 7.0);
+        return s;
+    };
+    auto du_x = stale();
+    auto du_y = stale();
+    auto du_z = stale();
+
+    // weighted by fields laid out like du
+    auto ex_dot = make_scalar(m);
+    grad.dot(u, u, ex_x, ex_y)(ex_dot);
+    auto du_dot = stale();
+
+    SECTION("eager")
+    {
+        grad.fused(u)(du_x, du_y, du_z);
+        grad.fused_dot(u, u, ex_x, ex_y)(du_dot);
+    }
+
+    SECTION("graph")
+    {
+        auto graph = Kokkos::Experimental::create_graph<execution_space>([&](auto root) {
+            grad.add_fused_graph_nodes(root, u, du_x, du_y, du_z);
+            grad.add_fused_dot_graph_nodes(root, u, u, ex_x, ex_y, du_dot);
+        });
+        graph.instantiate();
+        graph.submit();
+        Kokkos::fence();
+    }
+
+    for (auto&& [du, ex] :
+         {std::pair{&du_x, &ex_x},
+          std::pair{&du_y, &ex_y},
+          std::pair{&du_z, &ex_z},
+          std::pair{&du_dot, &ex_dot}}) {
+        REQUIRE_THAT(du->d_vec, Approx(ex->d_vec).margin(1e-12));
+        REQUIRE_THAT(du->rx_vec, Approx(ex->rx_vec).margin(1e-12));
+        REQUIRE_THAT(du->ry_vec, Approx(ex->ry_vec).margin(1e-12));
+        REQUIRE_THAT(du->rz_vec, Approx(ex->rz_vec).margin(1e-12));
+    }
+}
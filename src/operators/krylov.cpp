@@ -0,0 +1,254 @@
+#include "krylov.hpp"
+
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <string>
+
+#include <sol/sol.hpp>
+
+namespace ccs
+{
+namespace
+{
+using rp_t = index_policy<integer>;
+
+real dot(const real* x, const real* y, integer n)
+{
+    real s = 0;
+    Kokkos::parallel_reduce(
+        "krylov_dot", rp_t(exec_space(), 0, n), KOKKOS_LAMBDA(integer i, real& acc) {
+            acc += x[i] * y[i];
+        },
+        s);
+    return s;
+}
+
+real norm(const real* x, integer n) { return std::sqrt(dot(x, x, n)); }
+
+// y += a * x
+void axpy(real a, const real* x, real* y, integer n)
+{
+    index_for("krylov_axpy", n, KOKKOS_LAMBDA(auto i) { y[i] += a * x[i]; });
+}
+
+// y = x + a * y
+void xpay(const real* x, real a, real* y, integer n)
+{
+    index_for("krylov_xpay", n, KOKKOS_LAMBDA(auto i) { y[i] = x[i] + a * y[i]; });
+}
+
+// y = a * x
+void assign_scaled(real a, const real* x, real* y, integer n)
+{
+    index_for("krylov_assign", n, KOKKOS_LAMBDA(auto i) { y[i] = a * x[i]; });
+}
+} // namespace
+
+std::optional<krylov_options> krylov_options::from_lua(const sol::table& tbl,
+                                                       const logs& logger)
+{
+    krylov_options o{};
+    auto k = tbl["integrator"]["krylov"];
+    if (!k.valid()) return o;
+
+    const auto method = k["method"].get_or(std::string{"gmres"});
+    if (method == "cg")
+        o.method = krylov_method::cg;
+    else if (method == "gmres")
+        o.method = krylov_method::gmres;
+    else {
+        logger(spdlog::level::err, "integrator.krylov.method must be one of: [cg, gmres]");
+        return std::nullopt;
+    }
+
+    o.rtol = k["rtol"].get_or(o.rtol);
+    o.max_iterations = k["max_iterations"].get_or(o.max_iterations);
+    o.restart = k["restart"].get_or(o.restart);
+
+    if (!(o.rtol > 0) || o.max_iterations < 1 || o.restart < 1) {
+        logger(spdlog::level::err,
+               "integrator.krylov requires rtol > 0, max_iterations >= 1, restart >= 1");
+        return std::nullopt;
+    }
+    return o;
+}
+
+krylov_solver::krylov_solver(const mesh& m,
+                             const bcs::Grid& grid_bcs,
+                             const bcs::Object& object_bcs)
+    : sizes{m.size(), (integer)m.Rx().size(), (integer)m.Ry().size(), (integer)m.Rz().size()},
+      mask(unknown_mask(m, grid_bcs, object_bcs))
+{
+}
+
+krylov_result krylov_solver::operator()(const linear_operator& A,
+                                        const linear_operator& M,
+                                        scalar_view b,
+                                        scalar_span x,
+                                        const krylov_options& opts) const
+{
+    Kokkos::Profiling::ScopedRegion region("krylov_solver");
+
+    const integer n = static_cast<integer>(mask.size());
+    const real* msk = mask.data();
+
+    auto as_view = [this](const real* v) {
+        return scalar_view{std::span<const real>{v, (std::size_t)sizes[0]},
+                           std::span<const real>{v + sizes[0], (std::size_t)sizes[1]},
+                           std::span<const real>{v + sizes[0] + sizes[1], (std::size_t)sizes[2]},
+                           std::span<const real>{v + sizes[0] + sizes[1] + sizes[2],
+                                                 (std::size_t)sizes[3]}};
+    };
+    auto as_span = [this](real* v) {
+        return scalar_span{std::span<real>{v, (std::size_t)sizes[0]},
+                           std::span<real>{v + sizes[0], (std::size_t)sizes[1]},
+                           std::span<real>{v + sizes[0] + sizes[1], (std::size_t)sizes[2]},
+                           std::span<real>{v + sizes[0] + sizes[1] + sizes[2],
+                                           (std::size_t)sizes[3]}};
+    };
+    // out = mask * op(in)
+    auto apply = [&](const linear_operator& op, const real* in, real* out) {
+        as_span(out) = 0;
+        op(as_view(in), as_span(out));
+        index_for("krylov_mask", n, KOKKOS_LAMBDA(auto i) { out[i] *= msk[i]; });
+        exec_space().fence("krylov_solver apply");
+    };
+
+    // right hand side restricted to the unknowns, zero initial guess
+    std::vector<real> rhs(n), sol(n);
+    {
+        auto r = rhs.begin();
+        for (auto c : {b.D, b.Rx, b.Ry, b.Rz}) r = std::ranges::copy(c, r).out;
+        for (integer i = 0; i < n; ++i) rhs[i] *= msk[i];
+    }
+
+    krylov_result res{0, 0, true};
+    const real bnorm = norm(rhs.data(), n);
+
+    if (bnorm > 0 && opts.method == krylov_method::cg) {
+        std::vector<real> r(rhs), z(n), p(n), q(n);
+        apply(M, r.data(), z.data());
+        std::ranges::copy(z, p.begin());
+        real rz = dot(r.data(), z.data(), n);
+
+        res = {0, 1, false};
+        while (res.iterations < opts.max_iterations) {
+            apply(A, p.data(), q.data());
+            const real alpha = rz / dot(p.data(), q.data(), n);
+            axpy(alpha, p.data(), sol.data(), n);
+            axpy(-alpha, q.data(), r.data(), n);
+            ++res.iterations;
+
+            res.residual = norm(r.data(), n) / bnorm;
+            if (res.residual <= opts.rtol) {
+                res.converged = true;
+                break;
+            }
+
+            apply(M, r.data(), z.data());
+            const real rz_next = dot(r.data(), z.data(), n);
+            xpay(z.data(), rz_next / rz, p.data(), n);
+            rz = rz_next;
+        }
+    } else if (bnorm > 0) {
+        const int k = opts.restart;
+        // Krylov basis, one contiguous column of length n per vector
+        std::vector<real> V(static_cast<std::size_t>(k + 1) * n);
+        auto col = [&](int j) { return V.data() + static_cast<std::size_t>(j) * n; };
+        std::vector<real> w(n), z(n);
+
+        // Hessenberg matrix, column major with leading dimension k + 1, reduced
+        // to upper triangular form by Givens rotations as it is built
+        std::vector<real> H(static_cast<std::size_t>(k + 1) * k);
+        auto h = [&](int i, int j) -> real& { return H[i + static_cast<std::size_t>(j) * (k + 1)]; };
+        std::vector<real> cs(k), sn(k), g(k + 1), y(k);
+
+        res = {0, 1, false};
+        while (res.iterations < opts.max_iterations) {
+            // r = b - A x, in the first basis vector
+            if (res.iterations == 0) {
+                std::ranges::copy(rhs, col(0));
+            } else {
+                apply(A, sol.data(), w.data());
+                for (integer i = 0; i < n; ++i) col(0)[i] = rhs[i] - w[i];
+            }
+            const real beta = norm(col(0), n);
+            res.residual = beta / bnorm;
+            if (res.residual <= opts.rtol) {
+                res.converged = true;
+                break;
+            }
+            assign_scaled(1 / beta, col(0), col(0), n);
+
+            std::ranges::fill(H, 0.0);
+            std::ranges::fill(g, 0.0);
+            g[0] = beta;
+
+            int m = 0;
+            for (int j = 0; j < k && res.iterations < opts.max_iterations; ++j) {
+                apply(M, col(j), z.data());
+                apply(A, z.data(), col(j + 1));
+                real* v = col(j + 1);
+
+                // modified Gram-Schmidt
+                for (int i = 0; i <= j; ++i) {
+                    h(i, j) = dot(col(i), v, n);
+                    axpy(-h(i, j), col(i), v, n);
+                }
+                const real vn = norm(v, n);
+                h(j + 1, j) = vn;
+                if (vn > 0) assign_scaled(1 / vn, v, v, n);
+
+                // apply the previous rotations, then annihilate h(j + 1, j)
+                for (int i = 0; i < j; ++i) {
+                    const real t = cs[i] * h(i, j) + sn[i] * h(i + 1, j);
+                    h(i + 1, j) = -sn[i] * h(i, j) + cs[i] * h(i + 1, j);
+                    h(i, j) = t;
+                }
+                const real d = std::hypot(h(j, j), h(j + 1, j));
+                cs[j] = d > 0 ? h(j, j) / d : 1;
+                sn[j] = d > 0 ? h(j + 1, j) / d : 0;
+                h(j, j) = d;
+                h(j + 1, j) = 0;
+                g[j + 1] = -sn[j] * g[j];
+                g[j] *= cs[j];
+
+                ++res.iterations;
+                m = j + 1;
+                res.residual = std::abs(g[j + 1]) / bnorm;
+                if (res.residual <= opts.rtol || vn == 0) break;
+            }
+
+            // x += M V y with H y = g
+            for (int i = m - 1; i >= 0; --i) {
+                real s = g[i];
+                for (int l = i + 1; l < m; ++l) s -= h(i, l) * y[l];
+                y[i] = s / h(i, i);
+            }
+            std::ranges::fill(w, 0.0);
+            for (int i = 0; i < m; ++i) axpy(y[i], col(i), w.data(), n);
+            apply(M, w.data(), z.data());
+            axpy(1.0, z.data(), sol.data(), n);
+            exec_space().fence("krylov_solver update");
+
+            if (res.residual <= opts.rtol) {
+                res.converged = true;
+                break;
+            }
+        }
+    }
+
+    exec_space().fence("krylov_solver complete");
+    {
+        auto s = sol.begin();
+        for (auto c : {x.D, x.Rx, x.Ry, x.Rz}) {
+            std::copy_n(s, c.size(), c.begin());
+            s += c.size();
+        }
+    }
+    return res;
+}
+} // namespace ccs
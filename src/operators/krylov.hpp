@@ -0,0 +1,55 @@
+#pragma once
+
+#include "spectral_radius.hpp"
+
+#include <array>
+#include <optional>
+#include <sol/forward.hpp>
+#include <vector>
+
+namespace ccs
+{
+enum class krylov_method { cg, gmres };
+
+struct krylov_options {
+    krylov_method method = krylov_method::gmres;
+    real rtol = 1e-10;
+    int max_iterations = 500;
+    // GMRES restart length
+    int restart = 30;
+
+    // reads simulation.integrator.krylov; defaults when absent, nullopt when invalid
+    static std::optional<krylov_options> from_lua(const sol::table&, const logs& = {});
+};
+
+struct krylov_result {
+    int iterations;
+    real residual; // final residual relative to |b|
+    bool converged;
+};
+
+//
+// Matrix-free solves of A x = b for one scalar, restricted to the unknowns of
+// the discrete problem (see unknown_mask).  A and the preconditioner M ~ A^-1
+// are applied to fields laid out like the scalar; entries of x outside the
+// unknowns are set to zero, so A sees homogeneous boundary data.  CG requires A
+// and M to be symmetric positive definite on the unknowns; GMRES is
+// right-preconditioned and restarted.
+//
+class krylov_solver
+{
+    std::array<integer, 4> sizes; // D, Rx, Ry, Rz
+    std::vector<real> mask;
+
+public:
+    krylov_solver() = default;
+
+    krylov_solver(const mesh&, const bcs::Grid&, const bcs::Object&);
+
+    krylov_result operator()(const linear_operator& A,
+                             const linear_operator& M,
+                             scalar_view b,
+                             scalar_span x,
+                             const krylov_options& = {}) const;
+};
+} // namespace ccs
@@ -0,0 +1,173 @@
+#include "krylov.hpp"
+#include "derivative.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "stencils/stencil.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sol/sol.hpp>
+
+#include <Kokkos_Core.hpp>
+
+// Custom main: Kokkos must be initialized before parallel_for calls.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+using namespace ccs;
+
+namespace
+{
+// Owns the four buffers of one scalar laid out on the mesh
+struct field {
+    std::vector<real> d, rx, ry, rz;
+
+    field(const mesh& m)
+        : d(m.size()), rx(m.Rx().size()), ry(m.Ry().size()), rz(m.Rz().size())
+    {
+    }
+
+    scalar_span span() { return {d, rx, ry, rz}; }
+    scalar_view view() const { return {d, rx, ry, rz}; }
+};
+} // namespace
+
+TEST_CASE("cg and gmres")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(R"(
+            simulation = {
+                mesh = {
+                    index_extents = {21},
+                    domain_bounds = {20}
+                },
+                shapes = {
+                    {
+                        type = "yz_rect",
+                        psi = 0.001,
+                        normal = 1,
+                        boundary_condition = "dirichlet"
+                    },
+                    {
+                        type = "yz_rect",
+                        psi = 0.9,
+                        normal = -1,
+                        boundary_condition = "floating"
+                    }
+                },
+                scheme = {
+                    order = 1,
+                    type = "E2-poly",
+                    floating_alpha = {13/100, 7/50, 3/20, 4/25, 17/100, 9/50},
+                    dirichlet_alpha = {3/25, 13/100, 7/50}
+                },
+                integrator = {
+                    krylov = { method = "cg", rtol = 1e-12, max_iterations = 50 }
+                }
+            }
+        )");
+
+    auto mesh_opt = mesh::from_lua(lua["simulation"]);
+    REQUIRE(!!mesh_opt);
+    const auto& m = *mesh_opt;
+
+    auto bc_opt = bcs::from_lua(lua["simulation"], m.extents());
+    REQUIRE(!!bc_opt);
+
+    auto st_opt = stencil::from_lua(lua["simulation"]);
+    REQUIRE(!!st_opt);
+
+    auto mask = unknown_mask(m, bc_opt->first, bc_opt->second);
+    auto solve = krylov_solver{m, bc_opt->first, bc_opt->second};
+
+    field b{m}, x{m}, ax{m};
+    std::ranges::fill(b.d, 1.0);
+    std::ranges::fill(b.rx, 1.0);
+
+    auto identity = [](scalar_view u, scalar_span v) {
+        std::ranges::copy(u.D, v.D.begin());
+        std::ranges::copy(u.Rx, v.Rx.begin());
+    };
+
+    // maximum of |A x - b| over the unknowns
+    auto residual = [&](const linear_operator& A) {
+        ax.span() = 0;
+        A(x.view(), ax.span());
+        const auto n = m.size();
+        real r = 0;
+        for (integer i = 0; i < n; ++i) r = std::max(r, mask[i] * std::abs(ax.d[i] - b.d[i]));
+        for (std::size_t i = 0; i < ax.rx.size(); ++i)
+            r = std::max(r, mask[n + i] * std::abs(ax.rx[i] - b.rx[i]));
+        return r;
+    };
+
+    SECTION("cg with an exact preconditioner")
+    {
+        auto opts = krylov_options::from_lua(lua["simulation"]);
+        REQUIRE(!!opts);
+        REQUIRE(opts->method == krylov_method::cg);
+
+        // A = diag(2 + i), M = A^-1
+        auto A = [](scalar_view u, scalar_span v) {
+            for (std::size_t i = 0; i < u.D.size(); ++i) v.D[i] = (2.0 + i) * u.D[i];
+            for (std::size_t i = 0; i < u.Rx.size(); ++i) v.Rx[i] = 2.0 * u.Rx[i];
+        };
+        auto M = [](scalar_view u, scalar_span v) {
+            for (std::size_t i = 0; i < u.D.size(); ++i) v.D[i] = u.D[i] / (2.0 + i);
+            for (std::size_t i = 0; i < u.Rx.size(); ++i) v.Rx[i] = u.Rx[i] / 2.0;
+        };
+
+        auto r = solve(A, M, b.view(), x.span(), *opts);
+        REQUIRE(r.converged);
+        REQUIRE(r.iterations == 1);
+        REQUIRE(residual(A) < 1e-12);
+
+        // Dirichlet and solid points are not unknowns
+        for (integer i = 0; i < m.size(); ++i)
+            if (mask[i] == 0) REQUIRE(x.d[i] == 0);
+    }
+
+    SECTION("gmres on a nonsymmetric operator")
+    {
+        auto dx = derivative{0, m, *st_opt, bc_opt->first, bc_opt->second};
+
+        // A = I - c D, with homogeneous boundary data
+        auto A = [&dx](scalar_view u, scalar_span v) {
+            dx(u, v);
+            for (std::size_t i = 0; i < u.D.size(); ++i) v.D[i] = u.D[i] - 0.5 * v.D[i];
+            for (std::size_t i = 0; i < u.Rx.size(); ++i) v.Rx[i] = u.Rx[i] - 0.5 * v.Rx[i];
+        };
+
+        krylov_options opts{.rtol = 1e-12, .restart = 8};
+        auto r = solve(A, identity, b.view(), x.span(), opts);
+        REQUIRE(r.converged);
+        REQUIRE(r.residual <= 1e-12);
+        REQUIRE(residual(A) < 1e-10);
+    }
+}
+
+TEST_CASE("krylov options")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(R"(
+            a = { integrator = { type = "implicit" } }
+            b = { integrator = { krylov = { method = "bicgstab" } } }
+            c = { integrator = { krylov = { restart = 0 } } }
+        )");
+
+    auto a = krylov_options::from_lua(lua["a"]);
+    REQUIRE(!!a);
+    REQUIRE(a->method == krylov_method::gmres);
+    REQUIRE(a->restart == 30);
+
+    REQUIRE(!krylov_options::from_lua(lua["b"]));
+    REQUIRE(!krylov_options::from_lua(lua["c"]));
+}
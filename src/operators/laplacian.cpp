@@ -27,9 +27,10 @@ laplacian::laplacian(const mesh& m,
            fmt::join(hdr, ","));
     logger.set_pattern("%Y-%m-%d %H:%M:%S.%f,%v");
 
-    dx = derivative{0, m, st, grid_bcs, obj_bcs, logger};
-    dy = derivative{1, m, st, grid_bcs, obj_bcs, logger};
-    dz = derivative{2, m, st, grid_bcs, obj_bcs, logger};
+    auto d = make_derivatives(m, st, grid_bcs, obj_bcs, logger);
+    dx = MOVE(d[0]);
+    dy = MOVE(d[1]);
+    dz = MOVE(d[2]);
     ex = m.extents();
 }
 
@@ -57,27 +58,86 @@ std::function<void(scalar_span)> laplacian::operator()(scalar_view u,
         if (ex[2] > 1) dz(u, nu, du, plus_eq);
     };
 }
-void laplacian::build_graph(scalar_view u, scalar_span du)
+
+void laplacian::apply_batch(std::span<const scalar_view> u,
+                            std::span<const scalar_view> nu,
+                            std::span<const scalar_span> du) const
+{
+    Kokkos::Profiling::ScopedRegion region("laplacian::apply_batch()");
+    for (auto s : du) s = 0;
+    if (ex[0] > 1) dx.apply_batch(u, nu, du, plus_eq);
+    if (ex[1] > 1) dy.apply_batch(u, nu, du, plus_eq);
+    if (ex[2] > 1) dz.apply_batch(u, nu, du, plus_eq);
+}
+
+void laplacian::diagonal(scalar_span d) const
+{
+    d = 0;
+    if (ex[0] > 1) dx.diagonal(d);
+    if (ex[1] > 1) dy.diagonal(d);
+    if (ex[2] > 1) dz.diagonal(d);
+}
+
+std::array<matrix::line_solver, 3> laplacian::line_solvers(real k) const
+{
+    std::array<matrix::line_solver, 3> s;
+    if (ex[0] > 1) s[0] = dx.line_solve(1, -k);
+    if (ex[1] > 1) s[1] = dy.line_solve(1, -k);
+    if (ex[2] > 1) s[2] = dz.line_solve(1, -k);
+    return s;
+}
+
+void laplacian::build_graph(scalar_view u, scalar_span du, graph_schedule schedule)
 {
-    graph_ = Kokkos::Experimental::create_graph<execution_space>(
-        [&](auto root) { add_graph_nodes(root, u, du); });
+    graph_ = Kokkos::Experimental::create_graph(exec_space(), [&](auto root) {
+        if (schedule == graph_schedule::split)
+            add_split_graph_nodes(root, u, du);
+        else
+            add_graph_nodes(root, u, du);
+    });
 
     graph_->instantiate();
+    graph_work_ = cost();
 }
 
-void laplacian::build_graph(scalar_view u, scalar_view nu, scalar_span du)
+void laplacian::build_graph(scalar_view u,
+                            scalar_view nu,
+                            scalar_span du,
+                            graph_schedule schedule)
 {
-    graph_ = Kokkos::Experimental::create_graph<execution_space>(
-        [&](auto root) { add_graph_nodes(root, u, nu, du); });
+    graph_ = Kokkos::Experimental::create_graph(exec_space(), [&](auto root) {
+        if (schedule == graph_schedule::split)
+            add_split_graph_nodes(root, u, nu, du);
+        else
+            add_graph_nodes(root, u, nu, du);
+    });
 
     graph_->instantiate();
+    graph_work_ = cost();
 }
 
 void laplacian::submit_graph()
 {
     Kokkos::Profiling::ScopedRegion region("laplacian::submit_graph()");
+    report_work(graph_work_);
     graph_->submit();
-    Kokkos::fence("laplacian::submit_graph() complete");
+    exec_space().fence("laplacian::submit_graph() complete");
+}
+
+void laplacian::tune(matrix::autotuner& tuner)
+{
+    if (ex[0] > 1) dx.tune(tuner);
+    if (ex[1] > 1) dy.tune(tuner);
+    if (ex[2] > 1) dz.tune(tuner);
+}
+
+work laplacian::cost(int k) const
+{
+    work w{};
+    if (ex[0] > 1) w += dx.cost(k, true);
+    if (ex[1] > 1) w += dy.cost(k, true);
+    if (ex[2] > 1) w += dz.cost(k, true);
+    return w;
 }
 
 } // namespace ccs
@@ -3,10 +3,18 @@
 #include "derivative.hpp"
 
 #include <Kokkos_Graph.hpp>
+#include <array>
 #include <optional>
+#include <span>
+#include <utility>
 
 namespace ccs
 {
+// Node layout of a laplacian graph.  chained runs dx, dy and dz in turn over
+// all of du; split partitions du so the directions overlap (see
+// laplacian::add_split_batch_graph_nodes).
+enum class graph_schedule { chained, split };
+
 class laplacian
 {
     derivative dx;
@@ -16,6 +24,7 @@ class laplacian
 
     // Pre-built graph for submit_graph().
     std::optional<Kokkos::Experimental::Graph<execution_space>> graph_;
+    work graph_work_{};
 
 public:
     laplacian() = default;
@@ -32,15 +41,42 @@ public:
     std::function<void(scalar_span)> operator()(scalar_view field_values,
                                                 scalar_view derivative_values) const;
 
+    // Batched form: du[k] = lap(u[k]) for scalars sharing this operator, with
+    // each coefficient applied to all of them in one sweep.  nu holds per-scalar
+    // Neumann data and may be empty.
+    void apply_batch(std::span<const scalar_view> u,
+                     std::span<const scalar_view> nu,
+                     std::span<const scalar_span> du) const;
+
+    // d = diag(lap), e.g. for Jacobi preconditioning of implicit solves
+    void diagonal(scalar_span d) const;
+
+    // Line solvers for I - k D_dir, the directional factors of I - k lap on the
+    // D points.  Applied in turn they form an ADI approximation of its inverse.
+    // Directions with a single point get an empty solver.
+    std::array<matrix::line_solver, 3> line_solvers(real k) const;
+
     // Build a pre-instantiated graph for the non-Neumann overload.
-    void build_graph(scalar_view u, scalar_span du);
+    void build_graph(scalar_view u,
+                     scalar_span du,
+                     graph_schedule = graph_schedule::chained);
 
     // Build a pre-instantiated graph for the Neumann overload.
-    void build_graph(scalar_view u, scalar_view nu, scalar_span du);
+    void build_graph(scalar_view u,
+                     scalar_view nu,
+                     scalar_span du,
+                     graph_schedule = graph_schedule::chained);
 
     // Submit the pre-built graph.
     void submit_graph();
 
+    // Flops and compulsory memory traffic of the derivative matvecs of one
+    // application to k scalars
+    work cost(int k = 1) const;
+
+    // Tune the matrices of dx, dy and dz; call before build_graph
+    void tune(matrix::autotuner&);
+
     // Add laplacian nodes to an existing graph, chaining from parent.
     // Zeros du, then chains dx → dy → dz (all accumulate with plus_eq).
     // Returns the final node so the caller can chain further.
@@ -53,24 +89,24 @@ public:
         real* rx_ptr = du.Rx.data();
         real* ry_ptr = du.Ry.data();
         real* rz_ptr = du.Rz.data();
-        const int n_d = static_cast<int>(du.D.size());
-        const int n_rx = static_cast<int>(du.Rx.size());
-        const int n_ry = static_cast<int>(du.Ry.size());
-        const int n_rz = static_cast<int>(du.Rz.size());
+        const integer n_d = static_cast<integer>(du.D.size());
+        const integer n_rx = static_cast<integer>(du.Rx.size());
+        const integer n_ry = static_cast<integer>(du.Ry.size());
+        const integer n_rz = static_cast<integer>(du.Rz.size());
 
         // Zero-fill all 4 components of du
         auto z_d = parent.then_parallel_for(
             "lap_zero_D", rp_t(0, n_d),
-            KOKKOS_LAMBDA(int i) { d_ptr[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { d_ptr[i] = 0; });
         auto z_rx = parent.then_parallel_for(
             "lap_zero_Rx", rp_t(0, n_rx),
-            KOKKOS_LAMBDA(int i) { rx_ptr[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { rx_ptr[i] = 0; });
         auto z_ry = parent.then_parallel_for(
             "lap_zero_Ry", rp_t(0, n_ry),
-            KOKKOS_LAMBDA(int i) { ry_ptr[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { ry_ptr[i] = 0; });
         auto z_rz = parent.then_parallel_for(
             "lap_zero_Rz", rp_t(0, n_rz),
-            KOKKOS_LAMBDA(int i) { rz_ptr[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { rz_ptr[i] = 0; });
 
         auto zeroed = Kokkos::Experimental::when_all(z_d, z_rx, z_ry, z_rz);
 
@@ -80,6 +116,126 @@ public:
         return dz.add_graph_nodes(d1, u, du, plus_eq);
     }
 
+    // Graph form of apply_batch.  Zeros every du, then chains the batched
+    // dx → dy → dz nodes.
+    template <typename NodeT>
+    auto add_batch_graph_nodes(NodeT parent,
+                               std::span<const scalar_view> u,
+                               std::span<const scalar_view> nu,
+                               std::span<const scalar_span> du) const
+    {
+        using rp_t = Kokkos::RangePolicy<execution_space>;
+
+        matrix::batch<real> d, rx, ry, rz;
+        for (auto&& s : du) {
+            d.push_back(s.D.data());
+            rx.push_back(s.Rx.data());
+            ry.push_back(s.Ry.data());
+            rz.push_back(s.Rz.data());
+        }
+        const integer n_d = du.empty() ? 0 : static_cast<integer>(du[0].D.size());
+        const integer n_rx = du.empty() ? 0 : static_cast<integer>(du[0].Rx.size());
+        const integer n_ry = du.empty() ? 0 : static_cast<integer>(du[0].Ry.size());
+        const integer n_rz = du.empty() ? 0 : static_cast<integer>(du[0].Rz.size());
+
+        auto z_d = parent.then_parallel_for(
+            "lap_zero_D", rp_t(0, n_d),
+            KOKKOS_LAMBDA(integer i) { for (int k = 0; k < d.size(); ++k) d[k][i] = 0; });
+        auto z_rx = parent.then_parallel_for(
+            "lap_zero_Rx", rp_t(0, n_rx),
+            KOKKOS_LAMBDA(integer i) { for (int k = 0; k < rx.size(); ++k) rx[k][i] = 0; });
+        auto z_ry = parent.then_parallel_for(
+            "lap_zero_Ry", rp_t(0, n_ry),
+            KOKKOS_LAMBDA(integer i) { for (int k = 0; k < ry.size(); ++k) ry[k][i] = 0; });
+        auto z_rz = parent.then_parallel_for(
+            "lap_zero_Rz", rp_t(0, n_rz),
+            KOKKOS_LAMBDA(integer i) { for (int k = 0; k < rz.size(); ++k) rz[k][i] = 0; });
+
+        auto zeroed = Kokkos::Experimental::when_all(z_d, z_rx, z_ry, z_rz);
+
+        auto d0 = dx.add_batch_graph_nodes(zeroed, u, nu, du, plus_eq);
+        auto d1 = dy.add_batch_graph_nodes(d0, u, nu, du, plus_eq);
+        return dz.add_batch_graph_nodes(d1, u, nu, du, plus_eq);
+    }
+
+    // Split schedule of add_batch_graph_nodes for meshes whose kernels underfill
+    // the device.  The D rows are cut into Chunks ranges; in each range dx, dy
+    // and dz run in turn over its rows only, with the interior rows of each
+    // operator beside its closure rows and their B/N corrections.  The cut-cell
+    // updates of all three directions chain on each of Rx, Ry and Rz.  The
+    // Chunks + 3 chains write disjoint outputs, so they run concurrently without
+    // atomics, and every point sums the same terms in the same order as
+    // add_batch_graph_nodes.
+    template <int Chunks = 4, typename NodeT>
+    auto add_split_batch_graph_nodes(NodeT parent,
+                                     std::span<const scalar_view> u,
+                                     std::span<const scalar_view> nu,
+                                     std::span<const scalar_span> du) const
+    {
+        using rp_t = Kokkos::RangePolicy<execution_space>;
+
+        std::array<matrix::batch<real>, 4> db;
+        for (auto&& s : du) {
+            db[0].push_back(s.D.data());
+            db[1].push_back(s.Rx.data());
+            db[2].push_back(s.Ry.data());
+            db[3].push_back(s.Rz.data());
+        }
+        const std::array<integer, 4> n = {
+            du.empty() ? 0 : static_cast<integer>(du[0].D.size()),
+            du.empty() ? 0 : static_cast<integer>(du[0].Rx.size()),
+            du.empty() ? 0 : static_cast<integer>(du[0].Ry.size()),
+            du.empty() ? 0 : static_cast<integer>(du[0].Rz.size())};
+
+        // zero rows [first, last) of buffer b of every du
+        auto zero = [&](int b, integer first, integer last) {
+            const auto z = db[b];
+            return parent.then_parallel_for(
+                "lap_split_zero", rp_t(first, last),
+                KOKKOS_LAMBDA(integer i) {
+                    for (int k = 0; k < z.size(); ++k) z[k][i] = 0;
+                });
+        };
+
+        auto rows = [&](int c) {
+            const integer first = n[0] * c / Chunks;
+            const integer last = n[0] * (c + 1) / Chunks;
+            auto z = zero(0, first, last);
+            auto d0 = dx.add_batch_D_graph_nodes(z, u, nu, du, first, last, plus_eq);
+            auto d1 = dy.add_batch_D_graph_nodes(d0, u, nu, du, first, last, plus_eq);
+            return dz.add_batch_D_graph_nodes(d1, u, nu, du, first, last, plus_eq);
+        };
+
+        auto rays = [&](int r) {
+            auto z = zero(1 + r, 0, n[1 + r]);
+            auto r0 = dx.add_batch_R_graph_nodes(z, u, du, r);
+            auto r1 = dy.add_batch_R_graph_nodes(r0, u, du, r);
+            return dz.add_batch_R_graph_nodes(r1, u, du, r);
+        };
+
+        return [&]<std::size_t... c>(std::index_sequence<c...>) {
+            return Kokkos::Experimental::when_all(rows(c)..., rays(0), rays(1), rays(2));
+        }(std::make_index_sequence<Chunks>{});
+    }
+
+    // Single scalar forms of add_split_batch_graph_nodes.
+    template <int Chunks = 4, typename NodeT>
+    auto add_split_graph_nodes(NodeT parent, scalar_view u, scalar_span du) const
+    {
+        return add_split_batch_graph_nodes<Chunks>(
+            parent, std::span{&u, 1}, std::span<const scalar_view>{}, std::span{&du, 1});
+    }
+
+    template <int Chunks = 4, typename NodeT>
+    auto add_split_graph_nodes(NodeT parent,
+                               scalar_view u,
+                               scalar_view nu,
+                               scalar_span du) const
+    {
+        return add_split_batch_graph_nodes<Chunks>(
+            parent, std::span{&u, 1}, std::span{&nu, 1}, std::span{&du, 1});
+    }
+
     // Neumann overload: adds Neumann nodes at end of each derivative's D-space chain.
     template <typename NodeT>
     auto add_graph_nodes(NodeT parent, scalar_view u, scalar_view nu,
@@ -91,23 +247,23 @@ public:
         real* rx_ptr = du.Rx.data();
         real* ry_ptr = du.Ry.data();
         real* rz_ptr = du.Rz.data();
-        const int n_d = static_cast<int>(du.D.size());
-        const int n_rx = static_cast<int>(du.Rx.size());
-        const int n_ry = static_cast<int>(du.Ry.size());
-        const int n_rz = static_cast<int>(du.Rz.size());
+        const integer n_d = static_cast<integer>(du.D.size());
+        const integer n_rx = static_cast<integer>(du.Rx.size());
+        const integer n_ry = static_cast<integer>(du.Ry.size());
+        const integer n_rz = static_cast<integer>(du.Rz.size());
 
         auto z_d = parent.then_parallel_for(
             "lap_zero_D", rp_t(0, n_d),
-            KOKKOS_LAMBDA(int i) { d_ptr[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { d_ptr[i] = 0; });
         auto z_rx = parent.then_parallel_for(
             "lap_zero_Rx", rp_t(0, n_rx),
-            KOKKOS_LAMBDA(int i) { rx_ptr[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { rx_ptr[i] = 0; });
         auto z_ry = parent.then_parallel_for(
             "lap_zero_Ry", rp_t(0, n_ry),
-            KOKKOS_LAMBDA(int i) { ry_ptr[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { ry_ptr[i] = 0; });
         auto z_rz = parent.then_parallel_for(
             "lap_zero_Rz", rp_t(0, n_rz),
-            KOKKOS_LAMBDA(int i) { rz_ptr[i] = 0; });
+            KOKKOS_LAMBDA(integer i) { rz_ptr[i] = 0; });
 
         auto zeroed = Kokkos::Experimental::when_all(z_d, z_rx, z_ry, z_rz);
 
@@ -0,0 +1,132 @@
+#include "slab_derivative.hpp"
+
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace ccs
+{
+
+slab_partition::slab_partition(const index_extents& extents, int nslabs, int halo)
+    : slabs{extents, nslabs, halo}
+{
+    std::vector<int> weights(nslabs);
+    for (int s = 0; s < nslabs; ++s) weights[s] = slabs[s].last - slabs[s].first;
+    if (nslabs > 1 && exec_space().concurrency() >= nslabs)
+        instances = Kokkos::Experimental::partition_space(exec_space(), weights);
+    else
+        instances = {exec_space()};
+}
+
+void slab_partition::fill(std::span<real> v, real value) const
+{
+    assert((integer)v.size() == slabs.plane_size() * slabs.extents()[0]);
+
+    for_each([&](int s) { fill(s, v, value); });
+}
+
+void slab_partition::fill(int s, std::span<real> v, real value) const
+{
+    const auto own = slabs.owned(s);
+    real* p = v.data();
+    Kokkos::parallel_for(
+        "slab_fill",
+        Kokkos::RangePolicy<execution_space>(
+            instance(s), own.offset_, own.offset_ + own.count()),
+        KOKKOS_LAMBDA(integer i) { p[i] = value; });
+}
+
+int slab_derivative::halo_width(const stencil& st)
+{
+    auto&& [p, r, t, x] = st.query_max();
+    return std::max(p, r);
+}
+
+slab_derivative::slab_derivative(int dir,
+                                 const mesh& m,
+                                 const stencil& st,
+                                 const bcs::Grid& grid_bcs,
+                                 int nslabs,
+                                 const logs& logger)
+    : slab_derivative{dir,
+                      m,
+                      st,
+                      grid_bcs,
+                      slab_partition{m.extents(), nslabs, dir == 0 ? halo_width(st) : 0},
+                      logger}
+{
+}
+
+slab_derivative::slab_derivative(int dir,
+                                 const mesh& m,
+                                 const stencil& st,
+                                 const bcs::Grid& grid_bcs,
+                                 slab_partition part,
+                                 const logs& logger)
+    : dir{dir}, part{MOVE(part)}
+{
+    assert(m.Rx().empty() && m.Ry().empty() && m.Rz().empty());
+    assert(dir != 0 || this->part.decomposition().halo() >= halo_width(st));
+
+    const auto& slabs = this->part.decomposition();
+    const int nx = m.extents()[0];
+
+    ops.reserve(slabs.size());
+    for (int s = 0; s < slabs.size(); ++s) {
+        const auto& sl = slabs[s];
+        ops.emplace_back(dir,
+                         slab_mesh(m, sl.lo, sl.hi),
+                         st,
+                         slab_bcs(grid_bcs, sl.lo, sl.hi, nx),
+                         bcs::Object{},
+                         logger);
+    }
+}
+
+template <typename Op>
+    requires std::invocable<Op, real&, real>
+void slab_derivative::apply(int s, std::span<const real> u, std::span<real> du, Op op) const
+{
+    const auto& slabs = part.decomposition();
+    const auto own = slabs.owned(s);
+    const auto pad = slabs.padded(s);
+
+    // The slab mesh covers the padded planes.  The operator reads them where
+    // they lie in u and writes only the owned rows, so rows of du in a
+    // neighbour's halo are left to the neighbour.  In y and z the padded planes
+    // beyond the owned ones are only read.
+    const auto first = own.offset_ - pad.offset_;
+    ops[s].apply_D(part.instance(s),
+                   u.subspan(pad.offset_, pad.count()),
+                   du.subspan(pad.offset_, pad.count()),
+                   op,
+                   first,
+                   first + own.count());
+}
+
+template <typename Op>
+    requires std::invocable<Op, real&, real>
+void slab_derivative::operator()(std::span<const real> u, std::span<real> du, Op op) const
+{
+    Kokkos::Profiling::ScopedRegion region("slab_derivative::operator()");
+
+    part.for_each([&](int s) { apply(s, u, du, op); });
+}
+
+template void slab_derivative::apply<eq_t>(int,
+                                           std::span<const real>,
+                                           std::span<real>,
+                                           eq_t) const;
+template void slab_derivative::apply<plus_eq_t>(int,
+                                                std::span<const real>,
+                                                std::span<real>,
+                                                plus_eq_t) const;
+template void slab_derivative::operator()<eq_t>(std::span<const real>,
+                                                std::span<real>,
+                                                eq_t) const;
+template void slab_derivative::operator()<plus_eq_t>(std::span<const real>,
+                                                     std::span<real>,
+                                                     plus_eq_t) const;
+
+} // namespace ccs
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "derivative.hpp"
+#include "mesh/slab_decomposition.hpp"
+
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace ccs
+{
+
+//
+// The slabs of a slab_decomposition, each with its own partition of the host
+// execution space (e.g. one NUMA domain).  With fewer threads than slabs the
+// slabs take turns on the whole host.
+//
+class slab_partition
+{
+    slab_decomposition slabs;
+    std::vector<execution_space> instances;
+
+public:
+    slab_partition() = default;
+
+    slab_partition(const index_extents&, int nslabs, int halo);
+
+    int size() const { return slabs.size(); }
+    const slab_decomposition& decomposition() const { return slabs; }
+    const execution_space& instance(int s) const { return instances[s % instances.size()]; }
+
+    // f(s) for every slab, concurrently from one host thread per partition;
+    // instance(s) is fenced after each call
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        auto run = [&](int s) {
+            f(s);
+            instance(s).fence();
+        };
+        if (instances.size() == 1) {
+            for (int s = 0; s < size(); ++s) run(s);
+            return;
+        }
+        std::vector<std::jthread> threads;
+        threads.reserve(size());
+        for (int s = 0; s < size(); ++s) threads.emplace_back(run, s);
+    }
+
+    // v = value over the owned rows of every slab, written on the slab's
+    // partition.  Applied to a buffer allocated without initialization, this
+    // first touch places each slab's pages with the threads that use them.
+    void fill(std::span<real> v, real value) const;
+
+    // v = value over the owned rows of slab s, launched on its partition without
+    // fencing
+    void fill(int s, std::span<real> v, real value) const;
+};
+
+//
+// A derivative split over the slabs of a slab_partition, each slab with its own
+// operator built on a mesh of its planes.
+//
+// Lines in y and z lie inside a slab, so those operators work on the owned range
+// of the global buffers in place.  Lines in x cross slabs, so the x operator of a
+// slab is built on its owned and halo planes.  x is the slowest index, so those
+// planes are one contiguous range of u: the slab reads its halo, the
+// stencil-width planes of its neighbours, in place and writes only its owned
+// rows of du.  The halo is wide enough that every owned row uses the same
+// stencil as the undecomposed operator.  No slab buffers are needed.
+//
+// Only meshes without embedded objects are supported, and Neumann data is not
+// applied, as with the two argument derivative::operator().  slab_laplacian
+// combines one per direction for the heat rhs.
+//
+class slab_derivative
+{
+    int dir;
+    slab_partition part;
+    std::vector<derivative> ops;
+
+public:
+    slab_derivative() = default;
+
+    slab_derivative(int dir,
+                    const mesh& m,
+                    const stencil& st,
+                    const bcs::Grid& grid_bcs,
+                    int nslabs,
+                    const logs& = {});
+
+    // on the slabs of `part`, whose halo must be at least halo_width(st) for x
+    slab_derivative(int dir,
+                    const mesh& m,
+                    const stencil& st,
+                    const bcs::Grid& grid_bcs,
+                    slab_partition part,
+                    const logs& = {});
+
+    // planes of halo for owned rows to match the undecomposed operator: closures
+    // occupy the first r rows of a line and the interior stencil reaches p
+    static int halo_width(const stencil&);
+
+    const slab_decomposition& decomposition() const { return part.decomposition(); }
+    const slab_partition& partition() const { return part; }
+
+    // du op= D(u) over the owned rows of slab s, launched on its partition
+    // without fencing
+    template <typename Op = eq_t>
+        requires std::invocable<Op, real&, real>
+    void apply(int s, std::span<const real> u, std::span<real> du, Op op = {}) const;
+
+    // du op= D(u) over the whole D buffer
+    template <typename Op = eq_t>
+        requires std::invocable<Op, real&, real>
+    void operator()(std::span<const real> u, std::span<real> du, Op op = {}) const;
+};
+
+} // namespace ccs
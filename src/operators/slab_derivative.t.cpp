@@ -0,0 +1,102 @@
+#include "slab_derivative.hpp"
+
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "random/random.hpp"
+#include "stencils/stencil.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+
+// Custom main: Kokkos must be initialized before parallel_for calls.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+using namespace ccs;
+using Catch::Matchers::Approx;
+
+namespace
+{
+
+// du of the slab operator against the undecomposed derivative for every
+// direction and slab count.  du starts from the same random data in both, so
+// rows neither operator writes must also agree.
+void check_against_global(const mesh& m, const stencil& st, const bcs::Grid& grid_bcs)
+{
+    std::vector<real> u(m.size());
+    for (auto& v : u) v = pick();
+    const std::vector<real> du0 = [&] {
+        std::vector<real> v(m.size());
+        for (auto& x : v) x = pick();
+        return v;
+    }();
+
+    const std::vector<real> empty;
+    const scalar_view u_sv{u, empty, empty, empty};
+
+    for (int dir = 0; dir < m.dims(); ++dir) {
+        auto d = derivative{dir, m, st, grid_bcs, bcs::Object{}};
+
+        auto expected = du0;
+        d(u_sv, scalar_span{expected, {}, {}, {}});
+        auto expected_plus = du0;
+        d(u_sv, scalar_span{expected_plus, {}, {}, {}}, plus_eq);
+
+        for (int nslabs = 1; nslabs <= 3; ++nslabs) {
+            auto sd = slab_derivative{dir, m, st, grid_bcs, nslabs};
+            REQUIRE(sd.decomposition().size() == nslabs);
+
+            auto du = du0;
+            sd(u, du);
+            REQUIRE_THAT(du, Approx(expected));
+
+            du = du0;
+            sd(u, du, plus_eq);
+            REQUIRE_THAT(du, Approx(expected_plus));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("halo width")
+{
+    auto&& [p, r, t, x] = stencils::second::E4.query_max();
+    REQUIRE(slab_derivative::halo_width(stencils::second::E4) >= p);
+    REQUIRE(slab_derivative::halo_width(stencils::second::E4) >= r);
+}
+
+TEST_CASE("slabs match the global operator")
+{
+    auto m = mesh{index_extents{int3{31, 9, 8}},
+                  domain_extents{.min = {0.1, 0.2, 0.3}, .max = {1, 2, 2.2}}};
+
+    SECTION("E2 FFFFFF")
+    {
+        check_against_global(m, stencils::second::E2, bcs::Grid{bcs::ff, bcs::ff, bcs::ff});
+    }
+
+    SECTION("E2 DDFFFD")
+    {
+        check_against_global(m, stencils::second::E2, bcs::Grid{bcs::dd, bcs::ff, bcs::fd});
+    }
+
+    SECTION("E4 DFDDFF")
+    {
+        check_against_global(m, stencils::second::E4, bcs::Grid{bcs::df, bcs::dd, bcs::ff});
+    }
+}
+
+TEST_CASE("slabs match the global operator in 2D")
+{
+    auto m = mesh{index_extents{int3{25, 17}},
+                  domain_extents{.min = {0.1, 0.2}, .max = {1, 2}}};
+
+    check_against_global(m, stencils::second::E4, bcs::Grid{bcs::fd, bcs::dd, bcs::ff});
+}
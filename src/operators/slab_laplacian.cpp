@@ -0,0 +1,37 @@
+#include "slab_laplacian.hpp"
+
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <cassert>
+
+namespace ccs
+{
+
+slab_laplacian::slab_laplacian(const mesh& m,
+                               const stencil& st,
+                               const bcs::Grid& grid_bcs,
+                               int nslabs,
+                               const logs& logger)
+    : part{m.extents(), nslabs, slab_derivative::halo_width(st)}, dims{m.dims()}
+{
+    for (int dir = 0; dir < dims; ++dir)
+        d[dir] = slab_derivative{dir, m, st, grid_bcs, part, logger};
+}
+
+void slab_laplacian::apply_batch(std::span<const scalar_view> u,
+                                 std::span<const scalar_span> du) const
+{
+    Kokkos::Profiling::ScopedRegion region("slab_laplacian::apply_batch");
+    assert(u.size() == du.size());
+
+    // As laplacian: zero du, then accumulate every direction.  Kernels on one
+    // partition run in launch order.
+    part.for_each([&](int s) {
+        for (std::size_t k = 0; k < u.size(); ++k) {
+            part.fill(s, du[k].D, 0.0);
+            for (int dir = 0; dir < dims; ++dir) d[dir].apply(s, u[k].D, du[k].D, plus_eq);
+        }
+    });
+}
+
+} // namespace ccs
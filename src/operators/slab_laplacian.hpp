@@ -0,0 +1,41 @@
+#pragma once
+
+#include "slab_derivative.hpp"
+
+#include <array>
+#include <span>
+
+namespace ccs
+{
+
+//
+// The laplacian of the D buffers on the slabs of a slab_partition.  Each slab
+// runs every direction over its owned rows from one host thread on its own
+// partition, so the threads that first touched a slab's rows (see
+// slab_partition::fill) are the ones that read and write them.
+//
+// The restrictions of slab_derivative apply: no embedded objects and no Neumann
+// data.  heat uses it for its rhs when system.slabs is set.
+//
+class slab_laplacian
+{
+    slab_partition part;
+    std::array<slab_derivative, 3> d;
+    int dims = 0;
+
+public:
+    slab_laplacian() = default;
+
+    slab_laplacian(const mesh&,
+                   const stencil&,
+                   const bcs::Grid&,
+                   int nslabs,
+                   const logs& = {});
+
+    const slab_partition& partition() const { return part; }
+
+    // du[k].D = lap(u[k].D) for every scalar k, the slabs running concurrently
+    void apply_batch(std::span<const scalar_view> u, std::span<const scalar_span> du) const;
+};
+
+} // namespace ccs
@@ -0,0 +1,97 @@
+#include "slab_laplacian.hpp"
+#include "laplacian.hpp"
+
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "random/random.hpp"
+#include "stencils/stencil.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <vector>
+
+// Custom main: Kokkos must be initialized before parallel_for calls.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+using namespace ccs;
+using Catch::Matchers::Approx;
+
+namespace
+{
+
+// du of the slab laplacian for two scalars against the undecomposed laplacian,
+// for every slab count
+void check_against_global(const mesh& m, const stencil& st, const bcs::Grid& grid_bcs)
+{
+    constexpr int nb = 2;
+    const std::vector<real> empty;
+    auto lap = laplacian{m, st, grid_bcs, bcs::Object{}};
+
+    std::vector<std::vector<real>> u(nb, std::vector<real>(m.size()));
+    std::vector<std::vector<real>> expected(nb, std::vector<real>(m.size()));
+    std::vector<scalar_view> uv;
+    for (int k = 0; k < nb; ++k) {
+        for (auto& v : u[k]) v = pick();
+        uv.emplace_back(u[k], empty, empty, empty);
+        lap(uv[k])(scalar_span{expected[k], {}, {}, {}});
+    }
+
+    for (int nslabs = 1; nslabs <= 3; ++nslabs) {
+        auto sl = slab_laplacian{m, st, grid_bcs, nslabs};
+        REQUIRE(sl.partition().size() == nslabs);
+
+        std::vector<std::vector<real>> du(nb, std::vector<real>(m.size()));
+        std::vector<scalar_span> dus;
+        for (int k = 0; k < nb; ++k) {
+            for (auto& v : du[k]) v = pick();
+            dus.emplace_back(du[k], std::span<real>{}, std::span<real>{}, std::span<real>{});
+        }
+
+        sl.apply_batch(uv, dus);
+        for (int k = 0; k < nb; ++k) REQUIRE_THAT(du[k], Approx(expected[k]));
+    }
+}
+
+} // namespace
+
+TEST_CASE("slab laplacian matches the global operator")
+{
+    auto m = mesh{index_extents{int3{31, 9, 8}},
+                  domain_extents{.min = {0.1, 0.2, 0.3}, .max = {1, 2, 2.2}}};
+
+    SECTION("E2 DDFFFD")
+    {
+        check_against_global(m, stencils::second::E2, bcs::Grid{bcs::dd, bcs::ff, bcs::fd});
+    }
+
+    SECTION("E4 DFDDFF")
+    {
+        check_against_global(m, stencils::second::E4, bcs::Grid{bcs::df, bcs::dd, bcs::ff});
+    }
+}
+
+TEST_CASE("slab laplacian matches the global operator in 2D")
+{
+    auto m = mesh{index_extents{int3{25, 17}},
+                  domain_extents{.min = {0.1, 0.2}, .max = {1, 2}}};
+
+    check_against_global(m, stencils::second::E4, bcs::Grid{bcs::fd, bcs::dd, bcs::ff});
+}
+
+TEST_CASE("slab fill covers every row")
+{
+    const auto ext = index_extents{int3{31, 9, 8}};
+    for (int nslabs = 1; nslabs <= 3; ++nslabs) {
+        auto part = slab_partition{ext, nslabs, 2};
+        std::vector<real> v(ext[0] * ext[1] * ext[2], -1.0);
+        part.fill(v, 3.0);
+        REQUIRE(std::ranges::all_of(v, [](real x) { return x == 3.0; }));
+    }
+}
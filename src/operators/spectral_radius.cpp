@@ -0,0 +1,277 @@
+#include "spectral_radius.hpp"
+
+#include "fields/selection_desc.hpp"
+
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <ranges>
+
+#include <lapack.hh>
+#include <sol/sol.hpp>
+
+namespace ccs
+{
+namespace
+{
+using rp_t = index_policy<integer>;
+
+real dot(const real* x, const real* y, integer n)
+{
+    real s = 0;
+    Kokkos::parallel_reduce(
+        "spectral_dot", rp_t(exec_space(), 0, n), KOKKOS_LAMBDA(integer i, real& acc) {
+            acc += x[i] * y[i];
+        },
+        s);
+    return s;
+}
+
+// y += a * x
+void axpy(real a, const real* x, real* y, integer n)
+{
+    index_for("spectral_axpy", n, KOKKOS_LAMBDA(auto i) { y[i] += a * x[i]; });
+}
+
+// x *= m (elementwise)
+void mask_in_place(const real* m, real* x, integer n)
+{
+    index_for("spectral_mask", n, KOKKOS_LAMBDA(auto i) { x[i] *= m[i]; });
+}
+
+void scale(real a, real* x, integer n)
+{
+    index_for("spectral_scale", n, KOKKOS_LAMBDA(auto i) { x[i] *= a; });
+}
+
+// index of the Ritz value selected by the target
+int select_ritz(std::span<const std::complex<real>> w, spectral_target target)
+{
+    auto proj = [target](const std::complex<real>& z) {
+        return target == spectral_target::largest_magnitude ? -std::abs(z) : z.real();
+    };
+    return static_cast<int>(std::ranges::min_element(w, {}, proj) - w.begin());
+}
+} // namespace
+
+std::optional<spectral_options> spectral_options::from_lua(const sol::table& tbl,
+                                                           const logs& logger)
+{
+    auto s = tbl["system"]["spectral"];
+    if (!s.valid()) return std::nullopt;
+
+    spectral_options o{};
+    o.krylov_dim = s["krylov_dim"].get_or(o.krylov_dim);
+    o.max_restarts = s["max_restarts"].get_or(o.max_restarts);
+    o.tol = s["tol"].get_or(o.tol);
+
+    if (o.krylov_dim < 2 || o.max_restarts < 0 || !(o.tol > 0)) {
+        logger(spdlog::level::err,
+               "system.spectral requires krylov_dim >= 2, max_restarts >= 0, tol > 0");
+        return std::nullopt;
+    }
+    return o;
+}
+
+std::vector<real>
+unknown_mask(const mesh& m, const bcs::Grid& grid_bcs, const bcs::Object& object_bcs)
+{
+    std::vector<real> mask(m.size() + m.Rx().size() + m.Ry().size() + m.Rz().size());
+
+    // D: fluid points minus Dirichlet grid faces
+    const auto& fluid = m.fluid_desc();
+    for (integer i = 0; i < fluid.count(); ++i) mask[fluid.element(i)] = 1;
+    for_each_grid_bc_desc<bcs::Dirichlet>(grid_bcs, m.extents(), [&](auto desc) {
+        for (integer i = 0; i < desc.count(); ++i) mask[desc.element(i)] = 0;
+    });
+
+    // R: non-Dirichlet object boundary points
+    integer offset = m.size();
+    const std::array<integer, 3> r_sizes{
+        (integer)m.Rx().size(), (integer)m.Ry().size(), (integer)m.Rz().size()};
+    for (int dir = 0; dir < 3; ++dir) {
+        auto nd = m.non_dirichlet_object_desc(dir, object_bcs);
+        for (integer i = 0; i < nd.count(); ++i) mask[offset + nd.element(i)] = 1;
+        offset += r_sizes[dir];
+    }
+    return mask;
+}
+
+spectral_estimator::spectral_estimator(const mesh& m,
+                                       const bcs::Grid& grid_bcs,
+                                       const bcs::Object& object_bcs,
+                                       const spectral_options& opts)
+    : sizes{m.size(), (integer)m.Rx().size(), (integer)m.Ry().size(), (integer)m.Rz().size()},
+      mask(unknown_mask(m, grid_bcs, object_bcs)),
+      opts{opts}
+{
+}
+
+integer spectral_estimator::unknowns() const
+{
+    return static_cast<integer>(std::ranges::count(mask, real{1}));
+}
+
+spectral_estimate spectral_estimator::operator()(const linear_operator& A,
+                                                 spectral_target target) const
+{
+    Kokkos::Profiling::ScopedRegion region("spectral_estimator");
+
+    const integer n = static_cast<integer>(mask.size());
+    const int k = opts.krylov_dim;
+    const real* msk = mask.data();
+
+    spectral_estimate est{0, 0, 0, 0, false};
+    if (unknowns() == 0) {
+        est.converged = true;
+        return est;
+    }
+
+    // Krylov basis, one contiguous column of length n per vector
+    std::vector<real> V(static_cast<std::size_t>(k + 1) * n);
+    auto col = [&](int j) { return V.data() + static_cast<std::size_t>(j) * n; };
+
+    auto as_view = [this](const real* x) {
+        return scalar_view{std::span<const real>{x, (std::size_t)sizes[0]},
+                           std::span<const real>{x + sizes[0], (std::size_t)sizes[1]},
+                           std::span<const real>{x + sizes[0] + sizes[1], (std::size_t)sizes[2]},
+                           std::span<const real>{x + sizes[0] + sizes[1] + sizes[2],
+                                                 (std::size_t)sizes[3]}};
+    };
+    auto as_span = [this](real* x) {
+        return scalar_span{std::span<real>{x, (std::size_t)sizes[0]},
+                           std::span<real>{x + sizes[0], (std::size_t)sizes[1]},
+                           std::span<real>{x + sizes[0] + sizes[1], (std::size_t)sizes[2]},
+                           std::span<real>{x + sizes[0] + sizes[1] + sizes[2],
+                                           (std::size_t)sizes[3]}};
+    };
+
+    // deterministic random start restricted to the unknowns
+    {
+        std::mt19937 gen{5489u};
+        std::uniform_real_distribution<real> dist{-1.0, 1.0};
+        real* v0 = col(0);
+        for (integer i = 0; i < n; ++i) v0[i] = dist(gen) * msk[i];
+        scale(1 / std::sqrt(dot(v0, v0, n)), v0, n);
+    }
+
+    // Hessenberg matrix, column major with leading dimension k + 1
+    std::vector<real> H(static_cast<std::size_t>(k + 1) * k);
+    auto h = [&](int i, int j) -> real& { return H[i + static_cast<std::size_t>(j) * (k + 1)]; };
+
+    std::vector<real> Hm, VR;
+    std::vector<std::complex<real>> W;
+    std::vector<real> x(n);
+
+    for (int restart = 0; restart <= opts.max_restarts; ++restart) {
+        std::ranges::fill(H, 0.0);
+
+        int m = 0;
+        bool breakdown = false;
+        for (int j = 0; j < k; ++j) {
+            real* w = col(j + 1);
+            as_span(w) = 0;
+            A(as_view(col(j)), as_span(w));
+            mask_in_place(msk, w, n);
+            exec_space().fence("spectral_estimator apply");
+            ++est.applications;
+
+            const real w0 = std::sqrt(dot(w, w, n));
+
+            // classical Gram-Schmidt with one reorthogonalization pass
+            for (int pass = 0; pass < 2; ++pass) {
+                for (int i = 0; i <= j; ++i) {
+                    const real c = dot(col(i), w, n);
+                    h(i, j) += c;
+                    axpy(-c, col(i), w, n);
+                }
+            }
+
+            const real wn = std::sqrt(dot(w, w, n));
+            h(j + 1, j) = wn;
+            m = j + 1;
+
+            // invariant subspace found: Ritz values are exact eigenvalues
+            if (wn <= 100 * std::numeric_limits<real>::epsilon() * w0) {
+                breakdown = true;
+                break;
+            }
+            scale(1 / wn, w, n);
+        }
+
+        // Ritz values and vectors of the leading m x m Hessenberg block
+        Hm.resize(static_cast<std::size_t>(m) * m);
+        for (int j = 0; j < m; ++j)
+            for (int i = 0; i < m; ++i) Hm[i + static_cast<std::size_t>(j) * m] = h(i, j);
+        W.resize(m);
+        VR.resize(static_cast<std::size_t>(m) * m);
+        real vl;
+        [[maybe_unused]] auto ret = lapack::geev(lapack::Job::NoVec,
+                                                 lapack::Job::Vec,
+                                                 m,
+                                                 Hm.data(),
+                                                 m,
+                                                 W.data(),
+                                                 &vl,
+                                                 m,
+                                                 VR.data(),
+                                                 m);
+        assert(ret == 0);
+
+        est.radius = std::ranges::max(W | std::views::transform([](auto z) {
+                                          return std::abs(z);
+                                      }));
+        est.min_real = std::ranges::min(W | std::views::transform([](auto z) {
+                                            return z.real();
+                                        }));
+        est.max_real = std::ranges::max(W | std::views::transform([](auto z) {
+                                            return z.real();
+                                        }));
+
+        // Unpack the selected Ritz vector y = yr + i yi from LAPACK's packed
+        // real storage of conjugate pairs.
+        const int t = select_ritz(W, target);
+        const real* yr;
+        const real* yi = nullptr;
+        real sign = 1;
+        if (W[t].imag() > 0) {
+            yr = VR.data() + static_cast<std::size_t>(t) * m;
+            yi = yr + m;
+        } else if (W[t].imag() < 0) {
+            yr = VR.data() + static_cast<std::size_t>(t - 1) * m;
+            yi = yr + m;
+            sign = -1;
+        } else {
+            yr = VR.data() + static_cast<std::size_t>(t) * m;
+        }
+
+        const real ym_im = yi ? sign * yi[m - 1] : 0.0;
+        const real residual =
+            breakdown ? 0.0 : h(m, m - 1) * std::hypot(yr[m - 1], ym_im);
+        const real scale_t = std::max(std::abs(W[t]), std::numeric_limits<real>::min());
+
+        if (residual <= opts.tol * scale_t) {
+            est.converged = true;
+            break;
+        }
+
+        // Explicit restart from Re(V y) + Im(V y) which spans the Ritz pair
+        std::ranges::fill(x, 0.0);
+        for (int j = 0; j < m; ++j) {
+            const real c = yr[j] + (yi ? sign * yi[j] : 0.0);
+            axpy(c, col(j), x.data(), n);
+        }
+        exec_space().fence("spectral_estimator restart");
+        std::ranges::copy(x, col(0));
+        scale(1 / std::sqrt(dot(col(0), col(0), n)), col(0), n);
+    }
+
+    return est;
+}
+} // namespace ccs
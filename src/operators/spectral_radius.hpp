@@ -0,0 +1,71 @@
+#pragma once
+
+#include "boundaries.hpp"
+#include "fields/scalar.hpp"
+#include "io/logging.hpp"
+#include "mesh/mesh.hpp"
+
+#include <array>
+#include <functional>
+#include <optional>
+#include <sol/forward.hpp>
+#include <vector>
+
+namespace ccs
+{
+// A linear operator y = A x acting on the D/Rx/Ry/Rz scalar layout.  The output
+// is zeroed before each application so operators that accumulate (csr) are fine.
+using linear_operator = std::function<void(scalar_view, scalar_span)>;
+
+// 1 at the unknowns of a scalar problem laid out as D, Rx, Ry, Rz back to back:
+// fluid points that are not on a Dirichlet grid face and object boundary points
+// that are not Dirichlet.  0 everywhere else.
+std::vector<real> unknown_mask(const mesh&, const bcs::Grid&, const bcs::Object&);
+
+// Which Ritz value drives convergence and restarts.
+enum class spectral_target { largest_magnitude, smallest_real };
+
+struct spectral_options {
+    int krylov_dim = 30;
+    int max_restarts = 50;
+    real tol = 1e-6;
+
+    // reads simulation.system.spectral; nullopt when absent or invalid
+    static std::optional<spectral_options> from_lua(const sol::table&, const logs& = {});
+};
+
+struct spectral_estimate {
+    real radius;      // max |lambda| over the final Ritz values
+    real min_real;    // min Re(lambda) over the final Ritz values
+    real max_real;    // max Re(lambda) over the final Ritz values
+    int applications; // number of operator applications
+    bool converged;
+};
+
+//
+// Matrix-free spectral estimates via restarted Arnoldi.  Only the unknowns of
+// the discrete problem participate: fluid points that are not on a Dirichlet
+// grid face and object boundary points that are not Dirichlet.  This matches the
+// row/column selection used by eigenvalue_visitor but works in any dimension and
+// needs O(krylov_dim * n) memory instead of a dense n x n matrix.
+//
+class spectral_estimator
+{
+    std::array<integer, 4> sizes; // D, Rx, Ry, Rz
+    std::vector<real> mask;
+    spectral_options opts;
+
+public:
+    spectral_estimator() = default;
+
+    spectral_estimator(const mesh&,
+                       const bcs::Grid&,
+                       const bcs::Object&,
+                       const spectral_options& = {});
+
+    spectral_estimate operator()(const linear_operator&,
+                                 spectral_target = spectral_target::largest_magnitude) const;
+
+    integer unknowns() const;
+};
+} // namespace ccs
@@ -0,0 +1,156 @@
+#include "spectral_radius.hpp"
+#include "derivative.hpp"
+#include "eigenvalue_visitor.hpp"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "identity_stencil.hpp"
+#include "stencils/stencil.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <ranges>
+#include <sol/sol.hpp>
+
+#include <Kokkos_Core.hpp>
+
+// Custom main: Kokkos must be initialized before parallel_for calls.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+using namespace ccs;
+using B = std::vector<bool>;
+
+TEST_CASE("identity")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(R"(
+            simulation = {
+                mesh = {
+                    index_extents = {11},
+                    domain_bounds = {1}
+                },
+                shapes = {
+                    {
+                        type = "yz_rect",
+                        psi = 0.1,
+                        normal = 1,
+                        boundary_condition = "dirichlet"
+                    },
+                    {
+                        type = "yz_rect",
+                        psi = 0.2,
+                        normal = -1,
+                        boundary_condition = "floating"
+                    }
+                }
+            }
+        )");
+
+    auto mesh_opt = mesh::from_lua(lua["simulation"]);
+    REQUIRE(!!mesh_opt);
+
+    auto bc_opt = bcs::from_lua(lua["simulation"], mesh_opt->extents());
+    REQUIRE(!!bc_opt);
+
+    auto dx = derivative{0, *mesh_opt, stencils::identity, bc_opt->first, bc_opt->second};
+
+    auto est = spectral_estimator{*mesh_opt, bc_opt->first, bc_opt->second};
+    REQUIRE(est.unknowns() == 10);
+
+    auto r = est([&dx](scalar_view u, scalar_span du) { dx(u, du); });
+    REQUIRE(r.converged);
+    REQUIRE(r.radius == Catch::Approx(1.0));
+    REQUIRE(r.min_real == Catch::Approx(1.0));
+    REQUIRE(r.max_real == Catch::Approx(1.0));
+}
+
+TEST_CASE("e2-poly matches dense spectrum")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(R"(
+            simulation = {
+                mesh = {
+                    index_extents = {21},
+                    domain_bounds = {20}
+                },
+                shapes = {
+                    {
+                        type = "yz_rect",
+                        psi = 0.001,
+                        normal = 1,
+                        boundary_condition = "dirichlet"
+                    },
+                    {
+                        type = "yz_rect",
+                        psi = 0.9,
+                        normal = -1,
+                        boundary_condition = "floating"
+                    }
+                },
+                scheme = {
+                    order = 1,
+                    type = "E2-poly",
+                    floating_alpha = {13/100, 7/50, 3/20, 4/25, 17/100, 9/50},
+                    dirichlet_alpha = {3/25, 13/100, 7/50}
+                },
+                system = {
+                    spectral = { krylov_dim = 12, max_restarts = 400, tol = 1e-10 }
+                }
+            }
+        )");
+
+    auto mesh_opt = mesh::from_lua(lua["simulation"]);
+    REQUIRE(!!mesh_opt);
+
+    auto bc_opt = bcs::from_lua(lua["simulation"], mesh_opt->extents());
+    REQUIRE(!!bc_opt);
+
+    auto st_opt = stencil::from_lua(lua["simulation"]);
+    REQUIRE(!!st_opt);
+
+    auto dx = derivative{0, *mesh_opt, *st_opt, bc_opt->first, bc_opt->second};
+
+    auto v = eigenvalue_visitor{mesh_opt->extents(), B{true, false}, B{}, B{}};
+    v.visit(dx);
+
+    auto er = v.eigenvalues_real();
+    auto ei = v.eigenvalues_imag();
+    real radius = 0;
+    for (std::size_t i = 0; i < er.size(); ++i)
+        radius = std::max(radius, std::hypot(er[i], ei[i]));
+
+    auto apply = [&dx](scalar_view u, scalar_span du) { dx(u, du); };
+
+    SECTION("full krylov space")
+    {
+        auto est = spectral_estimator{
+            *mesh_opt, bc_opt->first, bc_opt->second, spectral_options{.krylov_dim = 30}};
+        REQUIRE(est.unknowns() == 20);
+
+        auto r = est(apply, spectral_target::smallest_real);
+        REQUIRE(r.converged);
+        REQUIRE(r.radius == Catch::Approx(radius));
+        REQUIRE(r.min_real == Catch::Approx(std::ranges::min(er)));
+        REQUIRE(r.max_real == Catch::Approx(0.19628372852526094));
+    }
+
+    SECTION("restarted")
+    {
+        auto opts = spectral_options::from_lua(lua["simulation"]);
+        REQUIRE(!!opts);
+        REQUIRE(opts->krylov_dim == 12);
+
+        auto est = spectral_estimator{*mesh_opt, bc_opt->first, bc_opt->second, *opts};
+        auto r = est(apply);
+        REQUIRE(r.converged);
+        REQUIRE(r.radius == Catch::Approx(radius).epsilon(1e-6));
+    }
+}
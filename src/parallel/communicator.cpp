@@ -0,0 +1,119 @@
+#include "communicator.hpp"
+
+#include <cassert>
+#include <fstream>
+#include <limits>
+
+namespace ccs
+{
+
+#ifdef SHOCCS_ENABLE_MPI
+
+mpi_scope::mpi_scope(int& argc, char**& argv)
+{
+    // Kokkos kernels are launched from the main thread only
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+}
+
+mpi_scope::~mpi_scope() { MPI_Finalize(); }
+
+int communicator::rank() const
+{
+    int r;
+    MPI_Comm_rank(handle(), &r);
+    return r;
+}
+
+int communicator::size() const
+{
+    int n;
+    MPI_Comm_size(handle(), &n);
+    return n;
+}
+
+real communicator::max(real v) const
+{
+    real r;
+    MPI_Allreduce(&v, &r, 1, MPI_DOUBLE, MPI_MAX, handle());
+    return r;
+}
+
+real communicator::min(real v) const
+{
+    real r;
+    MPI_Allreduce(&v, &r, 1, MPI_DOUBLE, MPI_MIN, handle());
+    return r;
+}
+
+real communicator::sum(real v) const
+{
+    real r;
+    MPI_Allreduce(&v, &r, 1, MPI_DOUBLE, MPI_SUM, handle());
+    return r;
+}
+
+integer communicator::sum(integer v) const
+{
+    integer r;
+    MPI_Allreduce(&v, &r, 1, MPI_LONG, MPI_SUM, handle());
+    return r;
+}
+
+void communicator::barrier() const { MPI_Barrier(handle()); }
+
+void communicator::write_at_all(const std::string& filename,
+                                integer offset,
+                                std::span<const real> v) const
+{
+    assert(v.size() <= static_cast<std::size_t>(std::numeric_limits<int>::max()));
+
+    MPI_File fh;
+    MPI_File_open(handle(),
+                  filename.c_str(),
+                  MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                  MPI_INFO_NULL,
+                  &fh);
+    MPI_File_write_at_all(fh,
+                          static_cast<MPI_Offset>(offset),
+                          v.data(),
+                          static_cast<int>(v.size()),
+                          MPI_DOUBLE,
+                          MPI_STATUS_IGNORE);
+    MPI_File_close(&fh);
+}
+
+#else
+
+mpi_scope::mpi_scope(int&, char**&) {}
+
+mpi_scope::~mpi_scope() {}
+
+int communicator::rank() const { return 0; }
+
+int communicator::size() const { return 1; }
+
+real communicator::max(real v) const { return v; }
+
+real communicator::min(real v) const { return v; }
+
+real communicator::sum(real v) const { return v; }
+
+integer communicator::sum(integer v) const { return v; }
+
+void communicator::barrier() const {}
+
+void communicator::write_at_all(const std::string& filename,
+                                integer offset,
+                                std::span<const real> v) const
+{
+    // open for update so other parts of the file are kept
+    std::fstream o(filename, std::ios::in | std::ios::out | std::ios::binary);
+    if (!o) o.open(filename, std::ios::out | std::ios::binary);
+    o.seekp(offset);
+    o.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(real));
+}
+
+#endif
+
+} // namespace ccs
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <span>
+#include <string>
+
+#ifdef SHOCCS_ENABLE_MPI
+#include <mpi.h>
+#endif
+
+namespace ccs
+{
+
+// Initializes MPI for its lifetime; a no-op when built without MPI.  Create it
+// before Kokkos is initialized and let it go out of scope after Kokkos is
+// finalized.
+class mpi_scope
+{
+public:
+    mpi_scope(int& argc, char**& argv);
+    ~mpi_scope();
+
+    mpi_scope(const mpi_scope&) = delete;
+    mpi_scope& operator=(const mpi_scope&) = delete;
+};
+
+//
+// The ranks taking part in a run (MPI_COMM_WORLD).  Without MPI there is a
+// single rank and every collective is the identity, so code written against a
+// communicator runs unchanged in a serial build.
+//
+class communicator
+{
+public:
+    int rank() const;
+    int size() const;
+
+    // allreduce over all ranks
+    real max(real) const;
+    real min(real) const;
+    real sum(real) const;
+    integer sum(integer) const;
+
+    void barrier() const;
+
+    // Collective write of v at byte offset `offset` of the file, which is
+    // created if needed.  Each rank writes its own part of a shared file.
+    void write_at_all(const std::string& filename,
+                      integer offset,
+                      std::span<const real> v) const;
+
+#ifdef SHOCCS_ENABLE_MPI
+    MPI_Comm handle() const { return MPI_COMM_WORLD; }
+#endif
+};
+
+} // namespace ccs
@@ -0,0 +1,69 @@
+#include "distributed_laplacian.hpp"
+#include "operators/slab_derivative.hpp"
+
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <cassert>
+
+namespace ccs
+{
+
+distributed_laplacian::distributed_laplacian(const communicator& comm,
+                                             const mesh& m,
+                                             const stencil& st,
+                                             const bcs::Grid& grid_bcs,
+                                             const logs& logger)
+    : slabs{m.extents(), comm.size(), slab_derivative::halo_width(st)},
+      local_{slabs[comm.rank()]},
+      halos{comm, slabs}
+{
+    assert(m.Rx().empty() && m.Ry().empty() && m.Rz().empty());
+
+    const int nx = m.extents()[0];
+    const auto& sl = local_;
+
+    dx = derivative{0,
+                    slab_mesh(m, sl.lo, sl.hi),
+                    st,
+                    slab_bcs(grid_bcs, sl.lo, sl.hi, nx),
+                    bcs::Object{},
+                    logger};
+
+    const auto owned = slab_mesh(m, sl.first, sl.last);
+    const auto owned_bcs = slab_bcs(grid_bcs, sl.first, sl.last, nx);
+    dy = derivative{1, owned, st, owned_bcs, bcs::Object{}, logger};
+    dz = derivative{2, owned, st, owned_bcs, bcs::Object{}, logger};
+}
+
+void distributed_laplacian::operator()(std::span<real> u, std::span<real> du)
+{
+    Kokkos::Profiling::ScopedRegion region("distributed_laplacian::operator()");
+
+    const integer plane = slabs.plane_size();
+    const auto& sl = local_;
+    assert(u.size() == static_cast<std::size_t>((sl.hi - sl.lo) * plane));
+    assert(du.size() == u.size());
+
+    real* d = du.data();
+    Kokkos::parallel_for(
+        "distributed_laplacian_zero",
+        index_policy<integer>(exec_space(), 0, static_cast<integer>(du.size())),
+        KOKKOS_LAMBDA(integer i) { d[i] = 0; });
+    exec_space().fence("distributed_laplacian_zero complete");
+
+    halos.start(u);
+
+    // owned planes only: no halo needed
+    const auto offset = (sl.first - sl.lo) * plane;
+    const auto count = (sl.last - sl.first) * plane;
+    const scalar_view u_own{u.subspan(offset, count), {}, {}, {}};
+    const scalar_span du_own{du.subspan(offset, count), {}, {}, {}};
+    if (slabs.extents()[1] > 1) dy(u_own, du_own, plus_eq);
+    if (slabs.extents()[2] > 1) dz(u_own, du_own, plus_eq);
+
+    halos.finish();
+
+    dx(scalar_view{u, {}, {}, {}}, scalar_span{du, {}, {}, {}}, plus_eq);
+}
+
+} // namespace ccs
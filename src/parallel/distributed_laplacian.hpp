@@ -0,0 +1,53 @@
+#pragma once
+
+#include "halo_exchange.hpp"
+#include "operators/derivative.hpp"
+
+#include <span>
+
+namespace ccs
+{
+
+//
+// Laplacian of a mesh split into x-slabs over the ranks of a communicator, one
+// slab per rank.  Each rank holds the padded planes [lo, hi) of its slab and
+// builds its operators on meshes of those planes only:
+//
+//   - y and z lines lie inside the owned planes, so dy and dz need no halo and
+//     run while the x halo planes are in flight,
+//   - dx runs on the padded planes once the exchange has finished.  The halo is
+//     slab_derivative::halo_width() planes, so owned rows use the same stencils
+//     as the undecomposed operator.
+//
+// Only the owned rows of the result are meaningful.  As with slab_derivative,
+// meshes with embedded objects are not supported and Neumann data is not applied.
+//
+class distributed_laplacian
+{
+    slab_decomposition slabs;
+    slab local_;
+    halo_exchange halos;
+    derivative dx;
+    derivative dy;
+    derivative dz;
+
+public:
+    distributed_laplacian() = default;
+
+    distributed_laplacian(const communicator& comm,
+                          const mesh& global,
+                          const stencil& st,
+                          const bcs::Grid& grid_bcs,
+                          const logs& = {});
+
+    const slab_decomposition& decomposition() const { return slabs; }
+
+    // the slab of this rank, in global plane numbers
+    const slab& local() const { return local_; }
+
+    // du = lap(u) on the owned planes.  u and du hold the padded planes of the
+    // local slab; the halo planes of u are overwritten by the exchange.
+    void operator()(std::span<real> u, std::span<real> du);
+};
+
+} // namespace ccs
@@ -0,0 +1,130 @@
+#include "distributed_laplacian.hpp"
+
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "operators/laplacian.hpp"
+#include "stencils/stencil.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+// Custom main: MPI wraps Kokkos, which must be initialized before parallel_for
+int main(int argc, char* argv[])
+{
+    mpi_scope mpi(argc, argv);
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+using namespace ccs;
+
+namespace
+{
+
+// smooth and the same on every rank
+real field(const mesh& m, integer i)
+{
+    const auto& n = m.extents();
+    const auto plane = (integer)n[1] * n[2];
+    const real x = m.x()[i / plane];
+    const real y = m.y()[(i % plane) / n[2]];
+    const real z = m.z()[i % n[2]];
+    return std::sin(x) * std::cos(2 * y) + x * z * z + y;
+}
+
+// Owned rows of every rank against the undecomposed laplacian of the whole mesh
+void check_against_global(const mesh& m, const stencil& st, const bcs::Grid& grid_bcs)
+{
+    const communicator comm;
+
+    std::vector<real> u(m.size());
+    for (integer i = 0; i < m.size(); ++i) u[i] = field(m, i);
+    std::vector<real> expected(m.size());
+    laplacian{m, st, grid_bcs, bcs::Object{}}(scalar_view{u, {}, {}, {}})(
+        scalar_span{expected, {}, {}, {}});
+
+    auto lap = distributed_laplacian{comm, m, st, grid_bcs};
+    const auto& sl = lap.local();
+    REQUIRE(lap.decomposition().size() == comm.size());
+
+    const integer plane = lap.decomposition().plane_size();
+    const integer own = sl.first * plane;
+    const integer n_own = (sl.last - sl.first) * plane;
+    REQUIRE(comm.sum(n_own) == m.size());
+
+    // halo planes start as junk and must come from the neighbours
+    std::vector<real> u_local((sl.hi - sl.lo) * plane, 1e10);
+    for (integer i = own; i < own + n_own; ++i) u_local[i - sl.lo * plane] = u[i];
+    std::vector<real> du_local(u_local.size(), 1e10);
+
+    lap(u_local, du_local);
+
+    real err = 0, scale = 1;
+    for (integer i = own; i < own + n_own; ++i) {
+        err = std::max(err, std::abs(du_local[i - sl.lo * plane] - expected[i]));
+        scale = std::max(scale, std::abs(expected[i]));
+    }
+    REQUIRE(comm.max(err) <= 1e-10 * comm.max(scale));
+}
+
+} // namespace
+
+TEST_CASE("distributed laplacian matches the global operator")
+{
+    auto m = mesh{index_extents{int3{31, 9, 8}},
+                  domain_extents{.min = {0.1, 0.2, 0.3}, .max = {1, 2, 2.2}}};
+
+    SECTION("E2 FFFFFF") { check_against_global(m, stencils::second::E2, bcs::Grid{}); }
+
+    SECTION("E2 DDFFDF")
+    {
+        check_against_global(m, stencils::second::E2, bcs::Grid{bcs::dd, bcs::ff, bcs::df});
+    }
+
+    SECTION("E4 DFDDFD")
+    {
+        check_against_global(m, stencils::second::E4, bcs::Grid{bcs::df, bcs::dd, bcs::fd});
+    }
+
+    SECTION("2D E4 FDDF")
+    {
+        auto m2 = mesh{index_extents{int3{25, 17, 1}},
+                       domain_extents{.min = {0, 0}, .max = {1, 1}}};
+        check_against_global(m2, stencils::second::E4, bcs::Grid{bcs::fd, bcs::df, bcs::ff});
+    }
+}
+
+TEST_CASE("collective output of owned planes")
+{
+    const communicator comm;
+    auto m = mesh{index_extents{int3{31, 9, 8}},
+                  domain_extents{.min = {0, 0, 0}, .max = {1, 1, 1}}};
+    auto slabs = slab_decomposition{m.extents(), comm.size(), 2};
+    const auto& sl = slabs[comm.rank()];
+    const auto own = slabs.owned(comm.rank());
+
+    std::vector<real> v(own.count());
+    for (integer i = 0; i < own.count(); ++i) v[i] = field(m, own.offset_ + i);
+
+    const std::string filename = "distributed_output.bin";
+    if (comm.rank() == 0) std::remove(filename.c_str());
+    comm.barrier();
+
+    comm.write_at_all(filename, sl.first * slabs.plane_size() * sizeof(real), v);
+    comm.barrier();
+
+    if (comm.rank() == 0) {
+        std::vector<real> all(m.size());
+        std::ifstream in(filename, std::ios::binary);
+        in.read(reinterpret_cast<char*>(all.data()), all.size() * sizeof(real));
+        REQUIRE(in);
+        for (integer i = 0; i < m.size(); ++i) REQUIRE(all[i] == field(m, i));
+        std::remove(filename.c_str());
+    }
+}
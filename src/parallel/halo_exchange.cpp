@@ -0,0 +1,72 @@
+#include "halo_exchange.hpp"
+
+#include <cassert>
+#include <limits>
+
+namespace ccs
+{
+
+halo_exchange::halo_exchange(const communicator& comm, const slab_decomposition& slabs)
+    : comm{comm}, slabs{slabs}
+{
+    assert(slabs.size() == comm.size());
+}
+
+#ifdef SHOCCS_ENABLE_MPI
+
+namespace
+{
+// messages travelling toward lower and higher ranks
+constexpr int tag_down = 1;
+constexpr int tag_up = 2;
+} // namespace
+
+void halo_exchange::start(std::span<real> local)
+{
+    const int r = comm.rank();
+    const auto& sl = slabs[r];
+    const integer plane = slabs.plane_size();
+    assert(local.size() == static_cast<std::size_t>((sl.hi - sl.lo) * plane));
+
+    // planes [first, last) of the global mesh as a message in the local buffer
+    auto planes = [&](int first, int last) {
+        const integer n = (last - first) * plane;
+        assert(n <= std::numeric_limits<int>::max());
+        return std::pair{local.data() + (first - sl.lo) * plane, static_cast<int>(n)};
+    };
+
+    requests.clear();
+    auto post_recv = [&](int first, int last, int from, int tag) {
+        auto [p, n] = planes(first, last);
+        requests.emplace_back();
+        MPI_Irecv(p, n, MPI_DOUBLE, from, tag, comm.handle(), &requests.back());
+    };
+    auto post_send = [&](int first, int last, int to, int tag) {
+        auto [p, n] = planes(first, last);
+        requests.emplace_back();
+        MPI_Isend(p, n, MPI_DOUBLE, to, tag, comm.handle(), &requests.back());
+    };
+
+    // Receives first so a matching send never waits on an unexpected message
+    requests.reserve(4);
+    if (r > 0) post_recv(sl.lo, sl.first, r - 1, tag_up);
+    if (r + 1 < slabs.size()) post_recv(sl.last, sl.hi, r + 1, tag_down);
+    if (r > 0) post_send(sl.first, slabs[r - 1].hi, r - 1, tag_down);
+    if (r + 1 < slabs.size()) post_send(slabs[r + 1].lo, sl.last, r + 1, tag_up);
+}
+
+void halo_exchange::finish()
+{
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    requests.clear();
+}
+
+#else
+
+void halo_exchange::start(std::span<real>) {}
+
+void halo_exchange::finish() {}
+
+#endif
+
+} // namespace ccs
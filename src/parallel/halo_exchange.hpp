@@ -0,0 +1,39 @@
+#pragma once
+
+#include "communicator.hpp"
+#include "mesh/slab_decomposition.hpp"
+
+#include <span>
+#include <vector>
+
+namespace ccs
+{
+
+//
+// Nonblocking exchange of the x halo planes between neighbouring ranks of a
+// slab_decomposition with one slab per rank.  The local buffer holds the padded
+// planes [lo, hi) of the rank's slab.  start() posts the receives into the halo
+// planes and the sends of the owned planes the neighbours read; finish() waits
+// for them.  Work that reads only owned planes can run in between.
+//
+// Without MPI there is a single slab with no halo and both calls do nothing.
+//
+class halo_exchange
+{
+    communicator comm;
+    slab_decomposition slabs;
+
+#ifdef SHOCCS_ENABLE_MPI
+    std::vector<MPI_Request> requests;
+#endif
+
+public:
+    halo_exchange() = default;
+
+    halo_exchange(const communicator&, const slab_decomposition&);
+
+    void start(std::span<real> local);
+    void finish();
+};
+
+} // namespace ccs
@@ -0,0 +1,181 @@
+#include "simulation/simulation_session.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+using namespace std::string_literals;
+using namespace ccs;
+
+namespace
+{
+using real_array = py::array_t<real, py::array::c_style | py::array::forcecast>;
+
+// Scheme keys become lua values: strings, booleans and numbers as they are, array
+// likes as 1-based lua arrays
+sol::table to_lua(sol::state& lua, const py::dict& d)
+{
+    auto t = lua.create_table();
+    for (auto&& [k, v] : d) {
+        const auto key = py::cast<std::string>(k);
+        if (py::isinstance<py::str>(v)) {
+            t[key] = py::cast<std::string>(v);
+        } else if (py::isinstance<py::bool_>(v)) {
+            t[key] = py::cast<bool>(v);
+        } else if (py::isinstance<py::int_>(v)) {
+            t[key] = py::cast<int>(v);
+        } else if (py::isinstance<py::float_>(v)) {
+            t[key] = py::cast<real>(v);
+        } else {
+            auto a = py::cast<real_array>(v);
+            if (a.ndim() == 0) {
+                t[key] = *a.data();
+            } else {
+                auto arr = lua.create_table();
+                for (py::ssize_t i = 0; i < a.size(); ++i) arr[i + 1] = a.data()[i];
+                t[key] = arr;
+            }
+        }
+    }
+    return t;
+}
+
+template <typename T>
+py::array_t<T> to_numpy(const std::vector<T>& v)
+{
+    return py::array_t<T>(static_cast<py::ssize_t>(v.size()), v.data());
+}
+
+//
+// A lua state holding one configuration and the session built on it.  Sessions
+// still open at interpreter exit are closed before Kokkos is finalized since their
+// geometry holds views.
+//
+// Runs release the GIL, so the mutex keeps a second python thread out of the
+// session's lua state while one is running.  It is always taken with the GIL
+// released so a thread holding it can get the GIL back.
+//
+class session
+{
+    std::unique_ptr<sol::state> lua;
+    std::optional<simulation_session> s;
+    std::mutex m;
+
+    std::unique_lock<std::mutex> lock()
+    {
+        py::gil_scoped_release release;
+        return std::unique_lock{m};
+    }
+
+    static inline std::vector<session*> open;
+
+public:
+    explicit session(const std::string& config) : lua{std::make_unique<sol::state>()}
+    {
+        lua->open_libraries(sol::lib::base, sol::lib::math);
+        lua->script(config);
+
+        sol::optional<sol::table> tbl = (*lua)["simulation"];
+        if (!tbl) throw std::invalid_argument("config does not define simulation");
+
+        // quiet unless the config asks for logs
+        bool enable_logging = (*tbl)["logging"].get_or(false);
+        std::string logging_dir =
+            enable_logging ? (*tbl)["logging_dir"].get_or("logs"s) : ""s;
+        logs l{logging_dir, enable_logging, "builder"};
+
+        s = simulation_session::from_lua(*tbl, l);
+        if (!s) throw std::invalid_argument("invalid simulation config");
+        open.push_back(this);
+    }
+
+    session(const session&) = delete;
+    session& operator=(const session&) = delete;
+
+    ~session()
+    {
+        close();
+        std::erase(open, this);
+    }
+
+    void close()
+    {
+        auto held = lock();
+        s.reset();
+        lua.reset();
+    }
+
+    py::dict run(const py::dict& scheme, std::optional<real> t_final)
+    {
+        auto held = lock();
+        if (!s) throw std::runtime_error("session is closed");
+
+        std::optional<simulation_trace> trace;
+        {
+            // the scheme table lives in the session's lua state, so it is built
+            // and dropped under the lock
+            auto st = to_lua(*lua, scheme);
+            py::gil_scoped_release release;
+            trace = s->run(st, t_final);
+        }
+        if (!trace) throw std::invalid_argument("invalid scheme");
+
+        const auto n = static_cast<py::ssize_t>(trace->size());
+        const auto k = static_cast<py::ssize_t>(trace->n_stats);
+
+        std::vector<real> linf(n);
+        for (py::ssize_t i = 0; i < n; ++i) linf[i] = trace->stats[i * k];
+
+        py::dict out;
+        out["time"] = to_numpy(trace->time);
+        out["step"] = to_numpy(trace->step);
+        out["linf"] = to_numpy(linf);
+        out["stats"] = real_array({n, k}, trace->stats.data());
+        out["wall_time_s"] = to_numpy(trace->wall_time_s);
+        return out;
+    }
+
+    static void close_all()
+    {
+        for (auto* p : open) p->close();
+    }
+};
+} // namespace
+
+PYBIND11_MODULE(pyshoccs, m)
+{
+    m.doc() = "In-process shoccs runs with the mesh and geometry kept between runs";
+
+    // Kokkos stays initialized for the life of the interpreter
+    if (!Kokkos::is_initialized()) {
+        Kokkos::initialize();
+        py::module_::import("atexit").attr("register")(py::cpp_function([] {
+            session::close_all();
+            if (Kokkos::is_initialized()) Kokkos::finalize();
+        }));
+    }
+
+    py::class_<session>(m, "Session")
+        .def(py::init<const std::string&>(),
+             py::arg("config"),
+             "Build the mesh, geometry and boundary conditions of the lua source "
+             "`config`, which must define a scalar wave simulation table")
+        .def("run",
+             &session::run,
+             py::arg("scheme"),
+             py::kw_only(),
+             py::arg("t_final") = py::none(),
+             "Run with the dict `scheme` as simulation.scheme.  Returns the time, "
+             "step, linf, stats and wall_time_s of every step as NumPy arrays")
+        .def("close", &session::close, "Release the geometry and the lua state");
+}
@@ -0,0 +1,120 @@
+#include <Kokkos_Core.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <sol/sol.hpp>
+
+#include <vector>
+
+#include "parallel/communicator.hpp"
+#include "simulation_builder.hpp"
+
+using namespace ccs;
+
+// Custom main: MPI wraps Kokkos, which must be initialized before any test
+// allocates Views
+int main(int argc, char* argv[])
+{
+    mpi_scope mpi(argc, argv);
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+// Every rank runs the whole mesh on its own, then its slab of the distributed
+// run.  The reduced stats of the distributed run must match the serial ones on
+// every rank, so the owned rows step exactly as the undecomposed heat does.
+TEST_CASE("cycle - distributed heat")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(R"(
+        simulation = {
+            logging = false,
+            mesh = {
+                index_extents = {21, 12, 10},
+                domain_bounds = {
+                    min = {1, 1.1, 0},
+                    max = {3, 3.3, 1}
+                }
+            },
+            domain_boundaries = {
+                xmin = "dirichlet",
+                xmax = "dirichlet",
+                ymin = "dirichlet",
+            },
+            scheme = {
+                order = 2,
+                type = "E2"
+            },
+            system = {
+                type = "heat",
+                diffusivity = {1.0, 0.5}
+            },
+            integrator = {
+                type = "rk4",
+            },
+            step_controller = {
+                max_step = 5,
+            },
+            manufactured_solution = {
+                type = "lua",
+                call = function(time, loc)
+                    local x, y, z = loc[1], loc[2], loc[3]
+                    return (time + math.sin(x) * y * y + x * z * z + y)
+                end,
+                ddt = function(time, loc)
+                    return 1.0
+                end,
+                grad = function(time, loc)
+                    local x, y, z = loc[1], loc[2], loc[3]
+                    return math.cos(x) * y * y + z * z,
+                           2. * math.sin(x) * y + 1,
+                           2. * x * z
+                end,
+                lap = function(time, loc)
+                    local x, y, z = loc[1], loc[2], loc[3]
+                    return -math.sin(x) * y * y + 2. * math.sin(x) + 2. * x
+                end,
+                div = function(time, loc)
+                    return 0.0
+                end
+            }
+        }
+    )");
+
+    std::vector<system_stats> serial, distributed;
+    auto run = [&](bool dist, std::vector<system_stats>& out) {
+        lua["simulation"]["system"]["distributed"] = dist;
+        auto cycle_opt = simulation_cycle::from_lua(lua["simulation"]);
+        REQUIRE(!!cycle_opt);
+        return cycle_opt->run(
+            [&](const step_controller&, const system_stats& s) { out.push_back(s); });
+    };
+
+    const auto expected = run(false, serial);
+    const auto res = run(true, distributed);
+
+    // a sine in x keeps the error away from zero, so the comparison means something
+    REQUIRE(expected[1] > 1e-8);
+    REQUIRE(expected[1] < 0.05);
+    REQUIRE(res[0] == expected[0]);
+    REQUIRE_THAT(res[1], Catch::Matchers::WithinAbs(expected[1], 1e-12));
+
+    // Linf, min, max, err_d, the Linf of scalar 1, and a global index for err_d
+    REQUIRE(distributed.size() == serial.size());
+    for (std::size_t n = 0; n < serial.size(); ++n) {
+        INFO("step " << n << " of " << communicator{}.size() << " rank(s)");
+        const auto& a = serial[n].stats;
+        const auto& b = distributed[n].stats;
+        REQUIRE(b.size() == a.size());
+        for (int i : {0, 1, 2, 3, 11})
+            REQUIRE_THAT(b[i], Catch::Matchers::WithinAbs(a[i], 1e-12));
+        REQUIRE(b[4] >= 0);
+        REQUIRE(b[4] < 21 * 12 * 10);
+    }
+
+    // slabs apply no Neumann data
+    lua.script("simulation.domain_boundaries.ymax = 'neumann'");
+    REQUIRE(!simulation_cycle::from_lua(lua["simulation"]));
+}
@@ -0,0 +1,118 @@
+#include "memory_estimate.hpp"
+
+#include "io/memory_tracker.hpp"
+#include "matrices/inner_block_meta.hpp"
+#include "mesh/mesh.hpp"
+#include "stencils/stencil.hpp"
+#include "systems/heat.hpp"
+#include "systems/inviscid_vortex.hpp"
+#include "systems/scalar_wave.hpp"
+#include "temporal/integrator.hpp"
+
+#include <sol/sol.hpp>
+
+#include <numeric>
+#include <string>
+
+namespace ccs
+{
+
+namespace
+{
+// registry layout and full-mesh buffers of a system type
+struct system_shape {
+    int scalars;
+    int vectors;
+    int buffers;
+};
+
+std::optional<system_shape>
+shape_of(const sol::table& tbl, const integrator& integ, const logs& logger)
+{
+    auto sys = tbl["system"];
+    const auto type = sys["type"].get_or(std::string{});
+
+    if (type == "heat") {
+        int scalars = sys["scalars"].get_or(1);
+        if (sol::optional<sol::table> t = sys["diffusivity"]; t) scalars = (int)t->size();
+        return system_shape{scalars, 0, systems::heat::fields(integ.is_implicit())};
+    } else if (type == "scalar wave") {
+        return system_shape{1, 0, systems::scalar_wave::fields()};
+    } else if (type == "inviscid vortex") {
+        return system_shape{2, 1, systems::inviscid_vortex::fields()};
+    }
+
+    logger(spdlog::level::err, "no memory model for system.type = '{}'", type);
+    return std::nullopt;
+}
+} // namespace
+
+std::int64_t memory_estimate::total() const
+{
+    return std::reduce(bytes.begin(), bytes.end(), std::int64_t{});
+}
+
+void memory_estimate::log(const logs& logger) const
+{
+    for (int i = 0; i < n_subsystems; ++i)
+        if (bytes[i] > 0)
+            logger(spdlog::level::info,
+                   "{:<10} {}",
+                   subsystem_names[i],
+                   memory_tracker::bytes(bytes[i]));
+    logger(spdlog::level::info, "estimated peak {}", memory_tracker::bytes(total()));
+}
+
+std::optional<memory_estimate> memory_estimate::from_lua(const sol::table& tbl,
+                                                         const logs& logger)
+{
+    const auto integ = integrator::from_lua(tbl, logger);
+    const auto shape = integ ? shape_of(tbl, *integ, logger) : std::nullopt;
+    auto st_opt = stencil::from_lua(tbl, logger);
+
+    const auto before = memory_in(subsystem::mesh).current;
+    auto m_opt = mesh::from_lua(tbl, logger);
+    const auto mesh_bytes = memory_in(subsystem::mesh).current - before;
+
+    if (!(shape && st_opt && m_opt)) return std::nullopt;
+
+    const auto& m = *m_opt;
+    const std::int64_t D = m.size();
+    const std::int64_t R = m.Rx().size() + m.Ry().size() + m.Rz().size();
+    const stencils::info info = st_opt->query_max();
+    const std::int64_t p = info.p, r = info.r, t = info.t;
+
+    constexpr std::int64_t sr = sizeof(real);
+    constexpr std::int64_t si = sizeof(integer);
+    constexpr std::int64_t smeta = sizeof(matrix::inner_block_meta);
+
+    memory_estimate est{};
+    auto at = [&est](subsystem s) -> std::int64_t& { return est.bytes[(int)s]; };
+
+    at(subsystem::mesh) = mesh_bytes;
+    at(subsystem::fields) =
+        integ->slots() * (shape->scalars + 3 * shape->vectors) * (D + R) * sr;
+    // the Krylov vectors of a solve are charged to the system that runs it
+    at(subsystem::systems) = (shape->buffers + integ->work_vectors()) * (D + R) * sr;
+
+    for (int d = 0; d < m.dims(); ++d) {
+        const std::int64_t lines = m.lines(d).size();
+        const std::int64_t Rd = m.R(d).size();
+
+        // every line holds its own closures and interior, the device copy pools
+        // them and only the closures of cut lines stay distinct
+        const std::int64_t line = 2 * r * t + 2 * p + 1;
+        const std::int64_t block = lines * (line * sr + smeta) + (Rd * r * t + line) * sr;
+
+        // B and N have a row per domain point, the six Bf/Br a row per boundary
+        // point; their nonzeros are the closure columns of the cut lines
+        const std::int64_t nnz = 2 * Rd * r * t;
+        const std::int64_t csr = (2 * D + 6 * R) * si + nnz * (sr + si);
+
+        at(subsystem::matrices) += block + csr;
+    }
+
+    return est;
+}
+
+} // namespace ccs
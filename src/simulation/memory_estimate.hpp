@@ -0,0 +1,44 @@
+#pragma once
+
+#include "io/logging.hpp"
+#include "memory.hpp"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include <sol/forward.hpp>
+
+namespace ccs
+{
+
+//
+// First-order model of the bytes a simulation_cycle run holds per subsystem,
+// for sizing a job before submitting it.  Only the mesh is built, to count the
+// boundary points; everything else is sized from those counts without being
+// allocated:
+//
+//   fields     the registry slots of the integrator (integrator::slots) for
+//              every scalar and vector component
+//   systems    the full-mesh member and scratch buffers of the system type
+//              (heat::fields and the like), and the Krylov vectors of a solve
+//              of an implicit integrator (integrator::work_vectors)
+//   matrices   per derivative direction, one block line per grid line and cut,
+//              each with its dense closures and circulant interior, and the
+//              boundary coupling csr matrices
+//   mesh       measured while building it
+//
+// The pooled ADI factors and transient Kokkos temporaries are not modelled.
+//
+struct memory_estimate {
+    std::array<std::int64_t, n_subsystems> bytes{};
+
+    std::int64_t total() const;
+
+    // Log every non-empty subsystem and the total
+    void log(const logs&) const;
+
+    static std::optional<memory_estimate> from_lua(const sol::table&, const logs& = {});
+};
+
+} // namespace ccs
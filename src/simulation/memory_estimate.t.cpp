@@ -0,0 +1,142 @@
+#include "memory_estimate.hpp"
+
+#include "fields/field_registry.hpp"
+#include "io/memory_tracker.hpp"
+#include "systems/system.hpp"
+#include "temporal/integrator.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <sol/sol.hpp>
+
+using namespace ccs;
+
+// Custom main: Kokkos must be initialized before any test allocates Views.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+namespace
+{
+constexpr auto config = R"(
+    simulation = {
+        mesh = {
+            index_extents = {17, 18, 19},
+            domain_bounds = {
+                min = {0.0, 0.0, 0.0},
+                max = {1.0, 1.0, 1.0}
+            }
+        },
+        domain_boundaries = {
+            xmin = "dirichlet",
+            xmax = "dirichlet"
+        },
+        shapes = {
+            {
+                type = "sphere",
+                center = {0.5013, 0.4989, 0.5017},
+                radius = 0.25,
+                boundary_condition = "dirichlet"
+            }
+        },
+        scheme = {
+            order = 2,
+            type = "E2"
+        },
+        system = {
+            type = "heat",
+            diffusivity = {0.1, 0.2}
+        },
+        manufactured_solution = {
+            type = "gaussian",
+            {
+                center = {0.5, 0.5, 0.5},
+                variance = {0.3, 0.3, 0.3},
+                amplitude = 1.0,
+                frequency = 1.0
+            }
+        }
+    }
+)";
+
+std::int64_t bytes_in(const memory_estimate& e, subsystem s)
+{
+    return e.bytes[static_cast<int>(s)];
+}
+} // namespace
+
+TEST_CASE("memory_estimate - heat")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(config);
+
+    auto est = memory_estimate::from_lua(lua["simulation"]);
+    REQUIRE(!!est);
+    REQUIRE(bytes_in(*est, subsystem::mesh) > 0);
+    REQUIRE(bytes_in(*est, subsystem::matrices) > 0);
+    REQUIRE(est->total() > bytes_in(*est, subsystem::fields));
+
+    // the model against the bytes a run charges
+    memory_tracker tracker{logs{false, "memory"}};
+    const auto systems = memory_in(subsystem::systems).current;
+
+    auto sys = system::from_lua(lua["simulation"]);
+    REQUIRE(!!sys);
+    REQUIRE(memory_in(subsystem::systems).current - systems <=
+            bytes_in(*est, subsystem::systems));
+
+    const auto fields = memory_in(subsystem::fields).current;
+    sim_registry reg;
+    auto sz = sys->size();
+    REQUIRE(sz.nscalars == 2);
+    for (int slot = 0; slot < integrator{}.slots(); ++slot)
+        for (int s = 0; s < sz.nscalars; ++s)
+            reg.allocate_scalar(slot, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+
+    REQUIRE(memory_in(subsystem::fields).current - fields ==
+            bytes_in(*est, subsystem::fields));
+}
+
+TEST_CASE("memory_estimate - integrators")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(config);
+
+    lua.script("simulation.integrator = { type = 'rk4' }");
+    auto rk4 = memory_estimate::from_lua(lua["simulation"]);
+    lua.script(R"(simulation.integrator = {
+                      type = "implicit",
+                      krylov = { method = "gmres", restart = 10 }
+                  })");
+    auto gmres = memory_estimate::from_lua(lua["simulation"]);
+    REQUIRE(!!rk4);
+    REQUIRE(!!gmres);
+
+    // 4 slots of 2 scalars
+    const auto field = bytes_in(*rk4, subsystem::fields) / 8;
+    REQUIRE(bytes_in(*gmres, subsystem::fields) == bytes_in(*rk4, subsystem::fields));
+
+    // the input and output of the lap graph, then the rhs, solution, 11 basis
+    // vectors, w and z of GMRES(10)
+    REQUIRE(bytes_in(*gmres, subsystem::systems) - bytes_in(*rk4, subsystem::systems) ==
+            (2 + 15) * field);
+
+    lua.script("simulation.integrator.type = 'crank'");
+    REQUIRE(!memory_estimate::from_lua(lua["simulation"]));
+}
+
+TEST_CASE("memory_estimate - unsupported")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(config);
+    lua.script("simulation.system = { type = 'eigenvalues' }");
+
+    REQUIRE(!memory_estimate::from_lua(lua["simulation"]));
+}
@@ -0,0 +1,225 @@
+#include "multi_run.hpp"
+
+#include "io/memory_tracker.hpp"
+#include "simulation_cycle.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <fmt/core.h>
+
+using namespace std::string_literals;
+namespace fs = std::filesystem;
+
+namespace ccs
+{
+namespace
+{
+sol::table shallow_copy(sol::state_view lua, const sol::table& src)
+{
+    auto t = lua.create_table();
+    src.for_each([&t](const sol::object& k, const sol::object& v) { t.set(k, v); });
+    return t;
+}
+
+// tbl with the entry at `path` ("system.diffusivity") set to v, copying only the
+// tables along the path
+sol::table with(sol::state_view lua,
+                const sol::table& tbl,
+                std::string_view path,
+                const sol::object& v)
+{
+    auto t = shallow_copy(lua, tbl);
+    const auto dot = path.find('.');
+    const auto key = std::string{path.substr(0, dot)};
+    if (dot == std::string_view::npos) {
+        t[key] = v;
+    } else {
+        auto sub = tbl[key].get_or<sol::table>(lua.create_table());
+        t[key] = with(lua, sub, path.substr(dot + 1), v);
+    }
+    return t;
+}
+} // namespace
+
+multi_run::multi_run(std::vector<sol::table>&& runs, int partitions, const logs& logger)
+    : runs{MOVE(runs)}, partitions{partitions}, logger{logger}
+{
+}
+
+std::optional<multi_run> multi_run::from_lua(const sol::table& tbl, const logs& logger)
+{
+    sol::optional<sol::table> runs_tbl = tbl["runs"];
+    if (!runs_tbl) {
+        logger(spdlog::level::err, "simulation.runs must be a table");
+        return std::nullopt;
+    }
+    sol::state_view lua{tbl.lua_state()};
+
+    // the simulation table every run starts from
+    auto base = shallow_copy(lua, tbl);
+    base["runs"] = sol::lua_nil;
+
+    std::vector<sol::table> runs;
+    for (int i = 1; (*runs_tbl)[i].valid(); ++i) {
+        sol::optional<sol::table> entries = (*runs_tbl)[i];
+        if (!entries) {
+            logger(spdlog::level::err, "simulation.runs[{}] must be a table", i);
+            return std::nullopt;
+        }
+        auto t = shallow_copy(lua, base);
+        entries->for_each(
+            [&t](const sol::object& k, const sol::object& v) { t.set(k, v); });
+        runs.push_back(t);
+    }
+
+    if (sol::optional<sol::table> sweep = (*runs_tbl)["sweep"]; sweep) {
+        std::vector<std::pair<std::string, sol::table>> axes;
+        bool ok = true;
+        sweep->for_each([&](const sol::object& k, const sol::object& v) {
+            if (k.is<std::string>() && v.is<sol::table>() &&
+                v.as<sol::table>().size() > 0)
+                axes.emplace_back(k.as<std::string>(), v.as<sol::table>());
+            else
+                ok = false;
+        });
+        if (!ok || axes.empty()) {
+            logger(spdlog::level::err,
+                   "simulation.runs.sweep must map key paths to non-empty lists of "
+                   "values");
+            return std::nullopt;
+        }
+        std::ranges::sort(
+            axes, {}, [](auto&& a) -> const std::string& { return a.first; });
+
+        std::vector<sol::table> level{base};
+        for (auto&& [path, values] : axes) {
+            std::vector<sol::table> next;
+            for (auto&& t : level)
+                for (std::size_t j = 1; j <= values.size(); ++j)
+                    next.push_back(with(lua, t, path, values.get<sol::object>(j)));
+            level = MOVE(next);
+        }
+        runs.insert(runs.end(), level.begin(), level.end());
+    }
+
+    if (runs.empty()) {
+        logger(spdlog::level::err, "simulation.runs lists no runs");
+        return std::nullopt;
+    }
+
+    const auto logging_dir = tbl["logging_dir"].get_or("logs"s);
+    for (int i = 0; i < (int)runs.size(); ++i) {
+        auto& t = runs[i];
+        if (t["profiling"].valid() || t["tuning"].valid()) {
+            logger(spdlog::level::err,
+                   "run {}: profiling and tuning cannot be used by concurrent runs",
+                   i);
+            return std::nullopt;
+        }
+        // ranks are driven from the main thread only
+        if (t["system"]["distributed"].get_or(false)) {
+            logger(spdlog::level::err,
+                   "run {}: system.distributed cannot be used by concurrent runs",
+                   i);
+            return std::nullopt;
+        }
+        if (t["manufactured_solution"]["type"].get_or(""s) == "lua") {
+            logger(spdlog::level::err,
+                   "run {}: lua manufactured solutions cannot be used by concurrent "
+                   "runs",
+                   i);
+            return std::nullopt;
+        }
+
+        // each run logs and writes to its own directories
+        const auto sub = fmt::format("run{}", i);
+        t["logging_dir"] =
+            (fs::path{t["logging_dir"].get_or(logging_dir)} / sub).string();
+        if (sol::optional<sol::table> io = t["io"]; io) {
+            auto c = shallow_copy(lua, *io);
+            c["dir"] = (fs::path{(*io)["dir"].get_or("io"s)} / sub).string();
+            t["io"] = c;
+        }
+    }
+
+    const int n = static_cast<int>(runs.size());
+    const int concurrency = execution_space().concurrency();
+    const int requested = (*runs_tbl)["partitions"].get_or(std::min(n, concurrency));
+    if (requested < 1) {
+        logger(spdlog::level::err, "simulation.runs.partitions must be positive");
+        return std::nullopt;
+    }
+    // every partition needs a thread of its own and a run to do
+    const int partitions = std::min({requested, n, concurrency});
+    logger(spdlog::level::info,
+           "{} runs on {} partitions of {} threads",
+           n,
+           partitions,
+           concurrency);
+
+    return multi_run{MOVE(runs), partitions, logger};
+}
+
+std::vector<std::optional<real3>> multi_run::run()
+{
+    const int n = size();
+    std::vector<std::optional<real3>> results(n);
+
+    // node-wide accounting; the trackers of the runs find it installed
+    memory_tracker memory{logger};
+
+    std::vector<execution_space> instances;
+    if (partitions > 1)
+        instances = Kokkos::Experimental::partition_space(
+            execution_space{}, std::vector<int>(partitions, 1));
+    else
+        instances = {execution_space{}};
+
+    // lua is only read while building a run, one at a time
+    std::mutex lua_mutex;
+    std::atomic<int> next{0};
+
+    auto work = [&](int p) {
+        scoped_exec_space scope{instances[p]};
+        for (int i = next++; i < n; i = next++) {
+            auto cycle = [&] {
+                std::scoped_lock lock{lua_mutex};
+                return simulation_cycle::from_lua(runs[i]);
+            }();
+            if (cycle) results[i] = cycle->run();
+        }
+        instances[p].fence("multi_run partition complete");
+    };
+
+    if (partitions == 1) {
+        work(0);
+    } else {
+        std::vector<std::jthread> threads;
+        threads.reserve(partitions);
+        for (int p = 0; p < partitions; ++p) threads.emplace_back(work, p);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (results[i])
+            logger(spdlog::level::info,
+                   "run {}: time {} Linf {}",
+                   i,
+                   (*results[i])[0],
+                   (*results[i])[1]);
+        else
+            logger(spdlog::level::err, "run {} could not be built", i);
+    }
+    memory.report("after all runs");
+
+    return results;
+}
+
+} // namespace ccs
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "types.hpp"
+
+#include "io/logging.hpp"
+
+#include <optional>
+#include <vector>
+
+#include <sol/sol.hpp>
+
+namespace ccs
+{
+
+//
+// Independent simulation_cycle runs of one process on partitions of the host,
+// for parameter sweeps of problems too small to use every core.  The runs are
+// listed in simulation.runs, each a table whose top-level entries replace those
+// of the simulation table, and/or generated by runs.sweep, which maps key paths
+// to lists of values and adds a run for every combination:
+//
+//   runs = {
+//       partitions = 8,
+//       { scheme = { order = 2, type = "E4" } },
+//       sweep = { ["system.diffusivity"] = {0.1, 0.2, 0.4} }
+//   }
+//
+// Listed runs come first, then the sweep with the last path (in sorted order)
+// varying fastest.  Each partition is a Kokkos::Experimental::partition_space
+// instance driven by its own host thread, which takes the next run whenever its
+// last one ends.  The kernels and graphs of a run launch on the instance of its
+// thread (exec_space()).  Runs log to and write fields in a run<i>
+// subdirectory of their logging_dir and io.dir.
+//
+// The lua state is shared, so runs are built one at a time and must not call
+// into lua while stepping: lua manufactured solutions are rejected, as are
+// profiling and tuning, whose Kokkos callbacks and cache file are process-wide.
+//
+class multi_run
+{
+    std::vector<sol::table> runs;
+    int partitions = 1;
+    logs logger{};
+
+public:
+    multi_run() = default;
+
+    multi_run(std::vector<sol::table>&&, int partitions, const logs&);
+
+    // the lua state of the table must outlive the multi_run
+    static std::optional<multi_run> from_lua(const sol::table&, const logs& = {});
+
+    int size() const { return static_cast<int>(runs.size()); }
+
+    // the tables the runs are built from, in order
+    const std::vector<sol::table>& tables() const { return runs; }
+
+    // The result of simulation_cycle::run for every run in order, nullopt for the
+    // runs that could not be built
+    std::vector<std::optional<real3>> run();
+};
+
+} // namespace ccs
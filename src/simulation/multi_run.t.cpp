@@ -0,0 +1,122 @@
+#include "multi_run.hpp"
+#include "simulation_cycle.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <sol/sol.hpp>
+
+using namespace ccs;
+
+// Custom main: Kokkos must be initialized before any test allocates Views.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+namespace
+{
+constexpr auto config = R"(
+    simulation = {
+        logging = false,
+        mesh = {
+            index_extents = {21, 22},
+            domain_bounds = {
+                min = {0, 0},
+                max = {1, 1.1}
+            }
+        },
+        domain_boundaries = {
+            xmin = "dirichlet",
+            xmax = "dirichlet"
+        },
+        scheme = {
+            order = 2,
+            type = "E2"
+        },
+        system = {
+            type = "heat",
+            diffusivity = 1.0
+        },
+        integrator = {
+            type = "rk4",
+        },
+        step_controller = {
+            max_step = 5,
+        },
+        manufactured_solution = {
+            type = "gaussian",
+            {
+                center = {0.5, 0.5},
+                variance = {0.3, 0.3},
+                amplitude = 1.0,
+                frequency = 1.0
+            }
+        },
+        runs = {
+            partitions = 2,
+            { scheme = { order = 2, type = "E4" } },
+            sweep = {
+                ["system.diffusivity"] = {0.5, 1.0},
+                ["step_controller.max_step"] = {3, 4}
+            }
+        }
+    }
+)";
+} // namespace
+
+TEST_CASE("multi_run - runs and sweep")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(config);
+
+    auto runs = multi_run::from_lua(lua["simulation"]);
+    REQUIRE(!!runs);
+    REQUIRE(runs->size() == 5);
+
+    // the listed run, then the sweep with max_step varying fastest
+    const auto& t = runs->tables();
+    REQUIRE(t[0]["scheme"]["type"].get<std::string>() == "E4");
+    REQUIRE(t[0]["system"]["diffusivity"].get<real>() == 1.0);
+    REQUIRE(t[1]["system"]["diffusivity"].get<real>() == 0.5);
+    REQUIRE(t[1]["step_controller"]["max_step"].get<int>() == 3);
+    REQUIRE(t[2]["step_controller"]["max_step"].get<int>() == 4);
+    REQUIRE(t[4]["system"]["diffusivity"].get<real>() == 1.0);
+    REQUIRE(!t[1]["runs"].valid());
+
+    // the sweep copies the tables it changes
+    REQUIRE(lua["simulation"]["system"]["diffusivity"].get<real>() == 1.0);
+
+    auto res = runs->run();
+    REQUIRE(res.size() == 5);
+
+    // concurrent runs match the same runs made one at a time
+    for (int i = 0; i < runs->size(); ++i) {
+        REQUIRE(!!res[i]);
+        auto cycle = simulation_cycle::from_lua(t[i]);
+        REQUIRE(!!cycle);
+        REQUIRE(cycle->run() == *res[i]);
+    }
+}
+
+TEST_CASE("multi_run - invalid")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(config);
+
+    lua.script("simulation.runs.sweep['system.diffusivity'] = {}");
+    REQUIRE(!multi_run::from_lua(lua["simulation"]));
+
+    lua.script("simulation.runs = { { profiling = { cadence = 1 } } }");
+    REQUIRE(!multi_run::from_lua(lua["simulation"]));
+
+    lua.script("simulation.runs = { partitions = 0, {} }");
+    REQUIRE(!multi_run::from_lua(lua["simulation"]));
+
+    lua.script("simulation.runs = {}");
+    REQUIRE(!multi_run::from_lua(lua["simulation"]));
+}
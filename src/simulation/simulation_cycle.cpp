@@ -19,17 +19,25 @@ simulation_cycle::simulation_cycle(system&& sys,
                                    step_controller&& controller,
                                    integrator&& integrate,
                                    field_io&& io,
+                                   profiler&& prof,
+                                   matrix::autotuner&& tuner,
+                                   memory_tracker&& memory,
                                    bool enable_logging)
     : sys{MOVE(sys)},
       controller{MOVE(controller)},
       integrate{MOVE(integrate)},
       io{MOVE(io)},
+      prof{MOVE(prof)},
+      tuner{MOVE(tuner)},
+      memory{MOVE(memory)},
       logger{enable_logging, "cycle"}
 {
 }
 
-real3 simulation_cycle::run()
+real3 simulation_cycle::run(const step_observer& observe)
 {
+    // outlives run_region so the region is closed before the last write
+    auto prof_session = prof.start();
     Kokkos::Profiling::ScopedRegion run_region("simulation_cycle::run");
     logger(spdlog::level::info, "begin time stepping");
 
@@ -41,18 +49,20 @@ real3 simulation_cycle::run()
     int ry_sz = sz.ry_size;
     int rz_sz = sz.rz_size;
 
+    const auto touch = sys.first_touch();
+
     field_ref u0_ref{0}, u1_ref{1}, rk_ref{2}, srhs_ref{3};
     for (int s = 0; s < sz.nscalars; ++s) {
-        u0_ref   = reg.allocate_scalar(0, s, d_sz, rx_sz, ry_sz, rz_sz);
-        u1_ref   = reg.allocate_scalar(1, s, d_sz, rx_sz, ry_sz, rz_sz);
-        rk_ref   = reg.allocate_scalar(2, s, d_sz, rx_sz, ry_sz, rz_sz);
-        srhs_ref = reg.allocate_scalar(3, s, d_sz, rx_sz, ry_sz, rz_sz);
+        u0_ref   = reg.allocate_scalar(0, s, d_sz, rx_sz, ry_sz, rz_sz, touch);
+        u1_ref   = reg.allocate_scalar(1, s, d_sz, rx_sz, ry_sz, rz_sz, touch);
+        rk_ref   = reg.allocate_scalar(2, s, d_sz, rx_sz, ry_sz, rz_sz, touch);
+        srhs_ref = reg.allocate_scalar(3, s, d_sz, rx_sz, ry_sz, rz_sz, touch);
     }
     for (int v = 0; v < sz.nvectors; ++v) {
-        u0_ref   = reg.allocate_vector(0, v, d_sz, rx_sz, ry_sz, rz_sz);
-        u1_ref   = reg.allocate_vector(1, v, d_sz, rx_sz, ry_sz, rz_sz);
-        rk_ref   = reg.allocate_vector(2, v, d_sz, rx_sz, ry_sz, rz_sz);
-        srhs_ref = reg.allocate_vector(3, v, d_sz, rx_sz, ry_sz, rz_sz);
+        u0_ref   = reg.allocate_vector(0, v, d_sz, rx_sz, ry_sz, rz_sz, touch);
+        u1_ref   = reg.allocate_vector(1, v, d_sz, rx_sz, ry_sz, rz_sz, touch);
+        rk_ref   = reg.allocate_vector(2, v, d_sz, rx_sz, ry_sz, rz_sz, touch);
+        srhs_ref = reg.allocate_vector(3, v, d_sz, rx_sz, ry_sz, rz_sz, touch);
     }
     // For zero-field systems (nscalars==0, nvectors==0), refs retain their
     // initial {slot, 0, 0} state — slot_ops correctly no-op.
@@ -65,14 +75,27 @@ real3 simulation_cycle::run()
     system_stats stats = sys.stats(reg, u0_ref, u1_ref, controller);
 
     sys.log(stats, controller);
+    if (observe) observe(controller, stats);
 
     // initial write
     sys.write(io, reg, u0_ref, controller, .0);
 
+    // Launch shapes are captured by the graph, so tune first
+    if (tuner) {
+        Kokkos::Profiling::ScopedRegion tune_region("simulation_cycle::tune");
+        sys.tune(tuner);
+        tuner.save();
+        logger(spdlog::level::info,
+               "autotuner: {} kernel shapes from the cache, {} tuned",
+               tuner.hits(),
+               tuner.tuned());
+    }
+
     // Build RHS graph once for graph-capable systems (heat, scalar_wave).
     // Uses u1_ref as the RHS input slot and srhs_ref as the RHS output slot,
     // matching the rk4 integrator's convention.
     sys.build_rhs_graph(reg, u1_ref, reg, srhs_ref);
+    memory.report("after operator build");
 
     Kokkos::Timer cumulative_timer;
 
@@ -81,6 +104,7 @@ real3 simulation_cycle::run()
         const std::optional<real> dt = sys.timestep_size(reg, u0_ref, controller);
         if (!dt) {
             logger(spdlog::level::info, "required timestep too small");
+            memory.report("at end of run");
             return {null_v<real>}; //{huge<double>, time};
         }
 
@@ -109,6 +133,19 @@ real3 simulation_cycle::run()
         }
         stats.wall_time_s = step_timer.seconds();
         sys.log(stats, controller);
+        if (observe) observe(controller, stats);
+        prof(controller);
+
+        // diverged scalars are dropped from the graph while the rest continue;
+        // their fields stay as they were
+        if (const int n = sys.retire(stats); n > 0) {
+            logger(spdlog::level::info,
+                   "{} diverged scalar(s) retired at time/step {} / {}",
+                   n,
+                   (real)controller,
+                   (int)controller);
+            if (sys.valid(stats)) sys.build_rhs_graph(reg, u1_ref, reg, srhs_ref);
+        }
 
         const double step_wall_ms = stats.wall_time_s * 1000.0;
 
@@ -128,6 +165,9 @@ real3 simulation_cycle::run()
     logger(spdlog::level::info,
            "cumulative wall time: {:.3f}s",
            cumulative_timer.seconds());
+    for (int i = 0; i < (int)stats.scalars.size(); ++i)
+        logger(spdlog::level::info, "scalar {}: Linf {}", i, stats.scalars[i][0]);
+    memory.report("at end of run");
 
     // only return Linf if system ends in a valid state
     if (controller) {
@@ -148,14 +188,49 @@ std::optional<simulation_cycle> simulation_cycle::from_lua(const sol::table& tbl
     std::string logging_dir = enable_logging ? tbl["logging_dir"].get_or("logs"s) : ""s;
     logs l{logging_dir, enable_logging, "builder"};
 
+    // installed first so the operators built below are charged to their views
+    memory_tracker memory{l};
+    memory.report("at startup");
+
     auto sys_opt = system::from_lua(tbl, l);
     auto it_opt = integrator::from_lua(tbl, l);
     auto st_opt = step_controller::from_lua(tbl, l);
     auto io_opt = field_io::from_lua(tbl, l);
+    auto prof_opt = profiler::from_lua(tbl, tbl["logging_dir"].get_or("logs"s), l);
+
+    // tuning = { cache = "tuning.cache", repeats = 5 } enables the autotuner
+    std::optional<matrix::autotuner> tuner_opt{std::in_place};
+    if (sol::optional<sol::table> t = tbl["tuning"]; t) {
+        const int repeats = (*t)["repeats"].get_or(5);
+        if (repeats < 1) {
+            l(spdlog::level::err, "tuning.repeats must be positive");
+            tuner_opt.reset();
+        } else {
+            tuner_opt.emplace((*t)["cache"].get_or("tuning.cache"s), repeats);
+        }
+    }
+
+    if (tbl["system"]["retire_diverged"].valid() &&
+        tbl["system"]["type"].get_or(""s) != "heat") {
+        l(spdlog::level::err,
+          "system.retire_diverged is only supported by the heat system");
+        return std::nullopt;
+    }
+
+    if (sys_opt && it_opt && it_opt->is_implicit() && !sys_opt->has_implicit()) {
+        l(spdlog::level::err, "integrator.type = implicit is not supported by this system");
+        return std::nullopt;
+    }
 
-    if (sys_opt && it_opt && st_opt && io_opt) {
-        return simulation_cycle{
-            MOVE(*sys_opt), MOVE(*st_opt), MOVE(*it_opt), MOVE(*io_opt), l};
+    if (sys_opt && it_opt && st_opt && io_opt && prof_opt && tuner_opt) {
+        return simulation_cycle{MOVE(*sys_opt),
+                                MOVE(*st_opt),
+                                MOVE(*it_opt),
+                                MOVE(*io_opt),
+                                MOVE(*prof_opt),
+                                MOVE(*tuner_opt),
+                                MOVE(memory),
+                                l};
     } else {
         return std::nullopt;
     }
@@ -3,10 +3,14 @@
 #include "types.hpp"
 
 #include "io/field_io.hpp"
+#include "io/memory_tracker.hpp"
+#include "io/profiler.hpp"
+#include "matrices/autotuner.hpp"
 #include "systems/system.hpp"
 #include "temporal/integrator.hpp"
 #include "temporal/step_controller.hpp"
 
+#include <functional>
 #include <sol/forward.hpp>
 
 namespace ccs
@@ -17,19 +21,30 @@ class simulation_cycle
     step_controller controller;
     integrator integrate;
     field_io io;
+    profiler prof;
+    matrix::autotuner tuner;
+    memory_tracker memory;
     logs logger;
 
 public:
+    // Called with the statistics of the initial condition and of every step,
+    // after the system has logged them
+    using step_observer =
+        std::function<void(const step_controller&, const system_stats&)>;
+
     simulation_cycle() = default;
 
     simulation_cycle(system&&,
                      step_controller&&,
                      integrator&&,
                      field_io&&,
+                     profiler&& = {},
+                     matrix::autotuner&& = {},
+                     memory_tracker&& = {},
                      bool enable_logging = false);
 
     static std::optional<simulation_cycle> from_lua(const sol::table&);
 
-    real3 run();
+    real3 run(const step_observer& = {});
 };
 } // namespace ccs
@@ -0,0 +1,94 @@
+#include "simulation_session.hpp"
+
+#include "simulation_cycle.hpp"
+
+#include <string>
+
+namespace ccs
+{
+namespace
+{
+sol::table shallow_copy(sol::state_view lua, const sol::table& src)
+{
+    auto t = lua.create_table();
+    src.for_each([&t](const sol::object& k, const sol::object& v) { t.set(k, v); });
+    return t;
+}
+} // namespace
+
+simulation_session::simulation_session(const sol::table& tbl,
+                                       mesh&& m,
+                                       bcs::Grid&& grid_bcs,
+                                       bcs::Object&& object_bcs,
+                                       const logs& logger)
+    : tbl{tbl},
+      m{MOVE(m)},
+      grid_bcs{MOVE(grid_bcs)},
+      object_bcs{MOVE(object_bcs)},
+      logger{logger}
+{
+}
+
+std::optional<simulation_session> simulation_session::from_lua(const sol::table& tbl,
+                                                               const logs& logger)
+{
+    if (auto type = tbl["system"]["type"].get_or(std::string{}); type != "scalar wave") {
+        logger(spdlog::level::err,
+               "simulation_session requires system.type = 'scalar wave', not '{}'",
+               type);
+        return std::nullopt;
+    }
+
+    auto mesh_opt = mesh::from_lua(tbl, logger);
+    if (!mesh_opt) return std::nullopt;
+
+    auto bc_opt = bcs::from_lua(tbl, mesh_opt->extents(), logger);
+    if (!bc_opt) return std::nullopt;
+
+    return simulation_session{
+        tbl, MOVE(*mesh_opt), MOVE(bc_opt->first), MOVE(bc_opt->second), logger};
+}
+
+std::optional<simulation_trace> simulation_session::run(const sol::table& scheme,
+                                                        std::optional<real> max_time)
+{
+    sol::state_view lua{tbl.lua_state()};
+
+    auto t = shallow_copy(lua, tbl);
+    t["scheme"] = scheme;
+    if (max_time) {
+        auto c = shallow_copy(
+            lua, tbl["step_controller"].get_or<sol::table>(lua.create_table()));
+        c["max_time"] = *max_time;
+        t["step_controller"] = c;
+    }
+
+    // the cached geometry is copied so the next run starts from it again
+    auto sys_opt = systems::scalar_wave::from_lua(
+        t, mesh{m}, bcs::Grid{grid_bcs}, bcs::Object{object_bcs}, logger);
+    auto it_opt = integrator::from_lua(t, logger);
+    auto st_opt = step_controller::from_lua(t, logger);
+
+    if (it_opt && it_opt->is_implicit()) {
+        logger(spdlog::level::err,
+               "integrator.type = implicit is not supported by this system");
+        return std::nullopt;
+    }
+    if (!(sys_opt && it_opt && st_opt)) return std::nullopt;
+
+    simulation_trace trace{};
+    auto observe = [&trace](const step_controller& c, const system_stats& s) {
+        trace.time.push_back((real)c);
+        trace.step.push_back((int)c);
+        trace.stats.insert(trace.stats.end(), s.stats.begin(), s.stats.end());
+        trace.wall_time_s.push_back(s.wall_time_s);
+        trace.n_stats = static_cast<int>(s.stats.size());
+    };
+
+    auto cycle = simulation_cycle{
+        system{MOVE(*sys_opt)}, MOVE(*st_opt), MOVE(*it_opt), field_io{}};
+    trace.result = cycle.run(observe);
+    return trace;
+}
+
+} // namespace ccs
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "types.hpp"
+
+#include "io/logging.hpp"
+#include "mesh/mesh.hpp"
+#include "operators/boundaries.hpp"
+
+#include <optional>
+#include <vector>
+
+#include <sol/sol.hpp>
+
+namespace ccs
+{
+
+// Statistics of every step of a run, row-major with n_stats columns per step in
+// the order the system logs them (Linf, Min, Max, ... for scalar wave)
+struct simulation_trace {
+    std::vector<real> time;
+    std::vector<int> step;
+    std::vector<real> stats;
+    std::vector<real> wall_time_s;
+    int n_stats = 0;
+    real3 result;
+
+    int size() const { return static_cast<int>(time.size()); }
+};
+
+//
+// Repeated in-process runs of one scalar wave configuration where only the scheme
+// and the final time change between runs, e.g. the evaluations of a stencil
+// optimizer.  The mesh, its embedded geometry and the boundary conditions are
+// built once; each run builds the operators for its scheme and returns the step
+// statistics in memory.  Nothing is written unless the logger writes.
+//
+class simulation_session
+{
+    sol::table tbl;
+    mesh m;
+    bcs::Grid grid_bcs;
+    bcs::Object object_bcs;
+    logs logger{};
+
+public:
+    simulation_session() = default;
+
+    simulation_session(
+        const sol::table&, mesh&&, bcs::Grid&&, bcs::Object&&, const logs&);
+
+    // the lua state of the table must outlive the session
+    static std::optional<simulation_session> from_lua(const sol::table&,
+                                                      const logs& = {});
+
+    // Run with `scheme` in place of simulation.scheme, stopping at max_time when
+    // given instead of simulation.step_controller.max_time
+    std::optional<simulation_trace> run(const sol::table& scheme,
+                                        std::optional<real> max_time = {});
+};
+
+} // namespace ccs
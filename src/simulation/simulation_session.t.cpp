@@ -0,0 +1,124 @@
+#include "simulation_session.hpp"
+#include "simulation_cycle.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <sol/sol.hpp>
+
+using namespace ccs;
+
+// Custom main: Kokkos must be initialized before any test allocates Views.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+namespace
+{
+constexpr auto config = R"(
+    simulation = {
+        logging = false,
+        mesh = {
+            index_extents = {41, 41},
+            domain_bounds = {
+                min = {0, 0},
+                max = {2, 2}
+            }
+        },
+        shapes = {
+            {
+                type = "sphere",
+                center = {1.0001, 0.9876543},
+                radius = 0.25,
+                boundary_condition = "dirichlet"
+            }
+        },
+        scheme = {
+            order = 1,
+            type = "E2",
+            alpha = {-1.47956280234494, 0.261900367793859, -0.145072532538541, -0.224665713988644}
+        },
+        system = {
+            type = "scalar wave"
+        },
+        integrator = {
+            type = "rk4",
+        },
+        step_controller = {
+            max_step = 5,
+            cfl = {
+                hyperbolic = 0.5
+            }
+        }
+    }
+)";
+} // namespace
+
+TEST_CASE("session - repeated runs")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(config);
+
+    auto session = simulation_session::from_lua(lua["simulation"]);
+    REQUIRE(!!session);
+
+    const sol::table scheme = lua["simulation"]["scheme"];
+    auto trace = session->run(scheme);
+    REQUIRE(!!trace);
+
+    // the initial condition and five steps
+    REQUIRE(trace->size() == 6);
+    REQUIRE(trace->step.back() == 5);
+    REQUIRE(trace->time.front() == 0.0);
+    REQUIRE_THAT(trace->time.back(), Catch::Matchers::WithinAbs(0.125, 1e-10));
+    REQUIRE(trace->n_stats > 0);
+    REQUIRE((int)trace->stats.size() == trace->size() * trace->n_stats);
+
+    // the first statistic is the Linf error returned by the cycle
+    const real linf = trace->stats[(trace->size() - 1) * trace->n_stats];
+    REQUIRE(linf == trace->result[1]);
+
+    // same answer as a cycle building its own geometry, and as the first run
+    auto cycle = simulation_cycle::from_lua(lua["simulation"]);
+    REQUIRE(!!cycle);
+    REQUIRE(cycle->run()[1] == linf);
+
+    auto again = session->run(scheme);
+    REQUIRE(!!again);
+    REQUIRE(again->stats == trace->stats);
+}
+
+TEST_CASE("session - max_time")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(config);
+
+    auto session = simulation_session::from_lua(lua["simulation"]);
+    REQUIRE(!!session);
+
+    // dt = 0.025
+    auto trace = session->run(lua["simulation"]["scheme"], 0.06);
+    REQUIRE(!!trace);
+    REQUIRE(trace->size() == 4);
+    REQUIRE_THAT(trace->time.back(), Catch::Matchers::WithinAbs(0.075, 1e-10));
+}
+
+TEST_CASE("session - invalid")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(config);
+
+    auto session = simulation_session::from_lua(lua["simulation"]);
+    REQUIRE(!!session);
+    REQUIRE(!session->run(lua.create_table_with("order", 1, "type", "nonsense")));
+
+    lua.script("simulation.system = { type = 'heat', diffusivity = 1.0 }");
+    REQUIRE(!simulation_session::from_lua(lua["simulation"]));
+}
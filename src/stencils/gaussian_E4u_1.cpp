@@ -204,6 +204,21 @@ struct gaussian_E4u_1 {
         }
     }
 
+    // The closure does not depend on psi: compute it once and copy it to the
+    // other points.
+    void nbs_batch(real h,
+                   bcs::type b,
+                   std::span<const real> psi,
+                   bool right,
+                   std::span<real> c,
+                   std::span<real> extra) const
+    {
+        if (psi.empty()) return;
+        const auto first = nbs(h, b, psi[0], right, c.subspan(0, R * T), extra);
+        for (std::size_t i = 1; i < psi.size(); ++i)
+            std::ranges::copy(first, c.begin() + i * R * T);
+    }
+
     std::span<const real>
     nbs_floating(real h, real, std::span<real> c, bool right) const
     {
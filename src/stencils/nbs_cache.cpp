@@ -0,0 +1,67 @@
+#include "nbs_cache.hpp"
+
+#include <bit>
+#include <cmath>
+
+namespace ccs::stencils
+{
+
+nbs_cache::nbs_cache(const stencil& st, real h)
+    : st{&st}, h{h}, quantum{st.psi_quantum()}, block{}, nextra{}
+{
+    auto&& [p, r, t, nex] = st.query_max();
+    block = r * t;
+    nextra = nex;
+}
+
+nbs_cache::key nbs_cache::make_key(bcs::type b, bool right, real psi) const
+{
+    return {b,
+            right,
+            quantum > 0 ? std::llround(psi / quantum) : std::bit_cast<std::int64_t>(psi)};
+}
+
+real nbs_cache::key_psi(const key& k) const
+{
+    const auto q = std::get<2>(k);
+    return quantum > 0 ? q * quantum : std::bit_cast<real>(q);
+}
+
+void nbs_cache::fill(bcs::type b, bool right, std::span<const real> psi)
+{
+    // distinct psi of the keys not cached yet
+    std::vector<real> missing{};
+    for (auto&& v : psi) {
+        const auto k = make_key(b, right, v);
+        if (slots.contains(k)) continue;
+        slots.emplace(k, static_cast<integer>(slots.size()));
+        missing.push_back(key_psi(k));
+    }
+    if (missing.empty()) return;
+
+    const auto n = static_cast<integer>(missing.size());
+    const auto first = static_cast<integer>(c.size()) / block;
+    c.resize(c.size() + n * block);
+    ex.resize(ex.size() + n * nextra);
+    st->nbs_batch(h,
+                  b,
+                  missing,
+                  right,
+                  std::span{c}.subspan(first * block),
+                  std::span{ex}.subspan(first * nextra));
+}
+
+nbs_cache::closure nbs_cache::operator()(bcs::type b, bool right, real psi)
+{
+    auto it = slots.find(make_key(b, right, psi));
+    if (it == slots.end()) {
+        fill(b, right, std::span{&psi, 1});
+        it = slots.find(make_key(b, right, psi));
+    }
+
+    const auto i = it->second;
+    return {std::span{c}.subspan(i * block, block),
+            std::span{ex}.subspan(i * nextra, nextra)};
+}
+
+} // namespace ccs::stencils
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "stencil.hpp"
+
+#include <cstdint>
+#include <map>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace ccs::stencils
+{
+
+//
+// Memoised boundary closures of one stencil at one grid spacing.  Closures are
+// keyed on the boundary type, the side and psi.  With the stencil's
+// psi_quantum() at 0 the key is the exact psi and every block is bitwise equal
+// to a direct nbs call.  Otherwise psi is rounded to the nearest multiple of the
+// quantum, and all points in a bin share the closure of the rounded psi.
+//
+// Blocks are query_max().r * query_max().t coefficients plus
+// query_max().nextra extra values.  Spans returned by operator() stay valid
+// until the next call that computes a new block.
+//
+class nbs_cache
+{
+    using key = std::tuple<bcs::type, bool, std::int64_t>;
+
+    const stencil* st;
+    real h;
+    real quantum;
+    integer block;
+    integer nextra;
+
+    std::map<key, integer> slots;
+    std::vector<real> c;
+    std::vector<real> ex;
+
+    key make_key(bcs::type b, bool right, real psi) const;
+    real key_psi(const key&) const;
+
+public:
+    struct closure {
+        std::span<const real> c;
+        std::span<const real> extra;
+    };
+
+    nbs_cache(const stencil& st, real h);
+
+    // Compute the closures missing for psi with one batched nbs call
+    void fill(bcs::type b, bool right, std::span<const real> psi);
+
+    // The closure for psi, computed now if it is not cached yet
+    closure operator()(bcs::type b, bool right, real psi);
+
+    // number of distinct closures computed
+    integer size() const { return static_cast<integer>(slots.size()); }
+};
+
+} // namespace ccs::stencils
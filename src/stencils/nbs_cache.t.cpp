@@ -0,0 +1,125 @@
+#include "nbs_cache.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include <sol/sol.hpp>
+
+using Catch::Matchers::Equals;
+using namespace ccs;
+
+namespace
+{
+std::optional<stencil> make_stencil(const std::string& scheme)
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script("simulation = { scheme = " + scheme + " }");
+    return stencil::from_lua(lua["simulation"]);
+}
+
+std::vector<real> direct_nbs(const stencil& st, real h, bcs::type b, real psi, bool right)
+{
+    auto [p, r, t, nextra] = st.query_max();
+    std::vector<real> c(r * t);
+    std::vector<real> ex(nextra);
+    st.nbs(h, b, psi, right, c, ex);
+    return c;
+}
+} // namespace
+
+TEST_CASE("batched nbs matches pointwise nbs")
+{
+    const std::vector<real> psi{0.1, 0.35, 0.5, 0.35, 0.9};
+    const real h = 0.25;
+
+    for (auto&& scheme : {"{order = 1, type = 'E4', alpha = {0.1, 0.7}}",
+                          "{order = 1, type = 'gaussian_E4u', epsilon = 0.9}",
+                          "{order = 1, type = 'tension_E4u', sigma = 3.0}"}) {
+        auto st_opt = make_stencil(scheme);
+        REQUIRE(!!st_opt);
+        const auto& st = *st_opt;
+
+        auto [p, r, t, nextra] = st.query_max();
+        const auto n = static_cast<integer>(psi.size());
+
+        for (auto b : {bcs::Floating, bcs::Dirichlet}) {
+            for (bool right : {false, true}) {
+                std::vector<real> c(n * r * t);
+                std::vector<real> ex(n * nextra);
+                st.nbs_batch(h, b, psi, right, c, ex);
+
+                for (integer i = 0; i < n; ++i) {
+                    auto expected = direct_nbs(st, h, b, psi[i], right);
+                    std::vector<real> got(c.begin() + i * r * t,
+                                          c.begin() + (i + 1) * r * t);
+                    REQUIRE_THAT(got, Equals(expected));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("nbs_cache")
+{
+    auto st_opt = make_stencil("{order = 1, type = 'E4', alpha = {0.1, 0.7}}");
+    REQUIRE(!!st_opt);
+    auto& st = *st_opt;
+    REQUIRE(st.psi_quantum() == 0.0);
+
+    const real h = 0.1;
+    const std::vector<real> psi{0.2, 0.2001, 0.2, 0.6, 0.2001, 0.61};
+
+    SECTION("exact psi")
+    {
+        stencils::nbs_cache cache{st, h};
+        cache.fill(bcs::Floating, false, psi);
+        REQUIRE(cache.size() == 4);
+
+        for (auto&& v : psi) {
+            auto c = cache(bcs::Floating, false, v).c;
+            REQUIRE_THAT(std::vector<real>(c.begin(), c.end()),
+                         Equals(direct_nbs(st, h, bcs::Floating, v, false)));
+        }
+        REQUIRE(cache.size() == 4);
+
+        // the side and boundary type are part of the key
+        auto c = cache(bcs::Floating, true, 0.2).c;
+        REQUIRE_THAT(std::vector<real>(c.begin(), c.end()),
+                     Equals(direct_nbs(st, h, bcs::Floating, 0.2, true)));
+        cache(bcs::Dirichlet, false, 0.2);
+        REQUIRE(cache.size() == 6);
+    }
+
+    SECTION("quantised psi")
+    {
+        st.psi_quantum(0.05);
+        stencils::nbs_cache cache{st, h};
+        cache.fill(bcs::Floating, false, psi);
+        REQUIRE(cache.size() == 2);
+
+        // every point in a bin gets the closure of the rounded psi
+        for (auto&& v : psi) {
+            auto c = cache(bcs::Floating, false, v).c;
+            const real rounded = std::round(v / 0.05) * 0.05;
+            REQUIRE_THAT(std::vector<real>(c.begin(), c.end()),
+                         Equals(direct_nbs(st, h, bcs::Floating, rounded, false)));
+        }
+    }
+}
+
+TEST_CASE("scheme.psi_quantum")
+{
+    auto st = make_stencil("{order = 1, type = 'E4u', alpha = {}, psi_quantum = 1e-3}");
+    REQUIRE(!!st);
+    REQUIRE(st->psi_quantum() == 1e-3);
+
+    // copies keep the quantum
+    stencil cp = *st;
+    REQUIRE(cp.psi_quantum() == 1e-3);
+
+    REQUIRE(!make_stencil("{order = 1, type = 'E4u', alpha = {}, psi_quantum = -1}"));
+}
@@ -5,7 +5,9 @@
 
 namespace ccs::stencils
 {
-std::optional<stencil> stencil::from_lua(const sol::table& tbl, const logs& logger)
+namespace
+{
+std::optional<stencil> scheme_from_lua(const sol::table& tbl, const logs& logger)
 {
 
     auto m = tbl["scheme"];
@@ -104,4 +106,22 @@ std::optional<stencil> stencil::from_lua(const sol::table& tbl, const logs& logg
     logger(spdlog::level::err, "scheme.order/type = {} / {} not recognized", order, type);
     return std::nullopt;
 }
+} // namespace
+
+std::optional<stencil> stencil::from_lua(const sol::table& tbl, const logs& logger)
+{
+    auto st = scheme_from_lua(tbl, logger);
+    if (!st) return std::nullopt;
+
+    real quantum = tbl["scheme"]["psi_quantum"].get_or(0.0);
+    if (quantum < 0) {
+        logger(spdlog::level::err, "scheme.psi_quantum must be non-negative");
+        return std::nullopt;
+    }
+    if (quantum > 0)
+        logger(spdlog::level::info, "boundary closures memoised per psi bin of {}", quantum);
+    st->psi_quantum(quantum);
+
+    return st;
+}
 } // namespace ccs::stencils
@@ -92,6 +92,12 @@ class stencil
                                           bool ray_outside,
                                           std::span<real> coeffs,
                                           std::span<real> extra) const = 0;
+        virtual void nbs_batch(real h,
+                               bcs::type,
+                               std::span<const real> psi,
+                               bool ray_outside,
+                               std::span<real> coeffs,
+                               std::span<real> extra) const = 0;
         virtual std::span<const real> interior(real c, std::span<real> coeffs) const = 0;
         virtual std::span<const real> interp_interior(real, std::span<real>) const = 0;
         virtual std::span<const real>
@@ -123,6 +129,30 @@ class stencil
             return s.nbs(h, b, psi, ray_outside, c, extra);
         }
 
+        // Stencils whose closure does not depend on psi may provide their own
+        // nbs_batch; the others are evaluated point by point without a virtual
+        // call per point
+        void nbs_batch(real h,
+                       bcs::type b,
+                       std::span<const real> psi,
+                       bool ray_outside,
+                       std::span<real> c,
+                       std::span<real> extra) const override
+        {
+            if constexpr (requires { s.nbs_batch(h, b, psi, ray_outside, c, extra); }) {
+                s.nbs_batch(h, b, psi, ray_outside, c, extra);
+            } else {
+                auto&& [p, r, t, nextra] = s.query_max();
+                for (std::size_t i = 0; i < psi.size(); ++i)
+                    s.nbs(h,
+                          b,
+                          psi[i],
+                          ray_outside,
+                          c.subspan(i * r * t, r * t),
+                          extra.subspan(i * nextra, nextra));
+            }
+        }
+
         std::span<const real> interior(real h, std::span<real> c) const override
         {
             return s.interior(h, c);
@@ -141,22 +171,27 @@ class stencil
     };
 
     any_stencil* s;
+    // bin width of psi for memoised closures (see nbs_cache); 0 keys on exact psi
+    real quantum;
 
 public:
-    stencil() : s{nullptr} {}
+    stencil() : s{nullptr}, quantum{0} {}
 
-    stencil(const stencil& other) : s{nullptr}
+    stencil(const stencil& other) : s{nullptr}, quantum{other.quantum}
     {
         if (other) s = other.s->clone();
     }
 
-    stencil(stencil&& other) : s{std::exchange(other.s, nullptr)} {}
+    stencil(stencil&& other)
+        : s{std::exchange(other.s, nullptr)}, quantum{other.quantum}
+    {
+    }
 
     // construction from anything with a hit method
     template <typename T>
         requires Stencil<T> &&
             (!std::same_as<stencil, std::remove_cvref_t<T>>)stencil(T&& other)
-            : s{new any_stencil_impl{std::forward<T>(other)}}
+            : s{new any_stencil_impl{std::forward<T>(other)}}, quantum{0}
         {
         }
 
@@ -171,12 +206,17 @@ public:
         {
             delete s;
             s = std::exchange(other.s, nullptr);
+            quantum = other.quantum;
             return *this;
         }
 
         ~stencil() { delete s; }
 
-        friend void swap(stencil& x, stencil& y) { std::swap(x.s, y.s); }
+        friend void swap(stencil& x, stencil& y)
+        {
+            std::swap(x.s, y.s);
+            std::swap(x.quantum, y.quantum);
+        }
 
         explicit operator bool() const { return s != nullptr; }
 
@@ -194,11 +234,27 @@ public:
             return s->nbs(h, b, psi, ray_outside, c, ex);
         }
 
+        // nbs for every psi[i] in one call.  Block i of c starts at
+        // i * query_max().r * query_max().t and block i of ex at
+        // i * query_max().nextra
+        void nbs_batch(real h,
+                       bcs::type b,
+                       std::span<const real> psi,
+                       bool ray_outside,
+                       std::span<real> c,
+                       std::span<real> ex) const
+        {
+            s->nbs_batch(h, b, psi, ray_outside, c, ex);
+        }
+
         std::span<const real> interior(real h, std::span<real> c) const
         {
             return s->interior(h, c);
         }
 
+        real psi_quantum() const { return quantum; }
+        void psi_quantum(real q) { quantum = q; }
+
         std::span<const real> interp_interior(real y, std::span<real> c) const
         {
             return s->interp_interior(y, c);
@@ -6,6 +6,9 @@
 #include "io/field_io.hpp"
 #include "mesh/mesh.hpp"
 #include "temporal/step_controller.hpp"
+#include "work.hpp"
+
+#include <Kokkos_Profiling_ScopedRegion.hpp>
 
 namespace ccs::systems::detail
 {
@@ -13,52 +16,58 @@ namespace ccs::systems::detail
 // Evaluate func(loc) at every mesh location, storing results in out.
 // When parallel=true, uses Kokkos::parallel_for for D and R buffers.
 // When parallel=false (e.g. Lua MMS which is not thread-safe), uses serial loops.
+// The flops of func are unknown, so only the traffic of the locations and the
+// results is reported.
 inline void eval_at_locations(const mesh& m, auto&& func, scalar_span out,
                               bool parallel = true)
 {
+    Kokkos::Profiling::ScopedRegion region("eval_at_locations");
     const auto* xv = m.x().data();
     const auto* yv = m.y().data();
     const auto* zv = m.z().data();
     int nx = (int)m.x().size(), ny = (int)m.y().size(), nz = (int)m.z().size();
 
+    const auto nr = (real)(m.Rx().size() + m.Ry().size() + m.Rz().size());
+    report_work({0, (real)nx * ny * nz * sizeof(real) +
+                        nr * (sizeof(real3) + sizeof(real))});
+
     if (parallel) {
         // D-buffer: flat parallel_for over cartesian product of x, y, z
         auto* d = out.D.data();
-        Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, nx * ny * nz),
-            [=, &func](int idx) {
-                int i = idx / (ny * nz);
-                int j = (idx / nz) % ny;
-                int k = idx % nz;
-                d[idx] = func(real3{xv[i], yv[j], zv[k]});
-            });
+        index_for("eval_at_locations", (integer)nx * ny * nz, [=, &func](auto idx) {
+            using I = decltype(idx);
+            const auto i = idx / ((I)ny * nz);
+            const auto j = (idx / nz) % ny;
+            const auto k = idx % nz;
+            d[idx] = func(real3{xv[i], yv[j], zv[k]});
+        });
 
         // Rx buffer
         const auto* rx_data = m.Rx().data();
         auto* rx_out = out.Rx.data();
         Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, (int)m.Rx().size()),
+            Kokkos::RangePolicy<execution_space>(exec_space(), 0, (int)m.Rx().size()),
             [=, &func](int i) { rx_out[i] = func(rx_data[i].position); });
 
         // Ry buffer
         const auto* ry_data = m.Ry().data();
         auto* ry_out = out.Ry.data();
         Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, (int)m.Ry().size()),
+            Kokkos::RangePolicy<execution_space>(exec_space(), 0, (int)m.Ry().size()),
             [=, &func](int i) { ry_out[i] = func(ry_data[i].position); });
 
         // Rz buffer
         const auto* rz_data = m.Rz().data();
         auto* rz_out = out.Rz.data();
         Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, (int)m.Rz().size()),
+            Kokkos::RangePolicy<execution_space>(exec_space(), 0, (int)m.Rz().size()),
             [=, &func](int i) { rz_out[i] = func(rz_data[i].position); });
 
-        Kokkos::fence();
+        exec_space().fence("eval_at_locations complete");
     } else {
         // Serial fallback for non-thread-safe callables (e.g. Lua MMS)
-        for (int idx = 0; idx < nx * ny * nz; ++idx) {
-            int i = idx / (ny * nz);
+        for (integer idx = 0; idx < (integer)nx * ny * nz; ++idx) {
+            int i = idx / ((integer)ny * nz);
             int j = (idx / nz) % ny;
             int k = idx % nz;
             out.D[idx] = func(real3{xv[i], yv[j], zv[k]});
@@ -72,6 +81,18 @@ inline void eval_at_locations(const mesh& m, auto&& func, scalar_span out,
     }
 }
 
+// Entries of compute_scalar_stats: Linf, Min, Max, then error and location for
+// each of D, Rx, Ry, Rz
+inline constexpr int n_scalar_stats = 11;
+
+// |u - sol| for the Linf reductions, which drop NaN in their comparisons, so a
+// NaN counts as an infinite error
+KOKKOS_INLINE_FUNCTION real linf_error(real u, real sol)
+{
+    const real e = Kokkos::abs(u - sol);
+    return Kokkos::isnan(e) ? Kokkos::Experimental::infinity_v<real> : e;
+}
+
 // Compute Linf error, min/max, and per-component stats for a scalar field
 // against an exact solution. Used by both heat::stats() and scalar_wave::stats().
 inline system_stats compute_scalar_stats(const mesh& m,
@@ -84,37 +105,38 @@ inline system_stats compute_scalar_stats(const mesh& m,
     const real* u_D = u.D.data();
     const real* sol_D = sol.D.data();
 
-    // MinMax reduction for u_min/u_max
+    // MinMax reduction for u_min/u_max and MaxLoc reduction for err_d/err_d_idx
     Kokkos::MinMaxScalar<real> minmax_result;
-    Kokkos::parallel_reduce(
-        Kokkos::RangePolicy<execution_space>(0, fd.count()),
-        KOKKOS_LAMBDA(int k, Kokkos::MinMaxScalar<real>& update) {
-            int i = fd.element(k);
-            if (u_D[i] < update.min_val) update.min_val = u_D[i];
-            if (u_D[i] > update.max_val) update.max_val = u_D[i];
-        },
-        Kokkos::MinMax<real>(minmax_result));
+    Kokkos::ValLocScalar<real, integer> maxloc_result;
+    fd.visit([&](auto fluid) {
+        Kokkos::parallel_reduce(
+            index_policy<integer>(exec_space(), 0, fluid.count()),
+            KOKKOS_LAMBDA(integer k, Kokkos::MinMaxScalar<real>& update) {
+                const integer i = fluid.element(k);
+                if (u_D[i] < update.min_val) update.min_val = u_D[i];
+                if (u_D[i] > update.max_val) update.max_val = u_D[i];
+            },
+            Kokkos::MinMax<real>(minmax_result));
+
+        Kokkos::parallel_reduce(
+            index_policy<integer>(exec_space(), 0, fluid.count()),
+            KOKKOS_LAMBDA(integer k, Kokkos::ValLocScalar<real, integer>& update) {
+                const integer i = fluid.element(k);
+                const real e = linf_error(u_D[i], sol_D[i]);
+                if (e > update.val) {
+                    update.val = e;
+                    update.loc = i;
+                }
+            },
+            Kokkos::MaxLoc<real, integer>(maxloc_result));
+    });
 
     real u_min = fd.count() > 0 ? minmax_result.min_val : 0.0;
     real u_max = fd.count() > 0 ? minmax_result.max_val : 0.0;
 
-    // MaxLoc reduction for err_d/err_d_idx
-    Kokkos::ValLocScalar<real, int> maxloc_result;
-    Kokkos::parallel_reduce(
-        Kokkos::RangePolicy<execution_space>(0, fd.count()),
-        KOKKOS_LAMBDA(int k, Kokkos::ValLocScalar<real, int>& update) {
-            int i = fd.element(k);
-            real e = Kokkos::abs(u_D[i] - sol_D[i]);
-            if (e > update.val) {
-                update.val = e;
-                update.loc = i;
-            }
-        },
-        Kokkos::MaxLoc<real, int>(maxloc_result));
-
     real err_d = fd.count() > 0 ? maxloc_result.val : 0.0;
     real err_d_idx = fd.count() > 0 ? (real)maxloc_result.loc : 0.0;
-    Kokkos::fence();
+    exec_space().fence("compute_scalar_stats D complete");
 
     // Per-component stats for Rx/Ry/Rz over non-dirichlet object indices
     std::span<const real> u_Rs[] = {u.Rx, u.Ry, u.Rz};
@@ -129,38 +151,39 @@ inline system_stats compute_scalar_stats(const mesh& m,
         const real* u_R_ptr = u_Rs[dir].data();
         const real* sol_R_ptr = sol_Rs[dir].data();
 
-        // MinMax reduction for this R component
+        // MinMax reduction for this R component and MaxLoc reduction for error
         Kokkos::MinMaxScalar<real> r_minmax;
-        Kokkos::parallel_reduce(
-            Kokkos::RangePolicy<execution_space>(0, nd.count()),
-            KOKKOS_LAMBDA(int k, Kokkos::MinMaxScalar<real>& update) {
-                int i = nd.element(k);
-                if (u_R_ptr[i] < update.min_val) update.min_val = u_R_ptr[i];
-                if (u_R_ptr[i] > update.max_val) update.max_val = u_R_ptr[i];
-            },
-            Kokkos::MinMax<real>(r_minmax));
+        Kokkos::ValLocScalar<real, int> r_maxloc;
+        nd.visit([&](auto obj) {
+            Kokkos::parallel_reduce(
+                Kokkos::RangePolicy<execution_space>(exec_space(), 0, obj.count()),
+                KOKKOS_LAMBDA(int k, Kokkos::MinMaxScalar<real>& update) {
+                    const integer i = obj.element(k);
+                    if (u_R_ptr[i] < update.min_val) update.min_val = u_R_ptr[i];
+                    if (u_R_ptr[i] > update.max_val) update.max_val = u_R_ptr[i];
+                },
+                Kokkos::MinMax<real>(r_minmax));
+
+            Kokkos::parallel_reduce(
+                Kokkos::RangePolicy<execution_space>(exec_space(), 0, obj.count()),
+                KOKKOS_LAMBDA(int k, Kokkos::ValLocScalar<real, int>& update) {
+                    const int i = obj.element(k);
+                    const real e = linf_error(u_R_ptr[i], sol_R_ptr[i]);
+                    if (e > update.val) {
+                        update.val = e;
+                        update.loc = i;
+                    }
+                },
+                Kokkos::MaxLoc<real, int>(r_maxloc));
+        });
 
         u_min = std::min(u_min, r_minmax.min_val);
         u_max = std::max(u_max, r_minmax.max_val);
 
-        // MaxLoc reduction for error
-        Kokkos::ValLocScalar<real, int> r_maxloc;
-        Kokkos::parallel_reduce(
-            Kokkos::RangePolicy<execution_space>(0, nd.count()),
-            KOKKOS_LAMBDA(int k, Kokkos::ValLocScalar<real, int>& update) {
-                int i = nd.element(k);
-                real e = Kokkos::abs(u_R_ptr[i] - sol_R_ptr[i]);
-                if (e > update.val) {
-                    update.val = e;
-                    update.loc = i;
-                }
-            },
-            Kokkos::MaxLoc<real, int>(r_maxloc));
-
         comp_errs[dir] = r_maxloc.val;
         comp_idxs[dir] = (real)r_maxloc.loc;
     }
-    Kokkos::fence();
+    exec_space().fence("compute_scalar_stats R complete");
 
     real err_rx = comp_errs[0], idx_rx = comp_idxs[0];
     real err_ry = comp_errs[1], idx_ry = comp_idxs[1];
@@ -187,10 +210,8 @@ inline void initialize_scalar_field(const mesh& m, scalar_span u, scalar_span so
 {
     // Fill D with zeros via parallel_for
     real* u_D = u.D.data();
-    int u_D_size = (int)u.D.size();
-    Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, u_D_size),
-        KOKKOS_LAMBDA(int i) { u_D[i] = 0.0; });
+    index_for("initialize_scalar_field", (integer)u.D.size(),
+              KOKKOS_LAMBDA(auto i) { u_D[i] = 0.0; });
 
     // Copy sol at fluid indices
     const auto fd = m.fluid_desc();
@@ -207,63 +228,56 @@ inline void initialize_scalar_field(const mesh& m, scalar_span u, scalar_span so
     const real* sol_Rz_ptr = sol.Rz.data();
     int rz_size = (int)u.Rz.size();
     Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, rx_size),
+        Kokkos::RangePolicy<execution_space>(exec_space(), 0, rx_size),
         KOKKOS_LAMBDA(int i) { u_Rx[i] = sol_Rx_ptr[i]; });
     Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, ry_size),
+        Kokkos::RangePolicy<execution_space>(exec_space(), 0, ry_size),
         KOKKOS_LAMBDA(int i) { u_Ry[i] = sol_Ry_ptr[i]; });
     Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, rz_size),
+        Kokkos::RangePolicy<execution_space>(exec_space(), 0, rz_size),
         KOKKOS_LAMBDA(int i) { u_Rz[i] = sol_Rz_ptr[i]; });
-    Kokkos::fence();
+    exec_space().fence("initialize_scalar_field complete");
 }
 
-// Compute |u - sol| error at fluid/non-dirichlet indices, zero Dirichlet
-// entries, and write scalar fields to IO. Used by both heat::write() and
-// scalar_wave::write().
-inline bool write_scalar_error(const mesh& m,
-                               const bcs::Object& object_bcs,
-                               const bcs::Grid& grid_bcs,
-                               scalar_view u,
-                               scalar_view sol,
-                               scalar_span error,
-                               field_io& io,
-                               std::span<const std::string> io_names,
-                               const step_controller& c,
-                               real dt)
+// Compute |u - sol| error at fluid/non-dirichlet indices and zero Dirichlet
+// entries.
+inline void compute_scalar_error(const mesh& m,
+                                 const bcs::Object& object_bcs,
+                                 const bcs::Grid& grid_bcs,
+                                 scalar_view u,
+                                 scalar_view sol,
+                                 scalar_span error)
 {
     // Zero all error buffers
     real* err_d_ptr = error.D.data();
     real* err_rx_ptr = error.Rx.data();
     real* err_ry_ptr = error.Ry.data();
     real* err_rz_ptr = error.Rz.data();
-    int n_d = (int)error.D.size();
     int n_rx = (int)error.Rx.size();
     int n_ry = (int)error.Ry.size();
     int n_rz = (int)error.Rz.size();
+    index_for("compute_scalar_error", (integer)error.D.size(),
+              KOKKOS_LAMBDA(auto i) { err_d_ptr[i] = 0.0; });
     Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, n_d),
-        KOKKOS_LAMBDA(int i) { err_d_ptr[i] = 0.0; });
-    Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, n_rx),
+        Kokkos::RangePolicy<execution_space>(exec_space(), 0, n_rx),
         KOKKOS_LAMBDA(int i) { err_rx_ptr[i] = 0.0; });
     Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, n_ry),
+        Kokkos::RangePolicy<execution_space>(exec_space(), 0, n_ry),
         KOKKOS_LAMBDA(int i) { err_ry_ptr[i] = 0.0; });
     Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, n_rz),
+        Kokkos::RangePolicy<execution_space>(exec_space(), 0, n_rz),
         KOKKOS_LAMBDA(int i) { err_rz_ptr[i] = 0.0; });
 
     // Compute |u - sol| at fluid D indices
     const auto fd = m.fluid_desc();
     const real* u_D = u.D.data();
     const real* sol_D = sol.D.data();
-    Kokkos::parallel_for(
-        Kokkos::RangePolicy<execution_space>(0, fd.count()),
-        KOKKOS_LAMBDA(int k) {
-            int i = fd.element(k);
+    fd.visit([=](auto fluid) {
+        index_for("compute_scalar_error", fluid.count(), KOKKOS_LAMBDA(auto k) {
+            const integer i = fluid.element(k);
             err_d_ptr[i] = Kokkos::abs(u_D[i] - sol_D[i]);
         });
+    });
 
     // Compute |u - sol| at non-dirichlet R indices
     std::span<const real> u_R[] = {u.Rx, u.Ry, u.Rz};
@@ -275,14 +289,16 @@ inline bool write_scalar_error(const mesh& m,
         const real* u_R_ptr = u_R[dir].data();
         const real* sol_R_ptr = sol_R[dir].data();
         real* err_R_ptr = err_R_ptrs[dir];
-        Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, nd.count()),
-            KOKKOS_LAMBDA(int k) {
-                int i = nd.element(k);
-                err_R_ptr[i] = Kokkos::abs(u_R_ptr[i] - sol_R_ptr[i]);
-            });
+        nd.visit([=](auto obj) {
+            Kokkos::parallel_for(
+                Kokkos::RangePolicy<execution_space>(exec_space(), 0, obj.count()),
+                KOKKOS_LAMBDA(int k) {
+                    const integer i = obj.element(k);
+                    err_R_ptr[i] = Kokkos::abs(u_R_ptr[i] - sol_R_ptr[i]);
+                });
+        });
     }
-    Kokkos::fence();
+    exec_space().fence("compute_scalar_error complete");
 
     // Zero Dirichlet grid faces on D buffer
     for_each_grid_bc_desc<bcs::Dirichlet>(grid_bcs, m.extents(), [&](auto desc) {
@@ -294,6 +310,22 @@ inline bool write_scalar_error(const mesh& m,
         auto gd = m.dirichlet_object_desc(dir, object_bcs);
         fill_selected(err_R_ptrs[dir], gd, 0.0);
     }
+}
+
+// Compute the error with compute_scalar_error and write u and the error to IO.
+// Used by both heat::write() and scalar_wave::write().
+inline bool write_scalar_error(const mesh& m,
+                               const bcs::Object& object_bcs,
+                               const bcs::Grid& grid_bcs,
+                               scalar_view u,
+                               scalar_view sol,
+                               scalar_span error,
+                               field_io& io,
+                               std::span<const std::string> io_names,
+                               const step_controller& c,
+                               real dt)
+{
+    compute_scalar_error(m, object_bcs, grid_bcs, u, sol, error);
 
     scalar_view err_view{error.D, error.Rx, error.Ry, error.Rz};
     std::vector<scalar_view> io_scalars{u, err_view};
@@ -0,0 +1,242 @@
+#include "eigenvalue_sweep.hpp"
+
+#include "operators/derivative.hpp"
+#include "operators/eigenvalue_visitor.hpp"
+
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <fmt/ranges.h>
+#include <sol/sol.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+namespace ccs::systems
+{
+namespace
+{
+sol::table shallow_copy(sol::state_view lua, const sol::table& src)
+{
+    auto t = lua.create_table();
+    src.for_each([&t](const sol::object& k, const sol::object& v) { t.set(k, v); });
+    return t;
+}
+
+// stability numbers for a single operator on a single geometry
+sweep_result analyze(const eigenvalue_sweep::psi_case& c,
+                     const stencil& st,
+                     const std::optional<spectral_options>& spectral)
+{
+    auto dx = derivative{0, c.m, st, c.grid_bcs, c.object_bcs};
+    const real h = c.m.h(0);
+
+    // dense spectra are exact but limited to 1D and small n
+    if (!spectral && c.m.dims() == 1) {
+        auto p = c.m.Rx() | std::views::transform([&c](auto&& info) {
+                     return c.object_bcs[info.shape_id] == bcs::Dirichlet;
+                 });
+        auto v = eigenvalue_visitor{
+            c.m.extents(), p, std::vector<bool>{}, std::vector<bool>{}};
+        v.visit(dx);
+
+        auto er = v.eigenvalues_real();
+        auto ei = v.eigenvalues_imag();
+        real radius = 0;
+        for (std::size_t i = 0; i < er.size(); ++i)
+            radius = std::max(radius, std::hypot(er[i], ei[i]));
+        return {0, 0, -h * std::ranges::min(er), h * radius};
+    }
+
+    auto est = spectral_estimator{c.m, c.grid_bcs, c.object_bcs, spectral.value_or(
+                                                                    spectral_options{})}(
+        [&dx](scalar_view u, scalar_span du) { dx(u, du); }, spectral_target::smallest_real);
+    return {0, 0, -h * est.min_real, h * est.radius};
+}
+} // namespace
+
+eigenvalue_sweep::eigenvalue_sweep(std::vector<psi_case>&& cases,
+                                   std::vector<stencil>&& candidates,
+                                   std::optional<spectral_options> spectral,
+                                   const logs& build_logger,
+                                   const std::string& output)
+    : cases{MOVE(cases)},
+      candidates{MOVE(candidates)},
+      spectral{spectral},
+      logger{build_logger, "sweep", output}
+{
+    const auto n_psi = this->cases.empty() ? 0 : this->cases.front().psi.size();
+    std::vector<std::string> psi_hdr(n_psi, "Psi");
+    for (std::size_t i = 0; i < n_psi; ++i) psi_hdr[i] += std::to_string(i + 1);
+
+    logger.set_pattern("%v");
+    if (n_psi > 0)
+        logger(spdlog::level::info,
+               "Case,Candidate,{},MaxEigen,Radius",
+               fmt::join(psi_hdr, ","));
+    else
+        logger(spdlog::level::info, "Case,Candidate,MaxEigen,Radius");
+}
+
+std::optional<eigenvalue_sweep> eigenvalue_sweep::from_lua(const sol::table& tbl,
+                                                           const logs& logger)
+{
+    auto sw = tbl["sweep"];
+    if (!sw.valid()) {
+        logger(spdlog::level::err, "simulation.sweep must be specified");
+        return std::nullopt;
+    }
+
+    sol::state_view lua{tbl.lua_state()};
+    std::string output = sw["output"].get_or(std::string{"sweep.csv"});
+
+    // Candidates: each entry overrides keys of simulation.scheme.  Stencils do
+    // not depend on the geometry so they are built once for all psi cases.
+    std::vector<stencil> candidates;
+    {
+        auto t = shallow_copy(lua, tbl);
+        const sol::table base = tbl["scheme"].get_or<sol::table>(lua.create_table());
+        auto add = [&](const sol::table& overrides) {
+            auto scheme = shallow_copy(lua, base);
+            overrides.for_each(
+                [&scheme](const sol::object& k, const sol::object& v) { scheme.set(k, v); });
+            t["scheme"] = scheme;
+            auto st_opt = stencil::from_lua(t, logger);
+            if (st_opt) candidates.push_back(*st_opt);
+            return !!st_opt;
+        };
+
+        if (sol::optional<sol::table> cand = sw["candidates"]; cand) {
+            for (int i = 1; (*cand)[i].valid(); ++i) {
+                if (!add((*cand)[i].get<sol::table>())) {
+                    logger(spdlog::level::err, "invalid scheme for sweep candidate {}", i);
+                    return std::nullopt;
+                }
+            }
+        } else if (!add(lua.create_table())) {
+            return std::nullopt;
+        }
+    }
+
+    // psi cases: each entry assigns psi to the shapes in order
+    std::vector<psi_case> cases;
+    {
+        auto t = shallow_copy(lua, tbl);
+        auto add = [&](std::vector<real> psi) -> bool {
+            if (!psi.empty()) {
+                const sol::table shapes = tbl["shapes"].get_or<sol::table>(lua.create_table());
+                auto new_shapes = lua.create_table();
+                for (int i = 1; shapes[i].valid(); ++i) {
+                    sol::table s = shallow_copy(lua, shapes[i].get<sol::table>());
+                    if (i <= (int)psi.size()) s["psi"] = psi[i - 1];
+                    new_shapes[i] = s;
+                }
+                t["shapes"] = new_shapes;
+            }
+
+            auto mesh_opt = mesh::from_lua(t, logger);
+            if (!mesh_opt) return false;
+            auto bc_opt = bcs::from_lua(t, mesh_opt->extents(), logger);
+            if (!bc_opt) return false;
+
+            cases.push_back(psi_case{MOVE(*mesh_opt),
+                                     MOVE(bc_opt->first),
+                                     MOVE(bc_opt->second),
+                                     MOVE(psi)});
+            return true;
+        };
+
+        if (sol::optional<sol::table> psi = sw["psi"]; psi) {
+            for (int i = 1; (*psi)[i].valid(); ++i) {
+                std::vector<real> p;
+                sol::table row = (*psi)[i].get<sol::table>();
+                for (int j = 1; row[j].valid(); ++j) p.push_back(row[j].get<real>());
+                if (!cases.empty() && p.size() != cases.front().psi.size()) {
+                    logger(spdlog::level::err,
+                           "sweep.psi[{}] has {} entries, expected {}",
+                           i,
+                           p.size(),
+                           cases.front().psi.size());
+                    return std::nullopt;
+                }
+                if (!add(MOVE(p))) return std::nullopt;
+            }
+        } else if (!add({})) {
+            return std::nullopt;
+        }
+    }
+
+    return eigenvalue_sweep{MOVE(cases),
+                            MOVE(candidates),
+                            spectral_options::from_lua(tbl, logger),
+                            logger,
+                            output};
+}
+
+std::vector<sweep_result> eigenvalue_sweep::run()
+{
+    Kokkos::Profiling::ScopedRegion region("eigenvalue_sweep::run");
+
+    const int nc = n_candidates();
+    std::vector<sweep_result> results(cases.size() * nc);
+
+    for (int ic = 0; ic < n_cases(); ++ic) {
+        const auto& c = cases[ic];
+        sweep_result* out = results.data() + static_cast<std::size_t>(ic) * nc;
+
+        // Candidates are independent: each partition of the host assembles and
+        // analyzes one candidate at a time on its own instance, taking the next
+        // when it is done.  A single partition is the whole pool.
+        const int partitions = std::min(nc, exec_space().concurrency());
+        std::vector<execution_space> instances;
+        if (partitions > 1)
+            instances = Kokkos::Experimental::partition_space(
+                exec_space(), std::vector<int>(partitions, 1));
+        else
+            instances = {exec_space()};
+
+        std::atomic<int> next{0};
+        auto work = [&](int p) {
+            scoped_exec_space scope{instances[p]};
+            for (int i = next++; i < nc; i = next++) {
+                out[i] = analyze(c, candidates[i], spectral);
+                out[i].psi_case = ic;
+                out[i].candidate = i;
+            }
+            instances[p].fence("eigenvalue_sweep partition complete");
+        };
+
+        if (partitions <= 1) {
+            work(0);
+        } else {
+            std::vector<std::jthread> threads;
+            threads.reserve(partitions);
+            for (int p = 0; p < partitions; ++p) threads.emplace_back(work, p);
+        }
+
+        // stream this case before starting the next
+        for (int i = 0; i < nc; ++i) {
+            if (c.psi.empty())
+                logger(spdlog::level::info,
+                       "{},{},{},{}",
+                       ic,
+                       i,
+                       out[i].max_eigen,
+                       out[i].radius);
+            else
+                logger(spdlog::level::info,
+                       "{},{},{},{},{}",
+                       ic,
+                       i,
+                       fmt::join(c.psi, ","),
+                       out[i].max_eigen,
+                       out[i].radius);
+        }
+    }
+
+    return results;
+}
+} // namespace ccs::systems
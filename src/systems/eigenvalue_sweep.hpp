@@ -0,0 +1,71 @@
+#pragma once
+
+#include "io/logging.hpp"
+#include "mesh/mesh.hpp"
+#include "operators/boundaries.hpp"
+#include "operators/spectral_radius.hpp"
+#include "stencils/stencil.hpp"
+#include "types.hpp"
+
+#include <optional>
+#include <sol/forward.hpp>
+#include <vector>
+
+namespace ccs::systems
+{
+
+struct sweep_result {
+    int psi_case;
+    int candidate;
+    real max_eigen; // -h * min Re(lambda), as reported by hyperbolic_eigenvalues
+    real radius;    //  h * max |lambda|
+};
+
+//
+// Stability screening of many stencil candidates over many psi configurations in
+// a single process.  Each psi configuration builds its mesh and geometry once and
+// the candidate stencils are assembled and analyzed on it concurrently, one per
+// partition_space instance of the host, each driven by its own thread.  Results
+// are streamed to a csv file in the logging directory after each psi case.
+//
+// simulation.sweep = {
+//     output = "sweep.csv",
+//     psi = { {0.001, 0.9}, {0.5, 0.5} },           -- one psi per shape, in order
+//     candidates = { {floating_alpha = {...}}, ... } -- merged into simulation.scheme
+// }
+//
+class eigenvalue_sweep
+{
+public:
+    // geometry shared by every candidate for one psi configuration
+    struct psi_case {
+        mesh m;
+        bcs::Grid grid_bcs;
+        bcs::Object object_bcs;
+        std::vector<real> psi;
+    };
+
+private:
+    std::vector<psi_case> cases;
+    std::vector<stencil> candidates;
+    std::optional<spectral_options> spectral;
+
+    logs logger;
+
+public:
+    eigenvalue_sweep() = default;
+
+    eigenvalue_sweep(std::vector<psi_case>&&,
+                     std::vector<stencil>&&,
+                     std::optional<spectral_options>,
+                     const logs& = {},
+                     const std::string& output = "sweep.csv");
+
+    static std::optional<eigenvalue_sweep> from_lua(const sol::table&, const logs& = {});
+
+    std::vector<sweep_result> run();
+
+    int n_cases() const { return static_cast<int>(cases.size()); }
+    int n_candidates() const { return static_cast<int>(candidates.size()); }
+};
+} // namespace ccs::systems
@@ -0,0 +1,137 @@
+#include "eigenvalue_sweep.hpp"
+#include "system.hpp"
+
+#include "fields/field_registry.hpp"
+#include "io/logging.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <sol/sol.hpp>
+
+using namespace ccs;
+
+// Custom main: Kokkos must be initialized before any test allocates Views.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+namespace
+{
+constexpr auto base_config = R"(
+        floating_a = {13/100, 7/50, 3/20, 4/25, 17/100, 9/50}
+        dirichlet_a = {3/25, 13/100, 7/50}
+        floating_b = {0.7039278390946743, 0.5390086175376538, -0.647109821986589,
+                      0.2051508287133347, 0.6062051039572746, 0.8148425279273044}
+        dirichlet_b = {-0.10739761225713096, 0.8736492896991024, 0.40413606410467495}
+
+        simulation = {
+            logging = false,
+            mesh = {
+                index_extents = {21},
+                domain_bounds = {1}
+            },
+            shapes = {
+                {
+                    type = "yz_rect",
+                    psi = 0.001,
+                    normal = 1,
+                    boundary_condition = "dirichlet"
+                },
+                {
+                    type = "yz_rect",
+                    psi = 0.9,
+                    normal = -1,
+                    boundary_condition = "floating"
+                }
+            },
+            scheme = {
+                order = 1,
+                type = "E2-poly",
+                floating_alpha = floating_a,
+                dirichlet_alpha = dirichlet_a
+            },
+            system = {
+                type = "eigenvalues",
+            },
+        }
+    )";
+
+// single-run reference using the hyperbolic_eigenvalues system
+real single_run(sol::state& lua)
+{
+    auto sys_opt = system::from_lua(lua["simulation"], logs{});
+    REQUIRE(!!sys_opt);
+    step_controller step{};
+    sim_registry reg;
+    field_ref u0_ref{0};
+    return sys_opt->stats(reg, u0_ref, u0_ref, step).stats[0];
+}
+} // namespace
+
+TEST_CASE("eigenvalue_sweep matches individual runs")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(base_config);
+    lua.script(R"(
+        simulation.sweep = {
+            psi = { {0.001, 0.9}, {0.3, 0.6}, {0.5, 0.5} },
+            candidates = {
+                { floating_alpha = floating_a, dirichlet_alpha = dirichlet_a },
+                { floating_alpha = floating_b, dirichlet_alpha = dirichlet_b }
+            }
+        }
+    )");
+
+    auto sweep_opt = systems::eigenvalue_sweep::from_lua(lua["simulation"]);
+    REQUIRE(!!sweep_opt);
+    REQUIRE(sweep_opt->n_cases() == 3);
+    REQUIRE(sweep_opt->n_candidates() == 2);
+
+    auto results = sweep_opt->run();
+    REQUIRE(results.size() == 6u);
+
+    const char* alphas[][2] = {{"floating_a", "dirichlet_a"}, {"floating_b", "dirichlet_b"}};
+    const char* psis[][2] = {{"0.001", "0.9"}, {"0.3", "0.6"}, {"0.5", "0.5"}};
+
+    for (auto&& r : results) {
+        lua.script(fmt::format(R"(
+            simulation.sweep = nil
+            simulation.shapes[1].psi = {}
+            simulation.shapes[2].psi = {}
+            simulation.scheme.floating_alpha = {}
+            simulation.scheme.dirichlet_alpha = {}
+        )",
+                               psis[r.psi_case][0],
+                               psis[r.psi_case][1],
+                               alphas[r.candidate][0],
+                               alphas[r.candidate][1]));
+
+        REQUIRE(r.max_eigen + 1.0 == Catch::Approx(single_run(lua) + 1.0));
+        REQUIRE(r.radius > 0);
+    }
+}
+
+TEST_CASE("eigenvalue_sweep defaults to a single case")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(base_config);
+    lua.script("simulation.sweep = {}");
+
+    auto sweep_opt = systems::eigenvalue_sweep::from_lua(lua["simulation"]);
+    REQUIRE(!!sweep_opt);
+    REQUIRE(sweep_opt->n_cases() == 1);
+    REQUIRE(sweep_opt->n_candidates() == 1);
+
+    auto results = sweep_opt->run();
+    REQUIRE(results.size() == 1u);
+
+    lua.script("simulation.sweep = nil");
+    REQUIRE(results[0].max_eigen + 1.0 == Catch::Approx(single_run(lua) + 1.0));
+}
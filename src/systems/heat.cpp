@@ -7,6 +7,7 @@
 #include <limits>
 #include <numbers>
 
+#include <fmt/format.h>
 #include <fmt/ranges.h>
 #include <sol/sol.hpp>
 
@@ -19,42 +20,167 @@ namespace ccs::systems
 
 using detail::eval_at_locations;
 
+static_assert(matrix::batch<real>::max_size >= sim_registry::layout_type::max_scalars,
+              "one batched laplacian must cover every scalar of a slot");
+
+namespace
+{
+// an error still worth advancing
+bool bounded(real v) { return std::isfinite(v) && std::abs(v) <= 1e6; }
+
+// Combine the compute_scalar_stats of the owned planes of every rank: extrema over
+// the ranks, and the global D index of the largest error.  Ranks without objects
+// leave the R entries zero.
+void reduce_stats(const communicator& comm, std::vector<real>& st, integer global_first)
+{
+    const real err_d = comm.max(st[3]);
+    st[4] = comm.max(st[3] == err_d ? st[4] + global_first : real(-1));
+    st[3] = err_d;
+    st[0] = comm.max(st[0]);
+    st[1] = comm.min(st[1]);
+    st[2] = comm.max(st[2]);
+}
+
+// dS/dt - k lap(S): the manufactured source of a scalar with diffusivity k
+struct source_expr {
+    const real* ddt;
+    const real* lap;
+    real k;
+    constexpr real operator()(integer i) const { return ddt[i] - k * lap[i]; }
+};
+
+constexpr scalar_handle handle(int s)
+{
+    return scalar_handle{s * sim_registry::layout_type::scalar_stride};
+}
+
+// y = x - k * lx: the implicit operator I - k lap once lx holds lap(x)
+void shift(real k, std::span<const real> x, std::span<const real> lx, std::span<real> y)
+{
+    const real* xp = x.data();
+    const real* lp = lx.data();
+    real* yp = y.data();
+    index_for("heat_implicit_shift", y.size(),
+              KOKKOS_LAMBDA(auto i) { yp[i] = xp[i] - k * lp[i]; });
+}
+
+// y = x
+void copy_in(std::span<const real> x, std::span<real> y)
+{
+    const real* xp = x.data();
+    real* yp = y.data();
+    index_for("heat_implicit_copy", y.size(), KOKKOS_LAMBDA(auto i) { yp[i] = xp[i]; });
+}
+
+// y = x / (1 - k * d), the Jacobi preconditioner of I - k lap with d = diag(lap)
+void jacobi(real k, std::span<const real> d, std::span<const real> x, std::span<real> y)
+{
+    const real* dp = d.data();
+    const real* xp = x.data();
+    real* yp = y.data();
+    index_for("heat_implicit_jacobi", y.size(), KOKKOS_LAMBDA(auto i) {
+        const real a = 1 - k * dp[i];
+        yp[i] = a > 0 ? xp[i] / a : xp[i];
+    });
+}
+
+// u += x
+void add_correction(std::span<const real> x, std::span<real> u)
+{
+    const real* xp = x.data();
+    real* up = u.data();
+    index_for("heat_implicit_update", u.size(), KOKKOS_LAMBDA(auto i) { up[i] += xp[i]; });
+}
+} // namespace
+
 heat::heat(mesh&& m,
            bcs::Grid&& grid_bcs,
            bcs::Object&& object_bcs,
            manufactured_solution&& m_sol,
            stencil st,
-           real diffusivity,
+           std::vector<real> diffusivity,
            const logs& build_logger)
     : m{MOVE(m)},
       grid_bcs{MOVE(grid_bcs)},
       object_bcs{MOVE(object_bcs)},
       m_sol{MOVE(m_sol)},
       lap{this->m, st, this->grid_bcs, this->object_bcs, build_logger},
-      diffusivity{diffusivity},
+      solver{this->m, this->grid_bcs, this->object_bcs},
+      lap_diag_d(this->m.size()), lap_diag_rx(this->m.Rx().size()),
+      lap_diag_ry(this->m.Ry().size()), lap_diag_rz(this->m.Rz().size()),
+      diffusivity{MOVE(diffusivity)},
       neumann_d(this->m.size()), neumann_rx(this->m.Rx().size()),
       neumann_ry(this->m.Ry().size()), neumann_rz(this->m.Rz().size()),
       src_d(this->m.size()), src_rx(this->m.Rx().size()),
       src_ry(this->m.Ry().size()), src_rz(this->m.Rz().size()),
+      src_lap_d(this->m.size()), src_lap_rx(this->m.Rx().size()),
+      src_lap_ry(this->m.Ry().size()), src_lap_rz(this->m.Rz().size()),
       error_d(this->m.size()), error_rx(this->m.Rx().size()),
       error_ry(this->m.Ry().size()), error_rz(this->m.Rz().size()),
       logger{build_logger, "system", "system.csv"}
 {
     assert(!!(this->m_sol));
+    const int n = static_cast<int>(this->diffusivity.size());
+    assert(n > 0 && n <= sim_registry::layout_type::max_scalars);
+    active.assign(n, true);
+
+    // scalar 0 keeps the single-scalar names; the others are numbered
+    io_names.push_back("U");
+    std::vector<std::string> extra_hdr;
+    for (int s = 1; s < n; ++s) {
+        io_names.push_back(fmt::format("U{}", s));
+        extra_hdr.push_back(fmt::format("U{}_Linf", s));
+    }
+    io_names.push_back("Error");
 
     logger.set_pattern("%v");
     logger(spdlog::level::info,
            "Timestamp,Time,Step,Linf,Min,Max,Domain_Linf,Domain_ic,Rx_Linf,Rx_ic,Ry_"
-           "Linf,Ry_ic,Rz_Linf,Rz_ic,Wall_ms");
+           "Linf,Ry_ic,Rz_Linf,Rz_ic,{}Wall_ms",
+           extra_hdr.empty() ? std::string{} : fmt::format("{},", fmt::join(extra_hdr, ",")));
 
     logger.set_pattern("%Y-%m-%d %H:%M:%S.%f,%v");
+
+    lap.diagonal(scalar_span{lap_diag_d, lap_diag_rx, lap_diag_ry, lap_diag_rz});
 }
 
 
+//
+// Valid while the Linf error of every scalar is bounded, or of any scalar when
+// diverged ones are retired
+//
 bool heat::valid(const system_stats& stats) const
 {
-    const auto& v = stats.stats[0];
-    return std::isfinite(v) && std::abs(v) <= 1e6;
+    if (retire_diverged)
+        return std::ranges::any_of(stats.scalars,
+                                   [](auto&& st) { return bounded(st[0]); });
+
+    if (!bounded(stats.stats[0])) return false;
+    // Linf of scalars 1.. follow the full stats of scalar 0
+    for (std::size_t i = detail::n_scalar_stats; i < stats.stats.size(); ++i)
+        if (!bounded(stats.stats[i])) return false;
+    return true;
+}
+
+int heat::retire(const system_stats& stats)
+{
+    if (!retire_diverged) return 0;
+
+    int n = 0;
+    for (int s : advancing()) {
+        if (bounded(stats.scalars[s][0])) continue;
+        active[s] = false;
+        ++n;
+    }
+    return n;
+}
+
+std::vector<int> heat::advancing() const
+{
+    std::vector<int> live;
+    for (int s = 0; s < (int)active.size(); ++s)
+        if (active[s]) live.push_back(s);
+    return live;
 }
 
 void heat::log(const system_stats& stats, const step_controller& step)
@@ -78,8 +204,82 @@ real3 heat::summary(const system_stats& stats) const
 std::optional<heat> heat::from_lua(const sol::table& tbl, const logs& logger)
 {
     // assume we can only get here if simulation.system.type == "heat" so check
-    // for the rest
-    real diff = tbl["system"]["diffusivity"].get_or(1.0);
+    // for the rest.  diffusivity is either one value shared by system.scalars
+    // scalars or a table with one value per scalar.
+    auto sys = tbl["system"];
+    std::vector<real> diff;
+    if (sol::optional<sol::table> t = sys["diffusivity"]; t) {
+        for (int i = 1; (*t)[i].valid(); ++i) diff.push_back((*t)[i].get<real>());
+    } else {
+        diff.assign(std::max(sys["scalars"].get_or(1), 0), sys["diffusivity"].get_or(1.0));
+    }
+
+    if (diff.empty() || (int)diff.size() > sim_registry::layout_type::max_scalars) {
+        logger(spdlog::level::err,
+               "heat requires between 1 and {} scalars, got {}",
+               sim_registry::layout_type::max_scalars,
+               diff.size());
+        return std::nullopt;
+    }
+    if (int n = sys["scalars"].get_or((int)diff.size()); n != (int)diff.size()) {
+        logger(spdlog::level::err,
+               "system.scalars = {} does not match the {} diffusivities given",
+               n,
+               diff.size());
+        return std::nullopt;
+    }
+
+    auto schedule = graph_schedule::chained;
+    if (const auto s = sys["schedule"].get_or(std::string{"chained"}); s == "split") {
+        schedule = graph_schedule::split;
+    } else if (s != "chained") {
+        logger(spdlog::level::err, "system.schedule must be one of: [chained, split]");
+        return std::nullopt;
+    }
+
+    // the ADI product of line inverses is not symmetric, so CG cannot use it
+    const auto precond = sys["preconditioner"].get_or(std::string{"adi"});
+    if (precond != "adi" && precond != "jacobi") {
+        logger(spdlog::level::err, "system.preconditioner must be one of: [adi, jacobi]");
+        return std::nullopt;
+    }
+    if (precond == "adi" &&
+        tbl["integrator"]["krylov"]["method"].get_or(std::string{}) == "cg") {
+        logger(spdlog::level::err,
+               "integrator.krylov.method = \"cg\" requires system.preconditioner = "
+               "\"jacobi\"; the ADI preconditioner is not symmetric");
+        return std::nullopt;
+    }
+
+    // system.slabs = n runs the rhs laplacian on n x-slabs, e.g. one per NUMA domain;
+    // system.distributed = true splits the mesh into one x-slab per rank
+    const int slabs = sys["slabs"].get_or(0);
+    if (slabs < 0) {
+        logger(spdlog::level::err, "system.slabs must not be negative");
+        return std::nullopt;
+    }
+    const bool distributed = sys["distributed"].get_or(false);
+    if (distributed) {
+        if (slabs > 0) {
+            logger(spdlog::level::err,
+                   "system.slabs and system.distributed cannot be combined");
+            return std::nullopt;
+        }
+        // the implicit solves and the spectral estimate need the global operator
+        if (tbl["integrator"]["type"].get_or(std::string{}) == "implicit" ||
+            sys["spectral"].valid()) {
+            logger(spdlog::level::err,
+                   "system.distributed supports neither implicit integrators nor "
+                   "system.spectral");
+            return std::nullopt;
+        }
+        // field_io writes the whole mesh from one process
+        if (communicator{}.size() > 1 && tbl["io"].valid()) {
+            logger(spdlog::level::err,
+                   "io is not supported by system.distributed on more than one rank");
+            return std::nullopt;
+        }
+    }
 
     auto mesh_opt = mesh::from_lua(tbl, logger);
     if (!mesh_opt) return std::nullopt;
@@ -87,100 +287,236 @@ std::optional<heat> heat::from_lua(const sol::table& tbl, const logs& logger)
     auto bc_opt = bcs::from_lua(tbl, mesh_opt->extents(), logger);
     auto st_opt = stencil::from_lua(tbl, logger);
 
+    if ((slabs > 0 || distributed) && bc_opt) {
+        const bool objects =
+            !mesh_opt->Rx().empty() || !mesh_opt->Ry().empty() || !mesh_opt->Rz().empty();
+        const bool neumann = std::ranges::any_of(bc_opt->first, [](auto&& l) {
+            return l.left == bcs::Neumann || l.right == bcs::Neumann;
+        });
+        if (objects || neumann) {
+            logger(spdlog::level::err,
+                   "system.slabs and system.distributed require a mesh without "
+                   "embedded objects or Neumann boundaries");
+            return std::nullopt;
+        }
+    }
+
     if (bc_opt && st_opt) {
+        // from here on m is the rank's padded slab and the cut faces are Floating
+        std::optional<rank_part> part;
+        if (distributed) {
+            communicator comm;
+            distributed_laplacian dl{comm, *mesh_opt, *st_opt, bc_opt->first, logger};
+            const auto sl = dl.local();
+            const integer plane = dl.decomposition().plane_size();
+            part.emplace(rank_part{comm,
+                                   MOVE(dl),
+                                   slab_mesh(*mesh_opt, sl.first, sl.last),
+                                   (sl.first - sl.lo) * plane,
+                                   sl.first * plane});
+            bc_opt->first = slab_bcs(bc_opt->first, sl.lo, sl.hi, mesh_opt->extents()[0]);
+            mesh_opt = slab_mesh(*mesh_opt, sl.lo, sl.hi);
+        }
+
         auto ms_opt = manufactured_solution::from_lua(tbl, mesh_opt->dims(), logger);
         auto t = ms_opt ? MOVE(*ms_opt) : manufactured_solution{};
 
-        return heat{MOVE(*mesh_opt),
-                    MOVE(bc_opt->first),
-                    MOVE(bc_opt->second),
-                    MOVE(t),
-                    *st_opt,
-                    diff,
-                    logger};
+        auto h = heat{MOVE(*mesh_opt),
+                      MOVE(bc_opt->first),
+                      MOVE(bc_opt->second),
+                      MOVE(t),
+                      *st_opt,
+                      MOVE(diff),
+                      logger};
+        h.schedule = schedule;
+        h.adi_preconditioner = precond == "adi";
+        h.retire_diverged = sys["retire_diverged"].get_or(false);
+        if (slabs > 0)
+            h.slab_lap = std::make_shared<const slab_laplacian>(
+                h.m, *st_opt, h.grid_bcs, slabs, logger);
+        h.dist = MOVE(part);
+
+        if (auto sp_opt = spectral_options::from_lua(tbl, logger); sp_opt) {
+            auto est = h.estimate_spectral_radius(*sp_opt);
+            logger(spdlog::level::info,
+                   "heat spectral radius {} after {} applications (converged: {})",
+                   est.radius,
+                   est.applications,
+                   est.converged);
+        }
+        return h;
     }
 
     return std::nullopt;
 }
 
+spectral_estimate heat::estimate_spectral_radius(const spectral_options& opts)
+{
+    auto est = spectral_estimator{m, grid_bcs, object_bcs, opts}(
+        [this](scalar_view u, scalar_span du) { du = lap(u); });
+
+    if (est.radius > 0) spectral_rho = est.radius;
+
+    // rho(k * lap) = k * rho(lap); the largest diffusivity bounds the timestep
+    const real k = std::ranges::max(diffusivity);
+    est.radius *= k;
+    est.min_real *= k;
+    est.max_real *= k;
+    return est;
+}
+
+int heat::fields(bool implicit)
+{
+    // lap_diag, neumann, src, src_lap, error and the solver's unknown mask, then
+    // update_boundary's solution and gradient.  implicit_update keeps the input
+    // and output of the lap graph and needs one delta beside them.
+    return 6 + 2 + (implicit ? 2 : 0);
+}
+
+sim_registry::first_touch heat::first_touch() const
+{
+    if (!slab_lap) return {};
+    return [sl = slab_lap](std::span<real> v) { sl->partition().fill(v, 0.0); };
+}
+
 system_size heat::size() const
 {
-    return {1, 0, m.size(), (integer)m.Rx().size(), (integer)m.Ry().size(), (integer)m.Rz().size()};
+    return {(integer)diffusivity.size(),
+            0,
+            m.size(),
+            (integer)m.Rx().size(),
+            (integer)m.Ry().size(),
+            (integer)m.Rz().size()};
 }
 
 void heat::fill_source(real time)
 {
     scalar_span src{src_d, src_rx, src_ry, src_rz};
     eval_at_locations(m, [&](const real3& loc) {
-        return m_sol.ddt(time, loc) - diffusivity * m_sol.laplacian(time, loc);
+        return m_sol.ddt(time, loc);
     }, src, m_sol.is_thread_safe());
+
+    scalar_span src_lap{src_lap_d, src_lap_rx, src_lap_ry, src_lap_rz};
+    eval_at_locations(m, [&](const real3& loc) {
+        return m_sol.laplacian(time, loc);
+    }, src_lap, m_sol.is_thread_safe());
 }
 
 void heat::rhs(const sim_registry& reg, field_ref input,
                sim_registry& out_reg, field_ref output, real time)
 {
     Kokkos::Profiling::ScopedRegion region("heat::rhs");
-    constexpr auto sh = scalar_handle{0};
-    auto u = extract_scalar_view(reg, input, sh);
-    auto u_rhs = extract_scalar_span(out_reg, output, sh);
+    const auto live = advancing();
+    const int n = static_cast<int>(live.size());
+
+    std::vector<scalar_view> u(n);
+    std::vector<scalar_span> u_rhs(n);
+    const std::vector<scalar_view> nu(n, scalar_view{neumann_d, neumann_rx, neumann_ry, neumann_rz});
+    for (int i = 0; i < n; ++i) {
+        u[i] = extract_scalar_view(reg, input, handle(live[i]));
+        u_rhs[i] = extract_scalar_span(out_reg, output, handle(live[i]));
+    }
 
-    // rhs = diffusivity * lap(u) + (dS/dt - diffusivity * lap(S))
-    u_rhs = lap(u, scalar_view{neumann_d, neumann_rx, neumann_ry, neumann_rz});
-    times_assign_scalar(out_reg, output, sh, diffusivity);
+    // rhs_s = k_s * lap(u_s) + (dS/dt - k_s * lap(S))
+    if (slab_lap || dist)
+        host_laplacian(u, u_rhs);
+    else
+        lap.apply_batch(u, nu, u_rhs);
+    for (int s : live) times_assign_scalar(out_reg, output, handle(s), diffusivity[s]);
 
     if (m_sol) {
         // Evaluate source expression into member buffers
         fill_source(time);
-        scalar_span src{src_d, src_rx, src_ry, src_rz};
-
-        // Shared destination pointers
-        real* rhs_D = out_reg.data(output, sh.D());
-        auto R = sh.R();
+        const real* ddt_R[] = {src_rx.data(), src_ry.data(), src_rz.data()};
+        const real* lap_R[] = {src_lap_rx.data(), src_lap_ry.data(), src_lap_rz.data()};
+
+        for (int s : live) {
+            const auto sh = handle(s);
+            const real k = diffusivity[s];
+            real* rhs_D = out_reg.data(output, sh.D());
+            auto R = sh.R();
+
+            // Fluid on D buffer: plus_assign from gather_selection of fluid indices
+            plus_assign_selected(rhs_D, m.fluid_desc(), source_expr{src_d.data(), src_lap_d.data(), k});
+
+            // Non-dirichlet objects on Rx/Ry/Rz buffers
+            for (int dir = 0; dir < 3; ++dir) {
+                auto gd = m.non_dirichlet_object_desc(dir, object_bcs);
+                plus_assign_selected(out_reg.data(output, R[dir]), gd,
+                                     source_expr{ddt_R[dir], lap_R[dir], k});
+            }
 
-        // Fluid on D buffer: plus_assign from gather_selection of fluid indices
-        plus_assign_selected(rhs_D, m.fluid_desc(), handle_expr{src.D.data()});
+            // Grid Dirichlet: fill plane subsets of D buffer with zero
+            for_each_grid_bc_desc<bcs::Dirichlet>(grid_bcs, m.extents(), [&](auto desc) {
+                fill_selected(rhs_D, desc, 0.0);
+            });
 
-        // Non-dirichlet objects on Rx/Ry/Rz buffers
-        real* src_R[] = {src.Rx.data(), src.Ry.data(), src.Rz.data()};
-        for (int dir = 0; dir < 3; ++dir) {
-            auto gd = m.non_dirichlet_object_desc(dir, object_bcs);
-            plus_assign_selected(out_reg.data(output, R[dir]), gd,
-                                 handle_expr{src_R[dir]});
+            // Object Dirichlet: fill predicate subsets of Rx/Ry/Rz buffers
+            for (int dir = 0; dir < 3; ++dir) {
+                auto gd = m.dirichlet_object_desc(dir, object_bcs);
+                fill_selected(out_reg.data(output, R[dir]), gd, 0.0);
+            }
         }
+    }
+}
 
-        // Grid Dirichlet: fill plane subsets of D buffer with zero
-        for_each_grid_bc_desc<bcs::Dirichlet>(grid_bcs, m.extents(), [&](auto desc) {
-            fill_selected(rhs_D, desc, 0.0);
-        });
+void heat::build_rhs_graph(scalar_view u, scalar_span du)
+{
+    assert(diffusivity.size() == 1);
+    build_rhs_graph(std::span{&u, 1}, std::span{&du, 1});
+}
 
-        // Object Dirichlet: fill predicate subsets of Rx/Ry/Rz buffers
-        for (int dir = 0; dir < 3; ++dir) {
-            auto gd = m.dirichlet_object_desc(dir, object_bcs);
-            fill_selected(out_reg.data(output, R[dir]), gd, 0.0);
+void heat::build_rhs_graph(std::span<const scalar_view> u, std::span<const scalar_span> du)
+{
+    assert(u.size() == diffusivity.size() && du.size() == diffusivity.size());
+
+    // retired scalars are left out; their rhs stays zeroed
+    const auto live = advancing();
+    if (live.size() < u.size()) {
+        std::vector<scalar_view> u_active;
+        std::vector<scalar_span> du_active;
+        for (int s : live) {
+            u_active.push_back(u[s]);
+            du_active.push_back(du[s]);
         }
+        build_rhs_graph(u_active, du_active, live);
+    } else {
+        build_rhs_graph(u, du, live);
     }
 }
 
-void heat::build_rhs_graph(scalar_view u, scalar_span du)
+void heat::build_rhs_graph(std::span<const scalar_view> u,
+                           std::span<const scalar_span> du,
+                           std::span<const int> live)
 {
-    scalar_view nu{neumann_d, neumann_rx, neumann_ry, neumann_rz};
-    const real k = diffusivity;
-
-    // Extract du pointers and sizes for graph node lambdas
-    real* d_ptr = du.D.data();
-    real* rx_ptr = du.Rx.data();
-    real* ry_ptr = du.Ry.data();
-    real* rz_ptr = du.Rz.data();
-    const int n_d = static_cast<int>(du.D.size());
-    const int n_rx = static_cast<int>(du.Rx.size());
-    const int n_ry = static_cast<int>(du.Ry.size());
-    const int n_rz = static_cast<int>(du.Rz.size());
+    const int n = static_cast<int>(live.size());
+    assert(n > 0);
+    const std::vector<scalar_view> nu(n, scalar_view{neumann_d, neumann_rx, neumann_ry, neumann_rz});
+
+    // Extract du pointers of every scalar and sizes for graph node lambdas
+    matrix::batch<real> d_ptr, rx_ptr, ry_ptr, rz_ptr;
+    Kokkos::Array<real, matrix::batch<real>::max_size> k{};
+    for (int s = 0; s < n; ++s) {
+        d_ptr.push_back(du[s].D.data());
+        rx_ptr.push_back(du[s].Rx.data());
+        ry_ptr.push_back(du[s].Ry.data());
+        rz_ptr.push_back(du[s].Rz.data());
+        k[s] = diffusivity[live[s]];
+    }
+    const integer n_d = static_cast<integer>(du[0].D.size());
+    const integer n_rx = static_cast<integer>(du[0].Rx.size());
+    const integer n_ry = static_cast<integer>(du[0].Ry.size());
+    const integer n_rz = static_cast<integer>(du[0].Rz.size());
 
     // Pre-compute source pointers (stable member data)
-    real* src_d_ptr = src_d.data();
-    real* src_rx_ptr = src_rx.data();
-    real* src_ry_ptr = src_ry.data();
-    real* src_rz_ptr = src_rz.data();
+    const real* src_d_ptr = src_d.data();
+    const real* src_rx_ptr = src_rx.data();
+    const real* src_ry_ptr = src_ry.data();
+    const real* src_rz_ptr = src_rz.data();
+    const real* lap_d_ptr = src_lap_d.data();
+    const real* lap_rx_ptr = src_lap_rx.data();
+    const real* lap_ry_ptr = src_lap_ry.data();
+    const real* lap_rz_ptr = src_lap_rz.data();
 
     // Pre-compute descriptors for source scatter and BC fill
     gather_selection fluid = m.fluid_desc();
@@ -191,17 +527,12 @@ void heat::build_rhs_graph(scalar_view u, scalar_span du)
     // Flatten all Dirichlet grid face indices into a single gather_selection
     gather_selection dir_d;
     {
-        std::vector<int> indices;
+        std::vector<integer> indices;
         for_each_grid_bc_desc<bcs::Dirichlet>(grid_bcs, m.extents(), [&](auto desc) {
-            for (int i = 0; i < desc.count(); ++i)
+            for (integer i = 0; i < desc.count(); ++i)
                 indices.push_back(desc.element(i));
         });
-        Kokkos::View<int*, memory_space> idx("dir_d_idx", indices.size());
-        auto h = Kokkos::create_mirror_view(idx);
-        for (size_t i = 0; i < indices.size(); ++i)
-            h(i) = indices[i];
-        Kokkos::deep_copy(idx, h);
-        dir_d = gather_selection{idx};
+        dir_d = make_gather_from_indices(indices);
     }
 
     gather_selection dir_rx = m.dirichlet_object_desc(0, object_bcs);
@@ -210,115 +541,141 @@ void heat::build_rhs_graph(scalar_view u, scalar_span du)
 
     bool has_sol = !!m_sol;
 
-    rhs_graph_ = Kokkos::Experimental::create_graph<execution_space>(
-        [&](auto root) {
-            using rp_t = Kokkos::RangePolicy<execution_space>;
-
-            // 1. Laplacian: zeros du, then accumulates dx + dy + dz with Neumann
-            auto lap_done = lap.add_graph_nodes(root, u, nu, du);
-
-            // 2. Scale all 4 buffers by diffusivity
-            auto s_d = lap_done.then_parallel_for(
-                "heat_scale_D", rp_t(0, n_d),
-                KOKKOS_LAMBDA(int i) { d_ptr[i] *= k; });
-            auto s_rx = lap_done.then_parallel_for(
-                "heat_scale_Rx", rp_t(0, n_rx),
-                KOKKOS_LAMBDA(int i) { rx_ptr[i] *= k; });
-            auto s_ry = lap_done.then_parallel_for(
-                "heat_scale_Ry", rp_t(0, n_ry),
-                KOKKOS_LAMBDA(int i) { ry_ptr[i] *= k; });
-            auto s_rz = lap_done.then_parallel_for(
-                "heat_scale_Rz", rp_t(0, n_rz),
-                KOKKOS_LAMBDA(int i) { rz_ptr[i] *= k; });
-
-            if (!has_sol) return;
-
-            // 3. Source scatter: plus_assign at selected indices
-            auto src_d_node = s_d.then_parallel_for(
-                "heat_src_D", rp_t(0, fluid.count()),
-                KOKKOS_LAMBDA(int i) {
-                    int idx = fluid.element(i);
-                    d_ptr[idx] += src_d_ptr[idx];
-                });
-            auto src_rx_node = s_rx.then_parallel_for(
-                "heat_src_Rx", rp_t(0, nd_rx.count()),
-                KOKKOS_LAMBDA(int i) {
-                    int idx = nd_rx.element(i);
-                    rx_ptr[idx] += src_rx_ptr[idx];
-                });
-            auto src_ry_node = s_ry.then_parallel_for(
-                "heat_src_Ry", rp_t(0, nd_ry.count()),
-                KOKKOS_LAMBDA(int i) {
-                    int idx = nd_ry.element(i);
-                    ry_ptr[idx] += src_ry_ptr[idx];
-                });
-            auto src_rz_node = s_rz.then_parallel_for(
-                "heat_src_Rz", rp_t(0, nd_rz.count()),
-                KOKKOS_LAMBDA(int i) {
-                    int idx = nd_rz.element(i);
-                    rz_ptr[idx] += src_rz_ptr[idx];
+    // Everything after the laplacian, chained from its final node
+    auto after_lap = [&](auto lap_done) {
+        using rp_t = Kokkos::RangePolicy<execution_space>;
+
+        // 2. Scale all 4 buffers of scalar s by its diffusivity
+        auto s_d = lap_done.then_parallel_for(
+            "heat_scale_D", rp_t(0, n_d),
+            KOKKOS_LAMBDA(integer i) { for (int s = 0; s < n; ++s) d_ptr[s][i] *= k[s]; });
+        auto s_rx = lap_done.then_parallel_for(
+            "heat_scale_Rx", rp_t(0, n_rx),
+            KOKKOS_LAMBDA(integer i) { for (int s = 0; s < n; ++s) rx_ptr[s][i] *= k[s]; });
+        auto s_ry = lap_done.then_parallel_for(
+            "heat_scale_Ry", rp_t(0, n_ry),
+            KOKKOS_LAMBDA(integer i) { for (int s = 0; s < n; ++s) ry_ptr[s][i] *= k[s]; });
+        auto s_rz = lap_done.then_parallel_for(
+            "heat_scale_Rz", rp_t(0, n_rz),
+            KOKKOS_LAMBDA(integer i) { for (int s = 0; s < n; ++s) rz_ptr[s][i] *= k[s]; });
+
+        if (!has_sol) return;
+
+        // 3. Source scatter: plus_assign dS/dt - k_s lap(S) at selected indices,
+        // then 4. BC fill: zero the Dirichlet indices.  Each selection is resolved
+        // to its index list here, once, so the kernels do not branch on it.
+        auto scatter = [&](auto scaled,
+                           const char* src_label,
+                           const char* fill_label,
+                           const gather_selection& sel,
+                           const gather_selection& dir,
+                           matrix::batch<real> out,
+                           const real* src,
+                           const real* lap_src) {
+            sel.visit([&](auto idx) {
+                auto src_node = scaled.then_parallel_for(
+                    src_label, rp_t(0, idx.count()), KOKKOS_LAMBDA(integer i) {
+                        const integer j = idx.element(i);
+                        for (int s = 0; s < n; ++s)
+                            out[s][j] += src[j] - k[s] * lap_src[j];
+                    });
+                if (dir.count() == 0) return;
+                dir.visit([&](auto zero) {
+                    src_node.then_parallel_for(
+                        fill_label, rp_t(0, zero.count()), KOKKOS_LAMBDA(integer i) {
+                            for (int s = 0; s < n; ++s) out[s][zero.element(i)] = 0;
+                        });
                 });
+            });
+        };
 
-            // 4. BC fill: zero Dirichlet indices
-            // D: grid Dirichlet faces
-            if (dir_d.count() > 0) {
-                src_d_node.then_parallel_for(
-                    "heat_fill_dir_D", rp_t(0, dir_d.count()),
-                    KOKKOS_LAMBDA(int i) { d_ptr[dir_d.element(i)] = 0; });
-            }
-            // Rx/Ry/Rz: object Dirichlet
-            if (dir_rx.count() > 0) {
-                src_rx_node.then_parallel_for(
-                    "heat_fill_dir_Rx", rp_t(0, dir_rx.count()),
-                    KOKKOS_LAMBDA(int i) { rx_ptr[dir_rx.element(i)] = 0; });
-            }
-            if (dir_ry.count() > 0) {
-                src_ry_node.then_parallel_for(
-                    "heat_fill_dir_Ry", rp_t(0, dir_ry.count()),
-                    KOKKOS_LAMBDA(int i) { ry_ptr[dir_ry.element(i)] = 0; });
-            }
-            if (dir_rz.count() > 0) {
-                src_rz_node.then_parallel_for(
-                    "heat_fill_dir_Rz", rp_t(0, dir_rz.count()),
-                    KOKKOS_LAMBDA(int i) { rz_ptr[dir_rz.element(i)] = 0; });
-            }
-        });
+        // D: grid Dirichlet faces; Rx/Ry/Rz: object Dirichlet
+        scatter(s_d, "heat_src_D", "heat_fill_dir_D", fluid, dir_d, d_ptr, src_d_ptr,
+                lap_d_ptr);
+        scatter(s_rx, "heat_src_Rx", "heat_fill_dir_Rx", nd_rx, dir_rx, rx_ptr,
+                src_rx_ptr, lap_rx_ptr);
+        scatter(s_ry, "heat_src_Ry", "heat_fill_dir_Ry", nd_ry, dir_ry, ry_ptr,
+                src_ry_ptr, lap_ry_ptr);
+        scatter(s_rz, "heat_src_Rz", "heat_fill_dir_Rz", nd_rz, dir_rz, rz_ptr,
+                src_rz_ptr, lap_rz_ptr);
+    };
+
+    if (slab_lap || dist) {
+        host_u.assign(u.begin(), u.end());
+        host_du.assign(du.begin(), du.end());
+    }
+
+    rhs_graph_ = Kokkos::Experimental::create_graph(exec_space(), [&](auto root) {
+        // 1. Batched laplacian: zeros every du, then accumulates dx + dy + dz
+        //    with Neumann.  host_laplacian cannot be a node, so submit_rhs_graph
+        //    runs it first.
+        if (slab_lap || dist)
+            after_lap(root);
+        else if (schedule == graph_schedule::split)
+            after_lap(lap.add_split_batch_graph_nodes(root, u, nu, du));
+        else
+            after_lap(lap.add_batch_graph_nodes(root, u, nu, du));
+    });
 
     rhs_graph_->instantiate();
+    rhs_graph_work_ = lap.cost(n);
+}
+
+void heat::host_laplacian(std::span<const scalar_view> u, std::span<const scalar_span> du)
+{
+    if (slab_lap) {
+        slab_lap->apply_batch(u, du);
+        return;
+    }
+
+    // The exchange refreshes the halo planes of u, which are copies of the
+    // neighbours' owned planes and not part of this rank's state.  The integrators
+    // hand them over as const, so the write goes through a cast.
+    for (std::size_t k = 0; k < u.size(); ++k)
+        dist->lap(std::span<real>{const_cast<real*>(u[k].D.data()), u[k].D.size()},
+                  du[k].D);
 }
 
+void heat::tune(matrix::autotuner& tuner) { lap.tune(tuner); }
+
 void heat::submit_rhs_graph()
 {
+    report_work(rhs_graph_work_);
+    if (slab_lap || dist) host_laplacian(host_u, host_du);
     rhs_graph_->submit();
-    Kokkos::fence("heat::submit_rhs_graph() complete");
+    exec_space().fence("heat::submit_rhs_graph() complete");
 }
 
 void heat::update_boundary(sim_registry& reg, field_ref ref, real time)
 {
     Kokkos::Profiling::ScopedRegion region("heat::update_boundary");
-    constexpr auto sh = scalar_handle{0};
     // Evaluate manufactured solution at all mesh locations
-    std::vector<real> sol_d(m.size());
-    std::vector<real> sol_rx(m.Rx().size());
-    std::vector<real> sol_ry(m.Ry().size());
-    std::vector<real> sol_rz(m.Rz().size());
+    buffer sol_d(m.size());
+    buffer sol_rx(m.Rx().size());
+    buffer sol_ry(m.Ry().size());
+    buffer sol_rz(m.Rz().size());
     scalar_span sol{sol_d, sol_rx, sol_ry, sol_rz};
     eval_at_locations(m, [&](const real3& loc) {
         return m_sol(time, loc);
     }, sol, m_sol.is_thread_safe());
 
-    // Grid Dirichlet: assign plane subsets of D buffer
-    real* u_D = reg.data(ref, sh.D());
-    for_each_grid_bc_desc<bcs::Dirichlet>(grid_bcs, m.extents(), [&](auto desc) {
-        assign_selected(u_D, desc, handle_expr{sol.D.data()});
-    });
-
-    // Object Dirichlet: assign predicate subsets of Rx/Ry/Rz buffers
-    auto R = sh.R();
     real* sol_R[] = {sol.Rx.data(), sol.Ry.data(), sol.Rz.data()};
-    for (int dir = 0; dir < 3; ++dir) {
-        auto gd = m.dirichlet_object_desc(dir, object_bcs);
-        assign_selected(reg.data(ref, R[dir]), gd, handle_expr{sol_R[dir]});
+    // retired scalars keep the boundary values they had
+    for (int s : advancing()) {
+        const auto sh = handle(s);
+
+        // Grid Dirichlet: assign plane subsets of D buffer
+        real* u_D = reg.data(ref, sh.D());
+        for_each_grid_bc_desc<bcs::Dirichlet>(grid_bcs, m.extents(), [&](auto desc) {
+            assign_selected(u_D, desc, handle_expr{sol.D.data()});
+        });
+
+        // Object Dirichlet: assign predicate subsets of Rx/Ry/Rz buffers
+        auto R = sh.R();
+        for (int dir = 0; dir < 3; ++dir) {
+            auto gd = m.dirichlet_object_desc(dir, object_bcs);
+            assign_selected(reg.data(ref, R[dir]), gd, handle_expr{sol_R[dir]});
+        }
     }
 
     // Set Neumann BCs: evaluate gradient component at domain locations, assign at faces
@@ -329,10 +686,10 @@ void heat::update_boundary(sim_registry& reg, field_ref ref, real time)
         bool need_right = grid_bcs[dir].right == bcs::Neumann;
         if (!need_left && !need_right) continue;
 
-        std::vector<real> grad_d(m.size());
-        std::vector<real> grad_rx(m.Rx().size());
-        std::vector<real> grad_ry(m.Ry().size());
-        std::vector<real> grad_rz(m.Rz().size());
+        buffer grad_d(m.size());
+        buffer grad_rx(m.Rx().size());
+        buffer grad_ry(m.Ry().size());
+        buffer grad_rz(m.Rz().size());
         scalar_span grad{grad_d, grad_rx, grad_ry, grad_rz};
         eval_at_locations(m, [&](const real3& loc) {
             return m_sol.gradient(time, loc)[dir];
@@ -353,74 +710,199 @@ void heat::update_boundary(sim_registry& reg, field_ref ref, real time)
     }
 }
 
+heat::adi_lines heat::adi(real k)
+{
+    auto it = adi_factors.find(k);
+    if (it == adi_factors.end()) {
+        // a varying dt would otherwise grow the cache without bound
+        if (adi_factors.size() == 8) adi_factors.clear();
+        auto f = std::make_shared<const std::array<matrix::line_solver, 3>>(
+            lap.line_solvers(k));
+        it = adi_factors.emplace(k, MOVE(f)).first;
+    }
+    const auto& f = *it->second;
+    return std::ranges::all_of(f, &matrix::line_solver::factored) ? it->second
+                                                                   : nullptr;
+}
+
+krylov_result heat::implicit_update(const sim_registry& creg, field_ref b,
+                                    sim_registry& reg, field_ref u, real c,
+                                    const krylov_options& opts)
+{
+    Kokkos::Profiling::ScopedRegion region("heat::implicit_update");
+
+    buffer delta_d(m.size()), delta_rx(m.Rx().size()), delta_ry(m.Ry().size()),
+        delta_rz(m.Rz().size());
+    scalar_span delta{delta_d, delta_rx, delta_ry, delta_rz};
+    const scalar_view diag{lap_diag_d, lap_diag_rx, lap_diag_ry, lap_diag_rz};
+
+    // the solver hands A a different basis vector each iteration, so lap's graph
+    // is bound once to fixed buffers that x is copied into
+    if (implicit_x_d.empty()) {
+        implicit_x_d.resize(m.size());
+        implicit_x_rx.resize(m.Rx().size());
+        implicit_x_ry.resize(m.Ry().size());
+        implicit_x_rz.resize(m.Rz().size());
+        implicit_lx_d.resize(m.size());
+        implicit_lx_rx.resize(m.Rx().size());
+        implicit_lx_ry.resize(m.Ry().size());
+        implicit_lx_rz.resize(m.Rz().size());
+        lap.build_graph(
+            scalar_view{implicit_x_d, implicit_x_rx, implicit_x_ry, implicit_x_rz},
+            scalar_span{implicit_lx_d, implicit_lx_rx, implicit_lx_ry, implicit_lx_rz},
+            schedule);
+    }
+
+    krylov_result res{0, 0, true};
+    for (int s : advancing()) {
+        const real k = c * diffusivity[s];
+
+        // A = I - k lap without Neumann data; the solver zeroes the boundary values
+        auto A = [this, k](scalar_view x, scalar_span y) {
+            copy_in(x.D, implicit_x_d);
+            copy_in(x.Rx, implicit_x_rx);
+            copy_in(x.Ry, implicit_x_ry);
+            copy_in(x.Rz, implicit_x_rz);
+            lap.submit_graph();
+            shift(k, x.D, implicit_lx_d, y.D);
+            shift(k, x.Rx, implicit_lx_rx, y.Rx);
+            shift(k, x.Ry, implicit_lx_ry, y.Ry);
+            shift(k, x.Rz, implicit_lx_rz, y.Rz);
+            exec_space().fence("heat::implicit_update A");
+        };
+        // (I - k Dz)^-1 (I - k Dy)^-1 (I - k Dx)^-1 on D, Jacobi on the rest
+        auto lines = adi_preconditioner ? adi(k) : nullptr;
+        auto M = [k, diag, lines](scalar_view x, scalar_span y) {
+            if (lines) {
+                std::ranges::copy(x.D, y.D.begin());
+                for (auto&& solve : *lines) solve(y.D);
+            } else {
+                jacobi(k, diag.D, x.D, y.D);
+            }
+            jacobi(k, diag.Rx, x.Rx, y.Rx);
+            jacobi(k, diag.Ry, x.Ry, y.Ry);
+            jacobi(k, diag.Rz, x.Rz, y.Rz);
+            exec_space().fence("heat::implicit_update M");
+        };
+
+        auto r = solver(A, M, extract_scalar_view(creg, b, handle(s)), delta, opts);
+        res.iterations = std::max(res.iterations, r.iterations);
+        res.residual = std::max(res.residual, r.residual);
+        res.converged = res.converged && r.converged;
+
+        auto us = extract_scalar_span(reg, u, handle(s));
+        add_correction(delta.D, us.D);
+        add_correction(delta.Rx, us.Rx);
+        add_correction(delta.Ry, us.Ry);
+        add_correction(delta.Rz, us.Rz);
+        exec_space().fence("heat::implicit_update u");
+    }
+    return res;
+}
+
 real heat::timestep_size(const sim_registry&, field_ref,
                          const step_controller& step) const
 {
+    // the largest diffusivity still advancing, so retiring that scalar lets the
+    // others take longer steps
+    real k = std::numeric_limits<real>::lowest();
+    for (int s : advancing()) k = std::max(k, diffusivity[s]);
+
+    // the uniform-grid bound h^2 / (4 k) is 1 / rho for 1D E2, so cfl keeps its meaning
+    if (spectral_rho) return step.parabolic_cfl() / (*spectral_rho * k);
+
     const auto h_min = std::ranges::min(m.h());
-    return step.parabolic_cfl() * h_min * h_min / (4 * diffusivity);
+    return step.parabolic_cfl() * h_min * h_min / (4 * k);
 }
 
 system_stats heat::stats(const sim_registry& reg, field_ref /*u0*/,
                           field_ref u1, const step_controller& step) const
 {
     Kokkos::Profiling::ScopedRegion region("heat::stats");
-    constexpr auto sh = scalar_handle{0};
-    auto u = extract_scalar_view(reg, u1, sh);
 
     // Evaluate manufactured solution at all mesh locations
-    std::vector<real> sol_d(m.size());
-    std::vector<real> sol_rx(m.Rx().size());
-    std::vector<real> sol_ry(m.Ry().size());
-    std::vector<real> sol_rz(m.Rz().size());
+    buffer sol_d(m.size());
+    buffer sol_rx(m.Rx().size());
+    buffer sol_ry(m.Ry().size());
+    buffer sol_rz(m.Rz().size());
     scalar_span sol{sol_d, sol_rx, sol_ry, sol_rz};
     eval_at_locations(m, [&](const real3& loc) {
         return m_sol(step.simulation_time(), loc);
     }, sol, m_sol.is_thread_safe());
 
-    return detail::compute_scalar_stats(m, object_bcs, u,
-        scalar_view{sol_d, sol_rx, sol_ry, sol_rz});
+    // full statistics for scalar 0, Linf errors for the remaining scalars, and the
+    // full statistics of every scalar when diverged ones are retired
+    const scalar_view sol_v{sol_d, sol_rx, sol_ry, sol_rz};
+    auto scalar_stats = [&](int s) {
+        const auto u = extract_scalar_view(reg, u1, handle(s));
+        if (!dist) return detail::compute_scalar_stats(m, object_bcs, u, sol_v);
+
+        // the owned planes of every rank
+        const auto n = static_cast<std::size_t>(dist->owned.size());
+        const scalar_view u_own{u.D.subspan(dist->owned_first, n), {}, {}, {}};
+        const scalar_view sol_own{sol_v.D.subspan(dist->owned_first, n), {}, {}, {}};
+        auto ss = detail::compute_scalar_stats(dist->owned, object_bcs, u_own, sol_own);
+        reduce_stats(dist->comm, ss.stats, dist->global_first);
+        return ss;
+    };
+
+    auto st = scalar_stats(0);
+    if (retire_diverged) st.scalars.push_back(st.stats);
+    for (int s = 1; s < (int)diffusivity.size(); ++s) {
+        auto ss = scalar_stats(s);
+        st.stats.push_back(ss.stats[0]);
+        if (retire_diverged) st.scalars.push_back(MOVE(ss.stats));
+    }
+    return st;
 }
 
 void heat::initialize(sim_registry& reg, field_ref ref, const step_controller& c)
 {
     if (!m_sol) return;
 
-    constexpr auto sh = scalar_handle{0};
-    auto u = extract_scalar_span(reg, ref, sh);
-
     // Evaluate manufactured solution at all mesh locations
-    std::vector<real> sol_d(m.size());
-    std::vector<real> sol_rx(m.Rx().size());
-    std::vector<real> sol_ry(m.Ry().size());
-    std::vector<real> sol_rz(m.Rz().size());
+    buffer sol_d(m.size());
+    buffer sol_rx(m.Rx().size());
+    buffer sol_ry(m.Ry().size());
+    buffer sol_rz(m.Rz().size());
     scalar_span sol{sol_d, sol_rx, sol_ry, sol_rz};
     eval_at_locations(m, [&](const real3& loc) {
         return m_sol(c.simulation_time(), loc);
     }, sol, m_sol.is_thread_safe());
 
-    detail::initialize_scalar_field(m, u, sol);
+    for (int s = 0; s < (int)diffusivity.size(); ++s)
+        detail::initialize_scalar_field(m, extract_scalar_span(reg, ref, handle(s)), sol);
 }
 
 bool heat::write(field_io& io, const sim_registry& reg, field_ref ref,
                  const step_controller& c, real dt)
 {
-    constexpr auto sh = scalar_handle{0};
-    auto u = extract_scalar_view(reg, ref, sh);
+    auto u = extract_scalar_view(reg, ref, handle(0));
 
     // Evaluate manufactured solution at all mesh locations
-    std::vector<real> sol_d(m.size());
-    std::vector<real> sol_rx(m.Rx().size());
-    std::vector<real> sol_ry(m.Ry().size());
-    std::vector<real> sol_rz(m.Rz().size());
+    buffer sol_d(m.size());
+    buffer sol_rx(m.Rx().size());
+    buffer sol_ry(m.Ry().size());
+    buffer sol_rz(m.Rz().size());
     scalar_span sol{sol_d, sol_rx, sol_ry, sol_rz};
     eval_at_locations(m, [&](const real3& loc) {
         return m_sol(c.simulation_time(), loc);
     }, sol, m_sol.is_thread_safe());
 
     scalar_span error{error_d, error_rx, error_ry, error_rz};
-    return detail::write_scalar_error(m, object_bcs, grid_bcs, u,
-        scalar_view{sol_d, sol_rx, sol_ry, sol_rz}, error,
-        io, io_names, c, dt);
+    if (diffusivity.size() == 1)
+        return detail::write_scalar_error(m, object_bcs, grid_bcs, u,
+            scalar_view{sol_d, sol_rx, sol_ry, sol_rz}, error,
+            io, io_names, c, dt);
+
+    // every scalar, then the error of scalar 0
+    detail::compute_scalar_error(m, object_bcs, grid_bcs, u,
+        scalar_view{sol_d, sol_rx, sol_ry, sol_rz}, error);
+    std::vector<scalar_view> io_scalars;
+    for (int s = 0; s < (int)diffusivity.size(); ++s)
+        io_scalars.push_back(extract_scalar_view(reg, ref, handle(s)));
+    io_scalars.push_back(scalar_view{error_d, error_rx, error_ry, error_rz});
+    return io.write(io_names, io_scalars, c, dt, m.R());
 }
 
 } // namespace ccs::systems
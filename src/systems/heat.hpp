@@ -2,21 +2,39 @@
 
 #include "fields/field_registry.hpp"
 #include "io/field_io.hpp"
+#include "memory.hpp"
 #include "mesh/mesh.hpp"
 #include "mms/manufactured_solutions.hpp"
+#include "operators/krylov.hpp"
 #include "operators/laplacian.hpp"
+#include "operators/slab_laplacian.hpp"
+#include "operators/spectral_radius.hpp"
+#include "parallel/distributed_laplacian.hpp"
 #include "temporal/step_controller.hpp"
 #include <Kokkos_Graph.hpp>
+#include <array>
+#include <map>
+#include <memory>
 #include <optional>
 #include <sol/forward.hpp>
+#include <span>
 
 namespace ccs::systems
 {
 //
-// solve dT/dt = k lap T
+// solve dT_s/dt = k_s lap T_s for one or more scalars T_s sharing the mesh,
+// boundary conditions and manufactured solution.  All scalars are advanced by
+// one batched laplacian so its coefficients are streamed once per rhs.
+//
+// With system.retire_diverged each scalar reports its own statistics, all
+// scalars share the timestep of the largest diffusivity still advancing, and a
+// scalar whose error diverges is retired from the rhs and boundary updates,
+// leaving its field as it was, while the others continue.
 //
 class heat
 {
+    // full-mesh scratch and member buffers, charged to subsystem::systems
+    using buffer = tracked_vector<real, subsystem::systems>;
 
     mesh m;
     bcs::Grid grid_bcs;
@@ -24,18 +42,81 @@ class heat
     manufactured_solution m_sol;
 
     laplacian lap;
-    real diffusivity;
-
-    std::vector<real> neumann_d, neumann_rx, neumann_ry, neumann_rz;
-    std::vector<real> src_d, src_rx, src_ry, src_rz;
-    std::vector<real> error_d, error_rx, error_ry, error_rz;
+    // the D-buffer laplacian of the rhs on x-slabs (system.slabs), null without
+    // slabs.  Shared so the registry's first_touch hook outlives moves.
+    std::shared_ptr<const slab_laplacian> slab_lap;
+
+    // This rank's part of a mesh split into x-slabs over the ranks
+    // (system.distributed).  m, the registry fields and the buffers above hold
+    // the padded planes of the rank's slab; only the owned planes are meaningful.
+    struct rank_part {
+        communicator comm;
+        distributed_laplacian lap;
+        // mesh of the owned planes, for stats
+        mesh owned;
+        // first owned row of the local D buffers, and its global index
+        integer owned_first;
+        integer global_first;
+    };
+    std::optional<rank_part> dist;
+
+    // buffers of the live scalars bound by build_rhs_graph for a laplacian that
+    // runs ahead of the graph in submit_rhs_graph (slab_lap or dist)
+    std::vector<scalar_view> host_u;
+    std::vector<scalar_span> host_du;
+
+    // du[k].D = lap(u[k].D) with slab_lap or dist, which launch from host threads
+    // or wait on messages and so cannot be graph nodes
+    void host_laplacian(std::span<const scalar_view> u, std::span<const scalar_span> du);
+    // implicit solves against I - c k_s lap, preconditioned by ADI line solves
+    // (or diag(lap)) on D and by diag(lap) on Rx/Ry/Rz
+    krylov_solver solver;
+    buffer lap_diag_d, lap_diag_rx, lap_diag_ry, lap_diag_rz;
+    // the input and output of lap's prebuilt graph, which applies A in the
+    // solves; allocated and bound on the first implicit update
+    buffer implicit_x_d, implicit_x_rx, implicit_x_ry, implicit_x_rz;
+    buffer implicit_lx_d, implicit_lx_rx, implicit_lx_ry, implicit_lx_rz;
+    // line factors of I - k D_dir for each k = c k_s seen so far.  Shared so that
+    // a preconditioner holding factors survives the cache being cleared.
+    using adi_lines = std::shared_ptr<const std::array<matrix::line_solver, 3>>;
+    std::map<real, adi_lines> adi_factors;
+    // ADI on D (system.preconditioner = "adi") or Jacobi everywhere ("jacobi")
+    bool adi_preconditioner = true;
+
+    // factors for I - k lap, null when a line could not be factored
+    adi_lines adi(real k);
+    // one diffusivity per scalar
+    std::vector<real> diffusivity;
+
+    // spectral radius of lap, when a matrix-free estimate was requested
+    std::optional<real> spectral_rho;
+
+    buffer neumann_d, neumann_rx, neumann_ry, neumann_rz;
+    // dS/dt and lap(S) of the manufactured solution; the source of scalar s is
+    // dS/dt - k_s lap(S)
+    buffer src_d, src_rx, src_ry, src_rz;
+    buffer src_lap_d, src_lap_rx, src_lap_ry, src_lap_rz;
+    buffer error_d, error_rx, error_ry, error_rz;
 
     logs logger;
 
-    std::vector<std::string> io_names = {"U", "Error"};
+    std::vector<std::string> io_names;
 
     // Pre-built graph for submit_rhs_graph().
     std::optional<Kokkos::Experimental::Graph<execution_space>> rhs_graph_;
+    work rhs_graph_work_{};
+    // node layout of the laplacian in the rhs graph (system.schedule)
+    graph_schedule schedule = graph_schedule::chained;
+
+    bool retire_diverged = false;
+    // scalars still advanced by the rhs; all of them unless retire_diverged
+    std::vector<bool> active;
+
+    std::vector<int> advancing() const;
+    // the rhs graph of the scalars in live, whose buffers are u[i] and du[i]
+    void build_rhs_graph(std::span<const scalar_view> u,
+                         std::span<const scalar_span> du,
+                         std::span<const int> live);
 
 public:
     heat() = default;
@@ -45,26 +126,50 @@ public:
          bcs::Object&& object_bcs,
          manufactured_solution&& m_sol,
          stencil st,
-         real diffusivity,
+         std::vector<real> diffusivity,
          const logs& = {});
 
     static std::optional<heat> from_lua(const sol::table&, const logs& = {});
 
+    // full-mesh fields a heat system holds outside the registry at its peak,
+    // with the scratch of implicit_update when an implicit integrator drives it
+    static int fields(bool implicit);
+
+    // Estimate the spectral radius of the rhs operator so that timestep_size
+    // returns parabolic_cfl / rho instead of the uniform-grid bound.
+    spectral_estimate estimate_spectral_radius(const spectral_options&);
+
     bool valid(const system_stats&) const;
 
+    // Retire the scalars whose error diverged in `stats`, returning how many were
+    // retired.  The rhs graph must be rebuilt afterwards.
+    int retire(const system_stats&);
+
     void log(const system_stats&, const step_controller&);
 
     real3 summary(const system_stats&) const;
 
     system_size size() const;
 
+    // with system.slabs, zero registry D buffers slab by slab on slab_lap's
+    // partitions; empty otherwise
+    sim_registry::first_touch first_touch() const;
+
     void fill_source(real time);
 
     void rhs(const sim_registry& reg, field_ref input,
              sim_registry& out_reg, field_ref output, real time);
+    // launch shapes of the laplacian's matrices; before build_rhs_graph
+    void tune(matrix::autotuner&);
     void build_rhs_graph(scalar_view u, scalar_span du);
+    void build_rhs_graph(std::span<const scalar_view> u, std::span<const scalar_span> du);
     void submit_rhs_graph();
     void update_boundary(sim_registry& reg, field_ref ref, real time);
+    // u_s += (I - c k_s lap)^-1 b_s for every scalar, with homogeneous boundary
+    // data so only the unknowns of u change
+    krylov_result implicit_update(const sim_registry& creg, field_ref b,
+                                  sim_registry& reg, field_ref u, real c,
+                                  const krylov_options&);
     real timestep_size(const sim_registry& reg, field_ref ref,
                        const step_controller&) const;
     system_stats stats(const sim_registry& reg, field_ref u0,
@@ -6,12 +6,14 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_session.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <sol/sol.hpp>
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <numeric>
 
 using namespace ccs;
@@ -732,9 +734,12 @@ TEST_CASE("heat - eval_at_locations parallel path (gaussian MMS)")
 // 17d.5c: Verify graph-based RHS matches eager RHS for heat system.
 // Uses the E2 setup with Dirichlet + Neumann grid BCs and a Dirichlet object,
 // exercising all graph branches: laplacian, diffusivity scaling, source scatter,
-// and BC fill (both grid Dirichlet and object Dirichlet).
+// and BC fill (both grid Dirichlet and object Dirichlet).  Both laplacian
+// schedules are checked.
 TEST_CASE("heat - graph matches eager")
 {
+    const auto schedule = GENERATE(as<std::string>{}, "chained", "split");
+
     sol::state lua;
     lua.open_libraries(sol::lib::base, sol::lib::math);
     lua.script(R"(
@@ -796,6 +801,8 @@ TEST_CASE("heat - graph matches eager")
         }
     )");
 
+    lua["simulation"]["system"]["schedule"] = schedule;
+
     auto heat_opt = systems::heat::from_lua(lua["simulation"]);
     REQUIRE(!!heat_opt);
     auto& h = *heat_opt;
@@ -872,3 +879,240 @@ TEST_CASE("heat - graph matches eager")
         }
     }
 }
+
+TEST_CASE("heat - spectral timestep")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(R"(
+        simulation = {
+            mesh = {
+                index_extents = {41},
+                domain_bounds = {2}
+            },
+            domain_boundaries = {
+                xmin = "dirichlet",
+                xmax = "dirichlet"
+            },
+            scheme = {
+                order = 2,
+                type = "E2"
+            },
+            system = {
+                type = "heat",
+                diffusivity = 0.25
+            },
+            step_controller = {
+                max_step = 1,
+                cfl = {
+                    parabolic = 0.5
+                }
+            }
+        }
+    )");
+
+    auto ctrl_opt = step_controller::from_lua(lua["simulation"]);
+    REQUIRE(!!ctrl_opt);
+
+    sim_registry reg;
+    field_ref u0_ref{0};
+
+    auto geometric = systems::heat::from_lua(lua["simulation"]);
+    REQUIRE(!!geometric);
+    const real dt_geometric = geometric->timestep_size(reg, u0_ref, *ctrl_opt);
+
+    lua.script("simulation.system.spectral = { krylov_dim = 48 }");
+    auto spectral = systems::heat::from_lua(lua["simulation"]);
+    REQUIRE(!!spectral);
+    const real dt_spectral = spectral->timestep_size(reg, u0_ref, *ctrl_opt);
+
+    // on a uniform 1D E2 grid the uniform bound is within a boundary-closure
+    // factor of the true spectral radius
+    REQUIRE(dt_spectral > 0.5 * dt_geometric);
+    REQUIRE(dt_spectral < 2.0 * dt_geometric);
+}
+
+// Retiring diverged scalars steps at the largest diffusivity still advancing
+TEST_CASE("heat - retired scalar timestep")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(R"(
+        simulation = {
+            mesh = {
+                index_extents = {41},
+                domain_bounds = {2}
+            },
+            domain_boundaries = {
+                xmin = "dirichlet",
+                xmax = "dirichlet"
+            },
+            scheme = {
+                order = 2,
+                type = "E2"
+            },
+            system = {
+                type = "heat",
+                diffusivity = {0.25, 1.0, 0.5},
+                retire_diverged = true
+            },
+            step_controller = {
+                max_step = 1,
+                cfl = {
+                    parabolic = 0.5
+                }
+            }
+        }
+    )");
+
+    auto ctrl_opt = step_controller::from_lua(lua["simulation"]);
+    REQUIRE(!!ctrl_opt);
+    auto heat_opt = systems::heat::from_lua(lua["simulation"]);
+    REQUIRE(!!heat_opt);
+    auto& h = *heat_opt;
+
+    sim_registry reg;
+    field_ref u0_ref{0};
+    const real dt = h.timestep_size(reg, u0_ref, *ctrl_opt);
+    REQUIRE(dt == Catch::Approx(0.5 * 0.05 * 0.05 / 4));
+
+    // a NaN error retires scalar 1, leaving scalar 2 the largest
+    system_stats st{};
+    st.scalars = {{0.0}, {std::numeric_limits<real>::quiet_NaN()}, {0.0}};
+    REQUIRE(h.retire(st) == 1);
+    REQUIRE(h.timestep_size(reg, u0_ref, *ctrl_opt) == Catch::Approx(2 * dt));
+}
+
+// Several scalars with different diffusivities go through one batched
+// laplacian; each must match a single-scalar heat system with its diffusivity,
+// on both the eager and graph paths.
+TEST_CASE("heat - multiple scalars")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(R"(
+        simulation = {
+            mesh = {
+                index_extents = {21, 22, 23},
+                domain_bounds = {
+                    min = {1, 1.1, 0.3},
+                    max = {3, 3.3, 2.2}
+                }
+            },
+            domain_boundaries = {
+                xmin = "dirichlet",
+                ymin = "neumann",
+                ymax = "neumann",
+                zmax = "dirichlet"
+            },
+            shapes = {
+                {
+                    type = "sphere",
+                    center = {2.0001, 2.5656565, 1.313131311},
+                    radius = 0.25,
+                    boundary_condition = "dirichlet"
+                }
+            },
+            scheme = {
+                order = 2,
+                type = "E2"
+            },
+            system = {
+                type = "heat",
+                diffusivity = {0.1, 0.5, 2.0}
+            },
+            manufactured_solution = {
+                type = "lua",
+                call = function(time, loc)
+                    local x, y, z = loc[1], loc[2], loc[3]
+                    return math.sin(time) + x * x * y + y * z * z + x * y * z
+                end,
+                ddt = function(time, loc)
+                    return math.cos(time)
+                end,
+                grad = function(time, loc)
+                    local x, y, z = loc[1], loc[2], loc[3]
+                    return 2. * x * y + y * z, x * x + z * z + x * z, 2. * y * z + x * y
+                end,
+                lap = function(time, loc)
+                    local x, y, z = loc[1], loc[2], loc[3]
+                    return 2. * y + 2. * y
+                end,
+                div = function(time, loc)
+                    return 0.0
+                end
+            }
+        }
+    )");
+
+    auto multi_opt = systems::heat::from_lua(lua["simulation"]);
+    REQUIRE(!!multi_opt);
+    auto& multi = *multi_opt;
+    const auto sz = multi.size();
+    REQUIRE(sz.nscalars == 3);
+
+    constexpr real time = 0.3;
+    step_controller step{};
+
+    // slot 0: state, slot 1: eager rhs, slot 2: graph rhs
+    sim_registry reg;
+    field_ref u0_ref{0}, rhs_ref{1}, rhs2_ref{2};
+    for (int s = 0; s < sz.nscalars; ++s) {
+        u0_ref = reg.allocate_scalar(0, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        rhs_ref = reg.allocate_scalar(1, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        rhs2_ref = reg.allocate_scalar(2, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+    }
+    multi.initialize(reg, u0_ref, step);
+    multi.update_boundary(reg, u0_ref, time);
+    multi.rhs(reg, u0_ref, reg, rhs_ref, time);
+
+    std::vector<scalar_view> u;
+    std::vector<scalar_span> du;
+    for (int s = 0; s < sz.nscalars; ++s) {
+        u.push_back(extract_scalar_view(reg, u0_ref, scalar_handle{4 * s}));
+        du.push_back(extract_scalar_span(reg, rhs2_ref, scalar_handle{4 * s}));
+    }
+    multi.fill_source(time);
+    multi.build_rhs_graph(u, du);
+    multi.submit_rhs_graph();
+
+    const real diffusivity[] = {0.1, 0.5, 2.0};
+    for (int s = 0; s < sz.nscalars; ++s) {
+        INFO("scalar " << s);
+        lua.script("simulation.system.diffusivity = " + std::to_string(diffusivity[s]));
+        auto single_opt = systems::heat::from_lua(lua["simulation"]);
+        REQUIRE(!!single_opt);
+        auto& single = *single_opt;
+
+        sim_registry sreg;
+        auto su0 = sreg.allocate_scalar(0, 0, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        auto srhs = sreg.allocate_scalar(1, 0, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        single.initialize(sreg, su0, step);
+        single.update_boundary(sreg, su0, time);
+        single.rhs(sreg, su0, sreg, srhs, time);
+
+        auto exact = extract_scalar_view(sreg, srhs, scalar_handle{0});
+        auto eager = extract_scalar_view(reg, rhs_ref, scalar_handle{4 * s});
+        for (int i = 0; i < sz.d_size; ++i) {
+            REQUIRE(eager.D[i] == Catch::Approx(exact.D[i]));
+            REQUIRE(du[s].D[i] == Catch::Approx(exact.D[i]));
+        }
+        for (int i = 0; i < sz.rx_size; ++i) {
+            REQUIRE(eager.Rx[i] == Catch::Approx(exact.Rx[i]));
+            REQUIRE(du[s].Rx[i] == Catch::Approx(exact.Rx[i]));
+        }
+    }
+
+    // every scalar is initialized exactly; stats append their Linf errors
+    auto st = multi.stats(reg, u0_ref, u0_ref, step);
+    REQUIRE(st.stats.size() == 13u);
+    REQUIRE(multi.valid(st));
+
+    // CG needs a symmetric preconditioner, which ADI is not
+    lua.script("simulation.integrator = { krylov = { method = 'cg' } }");
+    REQUIRE(!systems::heat::from_lua(lua["simulation"]));
+    lua.script("simulation.system.preconditioner = 'jacobi'");
+    REQUIRE(!!systems::heat::from_lua(lua["simulation"]));
+    lua.script("simulation.system.preconditioner = 'ilu'");
+    REQUIRE(!systems::heat::from_lua(lua["simulation"]));
+}
@@ -53,11 +53,12 @@ hyperbolic_eigenvalues::from_lua(const sol::table& tbl, const logs& logger)
     auto bc_opt = bcs::from_lua(tbl, mesh_opt->extents(), logger);
     auto st_opt = stencil::from_lua(tbl, logger);
 
-    if (bc_opt && st_opt)
-        return hyperbolic_eigenvalues{
-            MOVE(*mesh_opt), MOVE(bc_opt->first), MOVE(bc_opt->second), *st_opt, logger};
-    else
-        return std::nullopt;
+    if (!(bc_opt && st_opt)) return std::nullopt;
+
+    auto he = hyperbolic_eigenvalues{
+        MOVE(*mesh_opt), MOVE(bc_opt->first), MOVE(bc_opt->second), *st_opt, logger};
+    he.spectral = spectral_options::from_lua(tbl, logger);
+    return he;
 }
 
 bool hyperbolic_eigenvalues::valid(const system_stats&) const { return true; }
@@ -79,6 +80,22 @@ system_stats hyperbolic_eigenvalues::stats(const sim_registry&, field_ref,
                                             field_ref,
                                             const step_controller&) const
 {
+    if (spectral) {
+        // only the x-derivative is analyzed, matching gradient::visit
+        std::vector<real> dy_d(m.size()), dy_rx(m.Rx().size()), dy_ry(m.Ry().size()),
+            dy_rz(m.Rz().size());
+        std::vector<real> dz_d(m.size()), dz_rx(m.Rx().size()), dz_ry(m.Ry().size()),
+            dz_rz(m.Rz().size());
+        scalar_span dy{dy_d, dy_rx, dy_ry, dy_rz};
+        scalar_span dz{dz_d, dz_rx, dz_ry, dz_rz};
+
+        auto est = spectral_estimator{m, grid_bcs, object_bcs, *spectral}(
+            [&](scalar_view u, scalar_span du) { grad(u)(du, dy, dz); },
+            spectral_target::smallest_real);
+
+        return system_stats{.stats = {-m.h(0) * est.min_real}};
+    }
+
     auto p = m.Rx() | std::views::transform([this](auto&& info) {
                  return object_bcs[info.shape_id] == bcs::Dirichlet;
              });
@@ -4,6 +4,7 @@
 #include "io/field_io.hpp"
 #include "io/logging.hpp"
 #include "operators/gradient.hpp"
+#include "operators/spectral_radius.hpp"
 #include "temporal/step_controller.hpp"
 #include "types.hpp"
 
@@ -20,6 +21,9 @@ class hyperbolic_eigenvalues
 
     gradient grad; // field operator
 
+    // when set, use the matrix-free Arnoldi estimate instead of dense geev
+    std::optional<spectral_options> spectral;
+
     logs logger;
 
 public:
@@ -69,3 +69,56 @@ TEST_CASE("hyperbolic_eigenvalues")
     auto st = sys.stats(reg, u0_ref, u0_ref, step);
     REQUIRE(st.stats[0] + 1.0 == Catch::Approx(1.0));
 }
+
+TEST_CASE("hyperbolic_eigenvalues - matrix-free matches dense")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(R"(
+        simulation = {
+            mesh = {
+                index_extents = {41},
+                domain_bounds = {1}
+            },
+            shapes = {
+                    {
+                        type = "yz_rect",
+                        psi = 0.3,
+                        normal = 1,
+                        boundary_condition = "dirichlet"
+                    },
+                    {
+                        type = "yz_rect",
+                        psi = 0.6,
+                        normal = -1,
+                        boundary_condition = "floating"
+                    }
+                },
+                scheme = {
+                    order = 1,
+                    type = "E2-poly",
+                    floating_alpha = {13/100, 7/50, 3/20, 4/25, 17/100, 9/50},
+                    dirichlet_alpha = {3/25, 13/100, 7/50}
+                },
+            system = {
+                type = "eigenvalues",
+            },
+        }
+    )");
+
+    step_controller step{};
+    sim_registry reg;
+    field_ref u0_ref{0};
+
+    auto dense_opt = system::from_lua(lua["simulation"], logs{});
+    REQUIRE(!!dense_opt);
+    auto dense = dense_opt->stats(reg, u0_ref, u0_ref, step);
+
+    // a Krylov space larger than the number of unknowns makes Arnoldi exact
+    lua.script("simulation.system.spectral = { krylov_dim = 64 }");
+    auto mf_opt = system::from_lua(lua["simulation"], logs{});
+    REQUIRE(!!mf_opt);
+    auto mf = mf_opt->stats(reg, u0_ref, u0_ref, step);
+
+    REQUIRE(mf.stats[0] + 1.0 == Catch::Approx(dense.stats[0] + 1.0));
+}
@@ -1,21 +1,30 @@
 #include "inviscid_vortex.hpp"
+#include "detail/scalar_system_utils.hpp"
+#include "fields/expr.hpp"
+#include "fields/selection_desc.hpp"
 
 #include "real3_operators.hpp"
 #include <cmath>
 #include <numbers>
-#include <spdlog/spdlog.h>
+
+#include <sol/sol.hpp>
+
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <fmt/ranges.h>
 
 #include <algorithm>
+#include <array>
 
 namespace ccs::systems
 {
 
+using detail::eval_at_locations;
+
 constexpr real g = 1.4;
 constexpr real g1 = 0.4;
 constexpr real twoPi = 2 * std::numbers::pi_v<real>;
 
-enum class vars { rho, rhoU, rhoV, rhoE, P };
-
 namespace solution
 {
 
@@ -115,42 +124,348 @@ struct rhoE {
 
 } // namespace solution
 
-bool inviscid_vortex::valid(const system_stats&) const { return false; }
+namespace
+{
+
+// conserved variables in equation order
+enum vars { v_rho, v_rhoU, v_rhoV, v_rhoW, v_rhoE, n_vars };
+
+// the buffer handles of each conserved variable
+constexpr std::array<scalar_handle, n_vars> var_handles{inviscid_vortex::rho_h,
+                                                        inviscid_vortex::rhoU_h.x(),
+                                                        inviscid_vortex::rhoU_h.y(),
+                                                        inviscid_vortex::rhoU_h.z(),
+                                                        inviscid_vortex::rhoE_h};
+
+// Negative Euler flux of equation Eq in direction dir, evaluated on demand at a
+// flat index of one buffer (D, Rx, Ry or Rz) of the conserved variables.
+template <int Eq>
+struct neg_flux {
+    const real* r;
+    const real* mx;
+    const real* my;
+    const real* mz;
+    const real* e;
+    int dir;
+
+    KOKKOS_INLINE_FUNCTION real operator[](integer i) const
+    {
+        const real m[3] = {mx[i], my[i], mz[i]};
+        if constexpr (Eq == v_rho) {
+            return -m[dir];
+        } else {
+            const real un = m[dir] / r[i];
+            const real p = g1 * (e[i] - 0.5 * (m[0] * m[0] + m[1] * m[1] + m[2] * m[2]) / r[i]);
+            if constexpr (Eq == v_rhoE)
+                return -(e[i] + p) * un;
+            else
+                return -(m[Eq - v_rhoU] * un + (Eq - v_rhoU == dir ? p : 0.0));
+        }
+    }
+};
+
+// Pointers to one buffer (0 = D, 1/2/3 = Rx/Ry/Rz) of every conserved variable
+const real* buffer(scalar_view v, int b)
+{
+    return b == 0 ? v.D.data() : b == 1 ? v.Rx.data() : b == 2 ? v.Ry.data() : v.Rz.data();
+}
+
+// du_Eq = -sum_d D_d F_d(U) for one equation
+template <int Eq>
+void flux_divergence(const std::array<const derivative*, 3>& d,
+                     const index_extents& ex,
+                     const std::array<scalar_view, n_vars>& u,
+                     scalar_span du)
+{
+    du = 0;
+    for (int dir = 0; dir < 3; ++dir) {
+        if (ex[dir] < 2) continue;
+        auto flux = [&u, dir](int b) {
+            return neg_flux<Eq>{buffer(u[v_rho], b),
+                                buffer(u[v_rhoU], b),
+                                buffer(u[v_rhoV], b),
+                                buffer(u[v_rhoW], b),
+                                buffer(u[v_rhoE], b),
+                                dir};
+        };
+        d[dir]->apply_flux(flux, du, plus_eq);
+    }
+}
+
+// Owning storage for one evaluated scalar
+struct scalar_buffers {
+    tracked_vector<real, subsystem::systems> d, rx, ry, rz;
+
+    explicit scalar_buffers(const mesh& m)
+        : d(m.size()), rx(m.Rx().size()), ry(m.Ry().size()), rz(m.Rz().size())
+    {
+    }
 
-real3 inviscid_vortex::summary(const system_stats&) const { return {}; }
+    scalar_span span() { return {d, rx, ry, rz}; }
+    scalar_view view() const { return {d, rx, ry, rz}; }
+};
 
-void inviscid_vortex::log(const system_stats&, const step_controller&)
+// exact solution of every conserved variable at all mesh locations
+std::array<scalar_buffers, n_vars>
+exact_solution(const mesh& m, const real2& c, real eps, real mach, real time)
 {
-    if (auto logger = spdlog::get("system"); logger) { logger->info("InvisicdVortex"); }
+    std::array<scalar_buffers, n_vars> s{scalar_buffers{m},
+                                         scalar_buffers{m},
+                                         scalar_buffers{m},
+                                         scalar_buffers{m},
+                                         scalar_buffers{m}};
+    auto at = [time](auto sol) { return [=](const real3& loc) { return sol(time, loc); }; };
+
+    eval_at_locations(m, at(solution::rho{c[0], c[1], eps, mach}), s[v_rho].span());
+    eval_at_locations(m, at(solution::rhoU{c[0], c[1], eps, mach}), s[v_rhoU].span());
+    eval_at_locations(m, at(solution::rhoV{c[0], c[1], eps, mach}), s[v_rhoV].span());
+    eval_at_locations(m, at(solution::rhoE{c[0], c[1], eps, mach}), s[v_rhoE].span());
+    // rhoW is identically zero
+    return s;
 }
 
-system_size inviscid_vortex::size() const { return {}; }
+} // namespace
+
+inviscid_vortex::inviscid_vortex(mesh&& m_,
+                                 bcs::Grid&& grid_bcs,
+                                 bcs::Object&& object_bcs,
+                                 stencil st,
+                                 real2 center,
+                                 real eps,
+                                 real mach,
+                                 real max_error,
+                                 const logs& build_logger)
+    : m{MOVE(m_)},
+      grid_bcs{MOVE(grid_bcs)},
+      object_bcs{MOVE(object_bcs)},
+      dx{0, this->m, st, this->grid_bcs, this->object_bcs, build_logger},
+      dy{1, this->m, st, this->grid_bcs, this->object_bcs, build_logger},
+      dz{2, this->m, st, this->grid_bcs, this->object_bcs, build_logger},
+      center{center},
+      eps{eps},
+      mach{mach},
+      max_error{max_error},
+      error_d(m.size()),
+      error_rx(m.Rx().size()),
+      error_ry(m.Ry().size()),
+      error_rz(m.Rz().size()),
+      logger{build_logger, "system", "system.csv"}
+{
+    logger.set_pattern("%v");
+    logger(spdlog::level::info,
+           "Timestamp,Time,Step,Linf,Min,Max,Domain_Linf,Domain_ic,Rx_Linf,Rx_ic,Ry_"
+           "Linf,Ry_ic,Rz_Linf,Rz_ic,rhoU_Linf,rhoV_Linf,rhoE_Linf,Wall_ms");
+    logger.set_pattern("%Y-%m-%d %H:%M:%S.%f,%v");
+}
 
-void inviscid_vortex::rhs(const sim_registry&, field_ref,
-                           sim_registry&, field_ref, real)
+//
+// Valid while the density error is bounded and the density stays positive
+//
+bool inviscid_vortex::valid(const system_stats& stats) const
 {
+    const auto& v = stats.stats[0];
+    return std::isfinite(v) && std::abs(v) <= max_error && stats.stats[1] > 0;
 }
 
-void inviscid_vortex::update_boundary(sim_registry&, field_ref, real) {}
+real3 inviscid_vortex::summary(const system_stats& stats) const
+{
+    return {stats.stats[0], stats.stats[1], stats.stats[2]};
+}
 
-real inviscid_vortex::timestep_size(const sim_registry&, field_ref,
-                                     const step_controller&) const
+void inviscid_vortex::log(const system_stats& stats, const step_controller& step)
 {
-    return 1.0;
+    logger(spdlog::level::info,
+           "{},{},{},{:.3f}",
+           (real)step,
+           (int)step,
+           fmt::join(stats.stats, ","),
+           stats.wall_time_s * 1000.0);
 }
 
-system_stats inviscid_vortex::stats(const sim_registry&, field_ref,
-                                     field_ref, const step_controller&) const
+system_size inviscid_vortex::size() const
 {
-    return {};
+    return {2, 1, m.size(), (integer)m.Rx().size(), (integer)m.Ry().size(), (integer)m.Rz().size()};
 }
 
-void inviscid_vortex::initialize(sim_registry&, field_ref, const step_controller&) {}
+std::optional<inviscid_vortex> inviscid_vortex::from_lua(const sol::table& tbl,
+                                                         const logs& logger)
+{
+    auto sys = tbl["system"];
+    real max_error = sys["max_error"].get_or(100.0);
+    real eps = sys["eps"].get_or(5.0);
+    real mach = sys["mach"].get_or(0.5);
+    real2 center{sys["center"][1].get_or(0.0), sys["center"][2].get_or(0.0)};
+
+    if (!(mach > 0)) {
+        logger(spdlog::level::err, "system.mach must be positive for inviscid vortex");
+        return std::nullopt;
+    }
+
+    auto mesh_opt = mesh::from_lua(tbl, logger);
+    if (!mesh_opt) return std::nullopt;
+
+    auto bc_opt = bcs::from_lua(tbl, mesh_opt->extents(), logger);
+    auto st_opt = stencil::from_lua(tbl, logger);
+
+    if (bc_opt && st_opt) {
+        if (std::ranges::any_of(bc_opt->second, [](auto bc) { return bc != bcs::Dirichlet; })) {
+            logger(spdlog::level::err,
+                   "inviscid vortex only supports dirichlet object boundaries");
+            return std::nullopt;
+        }
+        return inviscid_vortex{MOVE(*mesh_opt),
+                               MOVE(bc_opt->first),
+                               MOVE(bc_opt->second),
+                               *st_opt,
+                               center,
+                               eps,
+                               mach,
+                               max_error,
+                               logger};
+    }
+
+    return std::nullopt;
+}
+
+void inviscid_vortex::tune(matrix::autotuner& tuner)
+{
+    dx.tune(tuner);
+    dy.tune(tuner);
+    dz.tune(tuner);
+}
+
+void inviscid_vortex::rhs(const sim_registry& reg, field_ref input,
+                          sim_registry& out_reg, field_ref output, real /*time*/)
+{
+    Kokkos::Profiling::ScopedRegion region("inviscid_vortex::rhs");
+
+    std::array<scalar_view, n_vars> u;
+    std::array<scalar_span, n_vars> du;
+    for (int k = 0; k < n_vars; ++k) {
+        u[k] = extract_scalar_view(reg, input, var_handles[k]);
+        du[k] = extract_scalar_span(out_reg, output, var_handles[k]);
+    }
+
+    const std::array<const derivative*, 3> d{&dx, &dy, &dz};
+    const auto ex = m.extents();
+
+    flux_divergence<v_rho>(d, ex, u, du[v_rho]);
+    flux_divergence<v_rhoU>(d, ex, u, du[v_rhoU]);
+    flux_divergence<v_rhoV>(d, ex, u, du[v_rhoV]);
+    if (ex[2] > 1)
+        flux_divergence<v_rhoW>(d, ex, u, du[v_rhoW]);
+    else
+        du[v_rhoW] = 0;
+    flux_divergence<v_rhoE>(d, ex, u, du[v_rhoE]);
+
+    // Dirichlet locations are set by update_boundary
+    for (auto&& s : du) {
+        for_each_grid_bc_desc<bcs::Dirichlet>(grid_bcs, m.extents(), [&](auto desc) {
+            fill_selected(s.D.data(), desc, 0.0);
+        });
+        real* R[] = {s.Rx.data(), s.Ry.data(), s.Rz.data()};
+        for (int dir = 0; dir < 3; ++dir)
+            fill_selected(R[dir], m.dirichlet_object_desc(dir, object_bcs), 0.0);
+    }
+}
+
+void inviscid_vortex::update_boundary(sim_registry& reg, field_ref ref, real time)
+{
+    Kokkos::Profiling::ScopedRegion region("inviscid_vortex::update_boundary");
+
+    auto sol = exact_solution(m, center, eps, mach, time);
+
+    for (int k = 0; k < n_vars; ++k) {
+        const auto h = var_handles[k];
+
+        real* u_D = reg.data(ref, h.D());
+        for_each_grid_bc_desc<bcs::Dirichlet>(grid_bcs, m.extents(), [&](auto desc) {
+            assign_selected(u_D, desc, handle_expr{sol[k].d.data()});
+        });
+
+        auto R = h.R();
+        real* sol_R[] = {sol[k].rx.data(), sol[k].ry.data(), sol[k].rz.data()};
+        for (int dir = 0; dir < 3; ++dir) {
+            auto gd = m.dirichlet_object_desc(dir, object_bcs);
+            assign_selected(reg.data(ref, R[dir]), gd, handle_expr{sol_R[dir]});
+        }
+    }
+}
+
+real inviscid_vortex::timestep_size(const sim_registry& reg, field_ref ref,
+                                    const step_controller& step) const
+{
+    // dt = cfl / max_i sum_d (|u_d| + c) / h_d over the fluid points
+    const auto fd = m.fluid_desc();
+    const real* r = reg.data(ref, rho_h.D());
+    const real* mx = reg.data(ref, rhoU_h.Dx());
+    const real* my = reg.data(ref, rhoU_h.Dy());
+    const real* mz = reg.data(ref, rhoU_h.Dz());
+    const real* e = reg.data(ref, rhoE_h.D());
+    const auto h = m.h();
+    const real ihx = 1 / h[0], ihy = 1 / h[1], ihz = 1 / h[2];
+
+    real rate = 0;
+    fd.visit([&](auto fluid) {
+        Kokkos::parallel_reduce(
+            index_policy<integer>(exec_space(), 0, fluid.count()),
+            KOKKOS_LAMBDA(integer k, real& mx_rate) {
+                const integer i = fluid.element(k);
+                const real u = mx[i] / r[i], v = my[i] / r[i], w = mz[i] / r[i];
+                const real p = g1 * (e[i] - 0.5 * r[i] * (u * u + v * v + w * w));
+                const real c = Kokkos::sqrt(g * p / r[i]);
+                const real s = (Kokkos::abs(u) + c) * ihx + (Kokkos::abs(v) + c) * ihy +
+                               (Kokkos::abs(w) + c) * ihz;
+                if (s > mx_rate) mx_rate = s;
+            },
+            Kokkos::Max<real>(rate));
+    });
+
+    return rate > 0 ? step.hyperbolic_cfl() / rate : step.hyperbolic_cfl() * std::ranges::min(h);
+}
+
+system_stats inviscid_vortex::stats(const sim_registry& reg, field_ref /*u0*/,
+                                    field_ref u1, const step_controller& c) const
+{
+    Kokkos::Profiling::ScopedRegion region("inviscid_vortex::stats");
+
+    auto sol = exact_solution(m, center, eps, mach, c);
+
+    // full statistics for density, Linf errors for the remaining variables
+    auto st = detail::compute_scalar_stats(
+        m, object_bcs, extract_scalar_view(reg, u1, rho_h), sol[v_rho].view());
+    for (int k : {v_rhoU, v_rhoV, v_rhoE}) {
+        auto sk = detail::compute_scalar_stats(
+            m, object_bcs, extract_scalar_view(reg, u1, var_handles[k]), sol[k].view());
+        st.stats.push_back(sk.stats[0]);
+    }
+    return st;
+}
+
+void inviscid_vortex::initialize(sim_registry& reg, field_ref ref, const step_controller& c)
+{
+    auto sol = exact_solution(m, center, eps, mach, c);
+
+    for (int k = 0; k < n_vars; ++k)
+        detail::initialize_scalar_field(
+            m, extract_scalar_span(reg, ref, var_handles[k]), sol[k].span());
+}
 
-bool inviscid_vortex::write(field_io&, const sim_registry&, field_ref,
-                             const step_controller&, real)
+bool inviscid_vortex::write(field_io& io, const sim_registry& reg, field_ref ref,
+                            const step_controller& c, real dt)
 {
-    return false;
+    auto sol = exact_solution(m, center, eps, mach, c);
+    auto rho = extract_scalar_view(reg, ref, rho_h);
+
+    scalar_span error{error_d, error_rx, error_ry, error_rz};
+    detail::compute_scalar_error(m, object_bcs, grid_bcs, rho, sol[v_rho].view(), error);
+
+    std::vector<scalar_view> io_scalars{rho,
+                                        extract_scalar_view(reg, ref, rhoU_h.x()),
+                                        extract_scalar_view(reg, ref, rhoU_h.y()),
+                                        extract_scalar_view(reg, ref, rhoE_h),
+                                        scalar_view{error_d, error_rx, error_ry, error_rz}};
+    return io.write(io_names, io_scalars, c, dt, m.R());
 }
 
 } // namespace ccs::systems
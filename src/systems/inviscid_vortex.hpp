@@ -2,18 +2,65 @@
 
 #include "fields/field_registry.hpp"
 #include "io/field_io.hpp"
+#include "memory.hpp"
+#include "operators/derivative.hpp"
 #include "temporal/step_controller.hpp"
 #include "types.hpp"
 
+#include <optional>
+#include <sol/forward.hpp>
+
 namespace ccs::systems
 {
 
-// the system of pdes to solve is in this class
+//
+// Compressible Euler equations advecting an isentropic vortex.  The conserved
+// variables are stored structure-of-arrays in the registry:
+//
+//   scalar 0: rho      scalar 1: rhoE      vector 0: rhoU = (rhoU, rhoV, rhoW)
+//
+// The rhs is the flux divergence -sum_d D_d F_d(U).  Fluxes are evaluated by an
+// accessor as each derivative stencil reads a point, so no flux field is stored.
+//
 class inviscid_vortex
 {
+    mesh m;
+    bcs::Grid grid_bcs;
+    bcs::Object object_bcs;
+
+    derivative dx;
+    derivative dy;
+    derivative dz;
+
+    // vortex center, strength and reference mach number
+    real2 center;
+    real eps;
+    real mach;
+
+    real max_error;
+
+    tracked_vector<real, subsystem::systems> error_d, error_rx, error_ry, error_rz;
+
+    logs logger;
+    std::vector<std::string> io_names = {"rho", "rhoU", "rhoV", "rhoE", "Error"};
+
 public:
+    static constexpr auto rho_h = scalar_handle{0};
+    static constexpr auto rhoE_h = scalar_handle{sim_registry::layout_type::scalar_stride};
+    static constexpr auto rhoU_h = vector_handle{sim_registry::layout_type::vector_base};
+
     inviscid_vortex() = default;
 
+    inviscid_vortex(mesh&&,
+                    bcs::Grid&&,
+                    bcs::Object&&,
+                    stencil,
+                    real2 center,
+                    real eps,
+                    real mach,
+                    real max_error = 100.0,
+                    const logs& = {});
+
     bool valid(const system_stats&) const;
 
     void log(const system_stats&, const step_controller&);
@@ -22,8 +69,16 @@ public:
 
     system_size size() const;
 
+    static std::optional<inviscid_vortex> from_lua(const sol::table&, const logs& = {});
+
+    // full-mesh fields held outside the registry: the error and the five
+    // conserved variables evaluated for it
+    static constexpr int fields() { return 6; }
+
     void rhs(const sim_registry& reg, field_ref input,
              sim_registry& out_reg, field_ref output, real time);
+    // launch shapes of the derivative matrices
+    void tune(matrix::autotuner&);
     void update_boundary(sim_registry& reg, field_ref ref, real time);
     real timestep_size(const sim_registry& reg, field_ref ref,
                        const step_controller&) const;
@@ -0,0 +1,166 @@
+#include "system.hpp"
+#include "inviscid_vortex.hpp"
+
+#include "fields/field_registry.hpp"
+
+#include <Kokkos_Core.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <fmt/format.h>
+#include <sol/sol.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace ccs;
+using systems::inviscid_vortex;
+
+// Custom main: Kokkos must be initialized before any test allocates Views.
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+namespace
+{
+// All five conserved variables, in equation order
+constexpr std::array<scalar_handle, 5> handles{inviscid_vortex::rho_h,
+                                               inviscid_vortex::rhoU_h.x(),
+                                               inviscid_vortex::rhoU_h.y(),
+                                               inviscid_vortex::rhoU_h.z(),
+                                               inviscid_vortex::rhoE_h};
+
+// Allocate the scalars and vectors of the system in the given slots.
+field_ref allocate_slot(sim_registry& reg, ccs::system& sys, int slot)
+{
+    auto sz = sys.size();
+    field_ref ref{slot};
+    for (int s = 0; s < sz.nscalars; ++s)
+        ref = reg.allocate_scalar(slot, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+    for (int v = 0; v < sz.nvectors; ++v)
+        ref = reg.allocate_vector(slot, v, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+    return ref;
+}
+
+std::optional<ccs::system> build(sol::state& lua, int n)
+{
+    lua.script(fmt::format(R"(
+        simulation = {{
+            mesh = {{
+                index_extents = {{{0}, {0}}},
+                domain_bounds = {{
+                    min = {{-5, -5}},
+                    max = {{5, 5}}
+                }}
+            }},
+            domain_boundaries = {{
+                xmin = "dirichlet",
+                xmax = "dirichlet",
+                ymin = "dirichlet",
+                ymax = "dirichlet"
+            }},
+            scheme = {{
+                order = 1,
+                type = "E2",
+                alpha = {{-1.47956280234494, 0.261900367793859, -0.145072532538541, -0.224665713988644}}
+            }},
+            system = {{
+                type = "inviscid vortex"
+            }}
+        }}
+    )",
+                           n));
+    return system::from_lua(lua["simulation"]);
+}
+
+// Max error of the rhs against the exact dU/dt over interior domain points.  The
+// exact time derivative is a central difference of the exact solution.
+real rhs_error(int n)
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    auto sys_opt = build(lua, n);
+    REQUIRE(!!sys_opt);
+    auto& sys = *sys_opt;
+
+    sim_registry reg;
+    auto um = allocate_slot(reg, sys, 0);
+    auto u = allocate_slot(reg, sys, 1);
+    auto up = allocate_slot(reg, sys, 2);
+    auto du = allocate_slot(reg, sys, 3);
+
+    constexpr real delta = 1e-5;
+    step_controller step{};
+    sys.initialize(reg, um, step);
+    step.advance(delta);
+    sys.initialize(reg, u, step);
+    step.advance(delta);
+    sys.initialize(reg, up, step);
+
+    sys.rhs(reg, u, reg, du, delta);
+
+    real err = 0;
+    for (auto h : handles) {
+        const real* a = reg.data(um, h.D());
+        const real* b = reg.data(up, h.D());
+        const real* r = reg.data(du, h.D());
+        for (int i = 1; i < n - 1; ++i)
+            for (int j = 1; j < n - 1; ++j) {
+                const int k = i * n + j;
+                err = std::max(err, std::abs(r[k] - (b[k] - a[k]) / (2 * delta)));
+            }
+    }
+    return err;
+}
+} // namespace
+
+TEST_CASE("inviscid_vortex - initialize")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    auto sys_opt = build(lua, 21);
+    REQUIRE(!!sys_opt);
+    auto& sys = *sys_opt;
+
+    auto sz = sys.size();
+    REQUIRE(sz.nscalars == 2);
+    REQUIRE(sz.nvectors == 1);
+
+    sim_registry reg;
+    auto u0 = allocate_slot(reg, sys, 0);
+    // max_step, max_time, hyperbolic cfl, parabolic cfl, min_dt
+    step_controller step{10, 1.0, 0.5, 0.5, 0.0};
+    sys.initialize(reg, u0, step);
+
+    auto st = sys.stats(reg, u0, u0, step);
+    REQUIRE(st.stats.size() == 14u);
+    REQUIRE_THAT(st.stats[0], Catch::Matchers::WithinAbs(0.0, 1e-13));
+    for (int k = 11; k < 14; ++k)
+        REQUIRE_THAT(st.stats[k], Catch::Matchers::WithinAbs(0.0, 1e-13));
+
+    // density is positive with a minimum at the vortex core
+    REQUIRE(st.stats[1] > 0);
+    REQUIRE(st.stats[1] < 1);
+    REQUIRE(sys.valid(st));
+
+    // 2D: rhoW is identically zero
+    const real* w = reg.data(u0, inviscid_vortex::rhoU_h.Dz());
+    REQUIRE(std::all_of(w, w + sz.d_size, [](real v) { return v == 0; }));
+
+    auto dt = sys.timestep_size(reg, u0, step);
+    REQUIRE(std::isfinite(dt));
+    REQUIRE(dt > 0);
+}
+
+TEST_CASE("inviscid_vortex - rhs convergence")
+{
+    const real e1 = rhs_error(41);
+    const real e2 = rhs_error(81);
+
+    REQUIRE(std::isfinite(e1));
+    REQUIRE(e2 < e1);
+    REQUIRE(e1 / e2 > 3);
+}
@@ -58,9 +58,6 @@ scalar_wave::scalar_wave(mesh&& m_,
       gG_xd(m.size()), gG_xrx(m.Rx().size()), gG_xry(m.Ry().size()), gG_xrz(m.Rz().size()),
       gG_yd(m.size()), gG_yrx(m.Rx().size()), gG_yry(m.Ry().size()), gG_yrz(m.Rz().size()),
       gG_zd(m.size()), gG_zrx(m.Rx().size()), gG_zry(m.Ry().size()), gG_zrz(m.Rz().size()),
-      du_xd(m.size()), du_xrx(m.Rx().size()), du_xry(m.Ry().size()), du_xrz(m.Rz().size()),
-      du_yd(m.size()), du_yrx(m.Rx().size()), du_yry(m.Ry().size()), du_yrz(m.Rz().size()),
-      du_zd(m.size()), du_zrx(m.Rx().size()), du_zry(m.Ry().size()), du_zrz(m.Rz().size()),
       error_d(m.size()), error_rx(m.Rx().size()),
       error_ry(m.Ry().size()), error_rz(m.Rz().size()),
       max_error{max_error},
@@ -133,6 +130,22 @@ system_size scalar_wave::size() const
 
 std::optional<scalar_wave> scalar_wave::from_lua(const sol::table& tbl,
                                                  const logs& logger)
+{
+    auto mesh_opt = mesh::from_lua(tbl, logger);
+    if (!mesh_opt) return std::nullopt;
+
+    auto bc_opt = bcs::from_lua(tbl, mesh_opt->extents(), logger);
+    if (!bc_opt) return std::nullopt;
+
+    return from_lua(
+        tbl, MOVE(*mesh_opt), MOVE(bc_opt->first), MOVE(bc_opt->second), logger);
+}
+
+std::optional<scalar_wave> scalar_wave::from_lua(const sol::table& tbl,
+                                                 mesh&& m,
+                                                 bcs::Grid&& grid_bcs,
+                                                 bcs::Object&& object_bcs,
+                                                 const logs& logger)
 {
     real max_error = tbl["system"]["max_error"].get_or(100.0);
     // assume we can only get here if simulation.system.type == "scalar_wave" so check
@@ -171,27 +184,49 @@ std::optional<scalar_wave> scalar_wave::from_lua(const sol::table& tbl,
         return std::nullopt;
     }
 
-    auto mesh_opt = mesh::from_lua(tbl, logger);
-    if (!mesh_opt) return std::nullopt;
-
-    auto bc_opt = bcs::from_lua(tbl, mesh_opt->extents(), logger);
     auto st_opt = stencil::from_lua(tbl, logger);
 
-    if (bc_opt && st_opt) {
-
-        return scalar_wave{MOVE(*mesh_opt),
-                           MOVE(bc_opt->first),
-                           MOVE(bc_opt->second),
-                           *st_opt,
-                           center,
-                           radius,
-                           max_error,
-                           logger};
+    if (st_opt) {
+
+        auto sw = scalar_wave{MOVE(m),
+                              MOVE(grid_bcs),
+                              MOVE(object_bcs),
+                              *st_opt,
+                              center,
+                              radius,
+                              max_error,
+                              logger};
+
+        if (auto sp_opt = spectral_options::from_lua(tbl, logger); sp_opt) {
+            auto est = sw.estimate_spectral_radius(*sp_opt);
+            logger(spdlog::level::info,
+                   "scalar_wave spectral radius {} after {} applications (converged: {})",
+                   est.radius,
+                   est.applications,
+                   est.converged);
+        }
+        return sw;
     }
 
     return std::nullopt;
 }
 
+spectral_estimate scalar_wave::estimate_spectral_radius(const spectral_options& opts)
+{
+    scalar_view gGx{gG_xd, gG_xrx, gG_xry, gG_xrz};
+    scalar_view gGy{gG_yd, gG_yrx, gG_yry, gG_yrz};
+    scalar_view gGz{gG_zd, gG_zrx, gG_zry, gG_zrz};
+
+    // linearized rhs: du = gG . grad(u)
+    auto apply = [&](scalar_view u, scalar_span du) {
+        grad.fused_dot(u, gGx, gGy, gGz)(du);
+    };
+
+    auto est = spectral_estimator{m, grid_bcs, object_bcs, opts}(apply);
+    if (est.radius > 0) spectral_rho = est.radius;
+    return est;
+}
+
 void scalar_wave::rhs(const sim_registry& reg, field_ref input,
                       sim_registry& out_reg, field_ref output, real /*time*/)
 {
@@ -199,13 +234,6 @@ void scalar_wave::rhs(const sim_registry& reg, field_ref input,
     constexpr auto sh = scalar_handle{0};
     auto u = extract_scalar_view(reg, input, sh);
 
-    scalar_span dux{du_xd, du_xrx, du_xry, du_xrz};
-    scalar_span duy{du_yd, du_yrx, du_yry, du_yrz};
-    scalar_span duz{du_zd, du_zrx, du_zry, du_zrz};
-
-    grad(u)(dux, duy, duz);
-
-    // u_rhs = dot(grad_G, du) = gG_x * du_x + gG_y * du_y + gG_z * du_z
     auto sp = [&](buf_handle bh) -> std::span<real> {
         return {out_reg.data(output, bh),
                 static_cast<std::size_t>(out_reg.size(output, bh))};
@@ -216,114 +244,37 @@ void scalar_wave::rhs(const sim_registry& reg, field_ref input,
     scalar_view gGy{gG_yd, gG_yrx, gG_yry, gG_yrz};
     scalar_view gGz{gG_zd, gG_zrx, gG_zry, gG_zrz};
 
-    auto dot_spans = [](std::span<real> out,
-                        std::span<const real> gx, std::span<const real> dx,
-                        std::span<const real> gy, std::span<const real> dy,
-                        std::span<const real> gz, std::span<const real> dz) {
-        auto* o = out.data();
-        const auto* gxp = gx.data(); const auto* dxp = dx.data();
-        const auto* gyp = gy.data(); const auto* dyp = dy.data();
-        const auto* gzp = gz.data(); const auto* dzp = dz.data();
-        Kokkos::parallel_for(
-            Kokkos::RangePolicy<execution_space>(0, (int)out.size()),
-            [=](int i) {
-                o[i] = gxp[i] * dxp[i] + gyp[i] * dyp[i] + gzp[i] * dzp[i];
-            });
-        Kokkos::fence();
-    };
-
-    dot_spans(u_rhs.D,  gGx.D,  dux.D,  gGy.D,  duy.D,  gGz.D,  duz.D);
-    dot_spans(u_rhs.Rx, gGx.Rx, dux.Rx, gGy.Rx, duy.Rx, gGz.Rx, duz.Rx);
-    dot_spans(u_rhs.Ry, gGx.Ry, dux.Ry, gGy.Ry, duy.Ry, gGz.Ry, duz.Ry);
-    dot_spans(u_rhs.Rz, gGx.Rz, dux.Rz, gGy.Rz, duy.Rz, gGz.Rz, duz.Rz);
+    // u_rhs = gG_x * du_x + gG_y * du_y + gG_z * du_z: one sweep of u writes the
+    // weighted interior rows, then each derivative accumulates its weighted
+    // closures directly into u_rhs
+    grad.fused_dot(u, gGx, gGy, gGz)(u_rhs);
 }
 
 void scalar_wave::build_rhs_graph(scalar_view u, scalar_span du)
 {
-    // Gradient scratch buffers (member data — stable pointers)
-    scalar_span dux{du_xd, du_xrx, du_xry, du_xrz};
-    scalar_span duy{du_yd, du_yrx, du_yry, du_yrz};
-    scalar_span duz{du_zd, du_zrx, du_zry, du_zrz};
-
     // Wave speed coefficients (member data — stable pointers)
-    const real* gx_d = gG_xd.data();
-    const real* gy_d = gG_yd.data();
-    const real* gz_d = gG_zd.data();
-    const real* gx_rx = gG_xrx.data();
-    const real* gy_rx = gG_yrx.data();
-    const real* gz_rx = gG_zrx.data();
-    const real* gx_ry = gG_xry.data();
-    const real* gy_ry = gG_yry.data();
-    const real* gz_ry = gG_zry.data();
-    const real* gx_rz = gG_xrz.data();
-    const real* gy_rz = gG_yrz.data();
-    const real* gz_rz = gG_zrz.data();
-
-    // Gradient scratch pointers
-    const real* dux_d = du_xd.data();
-    const real* duy_d = du_yd.data();
-    const real* duz_d = du_zd.data();
-    const real* dux_rx = du_xrx.data();
-    const real* duy_rx = du_yrx.data();
-    const real* duz_rx = du_zrx.data();
-    const real* dux_ry = du_xry.data();
-    const real* duy_ry = du_yry.data();
-    const real* duz_ry = du_zry.data();
-    const real* dux_rz = du_xrz.data();
-    const real* duy_rz = du_yrz.data();
-    const real* duz_rz = du_zrz.data();
-
-    // Output pointers and sizes
-    real* d_ptr = du.D.data();
-    real* rx_ptr = du.Rx.data();
-    real* ry_ptr = du.Ry.data();
-    real* rz_ptr = du.Rz.data();
-    const int n_d = static_cast<int>(du.D.size());
-    const int n_rx = static_cast<int>(du.Rx.size());
-    const int n_ry = static_cast<int>(du.Ry.size());
-    const int n_rz = static_cast<int>(du.Rz.size());
-
-    rhs_graph_ = Kokkos::Experimental::create_graph<execution_space>(
+    scalar_view gGx{gG_xd, gG_xrx, gG_xry, gG_xrz};
+    scalar_view gGy{gG_yd, gG_yrx, gG_yry, gG_yrz};
+    scalar_view gGz{gG_zd, gG_zrx, gG_zry, gG_zrz};
+
+    rhs_graph_ = Kokkos::Experimental::create_graph(exec_space(),
         [&](auto root) {
-            using rp_t = Kokkos::RangePolicy<execution_space>;
-
-            // 1. Gradient: zeros scratch, then dx/dy/dz in parallel
-            auto grad_done = grad.add_graph_nodes(root, u, dux, duy, duz);
-
-            // 2. Dot product: du[i] = gGx[i]*dux[i] + gGy[i]*duy[i] + gGz[i]*duz[i]
-            grad_done.then_parallel_for(
-                "sw_dot_D", rp_t(0, n_d),
-                KOKKOS_LAMBDA(int i) {
-                    d_ptr[i] = gx_d[i] * dux_d[i] + gy_d[i] * duy_d[i] +
-                               gz_d[i] * duz_d[i];
-                });
-            grad_done.then_parallel_for(
-                "sw_dot_Rx", rp_t(0, n_rx),
-                KOKKOS_LAMBDA(int i) {
-                    rx_ptr[i] = gx_rx[i] * dux_rx[i] + gy_rx[i] * duy_rx[i] +
-                                gz_rx[i] * duz_rx[i];
-                });
-            grad_done.then_parallel_for(
-                "sw_dot_Ry", rp_t(0, n_ry),
-                KOKKOS_LAMBDA(int i) {
-                    ry_ptr[i] = gx_ry[i] * dux_ry[i] + gy_ry[i] * duy_ry[i] +
-                                gz_ry[i] * duz_ry[i];
-                });
-            grad_done.then_parallel_for(
-                "sw_dot_Rz", rp_t(0, n_rz),
-                KOKKOS_LAMBDA(int i) {
-                    rz_ptr[i] = gx_rz[i] * dux_rz[i] + gy_rz[i] * duy_rz[i] +
-                                gz_rz[i] * duz_rz[i];
-                });
+            // weighted sweep of u into du, then the weighted closures of
+            // dx -> dy -> dz accumulate into du
+            grad.add_fused_dot_graph_nodes(root, u, gGx, gGy, gGz, du);
         });
 
     rhs_graph_->instantiate();
+    rhs_graph_work_ = grad.fused_dot_cost();
 }
 
+void scalar_wave::tune(matrix::autotuner& tuner) { grad.tune(tuner); }
+
 void scalar_wave::submit_rhs_graph()
 {
+    report_work(rhs_graph_work_);
     rhs_graph_->submit();
-    Kokkos::fence("scalar_wave::submit_rhs_graph() complete");
+    exec_space().fence("scalar_wave::submit_rhs_graph() complete");
 }
 
 void scalar_wave::update_boundary(sim_registry& reg, field_ref ref, real time)
@@ -332,10 +283,10 @@ void scalar_wave::update_boundary(sim_registry& reg, field_ref ref, real time)
     constexpr auto sh = scalar_handle{0};
 
     // Evaluate solution at all mesh locations
-    std::vector<real> sol_d(m.size());
-    std::vector<real> sol_rx(m.Rx().size());
-    std::vector<real> sol_ry(m.Ry().size());
-    std::vector<real> sol_rz(m.Rz().size());
+    buffer sol_d(m.size());
+    buffer sol_rx(m.Rx().size());
+    buffer sol_ry(m.Ry().size());
+    buffer sol_rz(m.Rz().size());
     scalar_span sol{sol_d, sol_rx, sol_ry, sol_rz};
     eval_at_locations(m, solution_at(center, radius, time), sol);
 
@@ -357,6 +308,9 @@ void scalar_wave::update_boundary(sim_registry& reg, field_ref ref, real time)
 real scalar_wave::timestep_size(const sim_registry&, field_ref,
                                 const step_controller& step) const
 {
+    // the uniform-grid bound h is 1 / rho for unit speed 1D E2, so cfl keeps its meaning
+    if (spectral_rho) return step.hyperbolic_cfl() / *spectral_rho;
+
     const auto h_min = std::ranges::min(m.h());
     return step.hyperbolic_cfl() * h_min;
 }
@@ -369,10 +323,10 @@ system_stats scalar_wave::stats(const sim_registry& reg, field_ref /*u0*/,
     auto u = extract_scalar_view(reg, u1, sh);
 
     // Evaluate solution at all mesh locations
-    std::vector<real> sol_d(m.size());
-    std::vector<real> sol_rx(m.Rx().size());
-    std::vector<real> sol_ry(m.Ry().size());
-    std::vector<real> sol_rz(m.Rz().size());
+    buffer sol_d(m.size());
+    buffer sol_rx(m.Rx().size());
+    buffer sol_ry(m.Ry().size());
+    buffer sol_rz(m.Rz().size());
     scalar_span sol{sol_d, sol_rx, sol_ry, sol_rz};
     eval_at_locations(m, solution_at(center, radius, c), sol);
 
@@ -386,10 +340,10 @@ void scalar_wave::initialize(sim_registry& reg, field_ref ref, const step_contro
     auto u = extract_scalar_span(reg, ref, sh);
 
     // Evaluate solution at all mesh locations
-    std::vector<real> sol_d(m.size());
-    std::vector<real> sol_rx(m.Rx().size());
-    std::vector<real> sol_ry(m.Ry().size());
-    std::vector<real> sol_rz(m.Rz().size());
+    buffer sol_d(m.size());
+    buffer sol_rx(m.Rx().size());
+    buffer sol_ry(m.Ry().size());
+    buffer sol_rz(m.Rz().size());
     scalar_span sol{sol_d, sol_rx, sol_ry, sol_rz};
     eval_at_locations(m, solution_at(center, radius, c), sol);
 
@@ -403,10 +357,10 @@ bool scalar_wave::write(field_io& io, const sim_registry& reg, field_ref ref,
     auto u = extract_scalar_view(reg, ref, sh);
 
     // Evaluate solution at all mesh locations
-    std::vector<real> sol_d(m.size());
-    std::vector<real> sol_rx(m.Rx().size());
-    std::vector<real> sol_ry(m.Ry().size());
-    std::vector<real> sol_rz(m.Rz().size());
+    buffer sol_d(m.size());
+    buffer sol_rx(m.Rx().size());
+    buffer sol_ry(m.Ry().size());
+    buffer sol_rz(m.Rz().size());
     scalar_span sol{sol_d, sol_rx, sol_ry, sol_rz};
     eval_at_locations(m, solution_at(center, radius, (real)c), sol);
 
@@ -2,7 +2,9 @@
 
 #include "fields/field_registry.hpp"
 #include "io/field_io.hpp"
+#include "memory.hpp"
 #include "operators/gradient.hpp"
+#include "operators/spectral_radius.hpp"
 #include "temporal/step_controller.hpp"
 #include "types.hpp"
 
@@ -16,6 +18,8 @@ namespace ccs::systems
 // the system of pdes to solve is in this class
 class scalar_wave
 {
+    using buffer = tracked_vector<real, subsystem::systems>;
+
     mesh m;
     bcs::Grid grid_bcs;
     bcs::Object object_bcs;
@@ -25,24 +29,25 @@ class scalar_wave
     real3 center; // center of the circular wave
     real radius;
 
-    // Wave speed coefficients (3 spatial components x {D, Rx, Ry, Rz})
-    std::vector<real> gG_xd, gG_xrx, gG_xry, gG_xrz;
-    std::vector<real> gG_yd, gG_yrx, gG_yry, gG_yrz;
-    std::vector<real> gG_zd, gG_zrx, gG_zry, gG_zrz;
-    // Gradient scratch (3 spatial components x {D, Rx, Ry, Rz})
-    std::vector<real> du_xd, du_xrx, du_xry, du_xrz;
-    std::vector<real> du_yd, du_yrx, du_yry, du_yrz;
-    std::vector<real> du_zd, du_zrx, du_zry, du_zrz;
+    // Wave speed coefficients (3 spatial components x {D, Rx, Ry, Rz}).  The rhs
+    // folds these into the derivative application so no gradient is stored.
+    buffer gG_xd, gG_xrx, gG_xry, gG_xrz;
+    buffer gG_yd, gG_yrx, gG_yry, gG_yrz;
+    buffer gG_zd, gG_zrx, gG_zry, gG_zrz;
 
-    std::vector<real> error_d, error_rx, error_ry, error_rz;
+    buffer error_d, error_rx, error_ry, error_rz;
 
     real max_error;
 
+    // spectral radius of the rhs operator, when a matrix-free estimate was requested
+    std::optional<real> spectral_rho;
+
     logs logger;
     std::vector<std::string> io_names = {"U", "Error"};
 
     // Pre-built graph for submit_rhs_graph().
     std::optional<Kokkos::Experimental::Graph<execution_space>> rhs_graph_;
+    work rhs_graph_work_{};
 
 public:
     scalar_wave() = default;
@@ -66,8 +71,26 @@ public:
 
     static std::optional<scalar_wave> from_lua(const sol::table&, const logs& = {});
 
+    // full-mesh fields held outside the registry: the three gG factors and the
+    // error, plus the solution scratch of update_boundary and stats
+    static constexpr int fields() { return 5; }
+
+    // As above on a mesh and boundary conditions that were already built, so that
+    // repeated runs on one geometry only rebuild the operators
+    static std::optional<scalar_wave> from_lua(const sol::table&,
+                                               mesh&&,
+                                               bcs::Grid&&,
+                                               bcs::Object&&,
+                                               const logs& = {});
+
+    // Estimate the spectral radius of the rhs operator so that timestep_size
+    // returns hyperbolic_cfl / rho instead of the uniform-grid bound.
+    spectral_estimate estimate_spectral_radius(const spectral_options&);
+
     void rhs(const sim_registry& reg, field_ref input,
              sim_registry& out_reg, field_ref output, real time);
+    // launch shapes of the gradient's matrices; before build_rhs_graph
+    void tune(matrix::autotuner&);
     void build_rhs_graph(scalar_view u, scalar_span du);
     void submit_rhs_graph();
     void update_boundary(sim_registry& reg, field_ref ref, real time);
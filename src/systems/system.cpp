@@ -3,6 +3,9 @@
 #include <sol/sol.hpp>
 #include <spdlog/spdlog.h>
 
+#include <span>
+#include <vector>
+
 namespace ccs
 {
 
@@ -11,6 +14,18 @@ bool system::valid(const system_stats& stats) const
     return std::visit([&stats](auto&& sys) { return sys.valid(stats); }, v);
 }
 
+int system::retire(const system_stats& stats)
+{
+    return std::visit(
+        [&stats](auto&& s) {
+            if constexpr (requires { s.retire(stats); })
+                return s.retire(stats);
+            else
+                return 0;
+        },
+        v);
+}
+
 void system::log(const system_stats& stats, const step_controller& controller)
 {
     return std::visit(
@@ -30,6 +45,18 @@ system_size system::size() const
     return std::visit([](auto&& current_system) { return current_system.size(); }, v);
 }
 
+sim_registry::first_touch system::first_touch() const
+{
+    return std::visit(
+        [](auto&& s) -> sim_registry::first_touch {
+            if constexpr (requires { s.first_touch(); })
+                return s.first_touch();
+            else
+                return {};
+        },
+        v);
+}
+
 // Registry-based dispatch methods
 
 void system::rhs(const sim_registry& creg, field_ref input,
@@ -38,11 +65,31 @@ void system::rhs(const sim_registry& creg, field_ref input,
     std::visit([&](auto&& s) { s.rhs(creg, input, reg, output, time); }, v);
 }
 
+void system::tune(matrix::autotuner& tuner)
+{
+    std::visit([&](auto&& s) {
+        if constexpr (requires { s.tune(tuner); }) s.tune(tuner);
+    }, v);
+}
+
 void system::build_rhs_graph(const sim_registry& creg, field_ref input,
                              sim_registry& reg, field_ref output)
 {
     std::visit([&](auto&& s) {
         if constexpr (requires {
+            s.build_rhs_graph(std::declval<std::span<const scalar_view>>(),
+                              std::declval<std::span<const scalar_span>>());
+        }) {
+            // multi-scalar systems capture every scalar of the slot
+            std::vector<scalar_view> u;
+            std::vector<scalar_span> du;
+            for (int i = 0; i < s.size().nscalars; ++i) {
+                const scalar_handle sh{i * sim_registry::layout_type::scalar_stride};
+                u.push_back(extract_scalar_view(creg, input, sh));
+                du.push_back(extract_scalar_span(reg, output, sh));
+            }
+            s.build_rhs_graph(u, du);
+        } else if constexpr (requires {
             s.build_rhs_graph(std::declval<scalar_view>(),
                               std::declval<scalar_span>());
         }) {
@@ -73,6 +120,32 @@ void system::update_boundary(sim_registry& reg, field_ref ref, real time)
     std::visit([&](auto&& s) { s.update_boundary(reg, ref, time); }, v);
 }
 
+bool system::has_implicit() const
+{
+    return std::visit(
+        [](auto&& s) {
+            using T = std::remove_cvref_t<decltype(s)>;
+            return requires(T& t, const sim_registry& creg, sim_registry& reg) {
+                t.implicit_update(creg, field_ref{}, reg, field_ref{}, real{}, krylov_options{});
+            };
+        },
+        v);
+}
+
+krylov_result system::implicit_update(const sim_registry& creg, field_ref b,
+                                      sim_registry& reg, field_ref u, real c,
+                                      const krylov_options& opts)
+{
+    return std::visit(
+        [&](auto&& s) -> krylov_result {
+            if constexpr (requires { s.implicit_update(creg, b, reg, u, c, opts); })
+                return s.implicit_update(creg, b, reg, u, c, opts);
+            else
+                return {0, 0, false};
+        },
+        v);
+}
+
 system_stats system::stats(const sim_registry& reg, field_ref u0,
                            field_ref u1, const step_controller& ctrl) const
 {
@@ -120,7 +193,8 @@ std::optional<system> system::from_lua(const sol::table& tbl, const logs& logger
             return system(MOVE(*opt));
     } else if (type == "inviscid vortex") {
         logger(spdlog::level::info, "building inviscid_vortex system");
-        return system(systems::inviscid_vortex{});
+        if (auto opt = systems::inviscid_vortex::from_lua(tbl, logger); opt)
+            return system(MOVE(*opt));
     } else if (type == "eigenvalues") {
         logger(spdlog::level::info, "building hyperbolic_eigenvalues system");
         if (auto opt = systems::hyperbolic_eigenvalues::from_lua(tbl, logger); opt)
@@ -41,20 +41,39 @@ public:
     // returns true if the system stats say so
     bool valid(const system_stats&) const;
 
+    // drop the scalars diverged in the stats from the rhs, returning how many were
+    // dropped.  Zero for systems that do not retire diverged scalars.
+    int retire(const system_stats&);
+
     real3 summary(const system_stats&) const;
 
     static std::optional<system> from_lua(const sol::table&, const logs& = {});
 
     system_size size() const;
 
+    // How the D buffers of the registry are zeroed when allocated, so that their
+    // pages are first touched by the threads of the system's operators.  Empty
+    // for systems that do not care.
+    sim_registry::first_touch first_touch() const;
+
     // Registry-based dispatch methods
     void rhs(const sim_registry& creg, field_ref input,
              sim_registry& reg, field_ref output, real time);
+    // Tune the launch shapes of the system's operators.  A no-op for systems
+    // without operators; call before build_rhs_graph.
+    void tune(matrix::autotuner&);
     void build_rhs_graph(const sim_registry& creg, field_ref input,
                          sim_registry& reg, field_ref output);
     void submit_rhs_graph(const sim_registry& creg, field_ref input,
                           sim_registry& reg, field_ref output, real time);
     void update_boundary(sim_registry& reg, field_ref ref, real time);
+    // true when the system supports implicit_update (see integrators::implicit)
+    bool has_implicit() const;
+    // u += (I - c J)^-1 b where J is the linear part of the rhs with homogeneous
+    // boundary data
+    krylov_result implicit_update(const sim_registry& creg, field_ref b,
+                                  sim_registry& reg, field_ref u, real c,
+                                  const krylov_options&);
     system_stats stats(const sim_registry& reg, field_ref u0,
                        field_ref u1, const step_controller&) const;
     void initialize(sim_registry& reg, field_ref ref, const step_controller&);
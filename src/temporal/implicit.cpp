@@ -0,0 +1,150 @@
+#include "implicit.hpp"
+#include "slot_ops.hpp"
+#include "step_controller.hpp"
+#include "systems/system.hpp"
+
+#include <Kokkos_Profiling_ScopedRegion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include <sol/sol.hpp>
+
+namespace ccs::integrators
+{
+
+implicit::implicit(implicit_scheme scheme, const krylov_options& opts, const logs& logger)
+    : scheme{scheme}, opts{opts}, logger{logger}
+{
+}
+
+namespace
+{
+// system_rhs_ref = F(output, time) through the pre-built rhs graph
+void rhs(system& sys, sim_registry& reg, field_ref output, field_ref system_rhs_ref, real time)
+{
+    slot_zero(reg, system_rhs_ref);
+    sys.submit_rhs_graph(reg, output, reg, system_rhs_ref, time);
+}
+} // namespace
+
+void implicit::solve(system& sys, sim_registry& reg, field_ref b, field_ref output, real c)
+{
+    auto r = sys.implicit_update(reg, b, reg, output, c, opts);
+    if (!r.converged)
+        logger(spdlog::level::warn,
+               "implicit solve did not converge: residual {} after {} iterations",
+               r.residual,
+               r.iterations);
+
+    last.iterations = std::max(last.iterations, r.iterations);
+    last.residual = std::max(last.residual, r.residual);
+    last.converged = last.converged && r.converged;
+}
+
+void implicit::operator()(system& sys, sim_registry& reg,
+                          field_ref u0, field_ref output,
+                          field_ref stage_ref, field_ref system_rhs_ref,
+                          const step_controller& ctrl, real dt)
+{
+    Kokkos::Profiling::ScopedRegion step_region("implicit::step");
+    const real time = ctrl;
+    last = {0, 0, true};
+
+    // The rhs graph is bound to (output, system_rhs_ref), so every rhs is taken
+    // of output.  Boundary values are set before each solve since the
+    // correction du vanishes on them.
+    reg.deep_copy_slot(output.slot, u0.slot);
+
+    switch (scheme) {
+    case implicit_scheme::backward_euler:
+        // (I - dt J) du = dt F(u0, t + dt)
+        sys.update_boundary(reg, output, time + dt);
+        rhs(sys, reg, output, system_rhs_ref, time + dt);
+        slot_scale(reg, system_rhs_ref, dt);
+        solve(sys, reg, system_rhs_ref, output, dt);
+        break;
+
+    case implicit_scheme::crank_nicolson:
+        // (I - dt/2 J) du = dt/2 (F(u0, t) + F(u0, t + dt))
+        rhs(sys, reg, output, system_rhs_ref, time);
+        reg.deep_copy_slot(stage_ref.slot, system_rhs_ref.slot);
+        sys.update_boundary(reg, output, time + dt);
+        rhs(sys, reg, output, system_rhs_ref, time + dt);
+        slot_accumulate(reg, system_rhs_ref, 1.0, stage_ref);
+        slot_scale(reg, system_rhs_ref, dt / 2);
+        solve(sys, reg, system_rhs_ref, output, dt / 2);
+        break;
+
+    case implicit_scheme::sdirk2: {
+        // two stage, L-stable SDIRK; both stages solve with c = gamma dt
+        const real gamma = 1 - 1 / std::sqrt(2.0);
+        const real t1 = time + gamma * dt;
+
+        // U1 = u0 + gamma dt F(U1, t1)
+        sys.update_boundary(reg, output, t1);
+        rhs(sys, reg, output, system_rhs_ref, t1);
+        slot_scale(reg, system_rhs_ref, gamma * dt);
+        solve(sys, reg, system_rhs_ref, output, gamma * dt);
+
+        // k1 = F(U1, t1)
+        rhs(sys, reg, output, system_rhs_ref, t1);
+        reg.deep_copy_slot(stage_ref.slot, system_rhs_ref.slot);
+
+        // u1 = u0 + (1 - gamma) dt k1 + gamma dt F(u1, t + dt)
+        slot_assign_lc(reg, output, u0, (1 - gamma) * dt, stage_ref);
+        sys.update_boundary(reg, output, time + dt);
+        rhs(sys, reg, output, system_rhs_ref, time + dt);
+        slot_scale(reg, system_rhs_ref, gamma * dt);
+        solve(sys, reg, system_rhs_ref, output, gamma * dt);
+        break;
+    }
+
+    case implicit_scheme::imex_euler:
+        // boundary data implicit at t + dt, sources explicit at t
+        sys.update_boundary(reg, output, time + dt);
+        rhs(sys, reg, output, system_rhs_ref, time);
+        slot_scale(reg, system_rhs_ref, dt);
+        solve(sys, reg, system_rhs_ref, output, dt);
+        break;
+    }
+
+    sys.update_boundary(reg, output, time + dt);
+}
+
+int implicit::work_vectors() const
+{
+    // the right hand side and solution on the unknowns, then r, z, p and q for
+    // CG or the restart + 1 basis vectors, w and z for GMRES
+    return 2 + (opts.method == krylov_method::cg ? 4 : opts.restart + 3);
+}
+
+std::optional<implicit> implicit::from_lua(const sol::table& tbl, const logs& logger)
+{
+    auto m = tbl["integrator"];
+    auto name = m["scheme"].get_or(std::string{"backward_euler"});
+
+    implicit_scheme scheme;
+    if (name == "backward_euler")
+        scheme = implicit_scheme::backward_euler;
+    else if (name == "crank_nicolson")
+        scheme = implicit_scheme::crank_nicolson;
+    else if (name == "sdirk2")
+        scheme = implicit_scheme::sdirk2;
+    else if (name == "imex_euler")
+        scheme = implicit_scheme::imex_euler;
+    else {
+        logger(spdlog::level::err,
+               "integrator.scheme must be one of: [backward_euler, crank_nicolson, "
+               "sdirk2, imex_euler]");
+        return std::nullopt;
+    }
+
+    auto opts = krylov_options::from_lua(tbl, logger);
+    if (!opts) return std::nullopt;
+
+    return implicit{scheme, *opts, logger};
+}
+
+} // namespace ccs::integrators
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "fields/field_registry.hpp"
+#include "io/logging.hpp"
+#include "operators/krylov.hpp"
+
+#include <optional>
+#include <sol/forward.hpp>
+
+namespace ccs
+{
+// Forward decls
+class system;
+class step_controller;
+
+namespace integrators
+{
+
+enum class implicit_scheme { backward_euler, crank_nicolson, sdirk2, imex_euler };
+
+//
+// Linearly implicit schemes for systems whose rhs is affine in the solution,
+// F(u, t) = J u + g(t).  Each stage solves (I - c J) du = b with
+// system::implicit_update, matrix-free, so the step is not bound by the
+// parabolic stability limit.  imex_euler treats J and the boundary data
+// implicitly and the source terms explicitly.
+//
+class implicit
+{
+    implicit_scheme scheme = implicit_scheme::backward_euler;
+    krylov_options opts{};
+    logs logger{};
+    krylov_result last{0, 0, true};
+
+    // output += (I - c J)^-1 b, recording the solve in last
+    void solve(system& sys, sim_registry& reg, field_ref b, field_ref output, real c);
+
+public:
+    implicit() = default;
+
+    implicit(implicit_scheme, const krylov_options& = {}, const logs& = {});
+
+    void operator()(system& sys, sim_registry& reg,
+                    field_ref u0, field_ref output,
+                    field_ref stage_ref, field_ref system_rhs_ref,
+                    const step_controller& ctrl, real dt);
+
+    // worst Krylov solve of the last step
+    const krylov_result& last_solve() const { return last; }
+
+    // scalar-sized vectors one Krylov solve holds
+    int work_vectors() const;
+
+    static std::optional<implicit> from_lua(const sol::table&, const logs& = {});
+};
+} // namespace integrators
+} // namespace ccs
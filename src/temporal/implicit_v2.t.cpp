@@ -0,0 +1,164 @@
+#include <Kokkos_Core.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <fmt/format.h>
+#include <sol/sol.hpp>
+
+#include "integrator.hpp"
+#include "systems/system.hpp"
+
+using namespace ccs;
+
+// ---------------------------------------------------------------------------
+// Custom main: Kokkos must be initialized before any test allocates Views.
+// ---------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    Kokkos::ScopeGuard kokkos(argc, argv);
+    return Catch::Session().run(argc, argv);
+}
+
+// ---------------------------------------------------------------------------
+// One step of each implicit scheme at 50x the explicit parabolic limit.  The
+// manufactured solution is cubic in space and linear in time, so every scheme
+// is exact up to the Krylov tolerance.
+// ---------------------------------------------------------------------------
+
+TEST_CASE("implicit registry-based step")
+{
+    const auto scheme = GENERATE(
+        as<std::string>{}, "backward_euler", "crank_nicolson", "sdirk2", "imex_euler");
+
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(fmt::format(R"(
+        simulation = {{
+            mesh = {{
+                index_extents = {{21, 22, 23}},
+                domain_bounds = {{
+                    min = {{1, 1.1, 0.3}},
+                    max = {{3, 3.3, 2.2}}
+                }}
+            }},
+            domain_boundaries = {{
+                xmin = "dirichlet",
+                ymin = "neumann",
+                ymax = "neumann",
+                zmax = "dirichlet"
+            }},
+            shapes = {{
+                {{
+                    type = "sphere",
+                    center = {{2.0001, 2.5656565, 1.313131311}},
+                    radius = 0.25,
+                    boundary_condition = "dirichlet"
+                }}
+            }},
+            scheme = {{
+                order = 2,
+                type = "E2"
+            }},
+            system = {{
+                type = "heat",
+                diffusivity = 1.0
+            }},
+            integrator = {{
+                type = "implicit",
+                scheme = "{}",
+                krylov = {{ method = "gmres", rtol = 1e-12, max_iterations = 2000 }}
+            }},
+            step_controller = {{
+                max_step = 1,
+                cfl = {{ parabolic = 50 }}
+            }},
+            manufactured_solution = {{
+                type = "lua",
+                call = function(time, loc)
+                    local x, y, z = loc[1], loc[2], loc[3]
+                    return (time +
+                        x * x * (y + z) + y * y * (x + z) + z * z * (x + y) +
+                        3 * x * y * z + x + y + z)
+                end,
+                ddt = function(time, loc)
+                    return 1.0
+                end,
+                grad = function(time, loc)
+                    local x, y, z = loc[1], loc[2], loc[3]
+                    return 2. * x * (y + z) + y * y + z * z + 3. * y * z + 1,
+                            x * x + 2. * y * (x + z) + z * z + 3. * x * z + 1,
+                            x * x + y * y + 2. * z * (x + y) + 3. * x * y + 1
+                end,
+                lap = function(time, loc)
+                    local x, y, z = loc[1], loc[2], loc[3]
+                    return 2. * (y + z) + 2. * (x + z) + 2. * (x + y)
+                end,
+                div = function(time, loc)
+                    return 0.0
+                end
+            }}
+        }}
+    )",
+                           scheme));
+
+    auto sys_opt = system::from_lua(lua["simulation"]);
+    REQUIRE(!!sys_opt);
+    auto& sys = *sys_opt;
+    REQUIRE(sys.has_implicit());
+
+    auto it_opt = integrator::from_lua(lua["simulation"]);
+    REQUIRE(!!it_opt);
+    REQUIRE(it_opt->is_implicit());
+
+    auto st_opt = step_controller::from_lua(lua["simulation"]);
+    REQUIRE(!!st_opt);
+    auto& step = *st_opt;
+
+    // u0(0), u1(1), stage(2), system_rhs(3) as in simulation_cycle
+    sim_registry reg;
+    auto sz = sys.size();
+    field_ref u0_ref{0}, u1_ref{1}, stage_ref{2}, srhs_ref{3};
+    for (int s = 0; s < sz.nscalars; ++s) {
+        u0_ref = reg.allocate_scalar(0, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        u1_ref = reg.allocate_scalar(1, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        stage_ref = reg.allocate_scalar(2, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+        srhs_ref = reg.allocate_scalar(3, s, sz.d_size, sz.rx_size, sz.ry_size, sz.rz_size);
+    }
+
+    sys.initialize(reg, u0_ref, step);
+    sys.update_boundary(reg, u0_ref, step);
+
+    // 50x the explicit limit h^2 / (4 k)
+    const real dt = *sys.timestep_size(reg, u0_ref, step);
+    REQUIRE(dt > 10 * 0.1 * 0.1 / 4);
+
+    sys.build_rhs_graph(reg, u1_ref, reg, srhs_ref);
+    (*it_opt)(sys, reg, u0_ref, u1_ref, stage_ref, srhs_ref, step, dt);
+
+    step.advance(dt);
+    auto stats = sys.stats(reg, u0_ref, u1_ref, step);
+    REQUIRE_THAT(stats.stats[0], Catch::Matchers::WithinAbs(0.0, 1e-9));
+}
+
+TEST_CASE("implicit from_lua")
+{
+    sol::state lua;
+    lua.open_libraries(sol::lib::base, sol::lib::math);
+    lua.script(R"(
+        a = { integrator = { type = "implicit" } }
+        b = { integrator = { type = "implicit", scheme = "bdf3" } }
+        c = { integrator = { type = "implicit", krylov = { method = "lu" } } }
+    )");
+
+    auto a = integrator::from_lua(lua["a"]);
+    REQUIRE(!!a);
+    REQUIRE(a->is_implicit());
+    REQUIRE(!integrator::from_lua(lua["b"]));
+    REQUIRE(!integrator::from_lua(lua["c"]));
+
+    // simulation_cycle::from_lua rejects implicit integrators for these
+    REQUIRE(!system{systems::empty{}}.has_implicit());
+}
@@ -14,7 +14,8 @@ void integrator::operator()(system& sys, sim_registry& reg,
     std::visit(
         [&](auto&& integ) {
             using T = std::decay_t<decltype(integ)>;
-            if constexpr (std::is_same_v<T, integrators::rk4>) {
+            if constexpr (std::is_same_v<T, integrators::rk4> ||
+                          std::is_same_v<T, integrators::implicit>) {
                 integ(sys, reg, u0, output, scratch1, scratch2, ctrl, dt);
             } else if constexpr (std::is_same_v<T, integrators::euler>) {
                 integ(sys, reg, u0, output, scratch2, ctrl, dt);
@@ -24,6 +25,17 @@ void integrator::operator()(system& sys, sim_registry& reg,
         v);
 }
 
+bool integrator::is_implicit() const
+{
+    return std::holds_alternative<integrators::implicit>(v);
+}
+
+int integrator::work_vectors() const
+{
+    auto* i = std::get_if<integrators::implicit>(&v);
+    return i ? i->work_vectors() : 0;
+}
+
 std::optional<integrator> integrator::from_lua(const sol::table& tbl, const logs& logger)
 {
 
@@ -42,8 +54,14 @@ std::optional<integrator> integrator::from_lua(const sol::table& tbl, const logs
     } else if (type == "euler") {
         logger(spdlog::level::info, "building euler integrator");
         return integrator{integrators::euler{}};
+    } else if (type == "implicit") {
+        logger(spdlog::level::info, "building implicit integrator");
+        if (auto opt = integrators::implicit::from_lua(tbl, logger); opt)
+            return integrator{MOVE(*opt)};
+        return std::nullopt;
     } else {
-        logger(spdlog::level::err, "integrator.type must be one of: [rk4, euler]");
+        logger(spdlog::level::err,
+               "integrator.type must be one of: [rk4, euler, implicit]");
         return std::nullopt;
     }
 }
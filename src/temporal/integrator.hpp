@@ -6,6 +6,7 @@
 
 #include "empty_integrator.hpp"
 #include "euler.hpp"
+#include "implicit.hpp"
 #include "io/logging.hpp"
 #include "rk4.hpp"
 #include "types.hpp"
@@ -17,7 +18,8 @@ class system;
 
 class integrator
 {
-    std::variant<integrators::empty, integrators::rk4, integrators::euler> v;
+    std::variant<integrators::empty, integrators::rk4, integrators::euler, integrators::implicit>
+        v;
     using v_t = decltype(v);
 
 public:
@@ -32,6 +34,18 @@ public:
                     field_ref scratch1, field_ref scratch2,
                     const step_controller& ctrl, real dt);
 
+    // true for integrators that need system::implicit_update
+    bool is_implicit() const;
+
+    // registry slots simulation_cycle allocates for a step: u0, the output and
+    // the two scratch slots operator() is handed, whether the scheme reads them
+    // or not
+    int slots() const { return 4; }
+
+    // scalar-sized vectors a step holds outside the registry: those of one
+    // Krylov solve for the implicit schemes, none otherwise
+    int work_vectors() const;
+
     static std::optional<integrator> from_lua(const sol::table&, const logs& = {});
 };
 
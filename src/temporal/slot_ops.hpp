@@ -7,55 +7,69 @@
 namespace ccs
 {
 
-// Zero all allocated buffers in a slot.
-inline void slot_zero(sim_registry& reg, field_ref ref)
+// Visit every allocated buffer of a slot: the 4 buffers of each scalar, then
+// the 12 component buffers of each vector.
+template <typename F>
+inline void for_each_slot_buffer(field_ref ref, F&& f)
 {
-    assert(ref.n_vectors == 0 && "slot_ops: vector support not yet implemented");
+    using layout = sim_registry::layout_type;
     for (int s = 0; s < ref.n_scalars; ++s) {
-        scalar_handle sh{s * sim_registry::layout_type::scalar_stride};
-        for (auto bh : sh.all())
-            Kokkos::deep_copy(reg.view(ref, bh), 0.0);
+        scalar_handle sh{s * layout::scalar_stride};
+        for (auto bh : sh.all()) f(bh);
+    }
+    for (int v = 0; v < ref.n_vectors; ++v) {
+        vector_handle vh{layout::vector_base + v * layout::vector_stride};
+        for (auto bh : vh.all()) f(bh);
     }
-    Kokkos::fence();
+}
+
+// Zero all allocated buffers in a slot.
+inline void slot_zero(sim_registry& reg, field_ref ref)
+{
+    for_each_slot_buffer(ref, [&](buf_handle bh) {
+        Kokkos::deep_copy(exec_space(), reg.view(ref, bh), 0.0);
+    });
+    exec_space().fence("slot_zero complete");
 }
 
 // dst[i] = src[i] + coeff * rhs[i]  for all allocated buffers.
 inline void slot_assign_lc(sim_registry& reg, field_ref dst,
                             field_ref src, real coeff, field_ref rhs)
 {
-    assert(dst.n_vectors == 0 && "slot_ops: vector support not yet implemented");
-    for (int s = 0; s < dst.n_scalars; ++s) {
-        scalar_handle sh{s * sim_registry::layout_type::scalar_stride};
-        for (auto bh : sh.all()) {
-            int n = reg.size(dst, bh);
-            real* d = reg.data(dst, bh);
-            const real* s0 = reg.data(src, bh);
-            const real* r = reg.data(rhs, bh);
-            Kokkos::parallel_for(
-                Kokkos::RangePolicy<execution_space>(0, n),
-                KOKKOS_LAMBDA(int i) { d[i] = s0[i] + coeff * r[i]; });
-        }
-    }
-    Kokkos::fence();
+    assert(dst.n_scalars == src.n_scalars && dst.n_vectors == src.n_vectors);
+    for_each_slot_buffer(dst, [&](buf_handle bh) {
+        const integer n = reg.size(dst, bh);
+        real* d = reg.data(dst, bh);
+        const real* s0 = reg.data(src, bh);
+        const real* r = reg.data(rhs, bh);
+        index_for("slot_assign_lc", n, KOKKOS_LAMBDA(auto i) { d[i] = s0[i] + coeff * r[i]; });
+    });
+    exec_space().fence("slot_assign_lc complete");
 }
 
 // dst[i] += coeff * src[i]  for all allocated buffers.
 inline void slot_accumulate(sim_registry& reg, field_ref dst,
                              real coeff, field_ref src)
 {
-    assert(dst.n_vectors == 0 && "slot_ops: vector support not yet implemented");
-    for (int s = 0; s < dst.n_scalars; ++s) {
-        scalar_handle sh{s * sim_registry::layout_type::scalar_stride};
-        for (auto bh : sh.all()) {
-            int n = reg.size(dst, bh);
-            real* d = reg.data(dst, bh);
-            const real* r = reg.data(src, bh);
-            Kokkos::parallel_for(
-                Kokkos::RangePolicy<execution_space>(0, n),
-                KOKKOS_LAMBDA(int i) { d[i] += coeff * r[i]; });
-        }
-    }
-    Kokkos::fence();
+    assert(dst.n_scalars == src.n_scalars && dst.n_vectors == src.n_vectors);
+    for_each_slot_buffer(dst, [&](buf_handle bh) {
+        const integer n = reg.size(dst, bh);
+        real* d = reg.data(dst, bh);
+        const real* r = reg.data(src, bh);
+        index_for("slot_accumulate", n, KOKKOS_LAMBDA(auto i) { d[i] += coeff * r[i]; });
+    });
+    exec_space().fence("slot_accumulate complete");
+}
+
+// dst[i] *= coeff  for all allocated buffers.
+inline void slot_scale(sim_registry& reg, field_ref dst, real coeff)
+{
+    for_each_slot_buffer(dst, [&](buf_handle bh) {
+        const integer n = reg.size(dst, bh);
+        real* d = reg.data(dst, bh);
+        index_for("slot_scale", n, KOKKOS_LAMBDA(auto i) { d[i] *= coeff; });
+    });
+    exec_space().fence("slot_scale complete");
 }
 
 } // namespace ccs
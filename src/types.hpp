@@ -56,6 +56,8 @@ using lit = std::integral_constant<int, N>;
 
 struct system_stats {
     std::vector<real> stats;
+    // the stats of each scalar of a heat run that retires diverged scalars
+    std::vector<std::vector<real>> scalars;
     real wall_time_s = 0.0;
 };
 
@@ -82,6 +84,19 @@ struct plus_eq_t {
     }
 };
 
+// accumulate with a pointwise weight: x[i] += w[i] * y.  Matrices that support it
+// pass the output row index so a variable coefficient can be folded into the
+// operator application instead of a separate scratch field.
+struct weighted_plus_eq_t {
+    const real* w;
+
+    template <typename X, typename Y>
+    constexpr void operator()(X& x, Y&& y, integer i) const
+    {
+        x += w[i] * FWD(y);
+    }
+};
+
 constexpr auto eq = eq_t{};
 constexpr auto plus_eq = plus_eq_t{};
 
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace ccs
+{
+
+// Floating point operations and compulsory memory traffic of a kernel, used to
+// turn region times into achieved GFLOP/s and GB/s.
+struct work {
+    real flops;
+    real bytes;
+
+    work& operator+=(const work& o)
+    {
+        flops += o.flops;
+        bytes += o.bytes;
+        return *this;
+    }
+
+    friend work operator+(work a, const work& b) { return a += b; }
+};
+
+// Set by an installed profiler, which adds reported work to the regions open on
+// the calling thread.  Without one a report is a single null check.
+inline void (*work_sink)(const work&) = nullptr;
+
+inline void report_work(const work& w)
+{
+    if (work_sink) work_sink(w);
+}
+
+} // namespace ccs